@@ -119,15 +119,21 @@ bool Discreet3DSImporter::CanRead( const std::string& pFile, IOSystem* pIOHandle
 		return true;
 	}
 	if (!extension.length() || checkSig) {
-		uint16_t token[3];
-		token[0] = 0x4d4d;
-		token[1] = 0x3dc2;
-		//token[2] = 0x3daa;
-		return CheckMagicToken(pIOHandler,pFile,token,2,0,2);
+		return CheckMagicTokens(pIOHandler,pFile);
 	}
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens checked by CanRead()
+void Discreet3DSImporter::GetMagicTokens(std::vector<MagicToken>& tokens) const
+{
+	uint16_t token[2];
+	token[0] = 0x4d4d;
+	token[1] = 0x3dc2;
+	AddMagicTokens(tokens,token,2,0,2);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Loader registry entry
 const aiImporterDesc* Discreet3DSImporter::GetInfo () const
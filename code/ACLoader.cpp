@@ -151,12 +151,19 @@ bool AC3DImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler, bool
 		return true;
 	}
 	if (!extension.length() || checkSig) {
-		uint32_t token = AI_MAKE_MAGIC("AC3D");
-		return CheckMagicToken(pIOHandler,pFile,&token,1,0);
+		return CheckMagicTokens(pIOHandler,pFile);
 	}
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens checked by CanRead()
+void AC3DImporter::GetMagicTokens(std::vector<MagicToken>& tokens) const
+{
+	const uint32_t token = AI_MAKE_MAGIC("AC3D");
+	AddMagicTokens(tokens,&token,1,0);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Loader meta information
 const aiImporterDesc* AC3DImporter::GetInfo () const
@@ -0,0 +1,376 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file  AnimationSampler.cpp
+ *  @brief Implementation of the Assimp::AnimationSampler class
+ */
+
+#include "../include/assimp/AnimationSampler.hpp"
+#include "../include/assimp/scene.h"
+#include "../include/assimp/DefaultLogger.hpp"
+#include "../include/assimp/ai_assert.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** State of a single animation channel */
+struct SamplerChannel
+{
+	const aiNodeAnim* mChannel;
+
+	// index of the animated node
+	unsigned int mNode;
+
+	// default transformation of the node, for aiAnimBehaviour_DEFAULT
+	aiVector3D mDefaultPosition;
+	aiQuaternion mDefaultRotation;
+	aiVector3D mDefaultScaling;
+
+	// index of the key at or before the time of the last evaluation, per track
+	unsigned int mPositionCursor;
+	unsigned int mRotationCursor;
+	unsigned int mScalingCursor;
+};
+
+// ------------------------------------------------------------------------------------------------
+class AnimationSamplerPimpl
+{
+public:
+
+	const aiAnimation* mAnim;
+
+	// flattened node hierarchy, parents come before their children
+	std::vector<const aiNode*> mNodes;
+	std::vector<unsigned int> mParents;
+	std::map<std::string, unsigned int> mNodesByName;
+
+	std::vector<aiMatrix4x4> mLocalTransforms;
+	std::vector<aiMatrix4x4> mGlobalTransforms;
+
+	std::vector<SamplerChannel> mChannels;
+};
+
+} // !namespace Assimp
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+template <typename KeyType>
+struct KeyTimeLess
+{
+	bool operator() (double pTime, const KeyType& pKey) const {
+		return pTime < pKey.mTime;
+	}
+};
+
+// ------------------------------------------------------------------------------------------------
+// Find the last key at or before pTime, which must not be before the first key.
+// pCursor is the result of the previous search on the track, which is usually
+// the same key or just before the key searched for.
+template <typename KeyType>
+unsigned int FindKey( const KeyType* pKeys, unsigned int pNumKeys, double pTime, unsigned int& pCursor)
+{
+	unsigned int i = pCursor < pNumKeys ? pCursor : 0;
+	if (pKeys[i].mTime > pTime) {
+		// time went backwards
+		i = (unsigned int)(std::upper_bound(pKeys, pKeys + i, pTime, KeyTimeLess<KeyType>()) - pKeys) - 1;
+	}
+	else {
+		// step over a few keys, if the time jumped further ahead than that, 
+		// search the remaining keys instead.
+		for (unsigned int n = 0; i + 1 < pNumKeys && pKeys[i+1].mTime <= pTime; ++n) {
+			if (n == 4) {
+				i = (unsigned int)(std::upper_bound(pKeys + i + 1, pKeys + pNumKeys, pTime, KeyTimeLess<KeyType>()) - pKeys) - 1;
+				break;
+			}
+			++i;
+		}
+	}
+	pCursor = i;
+	return i;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void InterpolateKeys( const aiVectorKey& pA, const aiVectorKey& pB, float pFactor, aiVector3D& pOut)
+{
+	pOut = pA.mValue + (pB.mValue - pA.mValue) * pFactor;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline void InterpolateKeys( const aiQuatKey& pA, const aiQuatKey& pB, float pFactor, aiQuaternion& pOut)
+{
+	aiQuaternion::Interpolate(pOut, pA.mValue, pB.mValue, pFactor);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename KeyType>
+inline float GetFactor( const KeyType& pA, const KeyType& pB, double pTime)
+{
+	const double diff = pB.mTime - pA.mTime;
+	return diff > 0. ? (float)((pTime - pA.mTime) / diff) : 0.f;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Evaluate a single track of a channel
+template <typename KeyType, typename ValueType>
+void SampleTrack( const KeyType* pKeys, unsigned int pNumKeys, double pTime, unsigned int& pCursor,
+	aiAnimBehaviour pPreState, aiAnimBehaviour pPostState, const ValueType& pDefault, ValueType& pOut)
+{
+	if (!pNumKeys) {
+		pOut = pDefault;
+		return;
+	}
+
+	const KeyType& first = pKeys[0];
+	const KeyType& last = pKeys[pNumKeys-1];
+
+	if (pTime < first.mTime || pTime > last.mTime) {
+		const bool before = pTime < first.mTime;
+		switch (before ? pPreState : pPostState)
+		{
+		case aiAnimBehaviour_CONSTANT:
+			pOut = before ? first.mValue : last.mValue;
+			return;
+
+		case aiAnimBehaviour_LINEAR:
+			if (pNumKeys == 1) {
+				pOut = first.mValue;
+			}
+			else if (before) {
+				InterpolateKeys(first, pKeys[1], GetFactor(first, pKeys[1], pTime), pOut);
+			}
+			else {
+				InterpolateKeys(pKeys[pNumKeys-2], last, GetFactor(pKeys[pNumKeys-2], last, pTime), pOut);
+			}
+			return;
+
+		case aiAnimBehaviour_REPEAT:
+			if (last.mTime > first.mTime) {
+				const double length = last.mTime - first.mTime;
+				double t = fmod(pTime - first.mTime, length);
+				if (t < 0.) {
+					t += length;
+				}
+				pTime = first.mTime + t;
+				break;
+			}
+			pOut = first.mValue;
+			return;
+
+		default:
+			pOut = pDefault;
+			return;
+		}
+	}
+
+	const unsigned int i = FindKey(pKeys, pNumKeys, pTime, pCursor);
+	if (i + 1 == pNumKeys) {
+		pOut = pKeys[i].mValue;
+		return;
+	}
+	InterpolateKeys(pKeys[i], pKeys[i+1], GetFactor(pKeys[i], pKeys[i+1], pTime), pOut);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Append a node and all nodes below it to the flattened hierarchy
+void AddNode( AnimationSamplerPimpl& p, const aiNode* pNode, unsigned int pParent)
+{
+	const unsigned int index = (unsigned int)p.mNodes.size();
+	p.mNodes.push_back(pNode);
+	p.mParents.push_back(pParent);
+	p.mLocalTransforms.push_back(pNode->mTransformation);
+	p.mNodesByName.insert(std::make_pair(std::string(pNode->mName.data), index));
+
+	for (unsigned int i = 0; i < pNode->mNumChildren; ++i) {
+		AddNode(p, pNode->mChildren[i], index);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Concatenate the local transformations, parents are always updated before their children
+void UpdateGlobalTransforms( AnimationSamplerPimpl& p)
+{
+	const unsigned int count = (unsigned int)p.mNodes.size();
+	if (!count) {
+		return;
+	}
+
+	const aiMatrix4x4* const local = &p.mLocalTransforms[0];
+	const unsigned int* const parents = &p.mParents[0];
+	aiMatrix4x4* const global = &p.mGlobalTransforms[0];
+
+	global[0] = local[0];
+	for (unsigned int i = 1; i < count; ++i) {
+		global[i] = global[parents[i]] * local[i];
+	}
+}
+
+} // !anon namespace
+
+// ------------------------------------------------------------------------------------------------
+AnimationSampler::AnimationSampler( const aiScene* pScene, unsigned int pAnimIndex)
+	: pimpl(new AnimationSamplerPimpl())
+{
+	ai_assert(pScene);
+	AnimationSamplerPimpl& p = *pimpl;
+
+	p.mAnim = pAnimIndex < pScene->mNumAnimations ? pScene->mAnimations[pAnimIndex] : NULL;
+	if (pScene->mRootNode) {
+		AddNode(p, pScene->mRootNode, UINT_MAX);
+	}
+	p.mGlobalTransforms.resize(p.mNodes.size());
+
+	if (p.mAnim) {
+		p.mChannels.reserve(p.mAnim->mNumChannels);
+		for (unsigned int i = 0; i < p.mAnim->mNumChannels; ++i) {
+			const aiNodeAnim* channel = p.mAnim->mChannels[i];
+
+			const unsigned int node = FindNodeIndex(channel->mNodeName.data);
+			if (node == UINT_MAX) {
+				DefaultLogger::get()->warn("AnimationSampler: no node for animation channel " + 
+					std::string(channel->mNodeName.data));
+				continue;
+			}
+
+			SamplerChannel c;
+			c.mChannel = channel;
+			c.mNode = node;
+			p.mLocalTransforms[node].Decompose(c.mDefaultScaling, c.mDefaultRotation, c.mDefaultPosition);
+			c.mPositionCursor = c.mRotationCursor = c.mScalingCursor = 0;
+			p.mChannels.push_back(c);
+		}
+	}
+
+	UpdateGlobalTransforms(p);
+}
+
+// ------------------------------------------------------------------------------------------------
+AnimationSampler::~AnimationSampler()
+{
+	delete pimpl;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSampler::Evaluate( double pTime)
+{
+	AnimationSamplerPimpl& p = *pimpl;
+	if (!p.mAnim) {
+		return;
+	}
+
+	// every following time calculation happens in ticks
+	const double ticksPerSecond = p.mAnim->mTicksPerSecond != 0.0 ? p.mAnim->mTicksPerSecond : 25.0;
+	const double time = pTime * ticksPerSecond;
+
+	// only animated nodes change their local transformation
+	for (std::vector<SamplerChannel>::iterator it = p.mChannels.begin(); it != p.mChannels.end(); ++it) {
+		SamplerChannel& c = *it;
+		const aiNodeAnim* channel = c.mChannel;
+
+		aiVector3D position, scaling;
+		aiQuaternion rotation;
+		SampleTrack(channel->mPositionKeys, channel->mNumPositionKeys, time, c.mPositionCursor,
+			channel->mPreState, channel->mPostState, c.mDefaultPosition, position);
+		SampleTrack(channel->mRotationKeys, channel->mNumRotationKeys, time, c.mRotationCursor,
+			channel->mPreState, channel->mPostState, c.mDefaultRotation, rotation);
+		SampleTrack(channel->mScalingKeys, channel->mNumScalingKeys, time, c.mScalingCursor,
+			channel->mPreState, channel->mPostState, c.mDefaultScaling, scaling);
+
+		// build a transformation matrix from it
+		aiMatrix4x4& mat = p.mLocalTransforms[c.mNode];
+		mat = aiMatrix4x4(rotation.GetMatrix());
+		mat.a1 *= scaling.x; mat.b1 *= scaling.x; mat.c1 *= scaling.x;
+		mat.a2 *= scaling.y; mat.b2 *= scaling.y; mat.c2 *= scaling.y;
+		mat.a3 *= scaling.z; mat.b3 *= scaling.z; mat.c3 *= scaling.z;
+		mat.a4 = position.x; mat.b4 = position.y; mat.c4 = position.z;
+	}
+
+	UpdateGlobalTransforms(p);
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationSampler::GetNumNodes() const
+{
+	return (unsigned int)pimpl->mNodes.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiNode* AnimationSampler::GetNode( unsigned int pIndex) const
+{
+	ai_assert(pIndex < pimpl->mNodes.size());
+	return pimpl->mNodes[pIndex];
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationSampler::GetParentIndex( unsigned int pIndex) const
+{
+	ai_assert(pIndex < pimpl->mParents.size());
+	return pimpl->mParents[pIndex];
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int AnimationSampler::FindNodeIndex( const char* pName) const
+{
+	std::map<std::string, unsigned int>::const_iterator it = pimpl->mNodesByName.find(pName);
+	return it == pimpl->mNodesByName.end() ? UINT_MAX : (*it).second;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiMatrix4x4* AnimationSampler::GetLocalTransforms() const
+{
+	return pimpl->mLocalTransforms.empty() ? NULL : &pimpl->mLocalTransforms[0];
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiMatrix4x4* AnimationSampler::GetGlobalTransforms() const
+{
+	return pimpl->mGlobalTransforms.empty() ? NULL : &pimpl->mGlobalTransforms[0];
+}
@@ -45,9 +45,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../include/assimp/IOStream.hpp"
 #include "../include/assimp/IOSystem.hpp"
 #include "../include/assimp/Exporter.hpp"
+#include "../include/assimp/config.h"
 #include "ProcessHelper.h"
+#include "ParallelFor.h"
 #include "Exceptional.h"
 #include <boost/static_assert.hpp>
+#include <deque>
+#include <vector>
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #	include <zlib.h>
@@ -306,6 +310,73 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
 	};
 
+	// Blobs smaller than this are always stored, compressing them doesn't pay off
+	const size_t AssbinMinCompressedBlobSize = 4096;
+
+	// ----------------------------------------------------------------------------------
+	/**	@brief	Array stored behind the chunks of a revision 2 file
+	 */
+	struct AssbinBlob
+	{
+		AssbinBlob()
+			: data(), size(), deflated(), offset()
+		{
+		}
+
+		// raw data, either owned by the scene or by the blob
+		const uint8_t* data;
+		size_t size;
+		std::vector<uint8_t> owned;
+
+		// DEFLATE compressed data, only used if it is noticeably smaller
+		std::vector<uint8_t> packed;
+		bool deflated;
+
+		// offset from the start of the file
+		uint64_t offset;
+
+		const uint8_t* GetStoredData() const {
+			return deflated ? &packed[0] : data;
+		}
+
+		size_t GetStoredSize() const {
+			return deflated ? packed.size() : size;
+		}
+	};
+
+	// ----------------------------------------------------------------------------------
+	/**	@brief	ParallelFor() work item, compresses a single blob
+	 */
+	struct AssbinBlobCompressor
+	{
+		AssbinBlobCompressor(std::deque<AssbinBlob>& blobs)
+			: blobs(blobs)
+		{
+		}
+
+		void operator() (unsigned int i)
+		{
+			AssbinBlob& b = blobs[i];
+			if (b.size < AssbinMinCompressedBlobSize) {
+				return;
+			}
+
+			uLongf packedSize = compressBound(static_cast<uLong>(b.size));
+			b.packed.resize(packedSize);
+			if (compress2(&b.packed[0],&packedSize,b.data,static_cast<uLong>(b.size),Z_DEFAULT_COMPRESSION) != Z_OK ||
+				packedSize > b.size - b.size / 8) {
+
+				std::vector<uint8_t>().swap(b.packed);
+				return;
+			}
+
+			b.packed.resize(packedSize);
+			b.deflated = true;
+		}
+
+		std::deque<AssbinBlob>& blobs;
+	};
+
 	// ----------------------------------------------------------------------------------
 	/**	@class	AssbinExport
 	 *	@brief	Assbin exporter class
@@ -316,10 +387,40 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 	{
 	private:
 		bool shortened;
-		bool compressed;
+		bool compressBlobs;
+
+		// blobs referenced by the chunks written so far. Elements of a deque
+		// don't move if more are added, so their data may be owned by them.
+		std::deque<AssbinBlob> blobs;
 
 	protected:
 
+		// -----------------------------------------------------------------------------------
+		// Add a blob referencing the given data and write its index
+		void WriteBlob( IOStream * container, const void* data, size_t size)
+		{
+			blobs.push_back(AssbinBlob());
+			AssbinBlob& b = blobs.back();
+			b.data = static_cast<const uint8_t*>(data);
+			b.size = size;
+
+			Write<unsigned int>(container,static_cast<unsigned int>(blobs.size()-1));
+		}
+
+		// -----------------------------------------------------------------------------------
+		// Add a blob owning its data and write its index. The caller fills the data.
+		uint8_t* WriteOwnedBlob( IOStream * container, size_t size)
+		{
+			blobs.push_back(AssbinBlob());
+			AssbinBlob& b = blobs.back();
+			b.owned.resize(size);
+			b.data = size ? &b.owned[0] : NULL;
+			b.size = size;
+
+			Write<unsigned int>(container,static_cast<unsigned int>(blobs.size()-1));
+			return size ? &b.owned[0] : NULL;
+		}
+
 		// -----------------------------------------------------------------------------------
 		void WriteBinaryNode( IOStream * container, const aiNode* node)
 		{
@@ -350,10 +451,10 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 
 			if(!shortened) {
 				if (!tex->mHeight) {
-					chunk.Write(tex->pcData,1,tex->mWidth);
+					WriteBlob(&chunk,tex->pcData,tex->mWidth);
 				}
 				else {
-					chunk.Write(tex->pcData,1,tex->mWidth*tex->mHeight*4);
+					WriteBlob(&chunk,tex->pcData,tex->mWidth*tex->mHeight*4);
 				}
 			}
 
@@ -412,18 +513,21 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 			}
 			Write<unsigned int>(&chunk,c);
 
-			aiVector3D minVec, maxVec;
+			// vertex components are blobs in their in-memory layout
+			BOOST_STATIC_ASSERT(sizeof(aiVector3D)==12 && sizeof(aiColor4D)==16);
+			const size_t vecSize = mesh->mNumVertices*sizeof(aiVector3D);
+
 			if (mesh->mVertices) {
 				if (shortened) {
 					WriteBounds(&chunk,mesh->mVertices,mesh->mNumVertices);
 				} // else write as usual
-				else WriteArray<aiVector3D>(&chunk,mesh->mVertices,mesh->mNumVertices);
+				else WriteBlob(&chunk,mesh->mVertices,vecSize);
 			}
 			if (mesh->mNormals) {
 				if (shortened) {
 					WriteBounds(&chunk,mesh->mNormals,mesh->mNumVertices);
 				} // else write as usual
-				else WriteArray<aiVector3D>(&chunk,mesh->mNormals,mesh->mNumVertices);
+				else WriteBlob(&chunk,mesh->mNormals,vecSize);
 			}
 			if (mesh->mTangents && mesh->mBitangents) {
 				if (shortened) {
@@ -431,8 +535,8 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 					WriteBounds(&chunk,mesh->mBitangents,mesh->mNumVertices);
 				} // else write as usual
 				else {
-					WriteArray<aiVector3D>(&chunk,mesh->mTangents,mesh->mNumVertices);
-					WriteArray<aiVector3D>(&chunk,mesh->mBitangents,mesh->mNumVertices);
+					WriteBlob(&chunk,mesh->mTangents,vecSize);
+					WriteBlob(&chunk,mesh->mBitangents,vecSize);
 				}
 			}
 			for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS;++n) {
@@ -442,7 +546,7 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 				if (shortened) {
 					WriteBounds(&chunk,mesh->mColors[n],mesh->mNumVertices);
 				} // else write as usual
-				else WriteArray<aiColor4D>(&chunk,mesh->mColors[n],mesh->mNumVertices);
+				else WriteBlob(&chunk,mesh->mColors[n],mesh->mNumVertices*sizeof(aiColor4D));
 			}
 			for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS;++n) {
 				if (!mesh->mTextureCoords[n])
@@ -454,7 +558,7 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 				if (shortened) {
 					WriteBounds(&chunk,mesh->mTextureCoords[n],mesh->mNumVertices);
 				} // else write as usual
-				else WriteArray<aiVector3D>(&chunk,mesh->mTextureCoords[n],mesh->mNumVertices);
+				else WriteBlob(&chunk,mesh->mTextureCoords[n],vecSize);
 			}
 
 			// write faces. There are no floating-point calculations involved
@@ -482,18 +586,34 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 			}
 			else // else write as usual
 			{
-				// if there are less than 2^16 vertices, we can simply use 16 bit integers ...
+				// all indices go to a single blob, so the loader can reference them 
+				// in place. Faces usually have the same size, so the size of each
+				// face is only stored if it varies.
+				unsigned int faceSize = mesh->mNumFaces ? mesh->mFaces[0].mNumIndices : 0;
+				size_t numIndices = 0;
 				for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
 					const aiFace& f = mesh->mFaces[i];
+					if (f.mNumIndices != faceSize) {
+						faceSize = 0;
+					}
+					numIndices += f.mNumIndices;
+				}
+				Write<unsigned int>(&chunk,faceSize);
 
-					BOOST_STATIC_ASSERT(AI_MAX_FACE_INDICES <= 0xffff);
-					Write<uint16_t>(&chunk,f.mNumIndices);
+				BOOST_STATIC_ASSERT(sizeof(unsigned int)==4);
+				uint8_t* indices = WriteOwnedBlob(&chunk,numIndices*sizeof(unsigned int));
+				for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
+					const aiFace& f = mesh->mFaces[i];
+					::memcpy(indices,f.mIndices,f.mNumIndices*sizeof(unsigned int));
+					indices += f.mNumIndices*sizeof(unsigned int);
+				}
 
-					for (unsigned int a = 0; a < f.mNumIndices;++a) {
-						if (mesh->mNumVertices < (1u<<16)) {
-							Write<uint16_t>(&chunk,f.mIndices[a]);
-						}
-						else Write<unsigned int>(&chunk,f.mIndices[a]);
+				if (!faceSize) {
+					BOOST_STATIC_ASSERT(AI_MAX_FACE_INDICES <= 0xffff);
+					uint8_t* sizes = WriteOwnedBlob(&chunk,mesh->mNumFaces*sizeof(uint16_t));
+					for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
+						const uint16_t n = static_cast<uint16_t>(mesh->mFaces[i].mNumIndices);
+						::memcpy(sizes+i*sizeof(uint16_t),&n,sizeof(uint16_t));
 					}
 				}
 			}
@@ -681,8 +801,8 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 		}
 
 	public:
-		AssbinExport() 
-			: shortened(false), compressed(false) // temporary settings until properties are introduced for exporters
+		AssbinExport(bool compressBlobs) 
+			: shortened(false), compressBlobs(compressBlobs)
 		{
 		}
 
@@ -693,16 +813,26 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 			IOStream * out = pIOSystem->Open( pFile, "wb" );
 			if (!out) return;
 
+			// gmtime() and asctime() return static buffers, but Exporter::ExportMany()
+			// may run several exporters at once
 			time_t tt = time(NULL);
-			tm* p     = gmtime(&tt);
+			tm t;
+			char date[32];
+#if _MSC_VER >= 1400
+			gmtime_s(&t,&tt);
+			asctime_s(date,sizeof(date),&t);
+#else
+			gmtime_r(&tt,&t);
+			asctime_r(&t,date);
+#endif
 
 			// header
 			char s[64];
 			memset( s, 0, 64 );
 #if _MSC_VER >= 1400
-			sprintf_s(s,"ASSIMP.binary-dump.%s",asctime(p));
+			sprintf_s(s,"ASSIMP.binary-dump.%s",date);
 #else
-			snprintf(s,64,"ASSIMP.binary-dump.%s",asctime(p));
+			snprintf(s,64,"ASSIMP.binary-dump.%s",date);
 #endif
 			out->Write( s, 44, 1 );
 			// == 44 bytes
@@ -712,7 +842,7 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 			Write<unsigned int>( out, aiGetVersionRevision() );
 			Write<unsigned int>( out, aiGetCompileFlags() );
 			Write<uint16_t>( out, shortened );
-			Write<uint16_t>( out, compressed );
+			Write<uint16_t>( out, 0 ); // blobs are compressed individually
 			// ==  20 bytes
 
 			char buff[256]; 
@@ -731,36 +861,60 @@ inline size_t WriteArray(IOStream * stream, const T* in, unsigned int size)
 			// ==== total header size: 512 bytes
 			ai_assert( out->Tell() == ASSBIN_HEADER_LENGTH );
 
-			// Up to here the data is uncompressed. For compressed files, the rest
-			// is compressed using standard DEFLATE from zlib.
-			if (compressed)
-			{
-				AssbinChunkWriter uncompressedStream( NULL, 0 );
-				WriteBinaryScene( &uncompressedStream, pScene );
+			// serialize the chunks first, this collects the blobs
+			blobs.clear();
+			AssbinChunkWriter structure( NULL, 0 );
+			WriteBinaryScene( &structure, pScene );
+			const uint64_t structureSize = structure.Tell();
 
-				uLongf uncompressedSize = uncompressedStream.Tell();
-				uLongf compressedSize = (uLongf)(uncompressedStream.Tell() * 1.001 + 12.);
-				uint8_t* compressedBuffer = new uint8_t[ compressedSize ];
+			if (compressBlobs) {
+				AssbinBlobCompressor worker(blobs);
+				ParallelFor(static_cast<unsigned int>(blobs.size()),worker);
+			}
 
-				compress2( compressedBuffer, &compressedSize, (const Bytef*)uncompressedStream.GetBufferPointer(), uncompressedSize, 9 );
+			// blobs start at aligned offsets behind the blob table
+			uint64_t offset = ASSBIN_HEADER_LENGTH + 16 + structureSize + blobs.size()*ASSBIN_BLOB_ENTRY_LENGTH;
+			const uint64_t tableEnd = offset;
+			for (std::deque<AssbinBlob>::iterator it = blobs.begin(); it != blobs.end(); ++it) {
+				offset = (offset + ASSBIN_BLOB_ALIGNMENT - 1) & ~static_cast<uint64_t>(ASSBIN_BLOB_ALIGNMENT - 1);
+				(*it).offset = offset;
+				offset += (*it).GetStoredSize();
+			}
 
-				out->Write( &uncompressedSize, sizeof(uint32_t), 1 );
-				out->Write( compressedBuffer, sizeof(char), compressedSize );
+			Write<uint64_t>( out, structureSize );
+			Write<uint64_t>( out, blobs.size() );
+			out->Write( structure.GetBufferPointer(), 1, static_cast<size_t>(structureSize) );
 
-				delete[] compressedBuffer;
+			for (std::deque<AssbinBlob>::const_iterator it = blobs.begin(); it != blobs.end(); ++it) {
+				Write<unsigned int>( out, (*it).deflated ? ASSBIN_BLOB_DEFLATE : ASSBIN_BLOB_STORED );
+				Write<unsigned int>( out, 0 );
+				Write<uint64_t>( out, (*it).offset );
+				Write<uint64_t>( out, (*it).GetStoredSize() );
+				Write<uint64_t>( out, (*it).size );
 			}
-			else
-			{
-				WriteBinaryScene( out, pScene );
+
+			static const uint8_t padding[ASSBIN_BLOB_ALIGNMENT] = {0};
+			offset = tableEnd;
+			for (std::deque<AssbinBlob>::const_iterator it = blobs.begin(); it != blobs.end(); ++it) {
+				out->Write( padding, 1, static_cast<size_t>((*it).offset - offset) );
+
+				const size_t size = (*it).GetStoredSize();
+				if (size) {
+					out->Write( (*it).GetStoredData(), 1, size );
+				}
+				offset = (*it).offset + size;
 			}
 
 			pIOSystem->Close( out );
+			blobs.clear();
 		}
 	};
 
 void ExportSceneAssbin(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
-	AssbinExport exporter;
+	const bool compress = pProperties && pProperties->GetPropertyBool(AI_CONFIG_EXPORT_ASSBIN_COMPRESS,false);
+
+	AssbinExport exporter(compress);
 	exporter.WriteBinaryDump( pFile, pIOSystem, pScene );
 }
 } // end of namespace Assimp
@@ -51,10 +51,19 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AssbinLoader.h"
 #include "assbin_chunks.h"
 #include "MemoryIOWrapper.h"
+#include "DefaultIOStream.h"
+#include "MappedFile.h"
+#include "ParallelFor.h"
+#include "ScenePrivate.h"
 #include "../include/assimp/mesh.h"
 #include "../include/assimp/anim.h"
 #include "../include/assimp/scene.h"
+#include "../include/assimp/config.h"
+#include "../include/assimp/Importer.hpp"
 #include <boost/static_assert.hpp>
+#include <boost/scoped_array.hpp>
+#include <memory>
+#include <limits>
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #	include <zlib.h>
@@ -77,11 +86,72 @@ static const aiImporterDesc desc = {
 	"assbin" 
 };
 
+// Memory the blobs of a revision 2 file live in. Owned by the scene if
+// meshes reference it.
+class AssbinStorage : public SceneStorage
+{
+public:
+	AssbinStorage()
+		: fileData(), unpacked()
+	{}
+
+	~AssbinStorage() {
+		delete[] fileData;
+		delete[] unpacked;
+	}
+
+	// the file, if it could be mapped
+	MappedFile mapping;
+
+	// contents of the file if it couldn't be mapped
+	uint8_t* fileData;
+
+	// decompressed blobs
+	uint8_t* unpacked;
+};
+
+// ParallelFor() work item, decompresses a single blob
+struct AssbinBlobDecompressor
+{
+	struct Job {
+		const uint8_t* src;
+		uLong srcSize;
+		uint8_t* dest;
+		uLong destSize;
+		uint64_t destOffset;
+		size_t blob;
+	};
+	std::vector<Job> jobs;
+
+	void operator() (unsigned int i)
+	{
+		const Job& job = jobs[i];
+
+		uLongf size = job.destSize;
+		if (uncompress(job.dest,&size,job.src,job.srcSize) != Z_OK || size != job.destSize) {
+			throw DeadlyImportError("ASSBIN: failed to decompress blob");
+		}
+	}
+};
+
+AssbinImporter::AssbinImporter()
+	: shortened()
+	, compressed()
+	, zeroCopy(true)
+	, blobFile()
+{
+}
+
 const aiImporterDesc* AssbinImporter::GetInfo() const
 {
 	return &desc;
 }
 
+void AssbinImporter::SetupProperties(const Importer* pImp)
+{
+	zeroCopy = pImp->GetPropertyBool(AI_CONFIG_IMPORT_ASSBIN_ZERO_COPY,true);
+}
+
 bool AssbinImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler, bool /*checkSig*/ ) const
 {
 	IOStream * in = pIOHandler->Open(pFile);
@@ -100,7 +170,9 @@ template <typename T>
 T Read(IOStream * stream)
 {
 	T t;
-	stream->Read( &t, sizeof(T), 1 );
+	if (stream->Read( &t, sizeof(T), 1 ) != 1) {
+		throw DeadlyImportError("ASSBIN: unexpected end of file");
+	}
 	return t;
 }
 
@@ -140,8 +212,13 @@ template <>
 aiString Read<aiString>(IOStream * stream)
 {
 	aiString s;
-	stream->Read(&s.length,4,1);
-	stream->Read(s.data,s.length,1);
+	s.length = Read<uint32_t>(stream);
+	if (s.length >= MAXLEN) {
+		throw DeadlyImportError("ASSBIN: string too long, the file is damaged");
+	}
+	if (s.length && stream->Read(s.data,s.length,1) != 1) {
+		throw DeadlyImportError("ASSBIN: unexpected end of file");
+	}
 	s.data[s.length] = 0;
 	return s;
 }
@@ -197,12 +274,44 @@ template <typename T> void ReadBounds( IOStream * stream, T* /*p*/, unsigned int
 	stream->Seek( sizeof(T) * n, aiOrigin_CUR );
 }
 
-void AssbinImporter::ReadBinaryNode( IOStream * stream, aiNode** node )
+// Read the header of the next chunk, which must be of the given type
+static void ReadChunkHeader( IOStream * stream, uint32_t id )
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AINODE);
+	const uint32_t chunk = Read<uint32_t>(stream);
+	if (chunk != id) {
+		throw DeadlyImportError("ASSBIN: unexpected chunk, the file is damaged");
+	}
 	/*uint32_t size =*/ Read<uint32_t>(stream);
+}
+
+// Reference blob data in place or copy it to a new array
+template <typename T> T* GetBlobArray( uint8_t* data, unsigned int n, bool zeroCopy )
+{
+	if (zeroCopy) {
+		return reinterpret_cast<T*>(data);
+	}
+
+	T* out = new T[n];
+	::memcpy(out,data,sizeof(T) * n);
+	return out;
+}
+
+// -----------------------------------------------------------------------------------
+uint8_t* AssbinImporter::ReadBlob( IOStream * stream, uint64_t size )
+{
+	const unsigned int index = Read<unsigned int>(stream);
+	if (index >= blobs.size() || blobs[index].size != size) {
+		throw DeadlyImportError("ASSBIN: invalid blob reference");
+	}
+	return blobs[index].data;
+}
+
+void AssbinImporter::ReadBinaryNode( IOStream * stream, aiNode** node, aiNode* parent )
+{
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AINODE);
 
 	*node = new aiNode();
+	(*node)->mParent = parent;
 
 	(*node)->mName = Read<aiString>(stream);
 	(*node)->mTransformation = Read<aiMatrix4x4>(stream);
@@ -219,9 +328,9 @@ void AssbinImporter::ReadBinaryNode( IOStream * stream, aiNode** node )
 
 	if ((*node)->mNumChildren)
 	{
-		(*node)->mChildren = new aiNode*[(*node)->mNumChildren];
+		(*node)->mChildren = new aiNode*[(*node)->mNumChildren]();
 		for (unsigned int i = 0; i < (*node)->mNumChildren; ++i) {
-			ReadBinaryNode( stream, &(*node)->mChildren[i] );
+			ReadBinaryNode( stream, &(*node)->mChildren[i], *node );
 		}
 	}
 
@@ -230,8 +339,7 @@ void AssbinImporter::ReadBinaryNode( IOStream * stream, aiNode** node )
 // -----------------------------------------------------------------------------------
 void AssbinImporter::ReadBinaryBone( IOStream * stream, aiBone* b )
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AIBONE );
-	/*uint32_t size =*/ Read<uint32_t>(stream);
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AIBONE);
 
 	b->mName = Read<aiString>(stream);
 	b->mNumWeights = Read<unsigned int>(stream);
@@ -253,8 +361,7 @@ void AssbinImporter::ReadBinaryBone( IOStream * stream, aiBone* b )
 
 void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AIMESH);
-	/*uint32_t size =*/ Read<uint32_t>(stream);
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AIMESH);
 
 	mesh->mPrimitiveTypes = Read<unsigned int>(stream);
 	mesh->mNumVertices = Read<unsigned int>(stream);
@@ -265,6 +372,11 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
 	// first of all, write bits for all existent vertex components
 	unsigned int c = Read<unsigned int>(stream);
 
+	if (blobFile) {
+		ReadBlobMesh(stream,mesh,c);
+		return;
+	}
+
 	if (c & ASSBIN_MESH_HAS_POSITIONS) 
 	{
 		if (shortened) {
@@ -367,7 +479,86 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
 
 	// write bones
 	if (mesh->mNumBones) {
-		mesh->mBones = new C_STRUCT aiBone*[mesh->mNumBones];
+		mesh->mBones = new C_STRUCT aiBone*[mesh->mNumBones]();
+		for (unsigned int a = 0; a < mesh->mNumBones;++a) {
+			mesh->mBones[a] = new aiBone();
+			ReadBinaryBone(stream,mesh->mBones[a]);
+		}
+	}
+}
+
+// -----------------------------------------------------------------------------------
+void AssbinImporter::ReadBlobMesh( IOStream * stream, aiMesh* mesh, unsigned int c )
+{
+	// vertex components are blobs in their in-memory layout
+	BOOST_STATIC_ASSERT(sizeof(aiVector3D)==12 && sizeof(aiColor4D)==16);
+	const uint64_t vecSize = static_cast<uint64_t>(mesh->mNumVertices)*sizeof(aiVector3D);
+
+	if (c & ASSBIN_MESH_HAS_POSITIONS) {
+		mesh->mVertices = GetBlobArray<aiVector3D>(ReadBlob(stream,vecSize),mesh->mNumVertices,zeroCopy);
+	}
+	if (c & ASSBIN_MESH_HAS_NORMALS) {
+		mesh->mNormals = GetBlobArray<aiVector3D>(ReadBlob(stream,vecSize),mesh->mNumVertices,zeroCopy);
+	}
+	if (c & ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS) {
+		mesh->mTangents = GetBlobArray<aiVector3D>(ReadBlob(stream,vecSize),mesh->mNumVertices,zeroCopy);
+		mesh->mBitangents = GetBlobArray<aiVector3D>(ReadBlob(stream,vecSize),mesh->mNumVertices,zeroCopy);
+	}
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS;++n) {
+		if (!(c & ASSBIN_MESH_HAS_COLOR(n)))
+			break;
+
+		const uint64_t size = static_cast<uint64_t>(mesh->mNumVertices)*sizeof(aiColor4D);
+		mesh->mColors[n] = GetBlobArray<aiColor4D>(ReadBlob(stream,size),mesh->mNumVertices,zeroCopy);
+	}
+	for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS;++n) {
+		if (!(c & ASSBIN_MESH_HAS_TEXCOORD(n)))
+			break;
+
+		mesh->mNumUVComponents[n] = Read<unsigned int>(stream);
+		mesh->mTextureCoords[n] = GetBlobArray<aiVector3D>(ReadBlob(stream,vecSize),mesh->mNumVertices,zeroCopy);
+	}
+
+	// faces, either all of the same size or with a separate blob of sizes
+	const unsigned int faceSize = Read<unsigned int>(stream);
+	const unsigned int indexBlob = Read<unsigned int>(stream);
+	if (indexBlob >= blobs.size()) {
+		throw DeadlyImportError("ASSBIN: invalid blob reference");
+	}
+
+	const uint8_t* sizes = NULL;
+	uint64_t numIndices = static_cast<uint64_t>(mesh->mNumFaces)*faceSize;
+	if (!faceSize) {
+		sizes = ReadBlob(stream,static_cast<uint64_t>(mesh->mNumFaces)*sizeof(uint16_t));
+		for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
+			uint16_t n;
+			::memcpy(&n,sizes+i*sizeof(uint16_t),sizeof(uint16_t));
+			numIndices += n;
+		}
+	}
+	if (blobs[indexBlob].size != numIndices*sizeof(unsigned int)) {
+		throw DeadlyImportError("ASSBIN: face indices don't match the blob size");
+	}
+
+	unsigned int* indices = reinterpret_cast<unsigned int*>(blobs[indexBlob].data);
+	mesh->mFaces = new aiFace[mesh->mNumFaces];
+	for (unsigned int i = 0; i < mesh->mNumFaces;++i) {
+		aiFace& f = mesh->mFaces[i];
+		if (sizes) {
+			uint16_t n;
+			::memcpy(&n,sizes+i*sizeof(uint16_t),sizeof(uint16_t));
+			f.mNumIndices = n;
+		}
+		else f.mNumIndices = faceSize;
+
+		f.mIndices = GetBlobArray<unsigned int>(reinterpret_cast<uint8_t*>(indices),f.mNumIndices,zeroCopy);
+		indices += f.mNumIndices;
+	}
+	mesh->mExternalData = zeroCopy ? 1 : 0;
+
+	// bones are stored inline
+	if (mesh->mNumBones) {
+		mesh->mBones = new C_STRUCT aiBone*[mesh->mNumBones]();
 		for (unsigned int a = 0; a < mesh->mNumBones;++a) {
 			mesh->mBones[a] = new aiBone();
 			ReadBinaryBone(stream,mesh->mBones[a]);
@@ -377,8 +568,7 @@ void AssbinImporter::ReadBinaryMesh( IOStream * stream, aiMesh* mesh )
 
 void AssbinImporter::ReadBinaryMaterialProperty(IOStream * stream, aiMaterialProperty* prop)
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AIMATERIALPROPERTY);
-	/*uint32_t size =*/ Read<uint32_t>(stream);
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AIMATERIALPROPERTY);
 
 	prop->mKey = Read<aiString>(stream);
 	prop->mSemantic = Read<unsigned int>(stream);
@@ -393,8 +583,7 @@ void AssbinImporter::ReadBinaryMaterialProperty(IOStream * stream, aiMaterialPro
 // -----------------------------------------------------------------------------------
 void AssbinImporter::ReadBinaryMaterial(IOStream * stream, aiMaterial* mat)
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AIMATERIAL);
-	/*uint32_t size =*/ Read<uint32_t>(stream);
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AIMATERIAL);
 
 	mat->mNumAllocated = mat->mNumProperties = Read<unsigned int>(stream);
 	if (mat->mNumProperties)
@@ -403,7 +592,7 @@ void AssbinImporter::ReadBinaryMaterial(IOStream * stream, aiMaterial* mat)
 		{
 			delete[] mat->mProperties;
 		}
-		mat->mProperties = new aiMaterialProperty*[mat->mNumProperties];
+		mat->mProperties = new aiMaterialProperty*[mat->mNumProperties]();
 		for (unsigned int i = 0; i < mat->mNumProperties;++i) {
 			mat->mProperties[i] = new aiMaterialProperty();
 			ReadBinaryMaterialProperty( stream, mat->mProperties[i]);
@@ -414,8 +603,7 @@ void AssbinImporter::ReadBinaryMaterial(IOStream * stream, aiMaterial* mat)
 // -----------------------------------------------------------------------------------
 void AssbinImporter::ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd)
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AINODEANIM);
-	/*uint32_t size =*/ Read<uint32_t>(stream);
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AINODEANIM);
 
 	nd->mNodeName = Read<aiString>(stream);
 	nd->mNumPositionKeys = Read<unsigned int>(stream);
@@ -462,8 +650,7 @@ void AssbinImporter::ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd)
 // -----------------------------------------------------------------------------------
 void AssbinImporter::ReadBinaryAnim( IOStream * stream, aiAnimation* anim )
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AIANIMATION);
-	/*uint32_t size =*/ Read<uint32_t>(stream);
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AIANIMATION);
 
 	anim->mName = Read<aiString> (stream);
 	anim->mDuration = Read<double> (stream);
@@ -472,7 +659,7 @@ void AssbinImporter::ReadBinaryAnim( IOStream * stream, aiAnimation* anim )
 
 	if (anim->mNumChannels)
 	{
-		anim->mChannels = new aiNodeAnim*[ anim->mNumChannels ];
+		anim->mChannels = new aiNodeAnim*[ anim->mNumChannels ]();
 		for (unsigned int a = 0; a < anim->mNumChannels;++a) {
 			anim->mChannels[a] = new aiNodeAnim();
 			ReadBinaryNodeAnim(stream,anim->mChannels[a]);
@@ -482,14 +669,21 @@ void AssbinImporter::ReadBinaryAnim( IOStream * stream, aiAnimation* anim )
 
 void AssbinImporter::ReadBinaryTexture(IOStream * stream, aiTexture* tex)
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AITEXTURE);
-	/*uint32_t size =*/ Read<uint32_t>(stream);
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AITEXTURE);
 
 	tex->mWidth = Read<unsigned int>(stream);
 	tex->mHeight = Read<unsigned int>(stream);
 	stream->Read( tex->achFormatHint, sizeof(char), 4 );
 
-	if(!shortened) {
+	if (blobFile) {
+		// aiTexture always owns its texels
+		const unsigned int n = tex->mHeight ? tex->mWidth*tex->mHeight : tex->mWidth;
+		const uint64_t size = tex->mHeight ? static_cast<uint64_t>(n)*4 : n;
+
+		tex->pcData = new aiTexel[ n ];
+		::memcpy(tex->pcData,ReadBlob(stream,size),static_cast<size_t>(size));
+	}
+	else if(!shortened) {
 		if (!tex->mHeight) {
 			tex->pcData = new aiTexel[ tex->mWidth ];
 			stream->Read(tex->pcData,1,tex->mWidth);
@@ -505,8 +699,7 @@ void AssbinImporter::ReadBinaryTexture(IOStream * stream, aiTexture* tex)
 // -----------------------------------------------------------------------------------
 void AssbinImporter::ReadBinaryLight( IOStream * stream, aiLight* l )
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AILIGHT);
-	/*uint32_t size =*/ Read<uint32_t>(stream);
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AILIGHT);
 
 	l->mName = Read<aiString>(stream);
 	l->mType = (aiLightSourceType)Read<unsigned int>(stream);
@@ -531,8 +724,7 @@ void AssbinImporter::ReadBinaryLight( IOStream * stream, aiLight* l )
 // -----------------------------------------------------------------------------------
 void AssbinImporter::ReadBinaryCamera( IOStream * stream, aiCamera* cam )
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AICAMERA);
-	/*uint32_t size =*/ Read<uint32_t>(stream);
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AICAMERA);
 
 	cam->mName = Read<aiString>(stream);
 	cam->mPosition = Read<aiVector3D>(stream);
@@ -546,8 +738,7 @@ void AssbinImporter::ReadBinaryCamera( IOStream * stream, aiCamera* cam )
 
 void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 {
-	ai_assert( Read<uint32_t>(stream) == ASSBIN_CHUNK_AISCENE);
-	/*uint32_t size =*/ Read<uint32_t>(stream);
+	ReadChunkHeader(stream,ASSBIN_CHUNK_AISCENE);
 
 	scene->mFlags         = Read<unsigned int>(stream);
 	scene->mNumMeshes     = Read<unsigned int>(stream);
@@ -564,7 +755,7 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 	// Read all meshes
 	if (scene->mNumMeshes)
 	{
-		scene->mMeshes = new aiMesh*[scene->mNumMeshes];
+		scene->mMeshes = new aiMesh*[scene->mNumMeshes]();
 		for (unsigned int i = 0; i < scene->mNumMeshes;++i) {
 			scene->mMeshes[i] = new aiMesh();
 			ReadBinaryMesh( stream,scene->mMeshes[i]);
@@ -574,7 +765,7 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 	// Read materials
 	if (scene->mNumMaterials)
 	{
-		scene->mMaterials = new aiMaterial*[scene->mNumMaterials];
+		scene->mMaterials = new aiMaterial*[scene->mNumMaterials]();
 		for (unsigned int i = 0; i< scene->mNumMaterials; ++i) {
 			scene->mMaterials[i] = new aiMaterial();
 			ReadBinaryMaterial(stream,scene->mMaterials[i]);
@@ -584,7 +775,7 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 	// Read all animations
 	if (scene->mNumAnimations)
 	{
-		scene->mAnimations = new aiAnimation*[scene->mNumAnimations];
+		scene->mAnimations = new aiAnimation*[scene->mNumAnimations]();
 		for (unsigned int i = 0; i < scene->mNumAnimations;++i) {
 			scene->mAnimations[i] = new aiAnimation();
 			ReadBinaryAnim(stream,scene->mAnimations[i]);
@@ -594,7 +785,7 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 	// Read all textures
 	if (scene->mNumTextures)
 	{
-		scene->mTextures = new aiTexture*[scene->mNumTextures];
+		scene->mTextures = new aiTexture*[scene->mNumTextures]();
 		for (unsigned int i = 0; i < scene->mNumTextures;++i) {
 			scene->mTextures[i] = new aiTexture();
 			ReadBinaryTexture(stream,scene->mTextures[i]);
@@ -604,7 +795,7 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 	// Read lights
 	if (scene->mNumLights)
 	{
-		scene->mLights = new aiLight*[scene->mNumLights];
+		scene->mLights = new aiLight*[scene->mNumLights]();
 		for (unsigned int i = 0; i < scene->mNumLights;++i) {
 			scene->mLights[i] = new aiLight();
 			ReadBinaryLight(stream,scene->mLights[i]);
@@ -614,7 +805,7 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 	// Read cameras
 	if (scene->mNumCameras)
 	{
-		scene->mCameras = new aiCamera*[scene->mNumCameras];
+		scene->mCameras = new aiCamera*[scene->mNumCameras]();
 		for (unsigned int i = 0; i < scene->mNumCameras;++i) {
 			scene->mCameras[i] = new aiCamera();
 			ReadBinaryCamera(stream,scene->mCameras[i]);
@@ -623,6 +814,114 @@ void AssbinImporter::ReadBinaryScene( IOStream * stream, aiScene* scene )
 
 }
 
+// -----------------------------------------------------------------------------------
+void AssbinImporter::ReadBlobFile( IOStream * stream, aiScene* pScene )
+{
+	std::auto_ptr<AssbinStorage> storage(new AssbinStorage());
+
+	// map plain files, read all others at once
+	uint8_t* file = NULL;
+	size_t fileSize = stream->FileSize();
+
+	DefaultIOStream* plain = dynamic_cast<DefaultIOStream*>(stream);
+	if (plain && storage->mapping.Map(plain->GetHandle())) {
+		file = storage->mapping.GetData();
+		fileSize = storage->mapping.GetSize();
+	}
+	else {
+		storage->fileData = new uint8_t[fileSize];
+		stream->Seek(0,aiOrigin_SET);
+		if (stream->Read(storage->fileData,1,fileSize) != fileSize) {
+			throw DeadlyImportError("ASSBIN: failed to read file");
+		}
+		file = storage->fileData;
+	}
+
+	const uint64_t start = ASSBIN_HEADER_LENGTH + 16;
+	if (fileSize < start) {
+		throw DeadlyImportError("ASSBIN: file is too small");
+	}
+
+	uint64_t structureSize, numBlobs;
+	::memcpy(&structureSize,file + ASSBIN_HEADER_LENGTH,8);
+	::memcpy(&numBlobs,file + ASSBIN_HEADER_LENGTH + 8,8);
+	if (structureSize > fileSize - start || numBlobs > (fileSize - start - structureSize) / ASSBIN_BLOB_ENTRY_LENGTH) {
+		throw DeadlyImportError("ASSBIN: invalid blob table");
+	}
+
+	// resolve stored blobs, compressed ones go to a single buffer
+	AssbinBlobDecompressor worker;
+	uint64_t unpackedSize = 0;
+
+	blobs.resize(static_cast<size_t>(numBlobs));
+	const uint8_t* entry = file + start + structureSize;
+	for (size_t i = 0; i < blobs.size(); ++i, entry += ASSBIN_BLOB_ENTRY_LENGTH) {
+		uint32_t compression;
+		uint64_t offset, storedSize, rawSize;
+		::memcpy(&compression,entry,4);
+		::memcpy(&offset,entry+8,8);
+		::memcpy(&storedSize,entry+16,8);
+		::memcpy(&rawSize,entry+24,8);
+
+		if (offset > fileSize || storedSize > fileSize - offset || offset % ASSBIN_BLOB_ALIGNMENT) {
+			throw DeadlyImportError("ASSBIN: blob exceeds the file");
+		}
+
+		Blob& b = blobs[i];
+		b.size = rawSize;
+		if (compression == ASSBIN_BLOB_STORED) {
+			if (rawSize != storedSize) {
+				throw DeadlyImportError("ASSBIN: stored blob has the wrong size");
+			}
+			b.data = file + offset;
+		}
+		else if (compression == ASSBIN_BLOB_DEFLATE) {
+			// DEFLATE can't exceed a ratio of about 1:1032
+			if (rawSize > storedSize * 1032 + 64 || rawSize > std::numeric_limits<uLong>::max()) {
+				throw DeadlyImportError("ASSBIN: compressed blob has an invalid size");
+			}
+
+			AssbinBlobDecompressor::Job job;
+			job.src = file + offset;
+			job.srcSize = static_cast<uLong>(storedSize);
+			job.dest = NULL;
+			job.destSize = static_cast<uLong>(rawSize);
+			job.blob = i;
+
+			// keep all blobs aligned for any vertex component
+			job.destOffset = unpackedSize;
+			unpackedSize += (rawSize + 15) & ~static_cast<uint64_t>(15);
+
+			worker.jobs.push_back(job);
+			b.data = NULL;
+		}
+		else throw DeadlyImportError("ASSBIN: unknown blob compression");
+	}
+
+	if (!worker.jobs.empty()) {
+		if (unpackedSize > std::numeric_limits<size_t>::max()) {
+			throw DeadlyImportError("ASSBIN: compressed blobs are too large");
+		}
+
+		storage->unpacked = new uint8_t[static_cast<size_t>(unpackedSize)];
+		for (std::vector<AssbinBlobDecompressor::Job>::iterator it = worker.jobs.begin(); it != worker.jobs.end(); ++it) {
+			(*it).dest = storage->unpacked + (*it).destOffset;
+			blobs[(*it).blob].data = (*it).dest;
+		}
+		ParallelFor(static_cast<unsigned int>(worker.jobs.size()),worker);
+	}
+
+	// the chunks reference the blobs by index
+	blobFile = true;
+	MemoryIOStream structure(file + start,static_cast<size_t>(structureSize));
+	ReadBinaryScene(&structure,pScene);
+
+	// keep the memory alive as long as meshes reference it
+	if (zeroCopy && pScene->mNumMeshes) {
+		ScenePriv(pScene)->mStorage = storage.release();
+	}
+}
+
 void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler )
 {
 	IOStream * stream = pIOHandler->Open(pFile,"rb");
@@ -631,7 +930,7 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
 
 	stream->Seek( 44, aiOrigin_CUR ); // signature
 
-	/*unsigned int versionMajor =*/ Read<unsigned int>(stream);
+	const unsigned int versionMajor = Read<unsigned int>(stream);
 	/*unsigned int versionMinor =*/ Read<unsigned int>(stream);
 	/*unsigned int versionRevision =*/ Read<unsigned int>(stream);
 	/*unsigned int compileFlags =*/ Read<unsigned int>(stream);
@@ -639,6 +938,9 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
 	shortened = Read<uint16_t>(stream) > 0;
 	compressed = Read<uint16_t>(stream) > 0;
 
+	blobFile = false;
+	blobs.clear();
+
 	if (shortened)
 		throw DeadlyImportError( "Shortened binaries are not supported!" );
 
@@ -646,30 +948,41 @@ void AssbinImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
 	stream->Seek( 128, aiOrigin_CUR ); // options
 	stream->Seek( 64, aiOrigin_CUR ); // padding
 
-	if (compressed)
-	{
-		uLongf uncompressedSize = Read<uint32_t>(stream);
-		uLongf compressedSize = stream->FileSize() - stream->Tell();
-
-		unsigned char * compressedData = new unsigned char[ compressedSize ];
-		stream->Read( compressedData, 1, compressedSize );
-
-		unsigned char * uncompressedData = new unsigned char[ uncompressedSize ];
-
-		uncompress( uncompressedData, &uncompressedSize, compressedData, compressedSize );
+	try {
+		if (versionMajor > ASSBIN_VERSION_MAJOR_INLINE)
+		{
+			ReadBlobFile(stream,pScene);
+		}
+		else if (compressed)
+		{
+			uLongf uncompressedSize = Read<uint32_t>(stream);
+			uLongf compressedSize = stream->FileSize() - stream->Tell();
 
-		MemoryIOStream io( uncompressedData, uncompressedSize );
+			boost::scoped_array<unsigned char> compressedData(new unsigned char[ compressedSize ]);
+			if (stream->Read( compressedData.get(), 1, compressedSize ) != compressedSize) {
+				throw DeadlyImportError("ASSBIN: failed to read file");
+			}
 
-		ReadBinaryScene(&io,pScene);
+			boost::scoped_array<unsigned char> uncompressedData(new unsigned char[ uncompressedSize ]);
+			if (uncompress( uncompressedData.get(), &uncompressedSize, compressedData.get(), compressedSize ) != Z_OK) {
+				throw DeadlyImportError("ASSBIN: failed to decompress file");
+			}
 
-		delete[] uncompressedData;
-		delete[] compressedData;
+			MemoryIOStream io( uncompressedData.get(), uncompressedSize );
+			ReadBinaryScene(&io,pScene);
+		}
+		else
+		{
+			ReadBinaryScene(stream,pScene);
+		}
 	}
-	else
-	{
-		ReadBinaryScene(stream,pScene);
+	catch (...) {
+		pIOHandler->Close(stream);
+		blobs.clear();
+		throw;
 	}
-	
+
+	blobs.clear();
 	pIOHandler->Close(stream);
 }
 
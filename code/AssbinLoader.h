@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseImporter.h"
 #include "../include/assimp/types.h"
+#include <vector>
 
 struct aiMesh;
 struct aiNode;
@@ -71,23 +72,39 @@ class AssbinImporter : public BaseImporter
 private:
   bool shortened;
   bool compressed;
+  bool zeroCopy;
+
+  // Blobs of revision 2 files, see assbin_chunks.h
+  struct Blob {
+    uint8_t* data;
+    uint64_t size;
+  };
+  bool blobFile;
+  std::vector<Blob> blobs;
+
 protected:
 
 public:
+  AssbinImporter();
+
   virtual bool CanRead( 
     const std::string& pFile, 
     IOSystem* pIOHandler, 
     bool checkSig
     ) const;
   virtual const aiImporterDesc* GetInfo() const;
+  virtual void SetupProperties(const Importer* pImp);
   virtual void InternReadFile( 
     const std::string& pFile, 
     aiScene* pScene, 
     IOSystem* pIOHandler
     );
+  void ReadBlobFile( IOStream * stream, aiScene* pScene );
+  uint8_t* ReadBlob( IOStream * stream, uint64_t size );
   void ReadBinaryScene( IOStream * stream, aiScene* pScene );
-  void ReadBinaryNode( IOStream * stream, aiNode** mRootNode );
+  void ReadBinaryNode( IOStream * stream, aiNode** mRootNode, aiNode* parent = NULL );
   void ReadBinaryMesh( IOStream * stream, aiMesh* mesh );
+  void ReadBlobMesh( IOStream * stream, aiMesh* mesh, unsigned int components );
   void ReadBinaryBone( IOStream * stream, aiBone* bone );
   void ReadBinaryMaterial(IOStream * stream, aiMaterial* mat);
   void ReadBinaryMaterialProperty(IOStream * stream, aiMaterialProperty* prop);
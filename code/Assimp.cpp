@@ -93,9 +93,6 @@ namespace Assimp
 	/** Verbose logging active or not? */
 	static aiBool gVerboseLogging = false;
 
-    /** will return all registered importers. */
-    void GetImporterInstanceList(std::vector< BaseImporter* >& out);
-
 } // namespace assimp
 
 
@@ -115,10 +112,9 @@ public:
 			ai_assert(NULL != s.callback);
 	}
 
+	// aiDetachLogStream() and aiDetachAllLogStreams() delete us while
+	// holding gLogStreamMutex, locking it again here would deadlock
 	~LogToCallbackRedirector()	{
-#ifndef ASSIMP_BUILD_SINGLETHREADED
-		boost::mutex::scoped_lock lock(gLogStreamMutex);
-#endif
 		// (HACK) Check whether the 'stream.user' pointer points to a
 		// custom LogStream allocated by #aiGetPredefinedLogStream.
 		// In this case, we need to delete it, too. Of course, this 
@@ -624,11 +620,10 @@ ASSIMP_API C_STRUCT const aiImporterDesc* aiGetImporterDesc( const char *extensi
         return NULL;
     }
     const aiImporterDesc *desc( NULL );
-    std::vector< BaseImporter* > out;
-    GetImporterInstanceList( out );
-    for( size_t i = 0; i < out.size(); ++i ) {
-        if( 0 == strncmp( out[ i ]->GetInfo()->mFileExtensions, extension, strlen( extension ) ) ) {
-            desc = out[ i ]->GetInfo();
+    const std::vector< const aiImporterDesc* >& info = GetSharedRegistry().mImporterIndex.mInfo;
+    for( size_t i = 0; i < info.size(); ++i ) {
+        if( 0 == strncmp( info[ i ]->mFileExtensions, extension, strlen( extension ) ) ) {
+            desc = info[ i ];
             break;
         }
     }
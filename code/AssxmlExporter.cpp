@@ -177,8 +177,17 @@ static std::string encodeXML(const std::string& data) {
 // Write a text model dump
 void WriteDump(const aiScene* scene, IOStream* io, bool shortened)
 {
+	// thread-safe variants, the dump may be written from a worker thread
 	time_t tt = ::time(NULL);
-	tm* p     = ::gmtime(&tt);
+	tm t;
+	char date[32];
+#if _MSC_VER >= 1400
+	::gmtime_s(&t,&tt);
+	::asctime_s(date,sizeof(date),&t);
+#else
+	::gmtime_r(&tt,&t);
+	::asctime_r(&t,date);
+#endif
 
 	aiString name;
 
@@ -194,7 +203,7 @@ void WriteDump(const aiScene* scene, IOStream* io, bool shortened)
 		" \n\n"
 		"<Scene flags=\"%i\" postprocessing=\"%i\">\n",
 		
-		aiGetVersionMajor(),aiGetVersionMinor(),aiGetVersionRevision(),asctime(p),
+		aiGetVersionMajor(),aiGetVersionMinor(),aiGetVersionRevision(),date,
 		scene->mFlags,
 		0 /*globalImporter->GetEffectivePostProcessing()*/);
 
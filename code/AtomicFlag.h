@@ -0,0 +1,102 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  AtomicFlag.h
+ *  @brief Boolean flag shared between threads
+ */
+#ifndef AI_ATOMICFLAG_H_INC
+#define AI_ATOMICFLAG_H_INC
+
+#include "../include/assimp/defs.h"
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/atomic.hpp>
+#endif
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Flag which is set by one thread and polled by others, e.g. to
+ *  request cancellation of a running import.
+ *
+ *  Setting the flag happens before a thread which observes it as set
+ *  continues. If threading support is disabled this is a plain bool. */
+class AtomicFlag
+{
+public:
+
+	AtomicFlag()
+		: value(false)
+	{}
+
+	/** Set or clear the flag */
+	void Set(bool v = true) {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+		value.store(v,boost::memory_order_release);
+#else
+		value = v;
+#endif
+	}
+
+	/** Check whether the flag is set */
+	bool IsSet() const {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+		return value.load(boost::memory_order_acquire);
+#else
+		return value;
+#endif
+	}
+
+private:
+
+	// not copyable
+	AtomicFlag(const AtomicFlag&);
+	AtomicFlag& operator = (const AtomicFlag&);
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::atomic<bool> value;
+#else
+	bool value;
+#endif
+};
+
+} // ! Assimp
+
+#endif // AI_ATOMICFLAG_H_INC
@@ -64,6 +64,7 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 BaseImporter::BaseImporter()
 : progress()
+, cancel()
 {
 	// nothing to do here
 }
@@ -81,6 +82,7 @@ aiScene* BaseImporter::ReadFile(const Importer* pImp, const std::string& pFile,
 {
 	progress = pImp->GetProgressHandler();
 	ai_assert(progress);
+	cancel = &pImp->Pimpl()->mCancelRequested;
 
 	// Gather configuration properties for this run
 	SetupProperties( pImp );
@@ -294,6 +296,80 @@ void BaseImporter::GetExtensionList(std::set<std::string>& extensions)
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens of the format, none by default
+void BaseImporter::GetMagicTokens(std::vector<MagicToken>& /*tokens*/) const
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+/* static */ void BaseImporter::AddMagicTokens(std::vector<MagicToken>& tokens, const void* _magic,
+	unsigned int num, unsigned int offset, unsigned int size)
+{
+	ai_assert(size <= 16 && _magic);
+
+	const char* magic = reinterpret_cast<const char*>(_magic);
+	for (unsigned int i = 0; i < num; ++i, magic += size) {
+		MagicToken token;
+		token.mOffset = offset;
+		token.mSize = size;
+		::memcpy(token.mData,magic,size);
+		tokens.push_back(token);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+bool BaseImporter::CheckMagicTokens(IOSystem* pIOHandler, const std::string& pFile) const
+{
+	std::vector<MagicToken> tokens;
+	GetMagicTokens(tokens);
+	if (!pIOHandler || tokens.empty()) {
+		return false;
+	}
+
+	size_t headerSize = 0;
+	for (std::vector<MagicToken>::const_iterator it = tokens.begin(); it != tokens.end(); ++it) {
+		headerSize = std::max(headerSize,static_cast<size_t>((*it).mOffset + (*it).mSize));
+	}
+
+	boost::scoped_ptr<IOStream> pStream (pIOHandler->Open(pFile));
+	if (!pStream.get()) {
+		return false;
+	}
+	std::vector<char> header(headerSize);
+	headerSize = pStream->Read(&header[0],1,headerSize);
+	return MatchMagicTokens(tokens,&header[0],headerSize);
+}
+
+// ------------------------------------------------------------------------------------------------
+/* static */ bool BaseImporter::MatchMagicTokens(const std::vector<MagicToken>& tokens, 
+	const char* header, size_t headerSize)
+{
+	for (std::vector<MagicToken>::const_iterator it = tokens.begin(); it != tokens.end(); ++it) {
+		const MagicToken& token = *it;
+		if (token.mOffset + token.mSize > headerSize) {
+			continue;
+		}
+
+		const char* data = header + token.mOffset;
+		if (!memcmp(token.mData,data,token.mSize)) {
+			return true;
+		}
+
+		// tokens of size 2,4 match byte-swapped as well, see CheckMagicToken()
+		if (2 == token.mSize || 4 == token.mSize) {
+			unsigned int i = 0;
+			while (i < token.mSize && token.mData[i] == data[token.mSize-1-i]) {
+				++i;
+			}
+			if (i == token.mSize) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
 #include "../contrib/ConvertUTF/ConvertUTF.h"
 
 // ------------------------------------------------------------------------------------------------
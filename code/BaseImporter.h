@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INCLUDED_AI_BASEIMPORTER_H
 
 #include "Exceptional.h"
+#include "AtomicFlag.h"
 
 #include <string>
 #include <map>
@@ -62,6 +63,16 @@ class SharedPostProcessInfo;
 class IOStream;
 
 
+// ---------------------------------------------------------------------------
+/** A magic token at a fixed position in the header of a file.
+ *  See BaseImporter::GetMagicTokens(). */
+struct MagicToken
+{
+	unsigned int mOffset; ///< Offset from file start, in bytes
+	unsigned int mSize;   ///< Size of the token in bytes, maximally 16
+	char mData[16];       ///< The token itself
+};
+
 // utility to do char4 to uint32 in a portable manner
 #define AI_MAKE_MAGIC(string) ((uint32_t)((string[0] << 24) + \
 	(string[1] << 16) + (string[2] << 8) + string[3]))
@@ -209,6 +220,19 @@ public:
 	 *  @param extension set to collect file extensions in*/
 	void GetExtensionList(std::set<std::string>& extensions);
 
+	// -------------------------------------------------------------------
+	/** Called by #Importer to collect the magic tokens of the format
+	 *  for signature-based detection. 
+	 *
+	 *  An importer returning tokens here promises that CanRead() with 
+	 *  'checkSig' set can only succeed if one of them is found in the
+	 *  file. #Importer matches the tokens of all importers against the
+	 *  file header in a single pass and doesn't ask the others. The
+	 *  default implementation returns no tokens, so CanRead() is always 
+	 *  called.
+	 *  @param tokens Vector to append the tokens to */
+	virtual void GetMagicTokens(std::vector<MagicToken>& tokens) const;
+
 protected:
 
 	// -------------------------------------------------------------------
@@ -329,6 +353,47 @@ public: // static utilities
 		unsigned int offset = 0,
 		unsigned int size   = 4);
 
+	// -------------------------------------------------------------------
+	/** @brief A utility for GetMagicTokens(), appends magic tokens.
+	 *  The parameters are the same as for #CheckMagicToken.
+	 */
+	static void AddMagicTokens(
+		std::vector<MagicToken>& tokens,
+		const void* magic,
+		unsigned int num,
+		unsigned int offset = 0,
+		unsigned int size   = 4);
+
+	// -------------------------------------------------------------------
+	/** @brief Check whether a file contains one of the magic tokens
+	 *    returned by GetMagicTokens().
+	 *
+	 *  Meant for CanRead(), so that importers define their tokens in 
+	 *  GetMagicTokens() only.
+	 *  @param pIOHandler IO system to be used
+	 *  @param pFile Input file
+	 *  @return true if one of the tokens was found
+	 */
+	bool CheckMagicTokens(
+		IOSystem* pIOHandler,
+		const std::string& pFile) const;
+
+	// -------------------------------------------------------------------
+	/** @brief Check whether a file header contains one of the given
+	 *    magic tokens.
+	 *  @param tokens Tokens to search for
+	 *  @param header First bytes of the file
+	 *  @param headerSize Number of bytes in header
+	 *  @return true if one of the given tokens was found
+	 *
+	 *  @note As in #CheckMagicToken, tokens of size 2 and 4 match 
+	 *  byte-swapped as well.
+	 */
+	static bool MatchMagicTokens(
+		const std::vector<MagicToken>& tokens,
+		const char* header,
+		size_t headerSize);
+
 	// -------------------------------------------------------------------
 	/** An utility for all text file loaders. It converts a file to our
 	 *   UTF8 character set. Errors are reported, but ignored.
@@ -366,6 +431,9 @@ protected:
 
 	/** Currently set progress handler */
 	ProgressHandler* progress;
+
+	/** Set while the import is to be cancelled, see ProgressReporter */
+	const AtomicFlag* cancel;
 };
 
 
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../include/assimp/DefaultLogger.hpp"
 #include "../include/assimp/scene.h"
 #include "Importer.h"
+#include "ProgressReporter.h"
 
 using namespace Assimp;
 
@@ -54,6 +55,9 @@ using namespace Assimp;
 BaseProcess::BaseProcess()
 : shared()
 , progress()
+, cancel()
+, progressBase(0.5f)
+, progressRange(0.5f)
 {
 }
 
@@ -71,6 +75,7 @@ void BaseProcess::ExecuteOnScene( Importer* pImp)
 
 	progress = pImp->GetProgressHandler();
 	ai_assert(progress);
+	cancel = &pImp->Pimpl()->mCancelRequested;
 
 	SetupProperties( pImp );
 
@@ -91,6 +96,12 @@ void BaseProcess::ExecuteOnScene( Importer* pImp)
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+ProgressReporter BaseProcess::GetProgressReporter(size_t total) const
+{
+	return ProgressReporter(progress,cancel,total,progressBase,progressRange);
+}
+
 // ------------------------------------------------------------------------------------------------
 void BaseProcess::SetupProperties(const Importer* /*pImp*/)
 {
@@ -103,3 +114,47 @@ bool BaseProcess::RequireVerboseFormat() const
 	return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+const char* BaseProcess::GetName() const
+{
+	return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::GetDataAccess( unsigned int& read, unsigned int& write) const
+{
+	// unknown, so assume the worst
+	read = write = PPData_All;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool BaseProcess::IsPerMesh() const
+{
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::BeginMeshes( aiScene* /*pScene*/)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ExecuteForMesh( aiScene* /*pScene*/, unsigned int /*meshIndex*/)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::EndMeshes( aiScene* /*pScene*/)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+void BaseProcess::ExecuteMeshByMesh( aiScene* pScene)
+{
+	BeginMeshes(pScene);
+	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+		ExecuteForMesh(pScene,i);
+	}
+	EndMeshes(pScene);
+}
+
@@ -52,6 +52,9 @@ struct aiScene;
 namespace Assimp	{
 
 class Importer;
+class PostProcessScheduler;
+class ProgressReporter;
+class AtomicFlag;
 
 // ---------------------------------------------------------------------------
 /** Helper class to allow post-processing steps to interact with each other.
@@ -181,22 +184,41 @@ private:
 	PropertyMap pmap;
 };
 
-#if 0
-
 // ---------------------------------------------------------------------------
-/** @brief Represents a dependency table for a postprocessing steps.
+/** @brief Parts of the scene a post-processing step reads or writes.
  *
- *  For future use.
+ *  Steps declare them via BaseProcess::GetDataAccess(). The scheduler 
+ *  uses them to decide which per-mesh steps can be pipelined, see 
+ *  PostProcessScheduler.
  */
- struct PPDependencyTable 
- {
-	 unsigned int execute_me_before_these;
-	 unsigned int execute_me_after_these;
-	 unsigned int only_if_these_are_not_specified;
-	 unsigned int mutually_exclusive_with;
- };
-
-#endif
+enum PPDataAccess
+{
+	PPData_Positions = 0x1,
+	PPData_Normals = 0x2,
+	//! Tangents and bitangents
+	PPData_Tangents = 0x4,
+	PPData_TexCoords = 0x8,
+	PPData_Colors = 0x10,
+	//! Faces and aiMesh::mPrimitiveTypes
+	PPData_Faces = 0x20,
+	PPData_Bones = 0x40,
+	PPData_Materials = 0x80,
+	PPData_NodeGraph = 0x100,
+	PPData_Animations = 0x200,
+	//! Number and order of the meshes in the scene
+	PPData_MeshList = 0x400,
+	//! aiScene::mFlags
+	PPData_SceneFlags = 0x800,
+
+	//! All vertex components
+	PPData_Vertices = PPData_Positions | PPData_Normals | PPData_Tangents | 
+		PPData_TexCoords | PPData_Colors,
+
+	//! Everything owned by a single mesh
+	PPData_MeshLocal = PPData_Vertices | PPData_Faces | PPData_Bones,
+
+	PPData_All = 0xffffffff
+};
 
 
 #define AI_SPP_SPATIAL_SORT "$Spat"
@@ -214,6 +236,7 @@ private:
 class ASSIMP_API_WINONLY BaseProcess 
 {
 	friend class Importer;
+	friend class PostProcessScheduler;
 
 public:
 
@@ -239,6 +262,13 @@ public:
 	 *  in verbose format. */
 	virtual bool RequireVerboseFormat() const;
 
+	// -------------------------------------------------------------------
+	/** Returns the name of the step. The importer's profiler names its
+	 *  regions after it, so it must differ between step classes. 
+	 * @return The class name for built-in steps. The default returns
+	 *   NULL, such steps are named after their position in the list. */
+	virtual const char* GetName() const;
+
 	// -------------------------------------------------------------------
 	/** Executes the post processing step on the given imported data.
 	* The function deletes the scene if the postprocess step fails (
@@ -262,6 +292,44 @@ public:
 	*/
 	virtual void Execute( aiScene* pScene) = 0;
 
+	// -------------------------------------------------------------------
+	/** Declares which parts of the scene the step reads and writes,
+	 *  as combinations of #PPDataAccess flags. The default implementation 
+	 *  declares everything, so the step is a barrier for the scheduler.
+	 * @param read Receives the data read by the step
+	 * @param write Receives the data modified by the step
+	 */
+	virtual void GetDataAccess( unsigned int& read, unsigned int& write) const;
+
+	// -------------------------------------------------------------------
+	/** Check whether the step processes every mesh independently.
+	 *
+	 *  If so, Execute() must be equivalent to calling BeginMeshes(),
+	 *  ExecuteForMesh() for all meshes and EndMeshes(). The scheduler 
+	 *  may then run the step on different meshes concurrently and
+	 *  interleave it with other per-mesh steps on the same mesh.
+	 *  ExecuteForMesh() may only touch the #PPData_MeshLocal data of its
+	 *  own mesh, scene-global data declared by GetDataAccess() is 
+	 *  read in BeginMeshes() and written in EndMeshes(). 
+	 */
+	virtual bool IsPerMesh() const;
+
+	// -------------------------------------------------------------------
+	/** Called once before the meshes are processed by a per-mesh step */
+	virtual void BeginMeshes( aiScene* pScene);
+
+	// -------------------------------------------------------------------
+	/** Processes a single mesh for a per-mesh step. May be called 
+	 *  concurrently for different meshes.
+	 * @param pScene The scene the mesh belongs to
+	 * @param meshIndex Index of the mesh in pScene->mMeshes
+	 */
+	virtual void ExecuteForMesh( aiScene* pScene, unsigned int meshIndex);
+
+	// -------------------------------------------------------------------
+	/** Called once after all meshes have been processed by a per-mesh step */
+	virtual void EndMeshes( aiScene* pScene);
+
 
 	// -------------------------------------------------------------------
 	/** Assign a new SharedPostProcessInfo to the step. This object
@@ -279,6 +347,32 @@ public:
 		return shared;
 	}
 
+	// -------------------------------------------------------------------
+	/** Assign the share of the total progress covered by the step, 
+	 *  see GetProgressReporter().
+	 * @param base Progress at the start of the step, in [0,1]
+	 * @param range Share of the total progress covered by the step
+	*/
+	inline void SetProgressRange(float base, float range)	{
+		progressBase = base;
+		progressRange = range;
+	}
+
+protected:
+
+	// -------------------------------------------------------------------
+	/** Creates a reporter for a long loop of Execute(), i.e. over the 
+	 *  meshes or materials of the scene. The reports cover the step's 
+	 *  share of the progress and throw if the import has been cancelled,
+	 *  so the scene must remain deletable whenever Update() is called.
+	 * @param total Number of iterations of the loop
+	*/
+	ProgressReporter GetProgressReporter(size_t total) const;
+
+	// -------------------------------------------------------------------
+	/** Execute() implementation for per-mesh steps */
+	void ExecuteMeshByMesh( aiScene* pScene);
+
 protected:
 
 	/** See the doc of #SharedPostProcessInfo for more details */
@@ -286,6 +380,12 @@ protected:
 
 	/** Currently active progress handler */
 	ProgressHandler* progress;
+
+	/** Set while the import is to be cancelled */
+	const AtomicFlag* cancel;
+
+	/** Share of the total progress covered by the step */
+	float progressBase, progressRange;
 };
 
 
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Bk3dImporter.h"
 #include "TextureTransform.h"
 #include "ConvertToLHProcess.h"
+#include "CompressedIOStream.h"
 #include <boost/scoped_ptr.hpp>
 #include "../include/assimp/IOSystem.hpp"
 #include "../include/assimp/anim.h"
@@ -90,11 +91,36 @@ Bk3dImporter::~Bk3dImporter()
 }
 
 // ------------------------------------------------------------------------------------------------
-bool Bk3dImporter::CanRead(const std::string& pFile, IOSystem* /*pIOHandler*/, bool /*checkSig*/) const{
+// Opens a bk3d file through the IOSystem. Unlike bk3d::load(), which calls gzopen() on the
+// file name, gzip compressed files are decompressed while they are read.
+static IOStream* OpenBk3dStream(IOSystem* pIOHandler, const std::string& pFile)
+{
+	IOStream* stream = pIOHandler->Open(pFile, "rb");
+	if (stream && CompressedIOStream::IsCompressed(stream)) {
+		return new CompressedIOStream(stream, pIOHandler);
+	}
+	return stream;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reads the leading node of a bk3d file and checks the file version
+static bool ReadBk3dHeader(IOStream* stream, std::vector<char>& structs)
+{
+	structs.resize(sizeof(bk3d::Node));
+	if (stream->Read(&structs[0], structs.size(), 1) != 1) {
+		return false;
+	}
+	return reinterpret_cast<bk3d::FileHeader*>(&structs[0])->version == RAWMESHVERSION;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool Bk3dImporter::CanRead(const std::string& pFile, IOSystem* pIOHandler, bool /*checkSig*/) const{
 
 	if (pFile.find("bk3d.gz") != std::string::npos) 
 	{
-		return bk3d::tryLoad(pFile.c_str());
+		boost::scoped_ptr<IOStream> stream(OpenBk3dStream(pIOHandler, pFile));
+		std::vector<char> header;
+		return stream && ReadBk3dHeader(stream.get(), header);
 	}
 	return false;
 }
@@ -120,7 +146,36 @@ extern "C"{ void _stdcall AllocConsole(); }
 #endif
 // ------------------------------------------------------------------------------------------------
 void Bk3dImporter::InternReadFile(const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler){
-	auto fileHeader = bk3d::load(pFile.c_str());
+	boost::scoped_ptr<IOStream> stream(OpenBk3dStream(pIOHandler, pFile));
+	if (!stream) {
+		throw DeadlyImportError("Failed to open bk3d file " + pFile + ".");
+	}
+
+	// Same layout as read by bk3d::load(): the structures describing the meshes, followed
+	// by the buffer area with vertex and index data. Both only need to live during import.
+	std::vector<char> structs, buffers;
+	if (!ReadBk3dHeader(stream.get(), structs)) {
+		throw DeadlyImportError("Wrong version in bk3d mesh description.");
+	}
+
+	const size_t fileSize = stream->FileSize();
+	const size_t structSize = reinterpret_cast<bk3d::FileHeader*>(&structs[0])->nodeByteSize;
+	if (structSize < structs.size() || structSize > fileSize) {
+		throw DeadlyImportError("Invalid bk3d header size.");
+	}
+
+	structs.resize(structSize);
+	buffers.resize(fileSize - structSize + 1);
+	if (structSize > sizeof(bk3d::Node) && stream->Read(&structs[sizeof(bk3d::Node)], structSize - sizeof(bk3d::Node), 1) != 1) {
+		throw DeadlyImportError("Unexpected end of bk3d file.");
+	}
+	if (stream->Read(&buffers[0], 1, fileSize - structSize) != fileSize - structSize) {
+		throw DeadlyImportError("Unexpected end of bk3d file.");
+	}
+
+	bk3d::FileHeader* fileHeader = reinterpret_cast<bk3d::FileHeader*>(&structs[0]);
+	fileHeader->resolvePointers(&buffers[0]);
+
 	auto meshes = vector<aiMesh*>();
 	auto nodes = vector<aiNode*>();
 	auto rootNode = new aiNode();
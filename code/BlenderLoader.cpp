@@ -60,13 +60,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cctype>
 
 
-// zlib is needed for compressed blend files 
+// compressed blend files are decompressed while they are read
 #ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
-#	ifdef ASSIMP_BUILD_NO_OWN_ZLIB
-#		include <zlib.h>
-#	else
-#		include "../contrib/zlib/zlib.h"
-#	endif
+#	include "CompressedIOStream.h"
 #endif
 
 namespace Assimp {
@@ -142,26 +138,11 @@ void BlenderImporter::SetupProperties(const Importer* /*pImp*/)
 	// nothing to be done for the moment
 }
 
-struct free_it
-{
-	free_it(void* free) : free(free) {}
-	~free_it() {
-		::free(this->free);
-	}
-
-	void* free;
-};
-
 // ------------------------------------------------------------------------------------------------
 // Imports the given file into the given scene structure. 
 void BlenderImporter::InternReadFile( const std::string& pFile, 
 	aiScene* pScene, IOSystem* pIOHandler)
 {
-#ifndef ASSIMP_BUILD_NO_COMPRESSED_BLEND
-	Bytef* dest = NULL;
-	free_it free_it_really(dest);
-#endif
-
 	FileDatabase file; 
 	boost::shared_ptr<IOStream> stream(pIOHandler->Open(pFile,"rb"));
 	if (!stream) {
@@ -187,49 +168,12 @@ void BlenderImporter::InternReadFile( const std::string& pFile,
 			ThrowException("Unsupported GZIP compression method");
 		}
 
-		// http://www.gzip.org/zlib/rfc-gzip.html#header-trailer
-		stream->Seek(0L,aiOrigin_SET);
-		boost::shared_ptr<StreamReaderLE> reader = boost::shared_ptr<StreamReaderLE>(new StreamReaderLE(stream));
-
-		// build a zlib stream
-		z_stream zstream;
-		zstream.opaque = Z_NULL;
-		zstream.zalloc = Z_NULL;
-		zstream.zfree  = Z_NULL;
-		zstream.data_type = Z_BINARY;
-
-		// http://hewgill.com/journal/entries/349-how-to-decompress-gzip-stream-with-zlib
-		inflateInit2(&zstream, 16+MAX_WBITS);
-
-		zstream.next_in   = reinterpret_cast<Bytef*>( reader->GetPtr() );
-		zstream.avail_in  = reader->GetRemainingSize();
-
-		size_t total = 0l;
-
-		// and decompress the data .... do 1k chunks in the hope that we won't kill the stack
-#define MYBLOCK 1024
-		Bytef block[MYBLOCK];
-		int ret;
-		do {
-			zstream.avail_out = MYBLOCK;
-			zstream.next_out = block;
-			ret = inflate(&zstream, Z_NO_FLUSH);
-
-			if (ret != Z_STREAM_END && ret != Z_OK) {
-				ThrowException("Failure decompressing this file using gzip, seemingly it is NOT a compressed .BLEND file");
-			}
-			const size_t have = MYBLOCK - zstream.avail_out;
-			total += have;
-			dest = reinterpret_cast<Bytef*>( realloc(dest,total) );
-			memcpy(dest + total - have,block,have);
-		} 
-		while (ret != Z_STREAM_END);
-
-		// terminate zlib
-		inflateEnd(&zstream);
-
-		// replace the input stream with a memory stream
-		stream.reset(new MemoryIOStream(reinterpret_cast<uint8_t*>(dest),total)); 
+		// replace the input stream with a decompressing stream
+		IOStream* const compressed = pIOHandler->Open(pFile,"rb");
+		if (!compressed) {
+			ThrowException("Could not open file for reading");
+		}
+		stream.reset(new CompressedIOStream(compressed,pIOHandler));
 
 		// .. and retry
 		stream->Read(magic,7,1);
@@ -496,9 +440,10 @@ void BlenderImporter::AddSentinelTexture(aiMaterial* out, const Material* mat, c
 	(void)mat; (void)tex; (void)conv_data;
 
 	aiString name;
-	name.length = sprintf(name.data, "Procedural,num=%i,type=%s",conv_data.sentinel_cnt++,
+	snprintf(name.data, MAXLEN, "Procedural,num=%i,type=%s",conv_data.sentinel_cnt++,
 		GetTextureTypeDisplayString(tex->tex->type)
 	);
+	name.length = ::strlen(name.data);
 	out->AddProperty(&name,AI_MATKEY_TEXTURE_DIFFUSE(
 		conv_data.next_texture[aiTextureType_DIFFUSE]++)
 	);
@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "TinyFormatter.h"
 #include "qnan.h"
+#include <algorithm>
 
 using namespace Assimp;
 
@@ -92,13 +93,40 @@ void CalcTangentsProcess::SetupProperties(const Importer* pImp)
 void CalcTangentsProcess::Execute( aiScene* pScene)
 {
     ai_assert( NULL != pScene );
+	ExecuteMeshByMesh(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+void CalcTangentsProcess::GetDataAccess( unsigned int& read, unsigned int& write) const
+{
+	read = PPData_Positions | PPData_Normals | PPData_TexCoords | PPData_Faces;
+	write = PPData_Tangents;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool CalcTangentsProcess::IsPerMesh() const
+{
+	return true;
+}
 
+// ------------------------------------------------------------------------------------------------
+void CalcTangentsProcess::BeginMeshes( aiScene* pScene)
+{
     DefaultLogger::get()->debug("CalcTangentsProcess begin");
+	meshResults.assign(pScene->mNumMeshes,0);
+}
 
-	bool bHas = false;
-	for ( unsigned int a = 0; a < pScene->mNumMeshes; a++ ) {
-		if(ProcessMesh( pScene->mMeshes[a],a))bHas = true;
-    }
+// ------------------------------------------------------------------------------------------------
+void CalcTangentsProcess::ExecuteForMesh( aiScene* pScene, unsigned int meshIndex)
+{
+	meshResults[meshIndex] = ProcessMesh( pScene->mMeshes[meshIndex],meshIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+void CalcTangentsProcess::EndMeshes( aiScene* /*pScene*/)
+{
+	const bool bHas = std::find(meshResults.begin(),meshResults.end(),1) != meshResults.end();
+	meshResults.clear();
 
 	if ( bHas ) {
         DefaultLogger::get()->info("CalcTangentsProcess finished. Tangents have been calculated");
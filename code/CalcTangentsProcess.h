@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_CALCTANGENTSPROCESS_H_INC
 
 #include "BaseProcess.h"
+#include <vector>
 
 struct aiMesh;
 
@@ -74,6 +75,18 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "CalcTangentsProcess"; }
+
+	// -------------------------------------------------------------------
+	/** Per-mesh execution, see BaseProcess::IsPerMesh() */
+	void GetDataAccess( unsigned int& read, unsigned int& write) const;
+	bool IsPerMesh() const;
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteForMesh( aiScene* pScene, unsigned int meshIndex);
+	void EndMeshes( aiScene* pScene);
+
 	// -------------------------------------------------------------------
 	/** Called prior to ExecuteOnScene().
 	* The function is a request to the process to update its configuration
@@ -108,6 +121,9 @@ private:
 	/** Configuration option: maximum smoothing angle, in radians*/
 	float configMaxAngle;
 	unsigned int configSourceUV;
+
+	/** Results of the meshes processed by ExecuteForMesh() */
+	std::vector<unsigned char> meshResults;
 };
 
 } // end of namespace Assimp
@@ -84,17 +84,13 @@ void ExportSceneCollada(const char* pFile, IOSystem* pIOSystem, const aiScene* p
 		}
 	}
 
-	// invoke the exporter 
-	ColladaExporter iDoTheExportThing( pScene, pIOSystem, path, file);
-
-	// we're still here - export successfully completed. Write result to the given IOSYstem
 	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
 	if(outfile == NULL) {
 		throw DeadlyExportError("could not open output .dae file: " + std::string(pFile));
 	}
 
-	// XXX maybe use a small wrapper around IOStream that behaves like std::stringstream in order to avoid the extra copy.
-	outfile->Write( iDoTheExportThing.mOutput.str().c_str(), static_cast<size_t>(iDoTheExportThing.mOutput.tellp()),1);
+	// invoke the exporter, it streams directly into the file
+	ColladaExporter iDoTheExportThing( pScene, pIOSystem, outfile.get(), path, file);
 }
 
 } // end of namespace Assimp
@@ -103,11 +99,8 @@ void ExportSceneCollada(const char* pFile, IOSystem* pIOSystem, const aiScene* p
 
 // ------------------------------------------------------------------------------------------------
 // Constructor for a specific scene to export
-ColladaExporter::ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file) : mIOSystem(pIOSystem), mPath(path), mFile(file)
+ColladaExporter::ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, IOStream* pOutput, const std::string& path, const std::string& file) : mOutput(pOutput), mIOSystem(pIOSystem), mPath(path), mFile(file)
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	mOutput.imbue( std::locale("C") );
-
 	mScene = pScene;
 	mSceneOwned = false;
 
@@ -116,6 +109,7 @@ ColladaExporter::ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, co
 
 	// start writing
 	WriteFile();
+	mOutput.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -176,7 +170,14 @@ void ColladaExporter::WriteHeader()
 	static const unsigned int date_nb_chars = 20;
 	char date_str[date_nb_chars];
 	std::time_t date = std::time(NULL);
-	std::strftime(date_str, date_nb_chars, "%Y-%m-%dT%H:%M:%S", std::localtime(&date));
+	std::tm local;
+	// we may run on a worker thread, so don't use localtime()'s static buffer
+#if _MSC_VER >= 1400
+	localtime_s(&local, &date);
+#else
+	localtime_r(&date, &local);
+#endif
+	std::strftime(date_str, date_nb_chars, "%Y-%m-%dT%H:%M:%S", &local);
 
 	std::string scene_name = mScene->mRootNode->mName.C_Str();
 
@@ -724,6 +725,25 @@ void ColladaExporter::WriteGeometry( size_t pIndex)
 	mOutput << startstr << "</geometry>" << endstr;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Formats the components of a single element of a float array, see WriteFloatArray()
+struct ColladaFloatFormatter
+{
+	ColladaFloatFormatter(const float* data, size_t stride, size_t count)
+		: data(data), stride(stride), count(count)
+	{}
+
+	void operator() (TextWriter& out, size_t i) const
+	{
+		const float* const p = data + i * stride;
+		for( size_t a = 0; a < count; ++a )
+			out << p[a] << ' ';
+	}
+
+	const float* data;
+	size_t stride, count;
+};
+
 // ------------------------------------------------------------------------------------------------
 // Writes a float array of the given type
 void ColladaExporter::WriteFloatArray( const std::string& pIdString, FloatDataType pType, const float* pData, size_t pElementCount)
@@ -748,28 +768,15 @@ void ColladaExporter::WriteFloatArray( const std::string& pIdString, FloatDataTy
 	mOutput << startstr << "<float_array id=\"" << XMLEscape(arrayId) << "\" count=\"" << pElementCount * floatsPerElement << "\"> ";
 	PushTag();
 
+	// texture coordinates are always stored as 3D vectors, colors with alpha
+	size_t stride = floatsPerElement;
 	if( pType == FloatType_TexCoord2 )
-	{
-		for( size_t a = 0; a < pElementCount; ++a )
-		{
-			mOutput << pData[a*3+0] << " ";
-			mOutput << pData[a*3+1] << " ";
-		}
-	} 
+		stride = 3;
 	else if( pType == FloatType_Color )
-	{
-		for( size_t a = 0; a < pElementCount; ++a )
-		{
-			mOutput << pData[a*4+0] << " ";
-			mOutput << pData[a*4+1] << " ";
-			mOutput << pData[a*4+2] << " ";
-		}
-	}
-	else
-	{
-		for( size_t a = 0; a < pElementCount * floatsPerElement; ++a )
-			mOutput << pData[a] << " ";
-	}
+		stride = 4;
+
+	ColladaFloatFormatter fmt( pData, stride, floatsPerElement);
+	WriteParallel( mOutput, pElementCount, fmt);
 	mOutput << "</float_array>" << endstr; 
 	PopTag();
 
@@ -838,15 +845,16 @@ void ColladaExporter::WriteSceneLibrary()
 // Recursively writes the given node
 void ColladaExporter::WriteNode(aiNode* pNode)
 {
-	// the must have a name
+	// the must have a name. Don't store it in the node, the scene may belong to the caller.
+	std::string node_name = pNode->mName.data;
 	if (pNode->mName.length == 0)
 	{		
 		std::stringstream ss;
 		ss << "Node_" << pNode;
-		pNode->mName.Set(ss.str());
+		node_name = ss.str();
 	}
 
-	const std::string node_name_escaped = XMLEscape(pNode->mName.data);
+	const std::string node_name_escaped = XMLEscape(node_name);
 	mOutput << startstr << "<node id=\"" << node_name_escaped << "\" name=\"" << node_name_escaped << "\">" << endstr;
 	PushTag();
 
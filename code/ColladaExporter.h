@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../include/assimp/material.h"
 #include "../include/assimp/mesh.h"
 #include "../include/assimp/Exporter.hpp"
+#include "TextWriter.h"
 #include <sstream>
 #include <vector>
 #include <map>
@@ -64,8 +65,8 @@ namespace Assimp
 class ColladaExporter
 {
 public:
-	/// Constructor for a specific scene to export
-	ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, const std::string& path, const std::string& file);
+	/// Constructor for a specific scene to export, the document is written to the given stream
+	ColladaExporter( const aiScene* pScene, IOSystem* pIOSystem, IOStream* pOutput, const std::string& path, const std::string& file);
 
 	/// Destructor
 	virtual ~ColladaExporter();
@@ -109,8 +110,8 @@ protected:
 	std::string GetMeshId( size_t pIndex) const { return std::string( "meshId" ) + boost::lexical_cast<std::string> (pIndex); }
 
 public:
-	/// Stringstream to write all output into
-	std::stringstream mOutput;
+	/// Writer for all output
+	TextWriter mOutput;
 
 protected:
 	/// The IOSystem for output
@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fast_atof.h"
 #include "ParsingUtils.h"
 #include "SkeletonMeshBuilder.h"
+#include "ProgressReporter.h"
 #include "Defines.h"
 
 #include "time.h"
@@ -144,7 +145,7 @@ void ColladaLoader::InternReadFile( const std::string& pFile, aiScene* pScene, I
 	mAnims.clear();
 
 	// parse the input file
-	ColladaParser parser( pIOHandler, pFile);
+	ColladaParser parser( pIOHandler, pFile, progress, cancel);
 
 	if( !parser.mRootNode)
 		throw DeadlyImportError( "Collada: File came out empty. Something is wrong here.");
@@ -186,6 +187,7 @@ void ColladaLoader::InternReadFile( const std::string& pFile, aiScene* pScene, I
 				 0,  0,  0,  1);
 		}
 	// store all meshes
+	ThrowIfCancelled( cancel);
 	StoreSceneMeshes( pScene);
 
 	// store all materials
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ColladaParser.h"
 #include "fast_atof.h"
 #include "ParsingUtils.h"
+#include "ProgressReporter.h"
 #include <boost/scoped_ptr.hpp>
 #include <boost/foreach.hpp>
 #include "../include/assimp/DefaultLogger.hpp"
@@ -61,10 +62,13 @@ using namespace Assimp::Collada;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
+ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile,
+	ProgressHandler* pProgress, const AtomicFlag* pCancel)
 	: mFileName( pFile)
 {
 	mRootNode = NULL;
+	mProgress = NULL;
+	mTextRead = 0;
 	mUnitSize = 1.0f;
 	mUpDirection = UP_Y;
 
@@ -82,8 +86,12 @@ ColladaParser::ColladaParser( IOSystem* pIOHandler, const std::string& pFile)
 	if( !mReader)
 		ThrowException( "Collada: Unable to open file.");
 
-	// start reading
+	// start reading. The data arrays and index lists make up most of a file,
+	// so the progress is estimated from the length of the text contents.
+	ProgressReporter reporter( pProgress, pCancel, mIOWrapper->getSize());
+	mProgress = &reporter;
 	ReadContents();
+	mProgress = NULL;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -156,6 +164,14 @@ void ColladaParser::ReadContents()
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+// Reports the progress of reading a text content, throws if the import has been cancelled
+void ColladaParser::UpdateProgress( const char* pStart, const char* pCur)
+{
+	if( mProgress)
+		mProgress->Update( mTextRead + (pCur - pStart));
+}
+
 // ------------------------------------------------------------------------------------------------
 // Reads the structure of the file
 void ColladaParser::ReadStructure()
@@ -1717,6 +1733,7 @@ void ColladaParser::ReadDataArray()
   // some exporters write empty data arrays, but we need to conserve them anyways because others might reference them
   if (content) 
   { 
+		const char* const start = content;
 		if( isStringArray)
 		{
 			data.mStrings.reserve( count);
@@ -1733,6 +1750,7 @@ void ColladaParser::ReadDataArray()
 				data.mStrings.push_back( s);
 
 				SkipSpacesAndLineEnd( &content);
+				UpdateProgress( start, content);
 			}
 		} else
 		{
@@ -1749,8 +1767,10 @@ void ColladaParser::ReadDataArray()
 				data.mValues.push_back( value);
 				// skip whitespace after it
 				SkipSpacesAndLineEnd( &content);
+				UpdateProgress( start, content);
 			}
 		}
+		mTextRead += content - start;
 	}
 
   // test for closing tag
@@ -2087,6 +2107,7 @@ size_t ColladaParser::ReadPrimitives( Mesh* pMesh, std::vector<InputChannel>& pP
 	if (pNumPrimitives > 0)	// It is possible to not contain any indicies
 	{
 		const char* content = GetTextContent();
+		const char* const start = content;
 		while( *content != 0)
 		{
 			// read a value. 
@@ -2095,7 +2116,9 @@ size_t ColladaParser::ReadPrimitives( Mesh* pMesh, std::vector<InputChannel>& pP
 			indices.push_back( size_t( value));
 			// skip whitespace after it
 			SkipSpacesAndLineEnd( &content);
+			UpdateProgress( start, content);
 		}
+		mTextRead += content - start;
 	}
 
 	// complain if the index count doesn't fit
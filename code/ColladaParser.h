@@ -55,6 +55,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace Assimp
 {
 
+class ProgressHandler;
+class ProgressReporter;
+class AtomicFlag;
+
 // ------------------------------------------------------------------------------------------
 /** Parser helper class for the Collada loader. 
  *
@@ -66,8 +70,10 @@ class ColladaParser
 	friend class ColladaLoader;
 
 protected:
-	/** Constructor from XML file */
-	ColladaParser( IOSystem* pIOHandler, const std::string& pFile);
+	/** Constructor from XML file. Progress is reported to the handler and the
+	 *  cancellation flag is checked while the file is read, both may be NULL. */
+	ColladaParser( IOSystem* pIOHandler, const std::string& pFile,
+		ProgressHandler* pProgress = NULL, const AtomicFlag* pCancel = NULL);
 
 	/** Destructor */
 	~ColladaParser();
@@ -75,6 +81,9 @@ protected:
 	/** Reads the contents of the file */
 	void ReadContents();
 
+	/** Reports the progress of reading a text content from pStart up to pCur */
+	void UpdateProgress( const char* pStart, const char* pCur);
+
 	/** Reads the structure of the file */
 	void ReadStructure();
 
@@ -272,6 +281,12 @@ protected:
 	/** XML reader, member for everyday use */
 	irr::io::IrrXMLReader* mReader;
 
+	/** Progress of reading the file, only set while it is read */
+	ProgressReporter* mProgress;
+
+	/** Length of the text contents read so far, the progress is estimated from it */
+	size_t mTextRead;
+
 	/** All data arrays found in the file by ID. Might be referred to by actually 
 	    everyone. Collada, you are a steaming pile of indirection. */
 	typedef std::map<std::string, Collada::Data> DataLibrary;
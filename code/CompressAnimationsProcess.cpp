@@ -0,0 +1,331 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file Implementation of the post processing step to remove redundant animation keys.
+ * <br>
+ * Keys are removed greedily: starting at the last key kept, a segment is
+ * extended key by key as long as all keys it spans can be interpolated
+ * from its end points within the error bounds. The key before the first
+ * one which fails is kept and starts the next segment.
+ */
+
+// internal headers
+#include "CompressAnimationsProcess.h"
+#include "ProcessHelper.h"
+#include "ParallelFor.h"
+#include "../include/assimp/postprocess.h"
+#include "../include/assimp/scene.h"
+#include "../include/assimp/DefaultLogger.hpp"
+#include <stdio.h>
+
+using namespace Assimp;
+
+namespace {
+
+// Maximum number of keys spanned by a single segment. Extending a segment checks
+// all keys it spans again, so this bounds the work per key for tracks which are
+// (almost) perfectly linear.
+const unsigned int MAX_SEGMENT_KEYS = 256;
+
+// ------------------------------------------------------------------------------------------------
+// Interpolation factor for time t between the keys at times ta and tb
+inline float GetFactor(double ta, double tb, double t)
+{
+	return tb > ta ? static_cast<float>((t - ta) / (tb - ta)) : 0.f;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether a position or scaling key can be restored from two other keys
+struct VectorKeyTest
+{
+	explicit VectorKeyTest(float fMaxError)
+		: fMaxSqrError(fMaxError * fMaxError)
+	{}
+
+	bool operator() (const aiVectorKey& a, const aiVectorKey& b, const aiVectorKey& key) const
+	{
+		const float f = GetFactor(a.mTime,b.mTime,key.mTime);
+		const aiVector3D v = a.mValue + (b.mValue - a.mValue) * f;
+		return (v - key.mValue).SquareLength() <= fMaxSqrError;
+	}
+
+	float fMaxSqrError;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Checks whether a rotation key can be restored from two other keys
+struct QuatKeyTest
+{
+	// for unit quaternions, |q0-q1| = 2*sin(angle/4) where angle is the angle between
+	// the two rotations. Unlike the dot product, this is still precise for small angles.
+	explicit QuatKeyTest(float fMaxError)
+		: fMaxSqrDist(std::pow(2.f * std::sin(std::min(fMaxError,(float)AI_MATH_PI) * 0.25f),2.f))
+	{}
+
+	bool operator() (const aiQuatKey& a, const aiQuatKey& b, const aiQuatKey& key) const
+	{
+		aiQuaternion q, k = key.mValue;
+		aiQuaternion::Interpolate(q,a.mValue,b.mValue,GetFactor(a.mTime,b.mTime,key.mTime));
+		q.Normalize();
+		k.Normalize();
+
+		// q and -q are the same rotation
+		const float s = q.x*k.x + q.y*k.y + q.z*k.z + q.w*k.w < 0.f ? -1.f : 1.f;
+		const float dx = q.x - s*k.x, dy = q.y - s*k.y, dz = q.z - s*k.z, dw = q.w - s*k.w;
+		return dx*dx + dy*dy + dz*dz + dw*dw <= fMaxSqrDist;
+	}
+
+	float fMaxSqrDist;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Removes all keys which the given test says can be restored from the keys kept
+template <typename KeyType, typename Test>
+void ReduceKeys(KeyType*& pKeys, unsigned int& iNumKeys, const Test& test)
+{
+	if (iNumKeys < 2) {
+		return;
+	}
+
+	std::vector<unsigned int> vKept;
+
+	// a track which doesn't change at all is collapsed to a single key
+	unsigned int i = 1;
+	while (i < iNumKeys && test(pKeys[0],pKeys[0],pKeys[i])) {
+		++i;
+	}
+
+	if (i == iNumKeys) {
+		vKept.push_back(0);
+	}
+	else {
+		vKept.push_back(0);
+		unsigned int iAnchor = 0;
+		for (i = 2; i < iNumKeys; ++i) {
+			bool bOk = i - iAnchor <= MAX_SEGMENT_KEYS;
+			for (unsigned int j = iAnchor + 1; bOk && j < i; ++j) {
+				bOk = test(pKeys[iAnchor],pKeys[i],pKeys[j]);
+			}
+			if (!bOk) {
+				iAnchor = i - 1;
+				vKept.push_back(iAnchor);
+			}
+		}
+		vKept.push_back(iNumKeys - 1);
+	}
+
+	if (vKept.size() == iNumKeys) {
+		return;
+	}
+
+	KeyType* pNew = new KeyType[vKept.size()];
+	for (unsigned int n = 0; n < vKept.size(); ++n) {
+		pNew[n] = pKeys[vKept[n]];
+	}
+	delete[] pKeys;
+	pKeys = pNew;
+	iNumKeys = (unsigned int)vKept.size();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Maximum distance of the nodes and mesh vertices below a node from its origin,
+// measured in the coordinate system of the node.
+float GetSubtreeExtent(const aiScene* pScene, const aiNode* pNode, const aiMatrix4x4& mTransform)
+{
+	float fMax = 0.f;
+	for (unsigned int a = 0; a < pNode->mNumMeshes; ++a) {
+		const aiMesh* pMesh = pScene->mMeshes[pNode->mMeshes[a]];
+		for (unsigned int v = 0; v < pMesh->mNumVertices; ++v) {
+			fMax = std::max(fMax, (mTransform * pMesh->mVertices[v]).SquareLength());
+		}
+	}
+	fMax = std::sqrt(fMax);
+
+	for (unsigned int a = 0; a < pNode->mNumChildren; ++a) {
+		const aiMatrix4x4 m = mTransform * pNode->mChildren[a]->mTransformation;
+		fMax = std::max(fMax, aiVector3D(m.a4,m.b4,m.c4).Length());
+		fMax = std::max(fMax, GetSubtreeExtent(pScene,pNode->mChildren[a],m));
+	}
+	return fMax;
+}
+
+// ------------------------------------------------------------------------------------------------
+// A channel to be processed along with its error limits
+struct ChannelJob
+{
+	aiNodeAnim* pChannel;
+	float fPositionError, fRotationError, fScalingError;
+};
+
+// ------------------------------------------------------------------------------------------------
+// ParallelFor() work item, processes a single channel
+struct ChannelWorker
+{
+	explicit ChannelWorker(const std::vector<ChannelJob>& jobs)
+		: jobs(&jobs)
+	{}
+
+	void operator() (unsigned int i)
+	{
+		const ChannelJob& job = (*jobs)[i];
+		CompressAnimationsProcess::ProcessChannel(job.pChannel,job.fPositionError,
+			job.fRotationError,job.fScalingError);
+	}
+
+	const std::vector<ChannelJob>* jobs;
+};
+
+// ------------------------------------------------------------------------------------------------
+unsigned int CountKeys(const aiNodeAnim* pChannel)
+{
+	return pChannel->mNumPositionKeys + pChannel->mNumRotationKeys + pChannel->mNumScalingKeys;
+}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+CompressAnimationsProcess::CompressAnimationsProcess()
+	: configPositionError(AI_CA_DEFAULT_POSITION_ERROR)
+	, configRotationError(AI_CA_DEFAULT_ROTATION_ERROR)
+	, configScalingError(AI_CA_DEFAULT_SCALING_ERROR)
+	, configPropagate(false)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+CompressAnimationsProcess::~CompressAnimationsProcess()
+{
+	// nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool CompressAnimationsProcess::IsActive( unsigned int pFlags) const
+{
+	return (pFlags & aiProcess_CompressAnimations) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void CompressAnimationsProcess::SetupProperties(const Importer* pImp)
+{
+	configPositionError = pImp->GetPropertyFloat(AI_CONFIG_PP_CA_POSITION_ERROR,AI_CA_DEFAULT_POSITION_ERROR);
+	configRotationError = pImp->GetPropertyFloat(AI_CONFIG_PP_CA_ROTATION_ERROR,AI_CA_DEFAULT_ROTATION_ERROR);
+	configScalingError = pImp->GetPropertyFloat(AI_CONFIG_PP_CA_SCALING_ERROR,AI_CA_DEFAULT_SCALING_ERROR);
+	configPropagate = pImp->GetPropertyInteger(AI_CONFIG_PP_CA_PROPAGATE_ERROR,0) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void CompressAnimationsProcess::Execute( aiScene* pScene)
+{
+	if (!pScene->mNumAnimations) {
+		DefaultLogger::get()->debug("CompressAnimationsProcess skipped; there are no animations");
+		return;
+	}
+
+	DefaultLogger::get()->debug("CompressAnimationsProcess begin");
+
+	const float fRotationError = AI_DEG_TO_RAD(configRotationError);
+
+	// gather all channels and their error limits. If the error is propagated,
+	// rotating or scaling a node must not move anything below it by more
+	// than the position error.
+	std::vector<ChannelJob> jobs;
+	std::map<const aiNode*,float> extents;
+
+	unsigned int iKeysIn = 0;
+	for (unsigned int a = 0; a < pScene->mNumAnimations; ++a) {
+		const aiAnimation* pAnim = pScene->mAnimations[a];
+		for (unsigned int c = 0; c < pAnim->mNumChannels; ++c) {
+			ChannelJob job;
+			job.pChannel = pAnim->mChannels[c];
+			job.fPositionError = configPositionError;
+			job.fRotationError = fRotationError;
+			job.fScalingError = configScalingError;
+
+			const aiNode* pNode = configPropagate && pScene->mRootNode ? 
+				pScene->mRootNode->FindNode(job.pChannel->mNodeName) : NULL;
+
+			if (pNode) {
+				std::map<const aiNode*,float>::const_iterator it = extents.find(pNode);
+				if (it == extents.end()) {
+					it = extents.insert(std::make_pair(pNode,GetSubtreeExtent(pScene,pNode,aiMatrix4x4()))).first;
+				}
+				if ((*it).second > 0.f) {
+					job.fRotationError = std::min(job.fRotationError,configPositionError / (*it).second);
+					job.fScalingError = std::min(job.fScalingError,configPositionError / (*it).second);
+				}
+			}
+
+			iKeysIn += CountKeys(job.pChannel);
+			jobs.push_back(job);
+		}
+	}
+
+	ChannelWorker worker(jobs);
+	ParallelFor((unsigned int)jobs.size(),worker);
+
+	unsigned int iKeysOut = 0;
+	for (std::vector<ChannelJob>::const_iterator it = jobs.begin(); it != jobs.end(); ++it) {
+		iKeysOut += CountKeys((*it).pChannel);
+	}
+
+	if (!DefaultLogger::isNullLogger()) {
+		char szBuff[128]; // should be sufficiently large in every case
+		::sprintf(szBuff,"CompressAnimationsProcess finished | Keys in: %u out: %u | ~%.1f%%",
+			iKeysIn,iKeysOut,iKeysIn ? ((iKeysIn - iKeysOut) / (float)iKeysIn) * 100.f : 0.f);
+		DefaultLogger::get()->info(szBuff);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Removes redundant keys from a single channel
+void CompressAnimationsProcess::ProcessChannel( aiNodeAnim* pChannel, float fPositionError, 
+	float fRotationError, float fScalingError)
+{
+	ReduceKeys(pChannel->mPositionKeys,pChannel->mNumPositionKeys,VectorKeyTest(fPositionError));
+	ReduceKeys(pChannel->mRotationKeys,pChannel->mNumRotationKeys,QuatKeyTest(fRotationError));
+	ReduceKeys(pChannel->mScalingKeys,pChannel->mNumScalingKeys,VectorKeyTest(fScalingError));
+}
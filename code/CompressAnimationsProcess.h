@@ -0,0 +1,129 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file Defines a post processing step to remove redundant animation keys */
+#ifndef AI_COMPRESSANIMATIONSPROCESS_H_INC
+#define AI_COMPRESSANIMATIONSPROCESS_H_INC
+
+#include "BaseProcess.h"
+#include "../include/assimp/types.h"
+
+struct aiNodeAnim;
+
+namespace Assimp
+{
+
+// ---------------------------------------------------------------------------
+/** The CompressAnimationsProcess removes all keys from node animation
+ *  channels which can be reconstructed by interpolating their neighbours
+ *  (linearly for position and scaling, spherically for rotation) within
+ *  a configurable error. Optionally, the rotation and scaling error of a
+ *  channel is also bounded by the displacement it causes at the nodes below
+ *  it in the hierarchy. Channels are processed in parallel.
+ */
+class ASSIMP_API CompressAnimationsProcess : public BaseProcess
+{
+public:
+
+	CompressAnimationsProcess();
+	~CompressAnimationsProcess();
+
+public:
+
+	// -------------------------------------------------------------------
+	// Check whether the pp step is active
+	bool IsActive( unsigned int pFlags) const;
+
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "CompressAnimationsProcess"; }
+
+	// -------------------------------------------------------------------
+	// Executes the pp step on a given scene
+	void Execute( aiScene* pScene);
+
+	// -------------------------------------------------------------------
+	// Configures the pp step
+	void SetupProperties(const Importer* pImp);
+
+	// -------------------------------------------------------------------
+	//! Set the error limits - needed for unit testing
+	void SetErrorLimits(float positionError, float rotationError, float scalingError, bool propagate) {
+		configPositionError = positionError;
+		configRotationError = rotationError;
+		configScalingError = scalingError;
+		configPropagate = propagate;
+	}
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Removes redundant keys from a single channel. Safe to be called
+	 *  concurrently for different channels.
+	 * @param pChannel The channel to process.
+	 * @param fPositionError Maximum distance between a removed position
+	 *   key and the interpolated value at its time.
+	 * @param fRotationError Maximum angle, in radians, between a removed
+	 *   rotation key and the interpolated value at its time.
+	 * @param fScalingError Maximum distance between a removed scaling
+	 *   key and the interpolated value at its time.
+	 */
+	static void ProcessChannel( aiNodeAnim* pChannel, float fPositionError, 
+		float fRotationError, float fScalingError);
+
+private:
+	//! Configuration parameter: position error
+	float configPositionError;
+
+	//! Configuration parameter: rotation error, in degrees
+	float configRotationError;
+
+	//! Configuration parameter: scaling error
+	float configScalingError;
+
+	//! Configuration parameter: bound errors at the child nodes, too
+	bool configPropagate;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_COMPRESSANIMATIONSPROCESS_H_INC
@@ -0,0 +1,571 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file CompressedIOStream.cpp
+ *  @brief Implementation of the gzip decompressing stream and IOSystem wrapper
+ */
+
+#include "CompressedIOStream.h"
+#include "../include/assimp/DefaultLogger.hpp"
+#include "../include/assimp/ai_assert.h"
+
+#ifdef ASSIMP_BUILD_NO_OWN_ZLIB
+#	include <zlib.h>
+#else
+#	include "../contrib/zlib/zlib.h"
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+using namespace Assimp;
+
+namespace {
+
+	// size of the chunks read from the compressed source
+	const size_t InputChunkSize = 64 * 1024;
+
+	inline z_stream* ZStream(void* p) {
+		return static_cast<z_stream*>(p);
+	}
+
+	// deflate can't compress better than this, so small files can't wrap the 32 bit trailer size
+	const size_t MaxDeflateRatio = 1032;
+
+	// Take the uncompressed size from the gzip trailer. It is only valid modulo 2^32 and
+	// covers only the last member of the file, so it is used only if the file is too small
+	// to inflate to 4 GB and no second member header shows up in it.
+	size_t TrailerSize(IOStream* source)
+	{
+		const size_t fileSize = source->FileSize();
+		if (fileSize < 18 || fileSize > 0xffffffffu / MaxDeflateRatio) {
+			return CompressedIOStream::UnknownSize;
+		}
+
+		std::vector<uint8_t> data(fileSize);
+		if (1 != source->Read(&data[0],fileSize,1)) {
+			return CompressedIOStream::UnknownSize;
+		}
+
+		// each member begins with the magic bytes and the deflate method. The sequence may
+		// also occur in compressed data, the size is counted then to be sure.
+		static const uint8_t member[] = {0x1f,0x8b,0x08};
+		if (std::search(data.begin() + 1,data.end(),member,member + 3) != data.end()) {
+			return CompressedIOStream::UnknownSize;
+		}
+
+		const uint8_t* isize = &data[fileSize - 4];
+		return static_cast<size_t>(isize[0]) | static_cast<size_t>(isize[1]) << 8 |
+			static_cast<size_t>(isize[2]) << 16 | static_cast<size_t>(isize[3]) << 24;
+	}
+
+	// Inflate a whole gzip stream and count the output bytes
+	size_t CountInflatedSize(IOStream* source)
+	{
+		z_stream z;
+		::memset(&z,0,sizeof(z));
+		if (Z_OK != inflateInit2(&z, 16 + MAX_WBITS)) {
+			return 0;
+		}
+
+		std::vector<char> in(InputChunkSize), out(CompressedIOStream::BlockSize);
+		size_t size = 0;
+		for (bool done = false; !done; ) {
+			if (!z.avail_in) {
+				const size_t read = source->Read(&in[0],1,in.size());
+				if (!read) {
+					break;
+				}
+				z.next_in = reinterpret_cast<Bytef*>(&in[0]);
+				z.avail_in = static_cast<uInt>(read);
+			}
+
+			z.next_out = reinterpret_cast<Bytef*>(&out[0]);
+			z.avail_out = static_cast<uInt>(out.size());
+
+			const int ret = inflate(&z,Z_NO_FLUSH);
+			size += out.size() - z.avail_out;
+
+			if (ret == Z_STREAM_END) {
+				// continue with the next member, if there is one
+				if (!z.avail_in) {
+					const size_t read = source->Read(&in[0],1,in.size());
+					z.next_in = reinterpret_cast<Bytef*>(&in[0]);
+					z.avail_in = static_cast<uInt>(read);
+				}
+				if (!z.avail_in) {
+					done = true;
+				}
+				else inflateReset(&z);
+			}
+			else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+				done = true;
+			}
+		}
+		inflateEnd(&z);
+		return size;
+	}
+}
+
+const size_t CompressedIOStream::BlockSize;
+const size_t CompressedIOStream::UnknownSize;
+
+// ------------------------------------------------------------------------------------------------
+CompressedIOStream::CompressedIOStream(IOStream* source, IOSystem* io, size_t knownSize)
+: source(source)
+, io(io)
+, zstream(new z_stream())
+, input(InputChunkSize)
+, eof()
+, failed()
+, size(knownSize)
+, pos()
+, blockStart()
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+, aheadReady()
+, stop()
+, worker()
+#endif
+{
+	ai_assert(NULL != source);
+
+	z_stream* z = ZStream(zstream);
+	z->zalloc = Z_NULL;
+	z->zfree  = Z_NULL;
+	z->opaque = Z_NULL;
+	z->next_in = Z_NULL;
+	z->avail_in = 0;
+
+	// 16 + window bits selects gzip decoding
+	if (Z_OK != inflateInit2(z, 16 + MAX_WBITS)) {
+		failed = eof = true;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+CompressedIOStream::~CompressedIOStream()
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	StopWorker();
+#endif
+
+	z_stream* z = ZStream(zstream);
+	inflateEnd(z);
+	delete z;
+
+	if (io) {
+		io->Close(source);
+	}
+	else delete source;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool CompressedIOStream::IsCompressed(IOStream* stream)
+{
+	uint8_t magic[2] = {0};
+	const bool ok = 1 == stream->Read(magic,2,1);
+	stream->Seek(0,aiOrigin_SET);
+
+	return ok && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Fill a block with decompressed data. Called from the worker thread, if there is one.
+void CompressedIOStream::InflateBlock(Block& block)
+{
+	block.data.resize(BlockSize);
+	block.size = 0;
+
+	z_stream* z = ZStream(zstream);
+	while (block.size < BlockSize && !eof) {
+		if (!z->avail_in) {
+			const size_t read = source->Read(&input[0],1,input.size());
+			if (!read) {
+				// input ends before the end of the deflate stream
+				failed = eof = true;
+				break;
+			}
+			z->next_in = reinterpret_cast<Bytef*>(&input[0]);
+			z->avail_in = static_cast<uInt>(read);
+		}
+
+		z->next_out = reinterpret_cast<Bytef*>(&block.data[block.size]);
+		z->avail_out = static_cast<uInt>(BlockSize - block.size);
+
+		const int ret = inflate(z,Z_NO_FLUSH);
+		block.size = BlockSize - z->avail_out;
+
+		if (ret == Z_STREAM_END) {
+			// gzip files may consist of several members, continue with the next one
+			if (!z->avail_in) {
+				const size_t read = source->Read(&input[0],1,input.size());
+				z->next_in = reinterpret_cast<Bytef*>(&input[0]);
+				z->avail_in = static_cast<uInt>(read);
+			}
+			if (!z->avail_in) {
+				eof = true;
+			}
+			else inflateReset(z);
+		}
+		else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+			failed = eof = true;
+		}
+	}
+	block.error = failed;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Advance to the next block of decompressed data
+bool CompressedIOStream::NextBlock()
+{
+	blockStart += current.size;
+	current.size = 0;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	// small files are not worth a thread, it takes over from the second block on
+	if (blockStart) {
+		if (!worker) {
+			StartWorker();
+		}
+
+		boost::mutex::scoped_lock lock(mutex);
+		while (!aheadReady) {
+			cond.wait(lock);
+		}
+		current.data.swap(ahead.data);
+		std::swap(current.size,ahead.size);
+		std::swap(current.error,ahead.error);
+		aheadReady = false;
+		cond.notify_all();
+	}
+	else
+#endif
+	InflateBlock(current);
+
+	if (current.error && !current.size) {
+		DefaultLogger::get()->error("Failed to decompress gzip stream, data is truncated or corrupt");
+	}
+	return current.size != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Determine the uncompressed size from the trailer or by inflating the whole source once,
+// may be called while reading
+void CompressedIOStream::CountSize()
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	// the worker is idle once it has filled the read-ahead block, keep it so
+	boost::mutex::scoped_lock lock(mutex);
+	while (worker && !aheadReady) {
+		cond.wait(lock);
+	}
+#endif
+	const size_t at = source->Tell();
+	source->Seek(0,aiOrigin_SET);
+	size = TrailerSize(source);
+	if (size == UnknownSize) {
+		source->Seek(0,aiOrigin_SET);
+		size = CountInflatedSize(source);
+	}
+	source->Seek(at,aiOrigin_SET);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Rewind to the beginning of the uncompressed data
+void CompressedIOStream::Restart()
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	StopWorker();
+#endif
+	source->Seek(0,aiOrigin_SET);
+
+	z_stream* z = ZStream(zstream);
+	z->next_in = Z_NULL;
+	z->avail_in = 0;
+	inflateReset(z);
+
+	eof = failed = false;
+	blockStart = current.size = 0;
+}
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+// ------------------------------------------------------------------------------------------------
+void CompressedIOStream::StartWorker()
+{
+	ai_assert(!worker);
+	stop = aheadReady = false;
+	worker = new boost::thread(Worker(this));
+}
+
+// ------------------------------------------------------------------------------------------------
+void CompressedIOStream::StopWorker()
+{
+	if (!worker) {
+		return;
+	}
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		stop = true;
+		cond.notify_all();
+	}
+	worker->join();
+	delete worker;
+	worker = NULL;
+
+	// only used for rewinding and destruction, so the read-ahead block can be dropped
+	stop = aheadReady = false;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Worker thread: keep one block decompressed ahead of the reader
+void CompressedIOStream::WorkerMain()
+{
+	for (;;) {
+		{
+			boost::mutex::scoped_lock lock(mutex);
+			while (aheadReady && !stop) {
+				cond.wait(lock);
+			}
+			if (stop) {
+				return;
+			}
+		}
+
+		InflateBlock(ahead);
+
+		boost::mutex::scoped_lock lock(mutex);
+		aheadReady = true;
+		cond.notify_all();
+	}
+}
+#endif
+
+// ------------------------------------------------------------------------------------------------
+size_t CompressedIOStream::Read(void* pvBuffer, size_t pSize, size_t pCount)
+{
+	const size_t bytes = pSize * pCount;
+	if (!bytes) {
+		return 0;
+	}
+
+	// going back means decompressing everything again
+	if (pos < blockStart) {
+		Restart();
+	}
+
+	// skip forward to the block containing the read position
+	while (pos >= blockStart + current.size) {
+		if (!NextBlock()) {
+			return 0;
+		}
+	}
+
+	char* out = static_cast<char*>(pvBuffer);
+	size_t remaining = bytes;
+	while (remaining) {
+		if (pos >= blockStart + current.size && !NextBlock()) {
+			break;
+		}
+
+		const size_t ofs = pos - blockStart, n = std::min(remaining,current.size - ofs);
+		::memcpy(out,&current.data[ofs],n);
+
+		out += n;
+		pos += n;
+		remaining -= n;
+	}
+	return (bytes - remaining) / pSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t CompressedIOStream::Write(const void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/)
+{
+	return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Seeking only moves the read position, data is decompressed by the next Read()
+aiReturn CompressedIOStream::Seek(size_t pOffset, aiOrigin pOrigin)
+{
+	size_t p;
+	switch (pOrigin) {
+	case aiOrigin_SET:
+		p = pOffset;
+		break;
+	case aiOrigin_CUR:
+		p = pos + pOffset;
+		break;
+	case aiOrigin_END:
+		if (pOffset > FileSize()) {
+			return aiReturn_FAILURE;
+		}
+		p = size - pOffset;
+		break;
+	default:
+		return aiReturn_FAILURE;
+	}
+
+	// not worth inflating everything, reading beyond the end fails anyway
+	if (size != UnknownSize && p > size) {
+		return aiReturn_FAILURE;
+	}
+	pos = p;
+	return aiReturn_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t CompressedIOStream::Tell() const
+{
+	return pos;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t CompressedIOStream::FileSize() const
+{
+	if (size == UnknownSize) {
+		const_cast<CompressedIOStream*>(this)->CountSize();
+	}
+	return size;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CompressedIOStream::Flush()
+{
+	// empty
+}
+
+// ------------------------------------------------------------------------------------------------
+CompressedIOSystem::CompressedIOSystem(IOSystem* wrapped)
+: wrapped(wrapped)
+{
+	ai_assert(NULL != wrapped);
+}
+
+// ------------------------------------------------------------------------------------------------
+CompressedIOSystem::~CompressedIOSystem()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+bool CompressedIOSystem::Exists( const char* pFile) const
+{
+	return wrapped->Exists(pFile) || wrapped->Exists(std::string(pFile) + ".gz");
+}
+
+// ------------------------------------------------------------------------------------------------
+char CompressedIOSystem::getOsSeparator() const
+{
+	return wrapped->getOsSeparator();
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream* CompressedIOSystem::Open(const char* pFile, const char* pMode)
+{
+	ai_assert(NULL != pFile && NULL != pMode);
+
+	// writing is passed through unmodified
+	if (::strchr(pMode,'w') || ::strchr(pMode,'a') || ::strchr(pMode,'+')) {
+		return wrapped->Open(pFile,pMode);
+	}
+
+	std::string name = pFile;
+	if (!wrapped->Exists(name)) {
+		name += ".gz";
+	}
+
+	IOStream* stream = wrapped->Open(name,pMode);
+	if (!stream || !CompressedIOStream::IsCompressed(stream)) {
+		return stream;
+	}
+
+	// compressed data must not go through text mode conversions
+	if (::strchr(pMode,'t')) {
+		wrapped->Close(stream);
+		if (!(stream = wrapped->Open(name,"rb"))) {
+			return NULL;
+		}
+	}
+
+	DefaultLogger::get()->debug("Reading gzip compressed file " + name);
+
+	const std::map<std::string,size_t>::const_iterator it = sizes.find(name);
+	IOStream* const out = new CompressedIOStream(stream,wrapped,
+		it == sizes.end() ? CompressedIOStream::UnknownSize : (*it).second);
+	created[out] = name;
+	return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CompressedIOSystem::Close( IOStream* pFile)
+{
+	const std::map<IOStream*,std::string>::iterator it = created.find(pFile);
+	if (it == created.end()) {
+		wrapped->Close(pFile);
+		return;
+	}
+
+	// remember the size for the next stream over the same file
+	const size_t size = static_cast<CompressedIOStream*>(pFile)->GetKnownSize();
+	if (size != CompressedIOStream::UnknownSize) {
+		sizes[(*it).second] = size;
+	}
+	created.erase(it);
+	delete pFile;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool CompressedIOSystem::ComparePaths (const char* one, const char* two) const
+{
+	return wrapped->ComparePaths(one,two);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool CompressedIOSystem::HasCompressedSuffix(const std::string& pFile, std::string* stripped)
+{
+	const std::string::size_type len = pFile.length();
+	if (len <= 3 || pFile[len-3] != '.' || ::tolower(pFile[len-2]) != 'g' || ::tolower(pFile[len-1]) != 'z') {
+		return false;
+	}
+	if (stripped) {
+		*stripped = pFile.substr(0,len-3);
+	}
+	return true;
+}
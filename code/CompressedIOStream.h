@@ -0,0 +1,222 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file CompressedIOStream.h
+ *  @brief Transparent decompression of gzip files for all loaders
+ */
+#ifndef AI_COMPRESSEDIOSTREAM_H_INC
+#define AI_COMPRESSEDIOSTREAM_H_INC
+
+#include "../include/assimp/IOStream.hpp"
+#include "../include/assimp/IOSystem.hpp"
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/thread.hpp>
+#	include <boost/thread/mutex.hpp>
+#	include <boost/thread/condition_variable.hpp>
+#endif
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Read-only stream inflating a gzip compressed source stream on the fly.
+ *
+ *  Data is decompressed in blocks as it is read. If threading support is available
+ *  (#ASSIMP_BUILD_SINGLETHREADED not defined) a worker thread inflates the next block
+ *  while the caller consumes the current one. Forward seeks skip data, backward seeks
+ *  restart decompression from the beginning of the source.
+ *
+ *  The uncompressed size is determined when it is first asked for, unless it is passed in.
+ *  It is taken from the gzip trailer if the file certainly consists of a single member
+ *  smaller than 4 GB, otherwise the whole source is inflated once to count it. Readers
+ *  which don't need the size get by with inflating the data once. */
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API CompressedIOStream : public IOStream
+{
+public:
+
+	/** Size of a single block of decompressed data */
+	static const size_t BlockSize = 256 * 1024;
+
+	/** Uncompressed size which hasn't been determined yet */
+	static const size_t UnknownSize = ~static_cast<size_t>(0);
+
+	/** Construct from a source stream.
+	 *  @param source Stream with gzip data, must be positioned at its start. Ownership is
+	 *    transferred, the stream is released when this stream is destroyed.
+	 *  @param io IOSystem to Close() the source with, NULL to delete it. 
+	 *  @param knownSize Uncompressed size, if it is known from an earlier stream
+	 *    over the same data */
+	CompressedIOStream(IOStream* source, IOSystem* io = NULL, size_t knownSize = UnknownSize);
+
+	~CompressedIOStream();
+
+	/** Checks whether a stream begins with the gzip magic bytes. The stream is
+	 *  positioned at its beginning afterwards. */
+	static bool IsCompressed(IOStream* stream);
+
+	/** Returns the uncompressed size without determining it, 
+	 *  #UnknownSize if FileSize() hasn't been called yet */
+	size_t GetKnownSize() const {
+		return size;
+	}
+
+public:
+
+	size_t Read(void* pvBuffer, size_t pSize, size_t pCount);
+
+	size_t Write(const void* pvBuffer, size_t pSize, size_t pCount);
+
+	aiReturn Seek(size_t pOffset, aiOrigin pOrigin);
+
+	size_t Tell() const;
+
+	size_t FileSize() const;
+
+	void Flush();
+
+private:
+
+	/** A block of decompressed data */
+	struct Block {
+		Block() : size(), error() {}
+
+		std::vector<char> data;
+		size_t size;
+		bool error;
+	};
+
+	void Restart();
+	void CountSize();
+	bool NextBlock();
+	void InflateBlock(Block& block);
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	void StartWorker();
+	void StopWorker();
+	void WorkerMain();
+
+	struct Worker {
+		Worker(CompressedIOStream* s) : s(s) {}
+		void operator() () { s->WorkerMain(); }
+		CompressedIOStream* s;
+	};
+#endif
+
+private:
+
+	IOStream* source;
+	IOSystem* io;
+
+	/** zlib state, opaque to keep zlib out of this header */
+	void* zstream;
+	std::vector<char> input;
+	bool eof, failed;
+
+	size_t size, pos;
+
+	/** Start of the current block in the uncompressed data */
+	size_t blockStart;
+	Block current;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	Block ahead;
+	bool aheadReady, stop;
+	boost::mutex mutex;
+	boost::condition_variable cond;
+	boost::thread* worker;
+#endif
+};
+
+// ------------------------------------------------------------------------------------------------
+/** @brief IOSystem wrapper which decompresses gzip files transparently.
+ *
+ *  Files beginning with the gzip magic bytes are returned as #CompressedIOStream,
+ *  all other files are passed through unmodified. If a file does not exist, but
+ *  the same name with an additional ".gz" suffix does, the compressed file is
+ *  used instead. This allows loaders to find e.g. the material library of an
+ *  OBJ file if both are stored compressed. The uncompressed size of each file
+ *  is remembered, so opening a file again doesn't inflate it just to count. */
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API CompressedIOSystem : public IOSystem
+{
+public:
+
+	/** @param wrapped IOSystem to read the files from. It is not owned. */
+	CompressedIOSystem(IOSystem* wrapped);
+
+	~CompressedIOSystem();
+
+public:
+
+	bool Exists( const char* pFile) const;
+
+	char getOsSeparator() const;
+
+	IOStream* Open(const char* pFile, const char* pMode = "rb");
+
+	void Close( IOStream* pFile);
+
+	bool ComparePaths (const char* one, const char* two) const;
+
+	/** Checks whether a file name has a ".gz" suffix.
+	 *  @param pFile File name
+	 *  @param stripped Receives the name without the suffix, optional */
+	static bool HasCompressedSuffix(const std::string& pFile, std::string* stripped = NULL);
+
+private:
+
+	IOSystem* wrapped;
+
+	/** Streams created by us and the files they read, all other 
+	 *  streams belong to #wrapped */
+	std::map<IOStream*,std::string> created;
+
+	/** Uncompressed sizes of the files read so far */
+	std::map<std::string,size_t> sizes;
+};
+
+} // ! Assimp
+
+#endif // AI_COMPRESSEDIOSTREAM_H_INC
@@ -73,6 +73,10 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "ComputeUVMappingProcess"; }
+
 	// -------------------------------------------------------------------
 	/** Executes the post processing step on the given imported data.
 	* At the moment a process is not supposed to fail.
@@ -80,6 +80,10 @@ public:
 	// -------------------------------------------------------------------
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "MakeLeftHandedProcess"; }
+
 	// -------------------------------------------------------------------
 	void Execute( aiScene* pScene);
 
@@ -131,6 +135,10 @@ public:
 	// -------------------------------------------------------------------
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "FlipWindingOrderProcess"; }
+
 	// -------------------------------------------------------------------
 	void Execute( aiScene* pScene);
 
@@ -155,6 +163,10 @@ public:
 	// -------------------------------------------------------------------
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "FlipUVsProcess"; }
+
 	// -------------------------------------------------------------------
 	void Execute( aiScene* pScene);
 
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fast_atof.h"
 #include <vector>
 #include "../include/assimp/DefaultLogger.hpp"
+#include "../include/assimp/scene.h"
 
 namespace Assimp {
 	namespace DXF {
@@ -226,6 +227,28 @@ struct FileData
 };
 
 
+// state while building the output scene from the parsed blocks.
+struct ConversionData
+{
+	~ConversionData()
+	{
+		// only non-empty if the conversion failed half-way
+		for (std::vector<aiMesh*>::iterator it = meshes.begin(); it != meshes.end(); ++it) {
+			delete *it;
+		}
+	}
+
+	BlockMap blocks_by_name;
+
+	// output meshes and the indices of each converted block's meshes in them.
+	std::vector<aiMesh*> meshes;
+	BlockMeshMap block_meshes;
+
+	// blocks currently being expanded, to detect cyclic references.
+	std::vector<const Block*> stack;
+};
+
+
 
 
 
@@ -216,9 +216,8 @@ void DXFImporter::InternReadFile( const std::string& pFile,
 // ------------------------------------------------------------------------------------------------
 void DXFImporter::ConvertMeshes(aiScene* pScene, DXF::FileData& output)
 {
-	// the process of resolving all the INSERT statements can grow the
-	// polycount excessively, so log the original number.
-	// XXX Option to import blocks as separate nodes?
+	// INSERT statements are not expanded, every block is converted only once
+	// and then referenced from one node per instance.
 	if (!DefaultLogger::isNullLogger()) {
 
 		unsigned int vcount = 0, icount = 0;
@@ -239,11 +238,11 @@ void DXFImporter::ConvertMeshes(aiScene* pScene, DXF::FileData& output)
 	}
 
 	DXF::Block* entities = 0;
+	DXF::ConversionData conv;
 	
 	// index blocks by name
-	DXF::BlockMap blocks_by_name;
 	BOOST_FOREACH (DXF::Block& bl, output.blocks) {
-		blocks_by_name[bl.name] = &bl;
+		conv.blocks_by_name[bl.name] = &bl;
 		if ( !entities && bl.name == AI_DXF_ENTITIES_MAGIC_BLOCK ) {
 			entities = &bl;
 		}
@@ -253,23 +252,42 @@ void DXFImporter::ConvertMeshes(aiScene* pScene, DXF::FileData& output)
 		throw DeadlyImportError("DXF: no ENTITIES data block loaded");
 	}
 
+	GenerateHierarchy(pScene,*entities,conv);
+
+	if (conv.meshes.empty()) {
+		throw DeadlyImportError("DXF: this file contains no 3d data");
+	}
+
+	pScene->mMeshes = new aiMesh*[ pScene->mNumMeshes = static_cast<unsigned int>(conv.meshes.size()) ];
+	std::copy(conv.meshes.begin(),conv.meshes.end(),pScene->mMeshes);
+	conv.meshes.clear();
+
+	GenerateMaterials(pScene,output);
+}
+
+
+// ------------------------------------------------------------------------------------------------
+const std::vector<unsigned int>& DXFImporter::ConvertBlockMeshes(const DXF::Block& bl, DXF::ConversionData& conv)
+{
+	// blocks are converted once, no matter how often they are referenced
+	DXF::BlockMeshMap::const_iterator have = conv.block_meshes.find(&bl);
+	if (have != conv.block_meshes.end()) {
+		return (*have).second;
+	}
+
+	std::vector<unsigned int>& out = conv.block_meshes[&bl];
+
 	typedef std::map<std::string, unsigned int> LayerMap;
 
 	LayerMap layers;
 	std::vector< std::vector< const DXF::PolyLine*> > corr;
 
-	// now expand all block references in the primary ENTITIES block
-	// XXX this involves heavy memory copying, consider a faster solution for future versions.
-	ExpandBlockReferences(*entities,blocks_by_name);
-
 	unsigned int cur = 0;
-	BOOST_FOREACH (boost::shared_ptr<const DXF::PolyLine> pl, entities->lines) {
+	BOOST_FOREACH (boost::shared_ptr<const DXF::PolyLine> pl, bl.lines) {
 		if (pl->positions.size()) {
 
 			std::map<std::string, unsigned int>::iterator it = layers.find(pl->layer);
 			if (it == layers.end()) {
-				++pScene->mNumMeshes;
-
 				layers[pl->layer] = cur++;
 
 				std::vector< const DXF::PolyLine* > pv;
@@ -283,14 +301,16 @@ void DXFImporter::ConvertMeshes(aiScene* pScene, DXF::FileData& output)
 		}
 	}
 
-	if (!pScene->mNumMeshes) {
-		throw DeadlyImportError("DXF: this file contains no 3d data");
-	}
+	const unsigned int first = static_cast<unsigned int>(conv.meshes.size());
+	conv.meshes.resize(first + cur, NULL);
 
-	pScene->mMeshes = new aiMesh*[ pScene->mNumMeshes ] ();
+	out.resize(cur);
+	for (unsigned int i = 0; i < cur; ++i) {
+		out[i] = first + i;
+	}
 
 	BOOST_FOREACH(const LayerMap::value_type& elem, layers){
-		aiMesh* const mesh =  pScene->mMeshes[elem.second] = new aiMesh();
+		aiMesh* const mesh = conv.meshes[first + elem.second] = new aiMesh();
 		mesh->mName.Set(elem.first);
 
 		unsigned int cvert = 0,cface = 0;
@@ -349,52 +369,69 @@ void DXFImporter::ConvertMeshes(aiScene* pScene, DXF::FileData& output)
 		mesh->mPrimitiveTypes = prims;
 		mesh->mMaterialIndex = 0;
 	}
-
-	GenerateHierarchy(pScene,output);
-	GenerateMaterials(pScene,output);
+	return out;
 }
 
 
 // ------------------------------------------------------------------------------------------------
-void DXFImporter::ExpandBlockReferences(DXF::Block& bl,const DXF::BlockMap& blocks_by_name)
+void DXFImporter::ExpandBlockReferences(aiNode* nd, const DXF::Block& bl, DXF::ConversionData& conv)
 {
+	if (bl.insertions.empty()) {
+		return;
+	}
+
+	// make room for one child per INSERT, keeping any children the node already has.
+	aiNode** const children = new aiNode*[nd->mNumChildren + bl.insertions.size()];
+	std::copy(nd->mChildren,nd->mChildren + nd->mNumChildren,children);
+	delete[] nd->mChildren;
+	nd->mChildren = children;
+
+	conv.stack.push_back(&bl);
 	BOOST_FOREACH (const DXF::InsertBlock& insert, bl.insertions) {
 
 		// first check if the referenced blocks exists ...
-		const DXF::BlockMap::const_iterator it = blocks_by_name.find(insert.name);
-		if (it == blocks_by_name.end()) {
+		const DXF::BlockMap::const_iterator it = conv.blocks_by_name.find(insert.name);
+		if (it == conv.blocks_by_name.end()) {
 			DefaultLogger::get()->error((Formatter::format("DXF: Failed to resolve block reference: "),
 				insert.name,"; skipping"
 			));
 			continue;
 		}
 
-		// XXX this would be the place to implement recursive expansion if needed.
 		const DXF::Block& bl_src = *(*it).second;
-		
-		BOOST_FOREACH (boost::shared_ptr<const DXF::PolyLine> pl_in, bl_src.lines) {
-			boost::shared_ptr<DXF::PolyLine> pl_out = boost::shared_ptr<DXF::PolyLine>(new DXF::PolyLine(*pl_in));
-
-			if (bl_src.base.Length() || insert.scale.x!=1.f || insert.scale.y!=1.f || insert.scale.z!=1.f || insert.angle || insert.pos.Length()) {
-				// manual coordinate system transformation
-				// XXX order
-				aiMatrix4x4 trafo, tmp;
-				aiMatrix4x4::Translation(-bl_src.base,trafo);
-				trafo *= aiMatrix4x4::Scaling(insert.scale,tmp);
-				trafo *= aiMatrix4x4::Translation(insert.pos,tmp);
-
-				// XXX rotation currently ignored - I didn't find an appropriate sample model.
-				if (insert.angle != 0.f) {
-					DefaultLogger::get()->warn("DXF: BLOCK rotation not currently implemented");
-				}
+		if (std::find(conv.stack.begin(),conv.stack.end(),&bl_src) != conv.stack.end()) {
+			DefaultLogger::get()->error((Formatter::format("DXF: Block references itself: "),
+				insert.name,"; skipping"
+			));
+			continue;
+		}
 
-				BOOST_FOREACH (aiVector3D& v, pl_out->positions) {
-					v *= trafo;
-				}
-			}
+		aiNode* const child = nd->mChildren[nd->mNumChildren++] = new aiNode();
+		child->mName.Set(insert.name);
+		child->mParent = nd;
 
-			bl.lines.push_back(pl_out);
+		// the block's coordinate system, relative to the block it is inserted in.
+		// Baking this into the vertices is left to aiProcess_PreTransformVertices.
+		aiMatrix4x4& trafo = child->mTransformation;
+		aiMatrix4x4 tmp;
+		aiMatrix4x4::Translation(insert.pos,trafo);
+		trafo *= aiMatrix4x4::RotationZ(AI_DEG_TO_RAD(insert.angle),tmp);
+		trafo *= aiMatrix4x4::Scaling(insert.scale,tmp);
+		trafo *= aiMatrix4x4::Translation(-bl_src.base,tmp);
+
+		const std::vector<unsigned int>& meshes = ConvertBlockMeshes(bl_src,conv);
+		if (meshes.size()) {
+			child->mMeshes = new unsigned int[child->mNumMeshes = static_cast<unsigned int>(meshes.size())];
+			std::copy(meshes.begin(),meshes.end(),child->mMeshes);
 		}
+
+		ExpandBlockReferences(child,bl_src,conv);
+	}
+	conv.stack.pop_back();
+
+	if (!nd->mNumChildren) {
+		delete[] nd->mChildren;
+		nd->mChildren = NULL;
 	}
 }
 
@@ -427,28 +464,36 @@ void DXFImporter::GenerateMaterials(aiScene* pScene, DXF::FileData& /*output*/)
 
 
 // ------------------------------------------------------------------------------------------------
-void DXFImporter::GenerateHierarchy(aiScene* pScene, DXF::FileData& /*output*/)
+void DXFImporter::GenerateHierarchy(aiScene* pScene, const DXF::Block& entities, DXF::ConversionData& conv)
 {
-	// generate the output scene graph, which is just the root node with a single child for each layer.
+	// generate the output scene graph. Geometry from ENTITIES ends up in the root node with a 
+	// single child for each layer, INSERTs become child nodes referencing their block's meshes.
 	pScene->mRootNode = new aiNode();
 	pScene->mRootNode->mName.Set("<DXF_ROOT>");
 
-	if (1 == pScene->mNumMeshes)	{
+	const std::vector<unsigned int>& meshes = ConvertBlockMeshes(entities,conv);
+	if (1 == meshes.size())	{
 		pScene->mRootNode->mMeshes = new unsigned int[ pScene->mRootNode->mNumMeshes = 1 ];
-		pScene->mRootNode->mMeshes[0] = 0;
+		pScene->mRootNode->mMeshes[0] = meshes[0];
 	}
-	else
+	else if (meshes.size())
 	{
-		pScene->mRootNode->mChildren = new aiNode*[ pScene->mRootNode->mNumChildren = pScene->mNumMeshes ];
+		pScene->mRootNode->mChildren = new aiNode*[ pScene->mRootNode->mNumChildren = static_cast<unsigned int>(meshes.size()) ];
 		for (unsigned int m = 0; m < pScene->mRootNode->mNumChildren;++m)	{
 			aiNode* p = pScene->mRootNode->mChildren[m] = new aiNode();
-			p->mName = pScene->mMeshes[m]->mName;
+			p->mName = conv.meshes[meshes[m]]->mName;
 
 			p->mMeshes = new unsigned int[p->mNumMeshes = 1];
-			p->mMeshes[0] = m;
+			p->mMeshes[0] = meshes[m];
 			p->mParent = pScene->mRootNode;
 		}
 	}
+
+	ExpandBlockReferences(pScene->mRootNode,entities,conv);
+
+	DefaultLogger::get()->debug((Formatter::format("DXF: "),
+		conv.block_meshes.size()-1," distinct blocks instanced, ", conv.meshes.size()," meshes"
+	));
 }
 
 
@@ -513,11 +558,10 @@ void DXFImporter::ParseBlock(DXF::LineReader& reader, DXF::FileData& output)
 			continue;
 		}
 
-		// XXX is this a valid case?
+		// nested block references are resolved into child nodes in ExpandBlockReferences()
 		if (reader.Is(0,"INSERT")) {
-			DefaultLogger::get()->warn("DXF: INSERT within a BLOCK not currently supported; skipping");
-			for( ;!reader.End() && !reader.Is(0,"ENDBLK"); ++reader);
-			break;
+			ParseInsertion(++reader,output);
+			continue;
 		}
 
 		else if (reader.Is(0,"3DFACE") || reader.Is(0,"LINE") || reader.Is(0,"3DLINE")) {
@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseImporter.h"
 
+struct aiNode;
+
 namespace Assimp	{
 	namespace DXF {
 	
@@ -54,8 +56,10 @@ namespace Assimp	{
 		struct PolyLine;
 		struct Block;
 		struct InsertBlock;
+		struct ConversionData;
 
 		typedef std::map<std::string, const DXF::Block*> BlockMap;
+		typedef std::map<const DXF::Block*, std::vector<unsigned int> > BlockMeshMap;
 	}
 
 
@@ -136,15 +140,24 @@ private:
 
 	// -----------------------------------------------------
 	void GenerateHierarchy(aiScene* pScene, 
-		DXF::FileData& output);
+		const DXF::Block& entities,
+		DXF::ConversionData& conv);
 
 	// -----------------------------------------------------
 	void GenerateMaterials(aiScene* pScene, 
 		DXF::FileData& output);
 
 	// -----------------------------------------------------
-	void ExpandBlockReferences(DXF::Block& bl,
-		const DXF::BlockMap& blocks_by_name);
+	/** Converts the polylines of a block to one mesh per layer,
+	 *  or returns the meshes from an earlier call for the same block. */
+	const std::vector<unsigned int>& ConvertBlockMeshes(const DXF::Block& bl,
+		DXF::ConversionData& conv);
+
+	// -----------------------------------------------------
+	/** Adds a child node for each INSERT in a block, recursively. */
+	void ExpandBlockReferences(aiNode* nd,
+		const DXF::Block& bl,
+		DXF::ConversionData& conv);
 };
 
 } // end of namespace Assimp
@@ -81,6 +81,10 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "DeboneProcess"; }
+
 	// -------------------------------------------------------------------
 	/** Called prior to ExecuteOnScene().
 	* The function is a request to the process to update its configuration
@@ -104,6 +104,12 @@ public:
 	/// Flush file contents
 	void Flush();
 
+	// -------------------------------------------------------------------
+	/// Get the C stdio handle of the file, i.e. to map it into memory
+	FILE* GetHandle() const {
+		return mFile;
+	}
+
 private:
 	//	File datastructure, using clib
 	FILE* mFile;
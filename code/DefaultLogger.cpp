@@ -60,6 +60,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #	include <boost/thread/mutex.hpp>
 
 boost::mutex loggerMutex;
+
+// post-processing steps may log from several worker threads at once
+boost::mutex writeMutex;
 #endif
 
 namespace Assimp	{
@@ -380,6 +383,10 @@ void DefaultLogger::WriteToStreams(const char *message,
 {
 	ai_assert(NULL != message);
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::mutex::scoped_lock lock(writeMutex);
+#endif
+
 	// Check whether this is a repeated message
 	if (! ::strncmp( message,lastMsg, lastLen-1))
 	{
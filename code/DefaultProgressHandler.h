@@ -54,7 +54,7 @@ class DefaultProgressHandler
 
 	
 	virtual bool Update(float /*percentage*/) {
-		return false;
+		return true;
 	}
 
 
@@ -63,12 +63,14 @@ Here we implement only the C++ interface (Assimp::Exporter).
 #include "ConvertToLHProcess.h"
 #include "Exceptional.h"
 #include "ScenePrivate.h"
+#include "ParallelFor.h"
 #include <boost/shared_ptr.hpp>
 #include "../include/assimp/Exporter.hpp"
 #include "../include/assimp/mesh.h"
 #include "../include/assimp/postprocess.h"
 #include "../include/assimp/scene.h"
 #include <memory>
+#include <map>
 
 namespace Assimp {
 
@@ -287,6 +289,168 @@ bool IsVerboseFormat(const aiScene* pScene)
 }
 
 
+// ------------------------------------------------------------------------------------------------
+// Owns a copy of a scene which may share data with its source scene
+struct SharedSceneCopy
+{
+	explicit SharedSceneCopy(const aiScene* source)
+		: copy(), source(source)
+	{}
+
+	~SharedSceneCopy()
+	{
+		if (copy) {
+			SceneCombiner::DetachSharedData(copy,source);
+			delete copy;
+		}
+	}
+
+	aiScene* get() const {
+		return copy;
+	}
+
+	aiScene* copy;
+	const aiScene* source;
+
+private:
+	SharedSceneCopy(const SharedSceneCopy&);
+	SharedSceneCopy& operator= (const SharedSceneCopy&);
+};
+
+// ------------------------------------------------------------------------------------------------
+// Preprocessing to be applied to a scene before handing it to an export format
+struct ExportPreprocessing
+{
+	ExportPreprocessing()
+		: pp(), verbosify(), join_again()
+	{}
+
+	bool operator< (const ExportPreprocessing& o) const {
+		if (pp != o.pp) {
+			return pp < o.pp;
+		}
+		if (verbosify != o.verbosify) {
+			return verbosify < o.verbosify;
+		}
+		return join_again < o.join_again;
+	}
+
+	unsigned int pp;
+	bool verbosify, join_again;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Determine the steps to be applied to pScene before exporting it to the given format
+ExportPreprocessing GetExportPreprocessing(const std::vector<BaseProcess*>& steps, const aiScene* pScene, 
+	bool is_verbose_format, const Exporter::ExportFormatEntry& exp, unsigned int pPreprocessing)
+{
+	ExportPreprocessing out;
+	const ScenePrivateData* const priv = ScenePriv(pScene);
+
+	// steps that are not idempotent, i.e. we might need to run them again, usually to get back to the
+	// original state before the step was applied first. When checking which steps we don't need
+	// to run, those are excluded.
+	const unsigned int nonIdempotentSteps = aiProcess_FlipWindingOrder | aiProcess_FlipUVs | aiProcess_MakeLeftHanded;
+
+	// Erase all pp steps that were already applied to this scene
+	out.pp = (exp.mEnforcePP | pPreprocessing) & ~(priv && !priv->mIsCopy
+		? (priv->mPPStepsApplied & ~nonIdempotentSteps)
+		: 0u);
+
+	// If no extra postprocessing was specified, and we obtained this scene from an
+	// Assimp importer, apply the reverse steps automatically.
+	// TODO: either drop this, or document it. Otherwise it is just a bad surprise.
+	//if (!pPreprocessing && priv) {
+	//	pp |= (nonIdempotentSteps & priv->mPPStepsApplied);
+	//}
+
+	// If the input scene is not in verbose format, but there is at least postprocessing step that relies on it,
+	// we need to run the MakeVerboseFormat step first.
+	if (!is_verbose_format) {
+		for( unsigned int a = 0; a < steps.size(); a++) {
+			BaseProcess* const p = steps[a];
+
+			if (p->IsActive(out.pp) && p->RequireVerboseFormat()) {
+				out.verbosify = true;
+				break;
+			}
+		}
+		out.verbosify = out.verbosify || (exp.mEnforcePP & aiProcess_JoinIdenticalVertices);
+		out.join_again = out.verbosify && !(exp.mEnforcePP & aiProcess_JoinIdenticalVertices);
+	}
+	return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Apply the given preprocessing to a copy of pScene. If there is nothing to do, no copy is made.
+void ApplyExportPreprocessing(const std::vector<BaseProcess*>& steps, const aiScene* pScene, 
+	const ExportPreprocessing& prep, SharedSceneCopy& scenecopy)
+{
+	const unsigned int pp = prep.pp;
+
+	// Steps are applied to a copy of the scene. If there is nothing to do, the
+	// exporter reads the source scene directly, which is not modified either.
+	// Embedded textures aren't touched by any step but RemoveComponent, so
+	// the copy references the texel data of the source scene otherwise.
+	if (pp || prep.verbosify) {
+		SceneCombiner::CopyScene(&scenecopy.copy,pScene,true,
+			(pp & aiProcess_RemoveComponent) ? 0 : AI_INT_COPY_SCENE_SHARE_TEXTURES);
+	}
+
+	if (prep.verbosify) {
+		DefaultLogger::get()->debug("export: Scene data not in verbose format, applying MakeVerboseFormat step first");
+
+		MakeVerboseFormatProcess proc;
+		proc.Execute(scenecopy.get());
+	}
+
+	if (pp) {
+		// the three 'conversion' steps need to be executed first because all other steps rely on the standard data layout
+		{
+			FlipWindingOrderProcess step;
+			if (step.IsActive(pp)) {
+				step.Execute(scenecopy.get());
+			}
+		}
+		
+		{
+			FlipUVsProcess step;
+			if (step.IsActive(pp)) {
+				step.Execute(scenecopy.get());
+			}
+		}
+
+		{
+			MakeLeftHandedProcess step;
+			if (step.IsActive(pp)) {
+				step.Execute(scenecopy.get());
+			}
+		}
+
+		// dispatch other processes
+		for( unsigned int a = 0; a < steps.size(); a++) {
+			BaseProcess* const p = steps[a];
+
+			if (p->IsActive(pp) 
+				&& !dynamic_cast<FlipUVsProcess*>(p) 
+				&& !dynamic_cast<FlipWindingOrderProcess*>(p) 
+				&& !dynamic_cast<MakeLeftHandedProcess*>(p)) {
+
+				p->Execute(scenecopy.get());
+			}
+		}
+		ScenePrivateData* const privOut = ScenePriv(scenecopy.get());
+		ai_assert(privOut);
+
+		privOut->mPPStepsApplied |= pp;
+	}
+
+	if(prep.join_again) {
+		JoinVerticesProcess proc;
+		proc.Execute(scenecopy.get());
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
 aiReturn Exporter :: Export( const aiScene* pScene, const char* pFormatId, const char* pPath, unsigned int pPreprocessing, const ExportProperties* pProperties)
 {
@@ -304,107 +468,13 @@ aiReturn Exporter :: Export( const aiScene* pScene, const char* pFormatId, const
 		if (!strcmp(exp.mDescription.id,pFormatId)) {
 
 			try {
-
-				// Always create a full copy of the scene. We might optimize this one day, 
-				// but for now it is the most pragmatic way.
-				aiScene* scenecopy_tmp;
-				SceneCombiner::CopyScene(&scenecopy_tmp,pScene);
-
-				std::auto_ptr<aiScene> scenecopy(scenecopy_tmp);
-				const ScenePrivateData* const priv = ScenePriv(pScene);
-
-				// steps that are not idempotent, i.e. we might need to run them again, usually to get back to the
-				// original state before the step was applied first. When checking which steps we don't need
-				// to run, those are excluded.
-				const unsigned int nonIdempotentSteps = aiProcess_FlipWindingOrder | aiProcess_FlipUVs | aiProcess_MakeLeftHanded;
-
-				// Erase all pp steps that were already applied to this scene
-				const unsigned int pp = (exp.mEnforcePP | pPreprocessing) & ~(priv && !priv->mIsCopy
-					? (priv->mPPStepsApplied & ~nonIdempotentSteps)
-					: 0u);
-
-				// If no extra postprocessing was specified, and we obtained this scene from an
-				// Assimp importer, apply the reverse steps automatically.
-				// TODO: either drop this, or document it. Otherwise it is just a bad surprise.
-				//if (!pPreprocessing && priv) {
-				//	pp |= (nonIdempotentSteps & priv->mPPStepsApplied);
-				//}
-
-				// If the input scene is not in verbose format, but there is at least postprocessing step that relies on it,
-				// we need to run the MakeVerboseFormat step first.
-				bool must_join_again = false;
-				if (!is_verbose_format) {
-					
-					bool verbosify = false;
-					for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++) {
-						BaseProcess* const p = pimpl->mPostProcessingSteps[a];
-
-						if (p->IsActive(pp) && p->RequireVerboseFormat()) {
-							verbosify = true;
-							break;
-						}
-					}
-
-					if (verbosify || (exp.mEnforcePP & aiProcess_JoinIdenticalVertices)) {
-						DefaultLogger::get()->debug("export: Scene data not in verbose format, applying MakeVerboseFormat step first");
-
-						MakeVerboseFormatProcess proc;
-						proc.Execute(scenecopy.get());
-
-						if(!(exp.mEnforcePP & aiProcess_JoinIdenticalVertices)) {
-							must_join_again = true;
-						}
-					}
-				}
-
-				if (pp) {
-					// the three 'conversion' steps need to be executed first because all other steps rely on the standard data layout
-					{
-						FlipWindingOrderProcess step;
-						if (step.IsActive(pp)) {
-							step.Execute(scenecopy.get());
-						}
-					}
-					
-					{
-						FlipUVsProcess step;
-						if (step.IsActive(pp)) {
-							step.Execute(scenecopy.get());
-						}
-					}
-
-					{
-						MakeLeftHandedProcess step;
-						if (step.IsActive(pp)) {
-							step.Execute(scenecopy.get());
-						}
-					}
-
-					// dispatch other processes
-					for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++) {
-						BaseProcess* const p = pimpl->mPostProcessingSteps[a];
-
-						if (p->IsActive(pp) 
-							&& !dynamic_cast<FlipUVsProcess*>(p) 
-							&& !dynamic_cast<FlipWindingOrderProcess*>(p) 
-							&& !dynamic_cast<MakeLeftHandedProcess*>(p)) {
-
-							p->Execute(scenecopy.get());
-						}
-					}
-					ScenePrivateData* const privOut = ScenePriv(scenecopy.get());
-					ai_assert(privOut);
-
-					privOut->mPPStepsApplied |= pp;
-				}
-
-				if(must_join_again) {
-					JoinVerticesProcess proc;
-					proc.Execute(scenecopy.get());
-				}
+				SharedSceneCopy scenecopy(pScene);
+				ApplyExportPreprocessing(pimpl->mPostProcessingSteps,pScene,GetExportPreprocessing(
+					pimpl->mPostProcessingSteps,pScene,is_verbose_format,exp,pPreprocessing),scenecopy);
 
 				ExportProperties emptyProperties;  // Never pass NULL ExportProperties so Exporters don't have to worry.
-				exp.mExportFunction(pPath,pimpl->mIOSystem.get(),scenecopy.get(), pProperties ? pProperties : &emptyProperties);
+				exp.mExportFunction(pPath,pimpl->mIOSystem.get(),scenecopy.copy ? scenecopy.get() : pScene, 
+					pProperties ? pProperties : &emptyProperties);
 			}
 			catch (DeadlyExportError& err) {
 				pimpl->mError = err.what();
@@ -420,6 +490,116 @@ aiReturn Exporter :: Export( const aiScene* pScene, const char* pFormatId, const
 }
 
 
+// ------------------------------------------------------------------------------------------------
+// Runs the export function of a single request of ExportMany(). Invoked concurrently for
+// all requests, the scenes are only read by the exporters.
+struct ExportManyWorker
+{
+	ExportManyWorker(Exporter::ExportRequest* requests, const std::vector<size_t>& jobs,
+		const std::vector<const Exporter::ExportFormatEntry*>& formats, const std::vector<const aiScene*>& scenes,
+		IOSystem* io)
+		: requests(requests), jobs(&jobs), formats(&formats), scenes(&scenes), io(io)
+	{}
+
+	void operator() (unsigned int i)
+	{
+		const size_t n = (*jobs)[i];
+		Exporter::ExportRequest& req = requests[n];
+
+		try {
+			ExportProperties emptyProperties;
+			(*formats)[n]->mExportFunction(req.mPath,req.mIOSystem ? req.mIOSystem : io,(*scenes)[n],
+				req.mProperties ? req.mProperties : &emptyProperties);
+			req.mResult = AI_SUCCESS;
+		}
+		catch (const std::exception& err) {
+			req.mError = err.what();
+		}
+	}
+
+	Exporter::ExportRequest* requests;
+	const std::vector<size_t>* jobs;
+	const std::vector<const Exporter::ExportFormatEntry*>* formats;
+	const std::vector<const aiScene*>* scenes;
+	IOSystem* io;
+};
+
+// ------------------------------------------------------------------------------------------------
+aiReturn Exporter :: ExportMany( const aiScene* pScene, ExportRequest* pRequests, size_t pNumRequests)
+{
+	ASSIMP_BEGIN_EXCEPTION_REGION();
+
+	// see Export()
+	const bool is_verbose_format = !(pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) || IsVerboseFormat(pScene);	
+
+	pimpl->mError = "";
+
+	// group all requests by the preprocessing they need
+	typedef std::map<ExportPreprocessing, std::vector<size_t> > GroupMap;
+	GroupMap groups;
+
+	std::vector<const ExportFormatEntry*> formats(pNumRequests);
+	for (size_t n = 0; n < pNumRequests; ++n) {
+		ExportRequest& req = pRequests[n];
+		req.mResult = AI_FAILURE;
+		req.mError = "";
+
+		for (size_t i = 0; i < pimpl->mExporters.size(); ++i) {
+			if (!strcmp(pimpl->mExporters[i].mDescription.id,req.mFormatId)) {
+				formats[n] = &pimpl->mExporters[i];
+				break;
+			}
+		}
+
+		if (!formats[n]) {
+			req.mError = std::string("Found no exporter to handle this file format: ") + req.mFormatId;
+			continue;
+		}
+		groups[GetExportPreprocessing(pimpl->mPostProcessingSteps,pScene,is_verbose_format,
+			*formats[n],req.mPreprocessing)].push_back(n);
+	}
+
+	// preprocess once per group. The steps keep state, so this happens sequentially.
+	std::vector< boost::shared_ptr<SharedSceneCopy> > copies;
+	std::vector<const aiScene*> scenes(pNumRequests);
+	std::vector<size_t> jobs;
+
+	for (GroupMap::const_iterator it = groups.begin(); it != groups.end(); ++it) {
+		const std::vector<size_t>& members = (*it).second;
+		try {
+			copies.push_back(boost::shared_ptr<SharedSceneCopy>(new SharedSceneCopy(pScene)));
+			ApplyExportPreprocessing(pimpl->mPostProcessingSteps,pScene,(*it).first,*copies.back());
+		}
+		catch (DeadlyExportError& err) {
+			for (size_t m = 0; m < members.size(); ++m) {
+				pRequests[members[m]].mError = err.what();
+			}
+			continue;
+		}
+
+		const aiScene* const scene = copies.back()->copy ? copies.back()->get() : pScene;
+		for (size_t m = 0; m < members.size(); ++m) {
+			scenes[members[m]] = scene;
+			jobs.push_back(members[m]);
+		}
+	}
+
+	// and run all writers concurrently
+	ExportManyWorker worker(pRequests,jobs,formats,scenes,pimpl->mIOSystem.get());
+	ParallelFor(static_cast<unsigned int>(jobs.size()),worker);
+
+	for (size_t n = 0; n < pNumRequests; ++n) {
+		if (pRequests[n].mResult != AI_SUCCESS) {
+			pimpl->mError = pRequests[n].mError;
+			return AI_FAILURE;
+		}
+	}
+	return AI_SUCCESS;
+
+	ASSIMP_END_EXCEPTION_REGION(aiReturn);
+}
+
+
 // ------------------------------------------------------------------------------------------------
 const char* Exporter :: GetErrorString() const
 {
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <stdint.h>
 #include "Exceptional.h"
 #include "ByteSwapper.h"
+#include "ProgressReporter.h"
 
 namespace Assimp {
 namespace FBX {
@@ -287,8 +288,12 @@ void ReadData(const char*& sbegin_out, const char*& send_out, const char* input,
 
 
 // ------------------------------------------------------------------------------------------------
-bool ReadScope(TokenList& output_tokens, const char* input, const char*& cursor, const char* end)
+bool ReadScope(TokenList& output_tokens, const char* input, const char*& cursor, const char* end, ProgressReporter* progress)
 {
+	if (progress) {
+		progress->Update(Offset(input, cursor));
+	}
+
 	// the first word contains the offset at which this block ends
 	const uint32_t end_offset = ReadWord(input, cursor, end);
 
@@ -350,7 +355,7 @@ bool ReadScope(TokenList& output_tokens, const char* input, const char*& cursor,
 
 		// XXX this is vulnerable to stack overflowing ..
 		while(Offset(input, cursor) < end_offset - BLOCK_SENTINEL_LENGTH) {
-			ReadScope(output_tokens, input, cursor, input + end_offset - BLOCK_SENTINEL_LENGTH);
+			ReadScope(output_tokens, input, cursor, input + end_offset - BLOCK_SENTINEL_LENGTH, progress);
 		}
 		output_tokens.push_back(new_Token(cursor, cursor + 1, TokenType_CLOSE_BRACKET, Offset(input, cursor) ));
 
@@ -373,7 +378,7 @@ bool ReadScope(TokenList& output_tokens, const char* input, const char*& cursor,
 }
 
 // ------------------------------------------------------------------------------------------------
-void TokenizeBinary(TokenList& output_tokens, const char* input, unsigned int length)
+void TokenizeBinary(TokenList& output_tokens, const char* input, unsigned int length, ProgressReporter* progress)
 {
 	ai_assert(input);
 
@@ -391,7 +396,7 @@ void TokenizeBinary(TokenList& output_tokens, const char* input, unsigned int le
 	const char* cursor = input + 0x1b;
 
 	while (cursor < input + length) {
-		if(!ReadScope(output_tokens, input, cursor, input + length)) {
+		if(!ReadScope(output_tokens, input, cursor, input + length, progress)) {
 			break;
 		}
 	}
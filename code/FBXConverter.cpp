@@ -44,9 +44,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #ifndef ASSIMP_BUILD_NO_FBX_IMPORTER
 
+#include <algorithm>
+#include <functional>
 #include <iterator>
 #include <sstream>
-#include <boost/tuple/tuple.hpp>
 #include <vector>
 #include "FBXParser.h"
 #include "FBXConverter.h"
@@ -54,6 +55,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXUtil.h"
 #include "FBXProperties.h"
 #include "FBXImporter.h"
+#include "ParallelFor.h"
+#include "ProgressReporter.h"
 #include "../include/assimp/scene.h"
 #include <boost/foreach.hpp>
 #include <boost/scoped_array.hpp>
@@ -100,16 +103,32 @@ public:
 
 public:
 
-	Converter(aiScene* out, const Document& doc)
+	Converter(aiScene* out, const Document& doc, const AtomicFlag* cancel)
 		: defaultMaterialIndex()
 		, out(out) 
 		, doc(doc)
+		, cancel(cancel)
+	{
+	}
+
+
+	// ------------------------------------------------------------------------------------------------
+	// Run the conversion. Kept out of the constructor so the destructor frees
+	// everything converted so far if the import is cancelled or fails.
+	void Convert()
 	{
 		// animations need to be converted first since this will
 		// populate the node_anim_chain_bits map, which is needed
 		// to determine which nodes need to be generated.
 		ConvertAnimations();
+		ThrowIfCancelled(cancel);
 		ConvertRootNode();
+		ThrowIfCancelled(cancel);
+
+		// the node graph is complete and all output meshes have their slots,
+		// materials and bone names assigned, so fill them concurrently.
+		ConvertQueuedMeshes();
+		ThrowIfCancelled(cancel);
 
 		if(doc.Settings().readAllMaterials) {
 			// unfortunately this means we have to evaluate all objects
@@ -485,35 +504,10 @@ private:
 
 
 	// ------------------------------------------------------------------------------------------------
-	void GetRotationMatrix(Model::RotOrder mode, const aiVector3D& rotation, aiMatrix4x4& out)
+	// indices (0: x, 1: y, 2: z) of the per-axis rotations in the order they are multiplied
+	void GetRotationOrder(Model::RotOrder mode, int order[3])
 	{
-		if(mode == Model::RotOrder_SphericXYZ) {
-			FBXImporter::LogError("Unsupported RotationMode: SphericXYZ");
-			out = aiMatrix4x4();
-			return;
-		}
-
-		const float angle_epsilon = 1e-6f;
-
-		out = aiMatrix4x4();
-
-		bool is_id[3] = { true, true, true };
-
-		aiMatrix4x4 temp[3];
-		if(std::fabs(rotation.z) > angle_epsilon) {
-			aiMatrix4x4::RotationZ(AI_DEG_TO_RAD(rotation.z),temp[2]);
-			is_id[2] = false;
-		}
-		if(std::fabs(rotation.y) > angle_epsilon) {
-			aiMatrix4x4::RotationY(AI_DEG_TO_RAD(rotation.y),temp[1]);
-			is_id[1] = false;
-		}
-		if(std::fabs(rotation.x) > angle_epsilon) {
-			aiMatrix4x4::RotationX(AI_DEG_TO_RAD(rotation.x),temp[0]);
-			is_id[0] = false;
-		}
-
-		int order[3] = {-1, -1, -1};
+		order[0] = order[1] = order[2] = -1;
 
 		// note: rotation order is inverted since we're left multiplying as is usual in assimp
 		switch(mode)
@@ -561,6 +555,40 @@ private:
         ai_assert((order[0] >= 0) && (order[0] <= 2));
         ai_assert((order[1] >= 0) && (order[1] <= 2));
         ai_assert((order[2] >= 0) && (order[2] <= 2));
+	}
+
+
+	// ------------------------------------------------------------------------------------------------
+	void GetRotationMatrix(Model::RotOrder mode, const aiVector3D& rotation, aiMatrix4x4& out)
+	{
+		if(mode == Model::RotOrder_SphericXYZ) {
+			FBXImporter::LogError("Unsupported RotationMode: SphericXYZ");
+			out = aiMatrix4x4();
+			return;
+		}
+
+		const float angle_epsilon = 1e-6f;
+
+		out = aiMatrix4x4();
+
+		bool is_id[3] = { true, true, true };
+
+		aiMatrix4x4 temp[3];
+		if(std::fabs(rotation.z) > angle_epsilon) {
+			aiMatrix4x4::RotationZ(AI_DEG_TO_RAD(rotation.z),temp[2]);
+			is_id[2] = false;
+		}
+		if(std::fabs(rotation.y) > angle_epsilon) {
+			aiMatrix4x4::RotationY(AI_DEG_TO_RAD(rotation.y),temp[1]);
+			is_id[1] = false;
+		}
+		if(std::fabs(rotation.x) > angle_epsilon) {
+			aiMatrix4x4::RotationX(AI_DEG_TO_RAD(rotation.x),temp[0]);
+			is_id[0] = false;
+		}
+
+		int order[3];
+		GetRotationOrder(mode, order);
 
 		if(!is_id[order[0]]) {
 			out = temp[order[0]];
@@ -611,16 +639,15 @@ private:
 
 
 	// ------------------------------------------------------------------------------------------------
-	/** note: memory for output_nodes will be managed by the caller */
-	void GenerateTransformationNodeChain(const Model& model, 
-		std::vector<aiNode*>& output_nodes)
+	/** compute the bind pose matrices for all components of a node's transformation chain,
+	 *  returns true if the node has more than just scaling, rotation and translation */
+	bool GetTransformationChain(const Model& model, aiMatrix4x4 chain[TransformationComp_MAXIMUM])
 	{
 		const PropertyTable& props = model.Props();
 		const Model::RotOrder rot = model.RotationOrder();
 
 		bool ok;
 
-		aiMatrix4x4 chain[TransformationComp_MAXIMUM];
 		std::fill_n(chain, static_cast<unsigned int>(TransformationComp_MAXIMUM), aiMatrix4x4());
 		
 		// generate transformation matrices for all the different transformation components
@@ -705,6 +732,17 @@ private:
 		// or the interplay between this code and the animation converter would
 		// not be guaranteed.
 		ai_assert(NeedsComplexTransformationChain(model) == is_complex);
+		return is_complex;
+	}
+
+
+	// ------------------------------------------------------------------------------------------------
+	/** note: memory for output_nodes will be managed by the caller */
+	void GenerateTransformationNodeChain(const Model& model, 
+		std::vector<aiNode*>& output_nodes)
+	{
+		aiMatrix4x4 chain[TransformationComp_MAXIMUM];
+		const bool is_complex = GetTransformationChain(model, chain);
 
 		const std::string& name = FixNodeName(model.Name());
 
@@ -886,7 +924,25 @@ private:
 	{
 		const MatIndexArray& mindices = mesh.GetMaterialIndices();
 		aiMesh* const out_mesh = SetupEmptyMesh(mesh); 
+		const unsigned int out_index = static_cast<unsigned int>(meshes.size() - 1);
+
+		if(!doc.Settings().readMaterials || mindices.empty()) {
+			FBXImporter::LogError("no material assigned to mesh, setting default material");
+			out_mesh->mMaterialIndex = GetDefaultMaterial();
+		}
+		else {
+			ConvertMaterialForMesh(out_mesh,model,mesh,mindices[0]);
+		}
 
+		QueueMesh(out_mesh, mesh, node_global_transform, NO_MATERIAL_SEPARATION);
+		return out_index;
+	}
+
+
+	// ------------------------------------------------------------------------------------------------
+	void FillMeshSingleMaterial(aiMesh* out_mesh, const MeshGeometry& mesh, 
+		const aiMatrix4x4& node_global_transform)
+	{
 		const std::vector<aiVector3D>& vertices = mesh.GetVertices();
 		const std::vector<unsigned int>& faces = mesh.GetFaceIndexCounts();
 
@@ -992,19 +1048,9 @@ private:
 			std::copy(colors.begin(),colors.end(),out_mesh->mColors[i]);
 		}
 
-		if(!doc.Settings().readMaterials || mindices.empty()) {
-			FBXImporter::LogError("no material assigned to mesh, setting default material");
-			out_mesh->mMaterialIndex = GetDefaultMaterial();
-		}
-		else {
-			ConvertMaterialForMesh(out_mesh,model,mesh,mindices[0]);
-		}
-
 		if(doc.Settings().readWeights && mesh.DeformerSkin() != NULL) {
-			ConvertWeights(out_mesh, model, mesh, node_global_transform, NO_MATERIAL_SEPARATION);
+			ConvertWeights(out_mesh, mesh, node_global_transform, NO_MATERIAL_SEPARATION);
 		}
-
-		return static_cast<unsigned int>(meshes.size() - 1);
 	}
 
 
@@ -1036,7 +1082,20 @@ private:
 		const aiMatrix4x4& node_global_transform)	
 	{
 		aiMesh* const out_mesh = SetupEmptyMesh(mesh);
+		const unsigned int out_index = static_cast<unsigned int>(meshes.size() - 1);
 
+		ConvertMaterialForMesh(out_mesh,model,mesh,index);
+
+		QueueMesh(out_mesh, mesh, node_global_transform, index);
+		return out_index;
+	}
+
+
+	// ------------------------------------------------------------------------------------------------
+	void FillMeshMultiMaterial(aiMesh* out_mesh, const MeshGeometry& mesh, 
+		MatIndexArray::value_type index, 
+		const aiMatrix4x4& node_global_transform)
+	{
 		const MatIndexArray& mindices = mesh.GetMaterialIndices();
 		const std::vector<aiVector3D>& vertices = mesh.GetVertices();
 		const std::vector<unsigned int>& faces = mesh.GetFaceIndexCounts();
@@ -1196,26 +1255,103 @@ private:
 				}
 			}
 		}
-	
-		ConvertMaterialForMesh(out_mesh,model,mesh,index);
 
 		if(process_weights) {
-			ConvertWeights(out_mesh, model, mesh, node_global_transform, index, &reverseMapping);
+			ConvertWeights(out_mesh, mesh, node_global_transform, index, &reverseMapping);
 		}
-
-		return static_cast<unsigned int>(meshes.size() - 1);
 	}
 
 	static const unsigned int NO_MATERIAL_SEPARATION = /* std::numeric_limits<unsigned int>::max() */ 
 		static_cast<unsigned int>(-1);
 
 
+	// ------------------------------------------------------------------------------------------------
+	/** Output mesh whose data is yet to be converted, see ConvertQueuedMeshes() */
+	struct QueuedMesh
+	{
+		aiMesh* out;
+		const MeshGeometry* geo;
+		aiMatrix4x4 node_global_transform;
+
+		// NO_MATERIAL_SEPARATION to take the whole geometry
+		unsigned int materialIndex;
+	};
+
+
+	// ------------------------------------------------------------------------------------------------
+	// defer copying the vertex data and weights of an output mesh until the node graph is complete.
+	// Everything that depends on the order of conversion is resolved here, though.
+	void QueueMesh(aiMesh* out, const MeshGeometry& geo, const aiMatrix4x4& node_global_transform,
+		unsigned int materialIndex)
+	{
+		QueuedMesh qm;
+		qm.out = out;
+		qm.geo = &geo;
+		qm.node_global_transform = node_global_transform;
+		qm.materialIndex = materialIndex;
+		queued_meshes.push_back(qm);
+
+		if(!doc.Settings().readWeights || geo.DeformerSkin() == NULL) {
+			return;
+		}
+
+		// bone names need to go through FixNodeName(), which is stateful
+		BOOST_FOREACH(const Cluster* cluster, geo.DeformerSkin()->Clusters()) {
+			ai_assert(cluster);
+			if (!cluster->GetIndices().empty() && bone_names.find(cluster) == bone_names.end()) {
+				bone_names[cluster] = FixNodeName(cluster->TargetNode()->Name());
+			}
+		}
+
+		// builds a lookup table on first use
+		if (materialIndex != NO_MATERIAL_SEPARATION) {
+			geo.FaceForVertexIndex(0);
+		}
+	}
+
+
+	// ------------------------------------------------------------------------------------------------
+	// Functor to convert the queued meshes with ParallelFor()
+	struct QueuedMeshWorker
+	{
+		QueuedMeshWorker(Converter& conv)
+			: conv(conv)
+		{}
+
+		void operator() (unsigned int i) {
+			const QueuedMesh& qm = conv.queued_meshes[i];
+			if (qm.materialIndex == NO_MATERIAL_SEPARATION) {
+				conv.FillMeshSingleMaterial(qm.out, *qm.geo, qm.node_global_transform);
+			}
+			else {
+				conv.FillMeshMultiMaterial(qm.out, *qm.geo, 
+					static_cast<MatIndexArray::value_type>(qm.materialIndex), 
+					qm.node_global_transform);
+			}
+		}
+
+		Converter& conv;
+	};
+
+
+	// ------------------------------------------------------------------------------------------------
+	// fill all output meshes. Each queued mesh only writes to its own aiMesh, so the order in
+	// which they are processed does not affect the output.
+	void ConvertQueuedMeshes()
+	{
+		QueuedMeshWorker worker(*this);
+		ParallelFor(static_cast<unsigned int>(queued_meshes.size()), worker);
+
+		queued_meshes.clear();
+	}
+
+
 	// ------------------------------------------------------------------------------------------------
 	/** - if materialIndex == NO_MATERIAL_SEPARATION, materials are not taken into
 	 *  account when determining which weights to include.
 	 *  - outputVertStartIndices is only used when a material index is specified, it gives for
 	 *    each output vertex the DOM index it maps to. */
-	void ConvertWeights(aiMesh* out, const Model& model, const MeshGeometry& geo, 
+	void ConvertWeights(aiMesh* out, const MeshGeometry& geo, 
 		const aiMatrix4x4& node_global_transform = aiMatrix4x4(),
 		unsigned int materialIndex = NO_MATERIAL_SEPARATION, 
 		std::vector<unsigned int>* outputVertStartIndices = NULL)
@@ -1300,7 +1436,7 @@ private:
 				// XXX this could be heavily simplified by collecting the bone
 				// data in a single step.
 				if (ok) {
-					ConvertCluster(bones, model, *cluster, out_indices, index_out_indices, 
+					ConvertCluster(bones, *cluster, out_indices, index_out_indices, 
 						count_out_indices, node_global_transform);
 				}
 			}
@@ -1323,7 +1459,7 @@ private:
 
 
 	// ------------------------------------------------------------------------------------------------
-	void ConvertCluster(std::vector<aiBone*>& bones, const Model& /*model*/, const Cluster& cl,
+	void ConvertCluster(std::vector<aiBone*>& bones, const Cluster& cl,
 		std::vector<size_t>& out_indices,
 		std::vector<size_t>& index_out_indices,
 		std::vector<size_t>& count_out_indices,
@@ -1333,7 +1469,10 @@ private:
 		aiBone* const bone = new aiBone();
 		bones.push_back(bone);
 
-		bone->mName = FixNodeName(cl.TargetNode()->Name());
+		// resolved in QueueMesh()
+		const ClusterNameMap::const_iterator it = bone_names.find(&cl);
+		ai_assert(it != bone_names.end());
+		bone->mName.Set((*it).second);
 
 		bone->mOffsetMatrix = cl.TransformLink();
 		bone->mOffsetMatrix.Inverse();
@@ -2011,6 +2150,11 @@ private:
 				node_map[name].push_back(node);
 
 				layer_map[node] = layer;
+
+				// both are resolved from the DOM on first access, which must not 
+				// happen concurrently in GenerateNodeAnimations().
+				node->Curves();
+				ResolveTransformationProperties(*model);
 			}
 		}
 
@@ -2025,20 +2169,22 @@ private:
 		double start_timeF = CONVERT_FBX_TIME(start_time);
 		double stop_timeF = CONVERT_FBX_TIME(stop_time);
 
-		try {
-			BOOST_FOREACH(const NodeMap::value_type& kv, node_map) {
-				GenerateNodeAnimations(node_anims, 
-					kv.first, 
-					kv.second, 
-					layer_map, 
-					start_time, stop_time,
-					max_time, 
-					min_time);
+		NodeAnimationWorker worker(*this, node_map, layer_map, start_time, stop_time);
+		ParallelFor(static_cast<unsigned int>(worker.results.size()), worker);
+
+		// merge in node_map order, same as converting one node after the other
+		NodeMap::const_iterator it = node_map.begin();
+		BOOST_FOREACH(NodeAnimationResult& res, worker.results) {
+			node_anims.insert(node_anims.end(), res.node_anims.begin(), res.node_anims.end());
+			res.node_anims.clear();
+
+			min_time = std::min(min_time, res.min_time);
+			max_time = std::max(max_time, res.max_time);
+
+			if (res.chain_bits) {
+				node_anim_chain_bits[(*it).first] = res.chain_bits;
 			}
-		}
-		catch(std::exception&) {
-			std::for_each(node_anims.begin(), node_anims.end(), Util::delete_fun<aiNodeAnim>());
-			throw;
+			++it;
 		}
 
 		if(node_anims.size()) {
@@ -2081,7 +2227,83 @@ private:
 
 
 	// ------------------------------------------------------------------------------------------------
-	void GenerateNodeAnimations(std::vector<aiNodeAnim*>& node_anims, 
+	/** Output of GenerateNodeAnimations() for a single node */
+	struct NodeAnimationResult
+	{
+		NodeAnimationResult()
+			: min_time(1e10)
+			, max_time(-1e10)
+			, chain_bits()
+		{}
+
+		std::vector<aiNodeAnim*> node_anims;
+		double min_time, max_time;
+		unsigned int chain_bits;
+	};
+
+
+	// ------------------------------------------------------------------------------------------------
+	// Functor to generate the node animations of an AnimationStack with ParallelFor(). Results
+	// are kept per node so they can be merged in a fixed order afterwards.
+	struct NodeAnimationWorker
+	{
+		NodeAnimationWorker(Converter& conv, const NodeMap& node_map, const LayerMap& layer_map,
+			int64_t start, int64_t stop)
+			: conv(conv)
+			, layer_map(layer_map)
+			, start(start)
+			, stop(stop)
+		{
+			nodes.reserve(node_map.size());
+			BOOST_FOREACH(const NodeMap::value_type& kv, node_map) {
+				nodes.push_back(&kv);
+			}
+			results.resize(nodes.size());
+		}
+
+		~NodeAnimationWorker() {
+			BOOST_FOREACH(NodeAnimationResult& res, results) {
+				std::for_each(res.node_anims.begin(), res.node_anims.end(), Util::delete_fun<aiNodeAnim>());
+			}
+		}
+
+		void operator() (unsigned int i) {
+			NodeAnimationResult& res = results[i];
+			res.chain_bits = conv.GenerateNodeAnimations(res.node_anims, 
+				nodes[i]->first, 
+				nodes[i]->second, 
+				layer_map, 
+				start, stop,
+				res.max_time, 
+				res.min_time);
+		}
+
+		Converter& conv;
+		const LayerMap& layer_map;
+		const int64_t start, stop;
+
+		std::vector<const NodeMap::value_type*> nodes;
+		std::vector<NodeAnimationResult> results;
+	};
+
+
+	// ------------------------------------------------------------------------------------------------
+	// PropertyTable parses its entries on first access. Look up everything the node animation
+	// code reads from a node's properties (and their templates) in advance.
+	void ResolveTransformationProperties(const Model& model)
+	{
+		const PropertyTable& props = model.Props();
+		for (size_t i = 0; i < TransformationComp_MAXIMUM; ++i) {
+			props.Get(NameTransformationCompProperty(static_cast<TransformationComp>(i)));
+		}
+		model.RotationOrder();
+	}
+
+
+	// ------------------------------------------------------------------------------------------------
+	// returns the transformation chain components that received animation channels, or 0 if
+	// a single channel was generated for the node.
+	unsigned int GenerateNodeAnimations(std::vector<aiNodeAnim*>& node_anims, 
 		const std::string& fixed_name, 
 		const std::vector<const AnimationCurveNode*>& curves, 
 		const LayerMap& layer_map, 
@@ -2166,7 +2388,7 @@ private:
 
 		if (!has_any) {
 			FBXImporter::LogWarn("ignoring node animation, did not find any transformation key frames");
-			return;
+			return 0;
 		}
 
 		// this needs to play nicely with GenerateTransformationNodeChain() which will
@@ -2191,7 +2413,27 @@ private:
 			else {
 				node_anims.push_back(nd);
 			}
-			return;
+			return 0;
+		}
+
+		// without pivots, GenerateTransformationNodeChain() will collapse the chain
+		// into a single node, so bake the whole chain into a single channel, too.
+		if (!doc.Settings().preservePivots) {
+
+			aiNodeAnim* const nd = GenerateBakedNodeAnim(fixed_name, target, chain, 
+				node_property_map.end(), 
+				start, stop,
+				max_time,
+				min_time);
+
+			ai_assert(nd);
+			if (nd->mNumPositionKeys == 0 && nd->mNumRotationKeys == 0 && nd->mNumScalingKeys == 0) {
+				delete nd;
+			}
+			else {
+				node_anims.push_back(nd);
+			}
+			return 0;
 		}
 
 		// otherwise, things get gruesome and we need separate animation channels
@@ -2321,7 +2563,7 @@ private:
 			}
 		}
 
-		node_anim_chain_bits[fixed_name] = flags;
+		return flags;
 	}
 
 
@@ -2624,8 +2866,142 @@ private:
 
 
 
-	// key (time), value, mapto (component index)
-	typedef boost::tuple<boost::shared_ptr<KeyTimeList>, boost::shared_ptr<KeyValueList>, unsigned int > KeyFrameList;
+	// ------------------------------------------------------------------------------------------------
+	// generate a single node anim for the whole transformation chain of a node by evaluating 
+	// the chain at every key. This is used if pivots are not preserved, in which case 
+	// GenerateTransformationNodeChain() collapses the chain into a single node.
+	aiNodeAnim* GenerateBakedNodeAnim(const std::string& name, 
+		const Model& target, 
+		NodeMap::const_iterator chain[TransformationComp_MAXIMUM], 
+		NodeMap::const_iterator iter_end,
+		int64_t start, int64_t stop,
+		double& max_time,
+		double& min_time)
+	{
+		ScopeGuard<aiNodeAnim> na(new aiNodeAnim());
+		na->mNodeName.Set(name);
+
+		const Model::RotOrder rot = target.RotationOrder();
+
+		// bind pose matrices, these are used for all components without animation
+		aiMatrix4x4 bind_pose[TransformationComp_MAXIMUM];
+		GetTransformationChain(target, bind_pose);
+
+		KeyFrameListList inputs[TransformationComp_MAXIMUM];
+		KeyFrameListList joined;
+		for (size_t i = 0; i < TransformationComp_MAXIMUM; ++i) {
+			if (chain[i] != iter_end) {
+				inputs[i] = GetKeyframeList((*chain[i]).second, start, stop);
+				joined.insert(joined.end(), inputs[i].begin(), inputs[i].end());
+			}
+		}
+
+		if (joined.empty()) {
+			return na.dismiss();
+		}
+
+		const KeyTimeList& times = GetKeyTimeList(joined);
+		const size_t count = times.size();
+
+		// evaluate all animated components at the union of their key times
+		boost::scoped_array<aiVectorKey> values[TransformationComp_MAXIMUM];
+		for (size_t i = 0; i < TransformationComp_MAXIMUM; ++i) {
+			if (inputs[i].empty()) {
+				continue;
+			}
+
+			const TransformationComp comp = static_cast<TransformationComp>(i);
+			values[i].reset(new aiVectorKey[count]);
+			InterpolateKeys(values[i].get(), times, inputs[i], 
+				comp == TransformationComp_Scaling || comp == TransformationComp_GeometricScaling,
+				max_time, 
+				min_time);
+		}
+
+		na->mNumScalingKeys = na->mNumRotationKeys = na->mNumPositionKeys = static_cast<unsigned int>(count);
+		na->mScalingKeys = new aiVectorKey[count];
+		na->mRotationKeys = new aiQuatKey[count];
+		na->mPositionKeys = new aiVectorKey[count];
+
+		aiQuaternion lastq;
+		for (size_t k = 0; k < count; ++k) {
+
+			aiMatrix4x4 mat, temp;
+			for (size_t i = 0; i < TransformationComp_MAXIMUM; ++i) {
+				const TransformationComp comp = static_cast<TransformationComp>(i);
+
+				// the inverse pivots follow the animation of the respective pivot
+				size_t src = i;
+				if (comp == TransformationComp_RotationPivotInverse) {
+					src = TransformationComp_RotationPivot;
+				}
+				else if (comp == TransformationComp_ScalingPivotInverse) {
+					src = TransformationComp_ScalingPivot;
+				}
+
+				if (!values[src].get()) {
+					mat *= bind_pose[i];
+					continue;
+				}
+
+				const aiVector3D& v = values[src][k].mValue;
+				switch(comp) 
+				{
+				case TransformationComp_Rotation:
+				case TransformationComp_PreRotation:
+				case TransformationComp_PostRotation:
+				case TransformationComp_GeometricRotation:
+					GetRotationMatrix(rot, v, temp);
+					break;
+
+				case TransformationComp_Scaling:
+				case TransformationComp_GeometricScaling:
+					aiMatrix4x4::Scaling(v, temp);
+					break;
+
+				case TransformationComp_RotationPivotInverse:
+				case TransformationComp_ScalingPivotInverse:
+					aiMatrix4x4::Translation(-v, temp);
+					break;
+
+				default:
+					aiMatrix4x4::Translation(v, temp);
+				}
+				mat *= temp;
+			}
+
+			const double time = CONVERT_FBX_TIME(times[k]) * anim_fps;
+			na->mScalingKeys[k].mTime = na->mRotationKeys[k].mTime = na->mPositionKeys[k].mTime = time;
+
+			aiQuaternion& quat = na->mRotationKeys[k].mValue;
+			mat.Decompose(na->mScalingKeys[k].mValue, quat, na->mPositionKeys[k].mValue);
+
+			// take shortest path, see InterpolateKeys()
+			if (quat.x * lastq.x + quat.y * lastq.y + quat.z * lastq.z + quat.w * lastq.w < 0) {
+				quat.x = -quat.x;
+				quat.y = -quat.y;
+				quat.z = -quat.z;
+				quat.w = -quat.w;
+			}
+			lastq = quat;
+		}
+
+		return na.dismiss();
+	}
+
+
+	// keys of a single animation curve that fall into the time window of an animation stack.
+	// Times and values are not copied, they point into the curve's own arrays.
+	struct KeyFrameList
+	{
+		const int64_t* times;
+		const float* values;
+		size_t count;
+
+		// component index (x,y,z)
+		unsigned int mapto;
+	};
+
 	typedef std::vector<KeyFrameList> KeyFrameListList;
 
 	
@@ -2662,25 +3038,27 @@ private:
 				}
 
 				const AnimationCurve* const curve = kv.second;
-				ai_assert(curve->GetKeys().size() == curve->GetValues().size() && curve->GetKeys().size());
-
-				//get values within the start/stop time window
-				boost::shared_ptr<KeyTimeList> Keys(new KeyTimeList());
-				boost::shared_ptr<KeyValueList> Values(new KeyValueList());
-				const int count = curve->GetKeys().size();
-				Keys->reserve(count);
-				Values->reserve(count);
-				for (int n = 0; n < count; n++)
-				{
-					int64_t k = curve->GetKeys().at(n);
-					if (k >= adj_start && k <= adj_stop)
-					{
-						Keys->push_back(k);
-						Values->push_back(curve->GetValues().at(n));
-					}
+				const KeyTimeList& keys = curve->GetKeys();
+				const KeyValueList& values = curve->GetValues();
+				ai_assert(keys.size() == values.size() && keys.size());
+
+				// the key times are strictly ascending (see AnimationCurve), so the keys 
+				// within the start/stop time window form a contiguous range.
+				const KeyTimeList::const_iterator first = std::lower_bound(keys.begin(), keys.end(), adj_start);
+				const KeyTimeList::const_iterator last = std::upper_bound(first, keys.end(), adj_stop);
+				if (first == last) {
+					continue;
 				}
 
-				inputs.push_back(boost::make_tuple(Keys, Values, mapto));
+				const size_t offset = static_cast<size_t>(std::distance(keys.begin(), first));
+
+				KeyFrameList kfl;
+				kfl.times = &keys[offset];
+				kfl.values = &values[offset];
+				kfl.count = static_cast<size_t>(std::distance(first, last));
+				kfl.mapto = mapto;
+
+				inputs.push_back(kfl);
 			}
 		}
 		return inputs; // pray for NRVO :-)
@@ -2690,8 +3068,6 @@ private:
 	// ------------------------------------------------------------------------------------------------
 	KeyTimeList GetKeyTimeList(const KeyFrameListList& inputs)
 	{
-		ai_assert(inputs.size());
-
 		// reserve some space upfront - it is likely that the keyframe lists
 		// have matching time values, so max(of all keyframe lists) should 
 		// be a good estimate.
@@ -2699,40 +3075,46 @@ private:
 		
 		size_t estimate = 0;
 		BOOST_FOREACH(const KeyFrameList& kfl, inputs) {
-			estimate = std::max(estimate, kfl.get<0>()->size());
+			estimate = std::max(estimate, kfl.count);
 		}
 
 		keys.reserve(estimate);
 
-		std::vector<unsigned int> next_pos;
-		next_pos.resize(inputs.size(),0);
-
-		const size_t count = inputs.size();
-		while(true) {
+		// k-way merge of the sorted input lists: keep the next key time of each
+		// list in a min-heap, so every input key is visited exactly once.
+		typedef std::pair<int64_t, size_t> HeapEntry;
+		typedef std::greater<HeapEntry> HeapOrder;
 
-			int64_t min_tick = std::numeric_limits<int64_t>::max();
-			for (size_t i = 0; i < count; ++i) {
-				const KeyFrameList& kfl = inputs[i];
+		std::vector<HeapEntry> heap;
+		heap.reserve(inputs.size());
 
-				if (kfl.get<0>()->size() > next_pos[i] && kfl.get<0>()->at(next_pos[i]) < min_tick) {
-					min_tick = kfl.get<0>()->at(next_pos[i]);
-				}
-			}
+		std::vector<size_t> next_pos(inputs.size(),0);
 
-			if (min_tick == std::numeric_limits<int64_t>::max()) {
-				break;
+		for (size_t i = 0, count = inputs.size(); i < count; ++i) {
+			if (inputs[i].count) {
+				heap.push_back(HeapEntry(inputs[i].times[0], i));
 			}
-			keys.push_back(min_tick);
+		}
+		std::make_heap(heap.begin(), heap.end(), HeapOrder());
 
-			for (size_t i = 0; i < count; ++i) {
-				const KeyFrameList& kfl = inputs[i];
+		while(!heap.empty()) {
+			std::pop_heap(heap.begin(), heap.end(), HeapOrder());
+			HeapEntry& next = heap.back();
 
+			// the output is ascending, so duplicates are always adjacent
+			if (keys.empty() || keys.back() != next.first) {
+				keys.push_back(next.first);
+			}
 
-				while(kfl.get<0>()->size() > next_pos[i] && kfl.get<0>()->at(next_pos[i]) == min_tick) {
-					++next_pos[i];
-				}
+			const KeyFrameList& kfl = inputs[next.second];
+			if (++next_pos[next.second] < kfl.count) {
+				next.first = kfl.times[next_pos[next.second]];
+				std::push_heap(heap.begin(), heap.end(), HeapOrder());
+			}
+			else {
+				heap.pop_back();
 			}
-		}	
+		}
 
 		return keys;
 	}
@@ -2748,7 +3130,9 @@ private:
 		ai_assert(keys.size());
 		ai_assert(valOut);
 
-		std::vector<unsigned int> next_pos;
+		// keys are ascending, so each input only needs a cursor that moves forward
+		// to the first key after the current time.
+		std::vector<size_t> next_pos;
 		const size_t count = inputs.size();
 
 		next_pos.resize(inputs.size(),0);
@@ -2762,31 +3146,33 @@ private:
 			for (size_t i = 0; i < count; ++i) {
 				const KeyFrameList& kfl = inputs[i];
 
-				const size_t ksize = kfl.get<0>()->size();
-				if (ksize > next_pos[i] && kfl.get<0>()->at(next_pos[i]) == time) {
-					++next_pos[i]; 
+				const size_t ksize = kfl.count;
+				size_t& pos = next_pos[i];
+				while (pos < ksize && kfl.times[pos] <= time) {
+					++pos; 
 				}
 
-				const size_t id0 = next_pos[i]>0 ? next_pos[i]-1 : 0;
-				const size_t id1 = next_pos[i]==ksize ? ksize-1 : next_pos[i];
+				const size_t id0 = pos>0 ? pos-1 : 0;
+				const size_t id1 = pos==ksize ? ksize-1 : pos;
 
 				// use lerp for interpolation
-				const KeyValueList::value_type valueA = kfl.get<1>()->at(id0);
-				const KeyValueList::value_type valueB = kfl.get<1>()->at(id1);
+				const KeyValueList::value_type valueA = kfl.values[id0];
+				const KeyValueList::value_type valueB = kfl.values[id1];
 
-				const KeyTimeList::value_type timeA = kfl.get<0>()->at(id0);
-				const KeyTimeList::value_type timeB = kfl.get<0>()->at(id1);
+				const KeyTimeList::value_type timeA = kfl.times[id0];
+				const KeyTimeList::value_type timeB = kfl.times[id1];
 
 				// do the actual interpolation in double-precision arithmetics
 				// because it is a bit sensitive to rounding errors.
-				const double factor = timeB == timeA ? 0. : static_cast<double>((time - timeA) / (timeB - timeA));
+				const double factor = timeB == timeA ? 0. : 
+					static_cast<double>(time - timeA) / static_cast<double>(timeB - timeA);
 				const float interpValue = static_cast<float>(valueA + (valueB - valueA) * factor);
 
 				if(geom) {
-					result[kfl.get<2>()] *= interpValue;
+					result[kfl.mapto] *= interpValue;
 				}
 				else {
-					result[kfl.get<2>()] += interpValue;
+					result[kfl.mapto] += interpValue;
 				}
 			}
 
@@ -2818,17 +3204,13 @@ private:
 		boost::scoped_array<aiVectorKey> temp(new aiVectorKey[keys.size()]);
 		InterpolateKeys(temp.get(),keys,inputs,geom,maxTime, minTime);
 
-		aiMatrix4x4 m;
-
 		aiQuaternion lastq;
 
 		for (size_t i = 0, c = keys.size(); i < c; ++i) {
 
 			valOut[i].mTime = temp[i].mTime;
 
-			
-			GetRotationMatrix(order, temp[i].mValue, m);
-			aiQuaternion quat = aiQuaternion(aiMatrix3x3(m));
+			aiQuaternion quat = EulerToQuaternion(temp[i].mValue, order);
 
 			// take shortest path by checking the inner product
 			// http://www.3dkingdoms.com/weekly/weekly.php?a=36
@@ -2860,6 +3242,8 @@ private:
 		const aiVector3D& def_translate,
 		const aiQuaternion& def_rotation)
 	{
+		// note: FBX composes Lcl Translation * Lcl Rotation * Lcl Scaling, which is what
+		// aiNodeAnim means, too - so the interpolated keys can be used as they are.
 		if (rotation.size()) {
 			InterpolateKeys(out_quat, times, rotation, false, maxTime, minTime, order);
 		}
@@ -2889,31 +3273,36 @@ private:
 				out_translation[i].mValue = def_translate;
 			}
 		}
-
-		const size_t count = times.size();
-		for (size_t i = 0; i < count; ++i) {
-			aiQuaternion& r = out_quat[i].mValue;
-			aiVector3D& s = out_scale[i].mValue;
-			aiVector3D& t = out_translation[i].mValue;
-
-			aiMatrix4x4 mat, temp;
-			aiMatrix4x4::Translation(t, mat);
-			mat *= aiMatrix4x4( r.GetMatrix() );
-			mat *= aiMatrix4x4::Scaling(s, temp);
-
-			mat.Decompose(s, r, t);
-		}
 	}
 
 
 	// ------------------------------------------------------------------------------------------------
-	// euler xyz -> quat
+	// euler xyz -> quat, composes the per-axis rotations directly instead of going
+	// through GetRotationMatrix() and a matrix -> quaternion conversion.
 	aiQuaternion EulerToQuaternion(const aiVector3D& rot, Model::RotOrder order) 
 	{
-		aiMatrix4x4 m;
-		GetRotationMatrix(order, rot, m);
+		if(order == Model::RotOrder_SphericXYZ) {
+			FBXImporter::LogError("Unsupported RotationMode: SphericXYZ");
+			return aiQuaternion();
+		}
+
+		const float angle_epsilon = 1e-6f;
+
+		aiQuaternion axis[3];
+		if(std::fabs(rot.z) > angle_epsilon) {
+			axis[2] = aiQuaternion(aiVector3D(0.f,0.f,1.f),AI_DEG_TO_RAD(rot.z));
+		}
+		if(std::fabs(rot.y) > angle_epsilon) {
+			axis[1] = aiQuaternion(aiVector3D(0.f,1.f,0.f),AI_DEG_TO_RAD(rot.y));
+		}
+		if(std::fabs(rot.x) > angle_epsilon) {
+			axis[0] = aiQuaternion(aiVector3D(1.f,0.f,0.f),AI_DEG_TO_RAD(rot.x));
+		}
+
+		int rot_order[3];
+		GetRotationOrder(order, rot_order);
 
-		return aiQuaternion(aiMatrix3x3(m));
+		return axis[rot_order[0]] * axis[rot_order[1]] * axis[rot_order[2]];
 	}
 
 
@@ -3044,6 +3433,12 @@ private:
 	typedef std::map<const Geometry*, std::vector<unsigned int> > MeshMap;
 	MeshMap meshes_converted;
 
+	std::vector<QueuedMesh> queued_meshes;
+
+	// FixNodeName() result for the target node of each skin cluster
+	typedef std::map<const Cluster*, std::string> ClusterNameMap;
+	ClusterNameMap bone_names;
+
 	// fixed node name -> which trafo chain components have animations?
 	typedef std::map<std::string, unsigned int> NodeAnimBitMap;
 	NodeAnimBitMap node_anim_chain_bits;
@@ -3059,14 +3454,16 @@ private:
 
 	aiScene* const out;
 	const FBX::Document& doc;
+	const AtomicFlag* const cancel;
 };
 
 //} // !anon
 
 // ------------------------------------------------------------------------------------------------
-void ConvertToAssimpScene(aiScene* out, const Document& doc)
+void ConvertToAssimpScene(aiScene* out, const Document& doc, const AtomicFlag* cancel)
 {
-	Converter converter(out,doc);
+	Converter converter(out,doc,cancel);
+	converter.Convert();
 }
 
 } // !FBX
@@ -47,6 +47,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 struct aiScene;
 
 namespace Assimp {
+
+class AtomicFlag;
+
 namespace FBX {
 
 	class Document;
@@ -54,8 +57,10 @@ namespace FBX {
 
 /** Convert a FBX #Document to #aiScene
  *  @param out Empty scene to be populated
- *  @param doc Parsed FBX document */
-void ConvertToAssimpScene(aiScene* out, const Document& doc);
+ *  @param doc Parsed FBX document
+ *  @param cancel Checked between the conversion phases, may be NULL
+ *  @throw DeadlyImportError if the import is cancelled */
+void ConvertToAssimpScene(aiScene* out, const Document& doc, const AtomicFlag* cancel = NULL);
 
 
 }
@@ -109,8 +109,9 @@ struct ImportSettings
 	/** preserve transformation pivots and offsets. Since these can
 	 *  not directly be represented in assimp, additional dummy
 	 *  nodes will be generated. Note that settings this to false
-	 *  can make animation import a lot slower. The default value
-	 *  is true.
+	 *  can make animation import a lot slower, the node animations
+	 *  are then baked by evaluating the full chain at every key.
+	 *  The default value is true.
 	 *
 	 *  The naming scheme for the generated nodes is:
 	 *    <OriginalName>_$AssimpFbx$_<TransformName>
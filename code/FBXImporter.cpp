@@ -58,6 +58,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "StreamReader.h"
 #include "MemoryIOWrapper.h"
+#include "ProgressReporter.h"
 #include "../include/assimp/Importer.hpp"
 
 namespace Assimp {
@@ -150,10 +151,11 @@ void FBXImporter::InternReadFile( const std::string& pFile,
 	// then becomes very large, too. Assimp doesn't support
 	// streaming for its output data structures so the net win with
 	// streaming input data would be very low.
-	std::vector<char> contents;
-	contents.resize(stream->FileSize());
+	// the ASCII tokenizer runs until it hits a terminating zero.
+	const size_t size = stream->FileSize();
+	std::vector<char> contents(size+1,'\0');
 
-	stream->Read(&*contents.begin(),contents.size(),1);
+	stream->Read(&*contents.begin(),size,1);
 	const char* const begin = &*contents.begin();
 
 	// broadphase tokenizing pass in which we identify the core
@@ -161,24 +163,30 @@ void FBXImporter::InternReadFile( const std::string& pFile,
 	TokenList tokens;
 	try {
 
+		// tokenizing is reported as the file reading phase, the import
+		// may be cancelled during it and between all later phases.
+		ProgressReporter reporter(progress, cancel, size);
+
 		bool is_binary = false;
 		if (!strncmp(begin,"Kaydara FBX Binary",18)) {
 			is_binary = true;
-			TokenizeBinary(tokens,begin,contents.size());
+			TokenizeBinary(tokens,begin,size,&reporter);
 		}
 		else {
-			Tokenize(tokens,begin);
+			Tokenize(tokens,begin,&reporter);
 		}
 
 		// use this information to construct a very rudimentary 
 		// parse-tree representing the FBX scope structure
 		Parser parser(tokens, is_binary);
+		ThrowIfCancelled(cancel);
 
 		// take the raw parse-tree and convert it to a FBX DOM
 		Document doc(parser,settings);
+		ThrowIfCancelled(cancel);
 
 		// convert the FBX DOM to aiScene
-		ConvertToAssimpScene(pScene,doc);
+		ConvertToAssimpScene(pScene,doc,cancel);
 
 		std::for_each(tokens.begin(),tokens.end(),Util::delete_fun<Token>());
 	}
@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXTokenizer.h"
 #include "FBXUtil.h"
 #include "Exceptional.h"
+#include "ProgressReporter.h"
 
 namespace Assimp {
 namespace FBX {
@@ -132,7 +133,7 @@ void ProcessDataToken( TokenList& output_tokens, const char*& start, const char*
 }
 
 // ------------------------------------------------------------------------------------------------
-void Tokenize(TokenList& output_tokens, const char* input)
+void Tokenize(TokenList& output_tokens, const char* input, ProgressReporter* progress)
 {
 	ai_assert(input);
 
@@ -148,6 +149,10 @@ void Tokenize(TokenList& output_tokens, const char* input)
 	for (const char* cur = input;*cur;column += (*cur == '\t' ? ASSIMP_FBX_TAB_WIDTH : 1), ++cur) {
 		const char c = *cur;
 
+		if (progress) {
+			progress->Update(cur - input);
+		}
+
 		if (IsLineEnd(c)) {
 			comment = false;
 
@@ -51,6 +51,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 
 namespace Assimp {
+
+class ProgressReporter;
+
 namespace FBX {
 
 /** Rough classification for text FBX tokens used for constructing the
@@ -171,8 +174,9 @@ typedef std::vector< TokenPtr > TokenList;
  *
  * @param output_tokens Receives a list of all tokens in the input data.
  * @param input_buffer Textual input buffer to be processed, 0-terminated.
- * @throw DeadlyImportError if something goes wrong */
-void Tokenize(TokenList& output_tokens, const char* input);
+ * @param progress Receives the offset of the tokenizer, may be NULL
+ * @throw DeadlyImportError if something goes wrong or the import is cancelled */
+void Tokenize(TokenList& output_tokens, const char* input, ProgressReporter* progress = NULL);
 
 
 /** Tokenizer function for binary FBX files.
@@ -182,8 +186,9 @@ void Tokenize(TokenList& output_tokens, const char* input);
  * @param output_tokens Receives a list of all tokens in the input data.
  * @param input_buffer Binary input buffer to be processed.
  * @param length Length of input buffer, in bytes. There is no 0-terminal.
- * @throw DeadlyImportError if something goes wrong */
-void TokenizeBinary(TokenList& output_tokens, const char* input, unsigned int length);
+ * @param progress Receives the offset of the tokenizer, may be NULL
+ * @throw DeadlyImportError if something goes wrong or the import is cancelled */
+void TokenizeBinary(TokenList& output_tokens, const char* input, unsigned int length, ProgressReporter* progress = NULL);
 
 
 } // ! FBX
@@ -66,6 +66,10 @@ public:
 	// Check whether step is active
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "FindDegeneratesProcess"; }
+
 	// -------------------------------------------------------------------
 	// Execute step on a given scene
 	void Execute( aiScene* pScene);
@@ -44,8 +44,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 
-#include "FindInstancesProcess.h"
-#include <boost/scoped_array.hpp>
+#include "FindInstancesProcess.h"
+#include "ParallelFor.h"
+#include "Hash.h"
+#include "ProgressReporter.h"
+#include <boost/scoped_array.hpp>
 #include <stdio.h>
 
 using namespace Assimp;
@@ -54,6 +57,7 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 FindInstancesProcess::FindInstancesProcess()
 :	configSpeedFlag (false)
+,	configTransformInvariant (false)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -76,8 +80,32 @@ void FindInstancesProcess::SetupProperties(const Importer* pImp)
 {
 	// AI_CONFIG_FAVOUR_SPEED
 	configSpeedFlag = (0 != pImp->GetPropertyInteger(AI_CONFIG_FAVOUR_SPEED,0));
+
+	// AI_CONFIG_PP_FI_TRANSFORM_INVARIANT
+	configTransformInvariant = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_FI_TRANSFORM_INVARIANT,0));
 }
 
+// ------------------------------------------------------------------------------------------------
+// Functor to compute the hashes of all meshes with ParallelFor()
+namespace {
+struct MeshHasher
+{
+	MeshHasher(aiMesh** meshes, uint64_t* hashes)
+		: meshes(meshes), hashes(hashes)
+	{}
+
+	void operator() (unsigned int i)
+	{
+		// the topology hash is invariant to transformations, so the same buckets
+		// can be used to look for rigidly transformed copies of a mesh.
+		hashes[i] = GetMeshHash(meshes[i]) ^ ((uint64_t)GetMeshTopologyHash(meshes[i]) << 7u);
+	}
+
+	aiMesh** meshes;
+	uint64_t* hashes;
+};
+} // ! anon namespace
+
 // ------------------------------------------------------------------------------------------------
 // Compare the bones of two meshes
 bool CompareBones(const aiMesh* orig, const aiMesh* inst)
@@ -102,15 +130,231 @@ bool CompareBones(const aiMesh* orig, const aiMesh* inst)
 	return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Compute the rigid transformation which maps the vertices of one mesh onto another
+bool ComputeRigidTransform(const aiMesh* orig, const aiMesh* inst, float epsilon, aiMatrix4x4& out)
+{
+	const unsigned int num = orig->mNumVertices;
+	if (num < 3) {
+		return false;
+	}
+
+	// build an orthonormal frame from the centroid and two vertices, the one farthest
+	// from the centroid and the one spanning the largest triangle with it. Using the
+	// same vertex indices in both meshes yields the rotation between them.
+	aiVector3D co, ci;
+	for (unsigned int i = 0; i < num; ++i) {
+		co += orig->mVertices[i];
+		ci += inst->mVertices[i];
+	}
+	co /= (float)num;
+	ci /= (float)num;
+
+	unsigned int a = 0;
+	float best = 0.f;
+	for (unsigned int i = 0; i < num; ++i) {
+		const float d = (orig->mVertices[i] - co).SquareLength();
+		if (d > best) {
+			best = d;
+			a = i;
+		}
+	}
+	const aiVector3D ea = orig->mVertices[a] - co;
+
+	unsigned int b = 0;
+	best = 0.f;
+	for (unsigned int i = 0; i < num; ++i) {
+		const float d = (ea ^ (orig->mVertices[i] - co)).SquareLength();
+		if (d > best) {
+			best = d;
+			b = i;
+		}
+	}
+	if (best <= epsilon * ea.SquareLength()) {
+		// all vertices are collinear, the rotation is not unique
+		return false;
+	}
+
+	const aiVector3D fa = inst->mVertices[a] - ci;
+	const aiVector3D e1 = aiVector3D(ea).Normalize();
+	const aiVector3D e3 = (ea ^ (orig->mVertices[b] - co)).Normalize();
+	const aiVector3D e2 = e3 ^ e1;
+	const aiVector3D f1 = aiVector3D(fa).Normalize();
+	const aiVector3D f3 = (fa ^ (inst->mVertices[b] - ci)).Normalize();
+	const aiVector3D f2 = f3 ^ f1;
+
+	// R = F * E^T
+	const aiMatrix3x3 rot = aiMatrix3x3(
+		f1.x, f2.x, f3.x,
+		f1.y, f2.y, f3.y,
+		f1.z, f2.z, f3.z) * aiMatrix3x3(
+		e1.x, e1.y, e1.z,
+		e2.x, e2.y, e2.z,
+		e3.x, e3.y, e3.z);
+	const aiVector3D t = ci - rot * co;
+
+	out = aiMatrix4x4(rot);
+	out.a4 = t.x;
+	out.b4 = t.y;
+	out.c4 = t.z;
+
+	// and check whether it maps all vertices
+	for (unsigned int i = 0; i < num; ++i) {
+		if ((out * orig->mVertices[i] - inst->mVertices[i]).SquareLength() >= epsilon) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compare an array of directions after applying a rotation to the first one
+bool CompareRotatedArrays(const aiMatrix3x3& rot, const aiVector3D* first, const aiVector3D* second,
+	unsigned int size, float e)
+{
+	for (const aiVector3D* end = first+size; first != end; ++first,++second) {
+		if ( (rot * *first - *second).SquareLength() >= e)
+			return false;
+	}
+	return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Update mesh indices in the node graph
-void UpdateMeshIndices(aiNode* node, unsigned int* lookup)
+void UpdateMeshIndices(aiNode* node, unsigned int* lookup, const std::vector<aiMatrix4x4>& transforms)
 {
-	for (unsigned int n = 0; n < node->mNumMeshes;++n)
-		node->mMeshes[n] = lookup[node->mMeshes[n]];
+	const unsigned int numChildren = node->mNumChildren;
+
+	unsigned int numKept = 0;
+	for (unsigned int n = 0; n < node->mNumMeshes;++n) {
+		const unsigned int idx = node->mMeshes[n];
+		if (transforms.empty() || transforms[idx] == aiMatrix4x4()) {
+			node->mMeshes[numKept++] = lookup[idx];
+			continue;
+		}
+
+		// a rigidly transformed copy of another mesh. Reference the original
+		// from a child node which carries the transformation.
+		aiNode* child = new aiNode();
+		child->mParent = node;
+		child->mName = node->mName;
+		child->mName.Append("_instance");
+		child->mTransformation = transforms[idx];
+		child->mMeshes = new unsigned int[child->mNumMeshes = 1];
+		child->mMeshes[0] = lookup[idx];
+
+		aiNode** children = new aiNode*[node->mNumChildren+1];
+		if (node->mNumChildren) {
+			::memcpy(children,node->mChildren,sizeof(aiNode*)*node->mNumChildren);
+		}
+		children[node->mNumChildren++] = child;
+		delete[] node->mChildren;
+		node->mChildren = children;
+	}
+	if (numKept != node->mNumMeshes) {
+		node->mNumMeshes = numKept;
+		if (!numKept) {
+			delete[] node->mMeshes;
+			node->mMeshes = NULL;
+		}
+	}
 
-	for (unsigned int n = 0; n < node->mNumChildren;++n)
-		UpdateMeshIndices(node->mChildren[n],lookup);
+	for (unsigned int n = 0; n < numChildren;++n)
+		UpdateMeshIndices(node->mChildren[n],lookup,transforms);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Check whether two meshes are equal
+bool FindInstancesProcess::IsInstance(const aiMesh* orig, const aiMesh* inst, aiMatrix4x4* transform) const
+{
+	// check for hash collision .. we needn't check
+	// the vertex format, it *must* match due to the
+	// (brilliant) construction of the hash
+	if (orig->mNumBones       != inst->mNumBones      ||
+		orig->mNumFaces       != inst->mNumFaces      ||
+		orig->mNumVertices    != inst->mNumVertices   ||
+		orig->mMaterialIndex  != inst->mMaterialIndex ||
+		orig->mPrimitiveTypes != inst->mPrimitiveTypes)
+		return false;
+
+	// up to now the meshes are equal. find an appropriate
+	// epsilon to compare position differences against
+	float epsilon = ComputePositionEpsilon(inst);
+	epsilon *= epsilon;
+
+	// now compare vertex positions, normals,
+	// tangents and bitangents using this epsilon.
+	if (orig->HasPositions()) {
+		if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon)) {
+
+			// not at the same place, but maybe the same shape. Skinned meshes
+			// are excluded, their bones would need to be transformed as well.
+			if (!transform || orig->HasBones() || !ComputeRigidTransform(orig,inst,epsilon,*transform))
+				return false;
+		}
+	}
+
+	const aiMatrix3x3 rot = transform ? aiMatrix3x3(*transform) : aiMatrix3x3();
+	if (orig->HasNormals()) {
+		if(!CompareRotatedArrays(rot,orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
+			return false;
+	}
+	if (orig->HasTangentsAndBitangents()) {
+		if (!CompareRotatedArrays(rot,orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
+			!CompareRotatedArrays(rot,orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
+			return false;
+	}
+
+	// use a constant epsilon for colors and UV coordinates
+	static const float uvEpsilon = 10e-4f;
+	for (unsigned int i = 0, end = orig->GetNumUVChannels(); i < end; ++i) {
+		if (!orig->mTextureCoords[i]) {
+			continue;
+		}
+		if(!CompareArrays(orig->mTextureCoords[i],inst->mTextureCoords[i],orig->mNumVertices,uvEpsilon)) {
+			return false;
+		}
+	}
+	for (unsigned int i = 0, end = orig->GetNumColorChannels(); i < end; ++i) {
+		if (!orig->mColors[i]) {
+			continue;
+		}
+		if(!CompareArrays(orig->mColors[i],inst->mColors[i],orig->mNumVertices,uvEpsilon)) {
+			return false;
+		}
+	}
+
+	// These two checks are actually quite expensive and almost *never* required.
+	// Almost. That's why they're still here. But there's no reason to do them
+	// in speed-targeted imports.
+	if (!configSpeedFlag) {
+
+		// It seems to be strange, but we really need to check whether the
+		// bones are identical too. Although it's extremely unprobable
+		// that they're not if control reaches here, we need to deal
+		// with unprobable cases, too. It could still be that there are
+		// equal shapes which are deformed differently.
+		if (!CompareBones(orig,inst))
+			return false;
+
+		// For completeness ... compare even the index buffers for equality
+		// face order & winding order doesn't care. Input data is in verbose format.
+		boost::scoped_array<unsigned int> ftbl_orig(new unsigned int[orig->mNumVertices]);
+		boost::scoped_array<unsigned int> ftbl_inst(new unsigned int[orig->mNumVertices]);
+
+		for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
+			aiFace& f = orig->mFaces[tt];
+			for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
+				ftbl_orig[f.mIndices[nn]] = tt;
+
+			aiFace& f2 = inst->mFaces[tt];
+			for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
+				ftbl_inst[f2.mIndices[nn]] = tt;
+		}
+		if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
+			return false;
+	}
+	return true;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -120,135 +364,61 @@ void FindInstancesProcess::Execute( aiScene* pScene)
 	DefaultLogger::get()->debug("FindInstancesProcess begin");
 	if (pScene->mNumMeshes) {
 
-		// use a pseudo hash for all meshes in the scene to quickly find 
-		// the ones which are possibly equal. This step is executed early 
-		// in the pipeline, so we could, depending on the file format,
-		// have several thousand small meshes. That's too much for a brute
-		// everyone-against-everyone check involving up to 10 comparisons
-		// each.
+		// use a hash for all meshes in the scene to quickly find the ones
+		// which are possibly equal. This step is executed early in the
+		// pipeline, so we could, depending on the file format, have several
+		// thousand small meshes. That's too much for a brute everyone-against-
+		// everyone check involving up to 10 comparisons each, so meshes are
+		// only compared against earlier meshes with the same hash.
 		boost::scoped_array<uint64_t> hashes (new uint64_t[pScene->mNumMeshes]);
 		boost::scoped_array<unsigned int> remapping (new unsigned int[pScene->mNumMeshes]);
 
-		unsigned int numMeshesOut = 0;
+		MeshHasher hasher(pScene->mMeshes,hashes.get());
+		ParallelFor(pScene->mNumMeshes,hasher);
+
+		// rigid transformation of each mesh relative to its original, if any
+		std::vector<aiMatrix4x4> transforms;
+		if (configTransformInvariant) {
+			transforms.resize(pScene->mNumMeshes);
+		}
+
+		typedef std::map<uint64_t, std::vector<unsigned int> > CandidateMap;
+		CandidateMap candidates;
+
+		ProgressReporter reporter = GetProgressReporter(pScene->mNumMeshes);
+		unsigned int numMeshesOut = 0, numRigid = 0;
 		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			reporter.Update(i);
 
 			aiMesh* inst = pScene->mMeshes[i];
-			hashes[i] = GetMeshHash(inst);
-
-			for (int a = i-1; a >= 0; --a) {
-				if (hashes[i] == hashes[a])
-				{
-					aiMesh* orig = pScene->mMeshes[a];
-					if (!orig)
-						continue;
-					
-					// check for hash collision .. we needn't check
-					// the vertex format, it *must* match due to the
-					// (brilliant) construction of the hash
-					if (orig->mNumBones       != inst->mNumBones      ||
-						orig->mNumFaces       != inst->mNumFaces      ||
-						orig->mNumVertices    != inst->mNumVertices   ||
-						orig->mMaterialIndex  != inst->mMaterialIndex ||
-						orig->mPrimitiveTypes != inst->mPrimitiveTypes)
-						continue;
-
-					// up to now the meshes are equal. find an appropriate
-					// epsilon to compare position differences against
-					float epsilon = ComputePositionEpsilon(inst);
-					epsilon *= epsilon;
-
-					// now compare vertex positions, normals,
-					// tangents and bitangents using this epsilon.
-					if (orig->HasPositions()) {
-						if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
-							continue;
-					}
-					if (orig->HasNormals()) {
-						if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
-							continue;
-					}
-					if (orig->HasTangentsAndBitangents()) {
-						if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
-							!CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
-							continue;
-					}
-
-					// use a constant epsilon for colors and UV coordinates
-					static const float uvEpsilon = 10e-4f;
-					{
-						unsigned int i, end = orig->GetNumUVChannels();
-						for(i = 0; i < end; ++i) {
-							if (!orig->mTextureCoords[i]) {
-								continue;
-							}
-							if(!CompareArrays(orig->mTextureCoords[i],inst->mTextureCoords[i],orig->mNumVertices,uvEpsilon)) {
-								break;	
-							}
-						}
-						if (i != end) {
-							continue;
-						}
-					}
-					{
-						unsigned int i, end = orig->GetNumColorChannels();
-						for(i = 0; i < end; ++i) {
-							if (!orig->mColors[i]) {
-								continue;
-							}
-							if(!CompareArrays(orig->mColors[i],inst->mColors[i],orig->mNumVertices,uvEpsilon)) {
-								break;	
-							}
-						}
-						if (i != end) {
-							continue;
-						}
-					}
-
-					// These two checks are actually quite expensive and almost *never* required.
-					// Almost. That's why they're still here. But there's no reason to do them
-					// in speed-targeted imports.
-					if (!configSpeedFlag) {
-
-						// It seems to be strange, but we really need to check whether the
-						// bones are identical too. Although it's extremely unprobable
-						// that they're not if control reaches here, we need to deal
-						// with unprobable cases, too. It could still be that there are
-						// equal shapes which are deformed differently.
-						if (!CompareBones(orig,inst))
-							continue;
-
-						// For completeness ... compare even the index buffers for equality
-						// face order & winding order doesn't care. Input data is in verbose format.
-						boost::scoped_array<unsigned int> ftbl_orig(new unsigned int[orig->mNumVertices]);
-						boost::scoped_array<unsigned int> ftbl_inst(new unsigned int[orig->mNumVertices]);
-
-						for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
-							aiFace& f = orig->mFaces[tt];
-							for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
-								ftbl_orig[f.mIndices[nn]] = tt;
-
-							aiFace& f2 = inst->mFaces[tt];
-							for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
-								ftbl_inst[f2.mIndices[nn]] = tt;
-						}
-						if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
-							continue;
-					}
-
-					// We're still here. Or in other words: 'inst' is an instance of 'orig'.
-					// Place a marker in our list that we can easily update mesh indices.
-					remapping[i] = remapping[a];
-
-					// Delete the instanced mesh, we don't need it anymore
-					delete inst;
-					pScene->mMeshes[i] = NULL;
-					break;
+			std::vector<unsigned int>& bucket = candidates[hashes[i]];
+
+			// check the most recent candidates first
+			for (std::vector<unsigned int>::reverse_iterator it = bucket.rbegin(); it != bucket.rend(); ++it) {
+				const unsigned int a = *it;
+
+				aiMatrix4x4 transform;
+				if (!IsInstance(pScene->mMeshes[a],inst,configTransformInvariant ? &transform : NULL))
+					continue;
+
+				// We're still here. Or in other words: 'inst' is an instance of 'orig'.
+				// Place a marker in our list that we can easily update mesh indices.
+				remapping[i] = remapping[a];
+				if (transform != aiMatrix4x4()) {
+					transforms[i] = transform;
+					++numRigid;
 				}
+
+				// Delete the instanced mesh, we don't need it anymore
+				delete inst;
+				pScene->mMeshes[i] = NULL;
+				break;
 			}
 
 			// If we didn't find a match for the current mesh: keep it
 			if (pScene->mMeshes[i]) {
 				remapping[i] = numMeshesOut++;
+				bucket.push_back(i);
 			}
 		}
 		ai_assert(0 != numMeshesOut);
@@ -261,13 +431,14 @@ void FindInstancesProcess::Execute( aiScene* pScene)
 			}
 
 			// And update the node graph with our nice lookup table
-			UpdateMeshIndices(pScene->mRootNode,remapping.get());
+			UpdateMeshIndices(pScene->mRootNode,remapping.get(),transforms);
 
 			// write to log
 			if (!DefaultLogger::isNullLogger()) {
 			
 				char buffer[512];
-				::sprintf(buffer,"FindInstancesProcess finished. Found %i instances",pScene->mNumMeshes-numMeshesOut);
+				::sprintf(buffer,"FindInstancesProcess finished. Found %i instances (%i rigidly transformed)",
+					pScene->mNumMeshes-numMeshesOut,numRigid);
 				DefaultLogger::get()->info(buffer); 
 			}
 			pScene->mNumMeshes = numMeshesOut;
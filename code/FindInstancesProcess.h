@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseProcess.h"
 #include "ProcessHelper.h"
+#include "Hash.h"
 
 class FindInstancesProcessTest;
 namespace Assimp	{
@@ -72,6 +73,28 @@ inline uint64_t GetMeshHash(aiMesh* in)
 		(in->mPrimitiveTypes<<28)) & 0xffffffff );
 }
 
+// -------------------------------------------------------------------------------
+/** @brief Get a hash of the face index data of a mesh.
+ *
+ *  Unlike the vertex data, the topology of a mesh is not affected by
+ *  transformations, so rigidly transformed copies of a mesh share this hash.
+ *  @param in Input mesh
+ *  @return Hash. 
+ */
+inline uint32_t GetMeshTopologyHash(const aiMesh* in) 
+{
+	ai_assert(NULL != in);
+
+	uint32_t hash = in->mNumFaces;
+	for (unsigned int i = 0; i < in->mNumFaces; ++i) {
+		const aiFace& f = in->mFaces[i];
+		if (f.mNumIndices) {
+			hash = SuperFastHash(reinterpret_cast<const char*>(f.mIndices),f.mNumIndices*sizeof(unsigned int),hash);
+		}
+	}
+	return hash;
+}
+
 // -------------------------------------------------------------------------------
 /** @brief Perform a component-wise comparison of two arrays
  *
@@ -105,7 +128,7 @@ inline bool CompareArrays(const aiColor4D* first, const aiColor4D* second,
 // ---------------------------------------------------------------------------
 /** @brief A post-processing steps to search for instanced meshes
 */
-class FindInstancesProcess : public BaseProcess
+class ASSIMP_API FindInstancesProcess : public BaseProcess
 {
 public:
 
@@ -117,6 +140,10 @@ public:
 	// Check whether step is active in given flags combination
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "FindInstancesProcess"; }
+
 	// -------------------------------------------------------------------
 	// Execute step on a given scene
 	void Execute( aiScene* pScene);
@@ -125,9 +152,24 @@ public:
 	// Setup properties prior to executing the process
 	void SetupProperties(const Importer* pImp);
 
+	// -------------------------------------------------------------------
+	/** @brief Toggle the detection of rigidly transformed copies,
+	 *  see #AI_CONFIG_PP_FI_TRANSFORM_INVARIANT.
+	 */
+	void SetTransformInvariant(bool d) {
+		configTransformInvariant = d;
+	}
+
 private:
 
+	// -------------------------------------------------------------------
+	// Check whether 'inst' is an instance of 'orig'. If 'transform' is
+	// not NULL, rigidly transformed copies are accepted as well and the
+	// transformation from 'orig' to 'inst' is returned.
+	bool IsInstance(const aiMesh* orig, const aiMesh* inst, aiMatrix4x4* transform) const;
+
 	bool configSpeedFlag;
+	bool configTransformInvariant;
 
 }; // ! end class FindInstancesProcess
 }  // ! end namespace Assimp
@@ -70,6 +70,10 @@ public:
 	// 
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "FindInvalidDataProcess"; }
+
 	// -------------------------------------------------------------------
 	// Setup import settings
 	void SetupProperties(const Importer* pImp);
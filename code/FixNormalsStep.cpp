@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../include/assimp/postprocess.h"
 #include "../include/assimp/scene.h"
 #include <stdio.h>
+#include <algorithm>
 
 
 using namespace Assimp;
@@ -78,12 +79,41 @@ bool FixInfacingNormalsProcess::IsActive( unsigned int pFlags) const
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FixInfacingNormalsProcess::Execute( aiScene* pScene)
+{
+	ExecuteMeshByMesh(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+void FixInfacingNormalsProcess::GetDataAccess( unsigned int& read, unsigned int& write) const
+{
+	read = PPData_Positions | PPData_Normals | PPData_Faces;
+	write = PPData_Normals | PPData_Faces;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool FixInfacingNormalsProcess::IsPerMesh() const
+{
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FixInfacingNormalsProcess::BeginMeshes( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("FixInfacingNormalsProcess begin");
+	meshResults.assign(pScene->mNumMeshes,0);
+}
 
-	bool bHas = false;
-	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-		if(ProcessMesh( pScene->mMeshes[a],a))bHas = true;
+// ------------------------------------------------------------------------------------------------
+void FixInfacingNormalsProcess::ExecuteForMesh( aiScene* pScene, unsigned int meshIndex)
+{
+	meshResults[meshIndex] = ProcessMesh( pScene->mMeshes[meshIndex],meshIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+void FixInfacingNormalsProcess::EndMeshes( aiScene* /*pScene*/)
+{
+	const bool bHas = std::find(meshResults.begin(),meshResults.end(),1) != meshResults.end();
+	meshResults.clear();
 
 	if (bHas)
 		 DefaultLogger::get()->debug("FixInfacingNormalsProcess finished. Found issues.");
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_FIXNORMALSPROCESS_H_INC
 
 #include "BaseProcess.h"
+#include <vector>
 
 struct aiMesh;
 
@@ -71,6 +72,18 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "FixInfacingNormalsProcess"; }
+
+	// -------------------------------------------------------------------
+	/** Per-mesh execution, see BaseProcess::IsPerMesh() */
+	void GetDataAccess( unsigned int& read, unsigned int& write) const;
+	bool IsPerMesh() const;
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteForMesh( aiScene* pScene, unsigned int meshIndex);
+	void EndMeshes( aiScene* pScene);
+
 	// -------------------------------------------------------------------
 	/** Executes the post processing step on the given imported data.
 	* At the moment a process is not supposed to fail.
@@ -85,6 +98,11 @@ protected:
 	 * @param pMesh The mesh to process.
 	 */
 	bool ProcessMesh( aiMesh* pMesh, unsigned int index);
+
+private:
+
+	/** Results of the meshes processed by ExecuteForMesh() */
+	std::vector<unsigned char> meshResults;
 };
 
 } // end of namespace Assimp
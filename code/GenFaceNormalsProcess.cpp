@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../include/assimp/DefaultLogger.hpp"
 #include "Exceptional.h"
 #include "qnan.h"
+#include <algorithm>
 
 
 using namespace Assimp;
@@ -78,19 +79,46 @@ bool GenFaceNormalsProcess::IsActive( unsigned int pFlags) const
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void GenFaceNormalsProcess::Execute( aiScene* pScene)
+{
+	ExecuteMeshByMesh(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenFaceNormalsProcess::GetDataAccess( unsigned int& read, unsigned int& write) const
+{
+	read = PPData_Positions | PPData_Faces | PPData_SceneFlags;
+	write = PPData_Normals;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenFaceNormalsProcess::IsPerMesh() const
+{
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenFaceNormalsProcess::BeginMeshes( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("GenFaceNormalsProcess begin");
 
 	if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) {
 		throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
 	}
+	meshResults.assign(pScene->mNumMeshes,0);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenFaceNormalsProcess::ExecuteForMesh( aiScene* pScene, unsigned int meshIndex)
+{
+	meshResults[meshIndex] = GenMeshFaceNormals( pScene->mMeshes[meshIndex]);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenFaceNormalsProcess::EndMeshes( aiScene* /*pScene*/)
+{
+	const bool bHas = std::find(meshResults.begin(),meshResults.end(),1) != meshResults.end();
+	meshResults.clear();
 
-	bool bHas = false;
-	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)	{
-		if(this->GenMeshFaceNormals( pScene->mMeshes[a])) {
-			bHas = true;
-		}
-	}
 	if (bHas)	{
 		DefaultLogger::get()->info("GenFaceNormalsProcess finished. "
 			"Face normals have been calculated");
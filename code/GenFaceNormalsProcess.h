@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_GENFACENORMALPROCESS_H_INC
 
 #include "BaseProcess.h"
+#include <vector>
 #include "../include/assimp/mesh.h"
 
 namespace Assimp
@@ -67,6 +68,18 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "GenFaceNormalsProcess"; }
+
+	// -------------------------------------------------------------------
+	/** Per-mesh execution, see BaseProcess::IsPerMesh() */
+	void GetDataAccess( unsigned int& read, unsigned int& write) const;
+	bool IsPerMesh() const;
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteForMesh( aiScene* pScene, unsigned int meshIndex);
+	void EndMeshes( aiScene* pScene);
+
 	// -------------------------------------------------------------------
 	/** Executes the post processing step on the given imported data.
 	* At the moment a process is not supposed to fail.
@@ -77,6 +90,9 @@ public:
 
 private:
 	bool GenMeshFaceNormals (aiMesh* pcMesh);
+
+	/** Results of the meshes processed by ExecuteForMesh() */
+	std::vector<unsigned char> meshResults;
 };
 
 } // end of namespace Assimp
@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "Exceptional.h"
 #include "qnan.h"
+#include <algorithm>
 
 using namespace Assimp;
 
@@ -86,18 +87,45 @@ void GenVertexNormalsProcess::SetupProperties(const Importer* pImp)
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void GenVertexNormalsProcess::Execute( aiScene* pScene)
+{
+	ExecuteMeshByMesh(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenVertexNormalsProcess::GetDataAccess( unsigned int& read, unsigned int& write) const
+{
+	read = PPData_Positions | PPData_Faces | PPData_SceneFlags;
+	write = PPData_Normals;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenVertexNormalsProcess::IsPerMesh() const
+{
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenVertexNormalsProcess::BeginMeshes( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("GenVertexNormalsProcess begin");
 
 	if (pScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT)
 		throw DeadlyImportError("Post-processing order mismatch: expecting pseudo-indexed (\"verbose\") vertices here");
 
-	bool bHas = false;
-	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-	{
-        if(GenMeshVertexNormals( pScene->mMeshes[a],a))
-			bHas = true;
-	}
+	meshResults.assign(pScene->mNumMeshes,0);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenVertexNormalsProcess::ExecuteForMesh( aiScene* pScene, unsigned int meshIndex)
+{
+	meshResults[meshIndex] = GenMeshVertexNormals( pScene->mMeshes[meshIndex],meshIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenVertexNormalsProcess::EndMeshes( aiScene* /*pScene*/)
+{
+	const bool bHas = std::find(meshResults.begin(),meshResults.end(),1) != meshResults.end();
+	meshResults.clear();
 
 	if (bHas)	{
 		DefaultLogger::get()->info("GenVertexNormalsProcess finished. "
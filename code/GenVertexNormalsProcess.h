@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_GENVERTEXNORMALPROCESS_H_INC
 
 #include "BaseProcess.h"
+#include <vector>
 #include "../include/assimp/mesh.h"
 
 class GenNormalsTest;
@@ -69,6 +70,18 @@ public:
 	*   false if not.
 	*/
 	bool IsActive( unsigned int pFlags) const;
+
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "GenVertexNormalsProcess"; }
+
+	// -------------------------------------------------------------------
+	/** Per-mesh execution, see BaseProcess::IsPerMesh() */
+	void GetDataAccess( unsigned int& read, unsigned int& write) const;
+	bool IsPerMesh() const;
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteForMesh( aiScene* pScene, unsigned int meshIndex);
+	void EndMeshes( aiScene* pScene);
 	
 	// -------------------------------------------------------------------
 	/** Called prior to ExecuteOnScene().
@@ -105,6 +118,9 @@ private:
 
 	/** Configuration option: maximum smoothing angle, in radians*/
 	float configMaxAngle;
+
+	/** Results of the meshes processed by ExecuteForMesh() */
+	std::vector<unsigned char> meshResults;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,431 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file Implementation of the post processing step to partition meshes into meshlets.
+ * <br>
+ * Meshlets are grown greedily: starting from a seed triangle, the step keeps
+ * adding the adjacent triangle which introduces the fewest new vertices until
+ * one of the limits is reached. Seeds are taken along a z-order curve over
+ * the face centroids, so meshlets of disconnected parts stay compact, too.
+ */
+
+// internal headers
+#include "GenerateMeshletsProcess.h"
+#include "VertexTriangleAdjacency.h"
+#include "ProcessHelper.h"
+#include "ParallelFor.h"
+#include "../include/assimp/postprocess.h"
+#include "../include/assimp/scene.h"
+#include "../include/assimp/DefaultLogger.hpp"
+#include <stdio.h>
+
+using namespace Assimp;
+
+namespace {
+
+// Number of faces along the z-order curve considered if a meshlet has no adjacent faces left
+const unsigned int SeedWindow = 8;
+
+// ------------------------------------------------------------------------------------------------
+// Squared distance of the centroid of a triangle to a point
+inline float FaceDistance(const aiMesh* pMesh, unsigned int f, const aiVector3D& p)
+{
+	const unsigned int* idx = pMesh->mFaces[f].mIndices;
+	return ((pMesh->mVertices[idx[0]] + pMesh->mVertices[idx[1]] + pMesh->mVertices[idx[2]]) / 3.f - p).SquareLength();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compute the bounding sphere of a set of vertices (Ritter's algorithm)
+void ComputeBoundingSphere(const aiVector3D* pcVertices, const std::vector<unsigned int>& vIndices,
+	aiVector3D& center, float& radius)
+{
+	// pick the point farthest away from an arbitrary point, and the point
+	// farthest away from that one. These are the initial diameter.
+	const aiVector3D& first = pcVertices[vIndices[0]];
+	aiVector3D a = first, b = first;
+	float fMax = 0.f;
+	for (std::vector<unsigned int>::const_iterator it = vIndices.begin(); it != vIndices.end(); ++it) {
+		const float d = (pcVertices[*it] - first).SquareLength();
+		if (d > fMax) {
+			fMax = d;
+			a = pcVertices[*it];
+		}
+	}
+	fMax = 0.f;
+	for (std::vector<unsigned int>::const_iterator it = vIndices.begin(); it != vIndices.end(); ++it) {
+		const float d = (pcVertices[*it] - a).SquareLength();
+		if (d > fMax) {
+			fMax = d;
+			b = pcVertices[*it];
+		}
+	}
+
+	center = (a + b) * 0.5f;
+	radius = (b - a).Length() * 0.5f;
+
+	// grow the sphere to include all points outside
+	for (std::vector<unsigned int>::const_iterator it = vIndices.begin(); it != vIndices.end(); ++it) {
+		const aiVector3D& p = pcVertices[*it];
+		const float d = (p - center).Length();
+		if (d > radius) {
+			const float r = (radius + d) * 0.5f;
+			center += (p - center) * ((r - radius) / d);
+			radius = r;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compute the normal cone of a range of triangles
+void ComputeNormalCone(const aiMesh* pMesh, const std::vector<unsigned int>& vFaces,
+	unsigned int iBegin, unsigned int iEnd, aiVector3D& axis, float& cutoff)
+{
+	std::vector<aiVector3D> normals;
+	normals.reserve(iEnd - iBegin);
+
+	aiVector3D sum;
+	for (unsigned int i = iBegin; i < iEnd; ++i) {
+		const aiFace& face = pMesh->mFaces[vFaces[i]];
+		const aiVector3D& v0 = pMesh->mVertices[face.mIndices[0]];
+		const aiVector3D& v1 = pMesh->mVertices[face.mIndices[1]];
+		const aiVector3D& v2 = pMesh->mVertices[face.mIndices[2]];
+
+		aiVector3D n = (v1 - v0) ^ (v2 - v0);
+		const float l = n.Length();
+		if (l <= 1e-30f) {
+			// degenerate triangles have no facing
+			continue;
+		}
+		n /= l;
+		normals.push_back(n);
+		sum += n;
+	}
+
+	const float l = sum.Length();
+	if (normals.empty() || l <= 1e-6f) {
+		axis = aiVector3D();
+		cutoff = -1.f;
+		return;
+	}
+
+	axis = sum / l;
+	cutoff = 1.f;
+	for (std::vector<aiVector3D>::const_iterator it = normals.begin(); it != normals.end(); ++it) {
+		cutoff = std::min(cutoff, *it * axis);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Functor to process all meshes of a scene with ParallelFor()
+struct MeshletWorker
+{
+	MeshletWorker(const GenerateMeshletsProcess* process, aiScene* scene, std::vector<unsigned char>& done)
+		: process(process), scene(scene), done(&done)
+	{}
+
+	void operator() (unsigned int i)
+	{
+		(*done)[i] = process->ProcessMesh(scene->mMeshes[i]) ? 1 : 0;
+	}
+
+	const GenerateMeshletsProcess* process;
+	aiScene* scene;
+	std::vector<unsigned char>* done;
+};
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+// Constructor to be privately used by Importer
+GenerateMeshletsProcess::GenerateMeshletsProcess()
+	: configMaxVertices(AI_GM_DEFAULT_MAX_VERTICES)
+	, configMaxTriangles(AI_GM_DEFAULT_MAX_TRIANGLES)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+// Destructor, private as well
+GenerateMeshletsProcess::~GenerateMeshletsProcess()
+{
+	// nothing to do here
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool GenerateMeshletsProcess::IsActive( unsigned int pFlags) const
+{
+	return (pFlags & aiProcess_GenerateMeshlets) != 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration
+void GenerateMeshletsProcess::SetupProperties(const Importer* pImp)
+{
+	configMaxVertices = pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_VERTICES,AI_GM_DEFAULT_MAX_VERTICES);
+	configMaxTriangles = pImp->GetPropertyInteger(AI_CONFIG_PP_GM_MAX_TRIANGLES,AI_GM_DEFAULT_MAX_TRIANGLES);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void GenerateMeshletsProcess::Execute( aiScene* pScene)
+{
+	if (!pScene->mNumMeshes) {
+		DefaultLogger::get()->debug("GenerateMeshletsProcess skipped; there are no meshes");
+		return;
+	}
+
+	DefaultLogger::get()->debug("GenerateMeshletsProcess begin");
+
+	std::vector<unsigned char> done(pScene->mNumMeshes,0);
+	MeshletWorker worker(this,pScene,done);
+	ParallelFor(pScene->mNumMeshes,worker);
+
+	unsigned int numm = 0, nump = 0;
+	for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+		if (done[a]) {
+			nump += pScene->mMeshes[a]->mNumMeshlets;
+			++numm;
+		}
+		else if (pScene->mMeshes[a]->HasFaces()) {
+			DefaultLogger::get()->warn("GenerateMeshletsProcess: skipping a mesh which is not a pure triangle mesh");
+		}
+	}
+	if (!DefaultLogger::isNullLogger()) {
+		char szBuff[128]; // should be sufficiently large in every case
+		::sprintf(szBuff,"GenerateMeshletsProcess finished. Generated %u meshlets for %u meshes",nump,numm);
+		DefaultLogger::get()->info(szBuff);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Partitions a specific mesh into meshlets
+bool GenerateMeshletsProcess::ProcessMesh( aiMesh* pMesh) const
+{
+	ai_assert(NULL != pMesh);
+
+	// Check whether the input data is valid
+	// - there must be vertices and faces 
+	// - all faces must be triangulated or we can't operate on them
+	if (!pMesh->HasFaces() || !pMesh->HasPositions() || pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+		return false;
+	}
+
+	// drop old meshlets, if any
+	delete[] pMesh->mMeshlets;
+	pMesh->mMeshlets = NULL;
+	pMesh->mNumMeshlets = 0;
+
+	const unsigned int iMaxVertices = std::max(configMaxVertices,3u);
+	const unsigned int iMaxTriangles = std::max(configMaxTriangles,1u);
+	const unsigned int iNumFaces = pMesh->mNumFaces;
+
+	VertexTriangleAdjacency adj(pMesh->mFaces,iNumFaces,pMesh->mNumVertices,true);
+
+	// seeds for new meshlets, along a z-order curve
+	std::vector<unsigned int> vSeeds;
+	ComputeMortonFaceOrder(pMesh,vSeeds);
+	unsigned int iSeedCursor = 0;
+
+	std::vector<bool> abEmitted(iNumFaces,false);
+
+	// the vertex stamp is the index of the last meshlet using the vertex
+	std::vector<unsigned int> vStamp(pMesh->mNumVertices,UINT_MAX);
+
+	// output: new face order, plus per meshlet its face range and vertex range
+	std::vector<unsigned int> vFaceOrder;
+	vFaceOrder.reserve(iNumFaces);
+	std::vector<unsigned int> vMeshletVertices;
+	std::vector<unsigned int> vMeshletFaceStart, vMeshletVertexStart;
+
+	std::vector<unsigned int> vCandidates;
+	unsigned int iMeshlet = 0, iCurFaces = 0, iCurVertices = 0;
+	aiVector3D vSum;
+
+	vMeshletFaceStart.push_back(0);
+	vMeshletVertexStart.push_back(0);
+
+	while (vFaceOrder.size() < iNumFaces) {
+
+		// find the adjacent face which needs the fewest new vertices, ties
+		// are broken by the distance to the center of the meshlet
+		const aiVector3D vCenter = iCurVertices ? vSum / (float)iCurVertices : aiVector3D();
+		unsigned int iBest = UINT_MAX, iBestNeed = 4;
+		float fBestDist = 0.f;
+		for (size_t c = 0; c < vCandidates.size();) {
+			const unsigned int f = vCandidates[c];
+			if (abEmitted[f]) {
+				vCandidates[c] = vCandidates.back();
+				vCandidates.pop_back();
+				continue;
+			}
+
+			const unsigned int* idx = pMesh->mFaces[f].mIndices;
+			const unsigned int iNeed = (vStamp[idx[0]] != iMeshlet) + (vStamp[idx[1]] != iMeshlet) + (vStamp[idx[2]] != iMeshlet);
+			if (iNeed <= iBestNeed) {
+				const float fDist = FaceDistance(pMesh,f,vCenter);
+				if (iNeed < iBestNeed || fDist < fBestDist) {
+					iBest = f;
+					iBestNeed = iNeed;
+					fBestDist = fDist;
+				}
+			}
+			++c;
+		}
+
+		if (iBest == UINT_MAX) {
+			// nothing adjacent left, take the face closest to the center of the
+			// meshlet among the next few along the curve. It is added to the current
+			// meshlet if it is close to it, so meshes without shared vertices (e.g.
+			// non-indexed ones) still get full meshlets rather than one per triangle.
+			// Faces further away start a new meshlet to keep meshlets compact.
+			while (abEmitted[vSeeds[iSeedCursor]]) {
+				++iSeedCursor;
+			}
+			iBest = vSeeds[iSeedCursor];
+			iBestNeed = iCurVertices ? UINT_MAX : 3;
+
+			if (iCurVertices) {
+				fBestDist = FaceDistance(pMesh,iBest,vCenter);
+				for (unsigned int s = iSeedCursor + 1, n = 1; s < iNumFaces && n < SeedWindow; ++s) {
+					const unsigned int f = vSeeds[s];
+					if (abEmitted[f]) {
+						continue;
+					}
+					const float fDist = FaceDistance(pMesh,f,vCenter);
+					if (fDist < fBestDist) {
+						iBest = f;
+						fBestDist = fDist;
+					}
+					++n;
+				}
+
+				// squared radius of the meshlet so far
+				float fRadius = 0.f;
+				for (size_t v = vMeshletVertexStart.back(); v < vMeshletVertices.size(); ++v) {
+					fRadius = std::max(fRadius,(pMesh->mVertices[vMeshletVertices[v]] - vCenter).SquareLength());
+				}
+				if (fBestDist <= fRadius * 4.f) {
+					iBestNeed = 3;
+				}
+			}
+		}
+
+		if (iBestNeed == UINT_MAX || iCurVertices + iBestNeed > iMaxVertices) {
+			// the face doesn't fit - close the meshlet and let the face seed the 
+			// next one, which will thus be adjacent to the current one
+			vMeshletFaceStart.push_back((unsigned int)vFaceOrder.size());
+			vMeshletVertexStart.push_back((unsigned int)vMeshletVertices.size());
+			vCandidates.clear();
+			++iMeshlet;
+			iCurFaces = iCurVertices = 0;
+			vSum = aiVector3D();
+		}
+
+		// add the face to the current meshlet
+		abEmitted[iBest] = true;
+		vFaceOrder.push_back(iBest);
+		++iCurFaces;
+
+		const aiFace& face = pMesh->mFaces[iBest];
+		for (unsigned int n = 0; n < 3; ++n) {
+			const unsigned int iIndex = face.mIndices[n];
+			if (vStamp[iIndex] == iMeshlet) {
+				continue;
+			}
+			vStamp[iIndex] = iMeshlet;
+			vMeshletVertices.push_back(iIndex);
+			vSum += pMesh->mVertices[iIndex];
+			++iCurVertices;
+
+			// all unprocessed faces sharing the vertex are candidates now
+			const unsigned int* piAdj = adj.GetAdjacentTriangles(iIndex);
+			const unsigned int iNumAdj = adj.GetNumTrianglesPtr(iIndex);
+			for (unsigned int k = 0; k < iNumAdj; ++k) {
+				if (!abEmitted[piAdj[k]]) {
+					vCandidates.push_back(piAdj[k]);
+				}
+			}
+		}
+
+		if (iCurFaces == iMaxTriangles && vFaceOrder.size() < iNumFaces) {
+			vMeshletFaceStart.push_back((unsigned int)vFaceOrder.size());
+			vMeshletVertexStart.push_back((unsigned int)vMeshletVertices.size());
+			vCandidates.clear();
+			++iMeshlet;
+			iCurFaces = iCurVertices = 0;
+			vSum = aiVector3D();
+		}
+	}
+	vMeshletFaceStart.push_back(iNumFaces);
+	vMeshletVertexStart.push_back((unsigned int)vMeshletVertices.size());
+
+	// setup the output meshlets
+	pMesh->mNumMeshlets = iMeshlet + 1;
+	pMesh->mMeshlets = new aiMeshlet[pMesh->mNumMeshlets];
+	for (unsigned int i = 0; i < pMesh->mNumMeshlets; ++i) {
+		aiMeshlet& out = pMesh->mMeshlets[i];
+		out.mFaceOffset = vMeshletFaceStart[i];
+		out.mNumFaces = vMeshletFaceStart[i+1] - vMeshletFaceStart[i];
+
+		const std::vector<unsigned int> vVertices(vMeshletVertices.begin() + vMeshletVertexStart[i],
+			vMeshletVertices.begin() + vMeshletVertexStart[i+1]);
+
+		out.mNumVertices = (unsigned int)vVertices.size();
+		out.mVertices = new unsigned int[out.mNumVertices];
+		::memcpy(out.mVertices,&vVertices[0],out.mNumVertices * sizeof(unsigned int));
+
+		ComputeBoundingSphere(pMesh->mVertices,vVertices,out.mCenter,out.mRadius);
+		ComputeNormalCone(pMesh,vFaceOrder,vMeshletFaceStart[i],vMeshletFaceStart[i+1],
+			out.mConeAxis,out.mConeCutoff);
+	}
+
+	// and reorder the faces. The index arrays are moved, not copied.
+	aiFace* pcNewFaces = new aiFace[iNumFaces];
+	for (unsigned int i = 0; i < iNumFaces; ++i) {
+		aiFace& src = pMesh->mFaces[vFaceOrder[i]];
+		pcNewFaces[i].mNumIndices = src.mNumIndices;
+		pcNewFaces[i].mIndices = src.mIndices;
+		src.mIndices = NULL;
+	}
+	delete[] pMesh->mFaces;
+	pMesh->mFaces = pcNewFaces;
+	return true;
+}
@@ -0,0 +1,115 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file Defines a post processing step to partition meshes into meshlets */
+#ifndef AI_GENERATEMESHLETSPROCESS_H_INC
+#define AI_GENERATEMESHLETSPROCESS_H_INC
+
+#include "BaseProcess.h"
+#include "../include/assimp/types.h"
+
+struct aiMesh;
+
+namespace Assimp
+{
+
+// ---------------------------------------------------------------------------
+/** The GenerateMeshletsProcess partitions each triangle mesh into meshlets,
+ *  small clusters of adjacent triangles with a bounded number of vertices
+ *  and triangles. The faces of the mesh are reordered so each meshlet
+ *  is a consecutive face range. Bounding spheres and normal cones are
+ *  computed for each meshlet. Meshes are processed in parallel.
+ *
+ *  @note This step expects triangulated input data.
+ */
+class ASSIMP_API GenerateMeshletsProcess : public BaseProcess
+{
+public:
+
+	GenerateMeshletsProcess();
+	~GenerateMeshletsProcess();
+
+public:
+
+	// -------------------------------------------------------------------
+	// Check whether the pp step is active
+	bool IsActive( unsigned int pFlags) const;
+
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "GenerateMeshletsProcess"; }
+
+	// -------------------------------------------------------------------
+	// Executes the pp step on a given scene
+	void Execute( aiScene* pScene);
+
+	// -------------------------------------------------------------------
+	// Configures the pp step
+	void SetupProperties(const Importer* pImp);
+
+	// -------------------------------------------------------------------
+	//! Set the meshlet limits - needed for unit testing
+	void SetLimits(unsigned int maxVertices, unsigned int maxTriangles) {
+		configMaxVertices = maxVertices;
+		configMaxTriangles = maxTriangles;
+	}
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Partitions a single mesh into meshlets. Safe to be called
+	 *  concurrently for different meshes.
+	 * @param pMesh The mesh to process.
+	 * @return false if the mesh is not suitable (i.e. not triangulated)
+	 */
+	bool ProcessMesh( aiMesh* pMesh) const;
+
+private:
+	//! Configuration parameter: maximum number of vertices per meshlet
+	unsigned int configMaxVertices;
+
+	//! Configuration parameter: maximum number of triangles per meshlet
+	unsigned int configMaxTriangles;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_GENERATEMESHLETSPROCESS_H_INC
@@ -91,15 +91,22 @@ bool HMPImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler, bool
 
 	// if check for extension is not enough, check for the magic tokens 
 	if (!extension.length() || cs) {
-		uint32_t tokens[3]; 
-		tokens[0] = AI_HMP_MAGIC_NUMBER_LE_4;
-		tokens[1] = AI_HMP_MAGIC_NUMBER_LE_5;
-		tokens[2] = AI_HMP_MAGIC_NUMBER_LE_7;
-		return CheckMagicToken(pIOHandler,pFile,tokens,3,0);
+		return CheckMagicTokens(pIOHandler,pFile);
 	}
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens checked by CanRead()
+void HMPImporter::GetMagicTokens(std::vector<MagicToken>& tokens) const
+{
+	uint32_t magic[3]; 
+	magic[0] = AI_HMP_MAGIC_NUMBER_LE_4;
+	magic[1] = AI_HMP_MAGIC_NUMBER_LE_5;
+	magic[2] = AI_HMP_MAGIC_NUMBER_LE_7;
+	AddMagicTokens(tokens,magic,3,0);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get list of all file extensions that are handled by this loader
 const aiImporterDesc* HMPImporter::GetInfo () const
@@ -76,6 +76,11 @@ public:
 	bool CanRead( const std::string& pFile, IOSystem* pIOHandler, 
 		bool checkSig) const;
 
+	// -------------------------------------------------------------------
+	/** Returns the magic tokens checked by CanRead().
+	 * See BaseImporter::GetMagicTokens() for details. */
+	void GetMagicTokens(std::vector<MagicToken>& tokens) const;
+
 protected:
 
 
@@ -50,7 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/tuple/tuple.hpp>
 
 #ifndef ASSIMP_BUILD_NO_COMPRESSED_IFC
-#	include "../contrib/unzip/unzip.h"
+#	include "ZipArchiveIOSystem.h"
 #endif
 
 #include "IFCLoader.h"
@@ -170,66 +170,39 @@ void IFCImporter::SetupProperties(const Importer* pImp)
 void IFCImporter::InternReadFile( const std::string& pFile, 
 	aiScene* pScene, IOSystem* pIOHandler)
 {
+#ifndef ASSIMP_BUILD_NO_COMPRESSED_IFC
+	// declared first so it outlives any stream opened from it
+	boost::scoped_ptr<ZipArchiveIOSystem> zip;
+#endif
 	boost::shared_ptr<IOStream> stream(pIOHandler->Open(pFile));
 	if (!stream) {
 		ThrowException("Could not open file for reading");
 	}
 
 
-	// if this is a ifczip file, decompress its contents first
+	// if this is a ifczip file, read the IFC member from the archive instead
 	if(GetExtension(pFile) == "ifczip") {
 #ifndef ASSIMP_BUILD_NO_COMPRESSED_IFC
-		unzFile zip = unzOpen( pFile.c_str() );
-		if(zip == NULL) {
+		stream.reset();
+		zip.reset(new ZipArchiveIOSystem(pIOHandler, pFile));
+		if(!zip->isOpen()) {
 			ThrowException("Could not open ifczip file for reading, unzip failed");
 		}
 
-		// chop 'zip' postfix
-		std::string fileName = pFile.substr(0,pFile.length() - 3);
-
-		std::string::size_type s = pFile.find_last_of('\\');
-		if(s == std::string::npos) {
-			s = pFile.find_last_of('/');
-		}
-		if(s != std::string::npos) {
-			fileName = fileName.substr(s+1);
-		}
-
-		// search file (same name as the IFCZIP except for the file extension) and place file pointer there
-		if(UNZ_OK == unzGoToFirstFile(zip)) {
-			do {
-				// get file size, etc.
-				unz_file_info fileInfo;
-				char filename[256];
-				unzGetCurrentFileInfo( zip , &fileInfo, filename, sizeof(filename), 0, 0, 0, 0 );
-				if (GetExtension(filename) != "ifc") {
-					continue;
-				}
-				uint8_t* buff = new uint8_t[fileInfo.uncompressed_size];
+		// pick the first IFC file member, entries are decompressed as they are read
+		std::vector<std::string> fileList;
+		zip->getFileList(fileList);
+		for(std::vector<std::string>::const_iterator it = fileList.begin(); it != fileList.end(); ++it) {
+			if (GetExtension(*it) == "ifc") {
 				LogInfo("Decompressing IFCZIP file");
-				unzOpenCurrentFile( zip  );
-				const int ret = unzReadCurrentFile( zip, buff, fileInfo.uncompressed_size);
-				size_t filesize = fileInfo.uncompressed_size;
-				if ( ret < 0 || size_t(ret) != filesize )
-				{
-					delete[] buff;
-					ThrowException("Failed to decompress IFC ZIP file");
-				}
-				unzCloseCurrentFile( zip );
-				stream.reset(new MemoryIOStream(buff,fileInfo.uncompressed_size,true));
+				stream.reset(zip->Open((*it).c_str()));
 				break;
-
-				if (unzGoToNextFile(zip) == UNZ_END_OF_LIST_OF_FILE) {
-					ThrowException("Found no IFC file member in IFCZIP file (1)");
-				}
-
-			} while(true);
-		}
-		else {
-			ThrowException("Found no IFC file member in IFCZIP file (2)");
+			}
 		}
 
-		unzClose(zip);
+		if (!stream) {
+			ThrowException("Found no IFC file member in IFCZIP file");
+		}
 #else
 		ThrowException("Could not open ifczip file for reading, assimp was built without ifczip support");
 #endif
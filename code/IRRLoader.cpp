@@ -345,9 +345,10 @@ void IRRImporter::ComputeAnimations(Node* root, aiNode* real, std::vector<aiNode
 		if (cur != total-1)	{
 			// Build a new name - a prefix instead of a suffix because it is
 			// easier to check against
-			anim->mNodeName.length = ::sprintf(anim->mNodeName.data,
+			::snprintf(anim->mNodeName.data,MAXLEN,
 				"$INST_DUMMY_%i_%s",total-1,
 				(root->name.length() ? root->name.c_str() : ""));
+			anim->mNodeName.length = ::strlen(anim->mNodeName.data);
 
 			// we'll also need to insert a dummy in the node hierarchy.
 			aiNode* dummy = new aiNode();
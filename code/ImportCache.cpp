@@ -0,0 +1,1050 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ImportCache.cpp
+ *  @brief Implementation of the on-disk cache of imported scenes
+ */
+
+#include "ImportCache.h"
+
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+
+#include "Importer.h"
+#include "AssbinLoader.h"
+#include "BaseImporter.h"
+#include "BaseProcess.h"
+#include "assbin_chunks.h"
+#include "DefaultIOSystem.h"
+#include "Hash.h"
+#include "../include/assimp/scene.h"
+#include "../include/assimp/config.h"
+#include "../include/assimp/version.h"
+#include "../include/assimp/DefaultLogger.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#if defined(_WIN32)
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#	include <io.h>
+#	include <fcntl.h>
+#	include <sys/stat.h>
+#	include <process.h>
+#else
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/file.h>
+#	include <sys/stat.h>
+#endif
+
+namespace Assimp {
+	class ExportProperties;
+
+	// AssbinExporter.cpp
+	void ExportSceneAssbin(const char*, IOSystem*, const aiScene*, const ExportProperties*);
+}
+
+using namespace Assimp;
+
+namespace {
+
+// Name of the index file in the cache directory
+const char* const IndexFile = "assimp-cache.index";
+
+// Name of the file which locks the index against other processes
+const char* const LockFile = "assimp-cache.lock";
+
+// How often and how long to wait for the lock, in milliseconds
+const unsigned int LockRetries = 500;
+const unsigned int LockRetryDelay = 10;
+
+// ------------------------------------------------------------------------------------------------
+/** Exclusive lock on the index of a cache directory, held while the index is read,
+ *  changed and written back so concurrent processes don't lose each other's updates.
+ *  The lock file is opened exclusively, the operating system releases it when a 
+ *  process holding it terminates. If it can't be taken within some seconds, the
+ *  lock is not held and the caller has to do without the index. */
+class IndexLock
+{
+public:
+
+	explicit IndexLock(const std::string& directory)
+		: path(directory + LockFile)
+#if defined(_WIN32)
+		, handle(INVALID_HANDLE_VALUE)
+#else
+		, fd(-1)
+#endif
+	{
+		for (unsigned int i = 0; i < LockRetries; ++i) {
+			if (TryLock()) {
+				return;
+			}
+			Wait();
+		}
+		DefaultLogger::get()->warn("Import cache: unable to lock " + path + ", bypassing the cache");
+	}
+
+	~IndexLock() {
+#if defined(_WIN32)
+		if (handle != INVALID_HANDLE_VALUE) {
+			::CloseHandle(handle);
+		}
+#else
+		if (fd != -1) {
+			::flock(fd,LOCK_UN);
+			::close(fd);
+		}
+#endif
+	}
+
+public:
+
+	bool IsLocked() const {
+#if defined(_WIN32)
+		return handle != INVALID_HANDLE_VALUE;
+#else
+		return fd != -1;
+#endif
+	}
+
+private:
+
+	bool TryLock() {
+#if defined(_WIN32)
+		// no sharing, fails while another handle to the file is open
+		handle = ::CreateFileA(path.c_str(),GENERIC_READ | GENERIC_WRITE,0,NULL,
+			OPEN_ALWAYS,FILE_ATTRIBUTE_NORMAL,NULL);
+		return handle != INVALID_HANDLE_VALUE;
+#else
+		// the file is never removed, a process could otherwise lock a
+		// file which has already been replaced by a new one.
+		const int f = ::open(path.c_str(),O_CREAT | O_RDWR,0644);
+		if (f == -1) {
+			return false;
+		}
+		if (0 != ::flock(f,LOCK_EX | LOCK_NB)) {
+			::close(f);
+			return false;
+		}
+		fd = f;
+		return true;
+#endif
+	}
+
+	static void Wait() {
+#if defined(_WIN32)
+		::Sleep(LockRetryDelay);
+#else
+		::usleep(LockRetryDelay * 1000);
+#endif
+	}
+
+	std::string path;
+#if defined(_WIN32)
+	HANDLE handle;
+#else
+	int fd;
+#endif
+};
+
+// ------------------------------------------------------------------------------------------------
+// Used to give temporary files of concurrent processes distinct names
+unsigned int GetCurrentPid()
+{
+#if defined(_WIN32)
+	return static_cast<unsigned int>(::_getpid());
+#else
+	return static_cast<unsigned int>(::getpid());
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+// Assbin has no room for node metadata
+bool HasMetaData(const aiNode* node)
+{
+	if (node->mMetaData) {
+		return true;
+	}
+	for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+		if (HasMetaData(node->mChildren[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+/** MD5 message digest as specified by RFC 1321. The keys of the cache and the digests
+ *  of dependencies are 128 bits wide, accidental collisions are practically impossible. */
+class Md5
+{
+public:
+
+	Md5()
+		: length()
+	{
+		state[0] = 0x67452301;
+		state[1] = 0xefcdab89;
+		state[2] = 0x98badcfe;
+		state[3] = 0x10325476;
+	}
+
+	void Add(const void* data, size_t len) {
+		const uint8_t* in = static_cast<const uint8_t*>(data);
+		size_t used = static_cast<size_t>(length & 63);
+		length += len;
+
+		if (used) {
+			const size_t n = std::min(len,64 - used);
+			::memcpy(buffer + used,in,n);
+			in += n;
+			len -= n;
+			if (used + n < 64) {
+				return;
+			}
+			Transform(buffer);
+		}
+		for (; len >= 64; in += 64, len -= 64) {
+			Transform(in);
+		}
+		if (len) {
+			::memcpy(buffer,in,len);
+		}
+	}
+
+	/** Returns the digest of the data added so far as hex string */
+	std::string ToString() const {
+		Md5 final(*this);
+
+		uint8_t pad[72] = {0x80};
+		const size_t used = static_cast<size_t>(length & 63);
+		const size_t padLen = (used < 56 ? 56 : 120) - used;
+		const uint64_t bits = length << 3;
+		for (unsigned int i = 0; i < 8; ++i) {
+			pad[padLen + i] = static_cast<uint8_t>(bits >> (i * 8));
+		}
+		final.Add(pad,padLen + 8);
+
+		char buff[33];
+		for (unsigned int i = 0; i < 16; ++i) {
+			::sprintf(buff + i * 2,"%02x",static_cast<unsigned int>((final.state[i / 4] >> ((i % 4) * 8)) & 0xff));
+		}
+		return std::string(buff,32);
+	}
+
+private:
+
+	void Transform(const uint8_t* block) {
+		static const uint32_t K[64] = {
+			0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+			0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+			0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+			0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+			0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+			0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+			0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+			0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+			0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+			0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+			0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+			0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+			0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+			0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+			0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+			0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+		};
+		static const unsigned int S[16] = {
+			7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21
+		};
+
+		uint32_t m[16];
+		for (unsigned int i = 0; i < 16; ++i) {
+			m[i] = block[i*4] | (block[i*4+1] << 8) | (block[i*4+2] << 16) | (static_cast<uint32_t>(block[i*4+3]) << 24);
+		}
+
+		uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+		for (unsigned int i = 0; i < 64; ++i) {
+			uint32_t f;
+			unsigned int g;
+			if (i < 16) {
+				f = (b & c) | (~b & d);
+				g = i;
+			}
+			else if (i < 32) {
+				f = (d & b) | (~d & c);
+				g = (5 * i + 1) & 15;
+			}
+			else if (i < 48) {
+				f = b ^ c ^ d;
+				g = (3 * i + 5) & 15;
+			}
+			else {
+				f = c ^ (b | ~d);
+				g = (7 * i) & 15;
+			}
+			f += a + K[i] + m[g];
+			const unsigned int s = S[(i >> 4) * 4 + (i & 3)];
+			a = d;
+			d = c;
+			c = b;
+			b += (f << s) | (f >> (32 - s));
+		}
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+	}
+
+	uint32_t state[4];
+	uint64_t length;
+	uint8_t buffer[64];
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Builds up the key of an import */
+struct KeyHash
+{
+	void Add(const void* data, size_t len) {
+		md5.Add(data,len);
+	}
+
+	template <typename T>
+	void Add(const T& value) {
+		Add(&value,sizeof(T));
+	}
+
+	void Add(const std::string& s) {
+		Add(static_cast<uint32_t>(s.length()));
+		Add(s.data(),s.length());
+	}
+
+	std::string ToString() const {
+		return md5.ToString();
+	}
+
+	Md5 md5;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Adds the size and the contents of a file to a digest
+bool AddFile(Md5& md5, IOSystem* pIOHandler, const std::string& file)
+{
+	IOStream* stream = pIOHandler->Open(file,"rb");
+	if (!stream) {
+		return false;
+	}
+
+	const size_t fileSize = stream->FileSize();
+	const uint64_t size64 = fileSize;
+	md5.Add(&size64,sizeof(size64));
+
+	std::vector<char> buffer(1 << 16);
+	for (size_t read = 0; read < fileSize; ) {
+		const size_t count = stream->Read(&buffer[0],1,std::min(buffer.size(),fileSize-read));
+		if (!count) {
+			break;
+		}
+		md5.Add(&buffer[0],count);
+		read += count;
+	}
+	pIOHandler->Close(stream);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the digest of a file's contents, empty if the file can't be read
+std::string GetFileDigest(IOSystem* pIOHandler, const std::string& file)
+{
+	Md5 md5;
+	return AddFile(md5,pIOHandler,file) ? md5.ToString() : std::string();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the time a local file has last been modified, 0 if it is unknown
+uint64_t GetModificationTime(const std::string& file)
+{
+#if defined _WIN32 && !defined __GNUC__
+	struct __stat64 fileStat;
+	if (0 != _stat64(file.c_str(),&fileStat)) {
+		return 0;
+	}
+#else
+	struct stat fileStat;
+	if (0 != stat(file.c_str(),&fileStat)) {
+		return 0;
+	}
+#endif
+	return static_cast<uint64_t>(fileStat.st_mtime);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Removes a file, true if it is gone. Files which are still open or mapped
+// can't be removed on some platforms.
+bool RemoveFile(const std::string& file)
+{
+	return 0 == ::remove(file.c_str()) || errno == ENOENT;
+}
+
+// ------------------------------------------------------------------------------------------------
+// The cache settings themselves don't affect the imported scene
+bool IsCacheProperty(ImporterPimpl::KeyType key)
+{
+	static const ImporterPimpl::KeyType directory = SuperFastHash(AI_CONFIG_IMPORT_CACHE_DIRECTORY);
+	static const ImporterPimpl::KeyType maxSize = SuperFastHash(AI_CONFIG_IMPORT_CACHE_MAX_SIZE);
+	return key == directory || key == maxSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void AddProperties(KeyHash& hash, const std::map<ImporterPimpl::KeyType, T>& props)
+{
+	for (typename std::map<ImporterPimpl::KeyType, T>::const_iterator it = props.begin(); it != props.end(); ++it) {
+		if (!IsCacheProperty((*it).first)) {
+			hash.Add((*it).first);
+			hash.Add((*it).second);
+		}
+	}
+}
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+/** The digest of the input file is the same as GetFileDigest() yields. It covers the
+ *  bytes read so far, as long as they have been read in order. Reads of bytes already
+ *  covered are fine, i.e. the header read for format detection and the same bytes read 
+ *  again by the loader. A gap can't be closed and the file has to be read again. */
+struct DependencyRecorder::InputDigest
+{
+	InputDigest()
+		: opened()
+		, valid(true)
+		, size()
+		, hashed()
+	{}
+
+	void Begin(size_t fileSize) {
+		if (!opened) {
+			opened = true;
+			size = fileSize;
+			const uint64_t size64 = fileSize;
+			md5.Add(&size64,sizeof(size64));
+		}
+	}
+
+	void Add(size_t pos, const void* data, size_t len) {
+		if (!valid) {
+			return;
+		}
+		if (pos > hashed) {
+			valid = false;
+			return;
+		}
+		if (pos + len > hashed) {
+			md5.Add(static_cast<const char*>(data) + (hashed - pos),pos + len - hashed);
+			hashed = pos + len;
+		}
+	}
+
+	bool IsComplete() const {
+		return opened && valid && hashed == size;
+	}
+
+	bool opened, valid;
+	size_t size, hashed;
+	Md5 md5;
+};
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Stream over the input file which adds all bytes read to its digest */
+class DigestStream : public IOStream
+{
+public:
+
+	DigestStream(IOSystem* io, IOStream* source, DependencyRecorder::InputDigest* digest)
+		: io(io)
+		, source(source)
+		, digest(digest)
+	{}
+
+	~DigestStream() {
+		io->Close(source);
+	}
+
+public:
+
+	size_t Read(void* pvBuffer, size_t pSize, size_t pCount) {
+		const size_t pos = source->Tell();
+		const size_t cnt = source->Read(pvBuffer,pSize,pCount);
+		digest->Add(pos,pvBuffer,cnt * pSize);
+		return cnt;
+	}
+
+	size_t Write(const void* pvBuffer, size_t pSize, size_t pCount) {
+		return source->Write(pvBuffer,pSize,pCount);
+	}
+
+	aiReturn Seek(size_t pOffset, aiOrigin pOrigin) {
+		return source->Seek(pOffset,pOrigin);
+	}
+
+	size_t Tell() const {
+		return source->Tell();
+	}
+
+	size_t FileSize() const {
+		return source->FileSize();
+	}
+
+	void Flush() {
+		source->Flush();
+	}
+
+private:
+
+	IOSystem* io;
+	IOStream* source;
+	DependencyRecorder::InputDigest* digest;
+};
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+DependencyRecorder::DependencyRecorder(IOSystem* _wrapped, const std::string& _file)
+	: wrapped(_wrapped)
+	, file(_file)
+	, input(new InputDigest())
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+DependencyRecorder::~DependencyRecorder()
+{
+	delete input;
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportDependencyList DependencyRecorder::GetDependencies() const
+{
+	ImportDependency dep;
+	dep.path = file;
+	dep.digest = input->IsComplete() ? input->md5.ToString() : GetFileDigest(wrapped,file);
+
+	ImportDependencyList out(1,dep);
+	out.insert(out.end(),dependencies.begin(),dependencies.end());
+	return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DependencyRecorder::Exists( const char* pFile) const
+{
+	const bool exists = wrapped->Exists(pFile);
+	if (!exists) {
+		Record(pFile,false);
+	}
+	return exists;
+}
+
+// ------------------------------------------------------------------------------------------------
+char DependencyRecorder::getOsSeparator() const
+{
+	return wrapped->getOsSeparator();
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream* DependencyRecorder::Open(const char* pFile, const char* pMode)
+{
+	// the contents are read before the loader gets to see them. If the file
+	// is changed meanwhile, the entry is dropped when it is looked up.
+	IOStream* stream = wrapped->Open(pFile,pMode);
+	if (pMode[0] != 'r') {
+		return stream;
+	}
+	if (stream && file == pFile) {
+		input->Begin(stream->FileSize());
+		return new DigestStream(wrapped,stream,input);
+	}
+	Record(pFile,NULL != stream);
+	return stream;
+}
+
+// ------------------------------------------------------------------------------------------------
+void DependencyRecorder::Close( IOStream* pFile)
+{
+	// importers may also delete our streams directly, so they aren't tracked
+	if (dynamic_cast<DigestStream*>(pFile)) {
+		delete pFile;
+	}
+	else wrapped->Close(pFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DependencyRecorder::ComparePaths (const char* one, const char* two) const
+{
+	return wrapped->ComparePaths(one,two);
+}
+
+// ------------------------------------------------------------------------------------------------
+void DependencyRecorder::Record(const std::string& path, bool exists) const
+{
+	if (path == file) {
+		return;
+	}
+	for (ImportDependencyList::const_iterator it = dependencies.begin(); it != dependencies.end(); ++it) {
+		if ((*it).path == path && (*it).digest.empty() == !exists) {
+			return;
+		}
+	}
+
+	ImportDependency dep;
+	dep.path = path;
+	if (exists) {
+		dep.digest = GetFileDigest(wrapped,path);
+	}
+	dependencies.push_back(dep);
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::ImportCache(const std::string& _directory, uint64_t _maxSize)
+	: directory(_directory)
+	, maxSize(_maxSize)
+	, size(0)
+{
+	if (!directory.empty() && directory[directory.length()-1] != '/' && directory[directory.length()-1] != '\\') {
+		directory += DefaultIOSystem().getOsSeparator();
+	}
+	IndexLock lock(directory);
+	if (!lock.IsLocked()) {
+		return;
+	}
+	ReadIndex();
+
+	// the limit may have been lowered since the cache was last used
+	if (size > maxSize) {
+		Evict();
+		WriteIndex();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::~ImportCache()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportCache::ComputeKey(IOSystem* pIOHandler, const std::string& file,
+	unsigned int flags, const ImporterPimpl* pimpl)
+{
+	KeyHash hash;
+
+	// the file's name, size and modification time. The contents are only read when
+	// there is an entry for the key, Lookup() compares them to the stored digest.
+	IOStream* stream = pIOHandler->Open(file,"rb");
+	if (!stream) {
+		return std::string();
+	}
+	hash.Add(static_cast<uint64_t>(stream->FileSize()));
+	pIOHandler->Close(stream);
+
+	hash.Add(file);
+	if (pimpl->mIsDefaultHandler) {
+		hash.Add(GetModificationTime(file));
+	}
+
+	// ... the library and the format it is stored in ...
+	hash.Add(aiGetVersionMajor());
+	hash.Add(aiGetVersionMinor());
+	hash.Add(aiGetVersionRevision());
+	hash.Add(aiGetCompileFlags());
+	hash.Add(static_cast<unsigned int>(ASSBIN_VERSION_MAJOR));
+	hash.Add(static_cast<unsigned int>(ASSBIN_VERSION_MINOR));
+
+	// ... and everything that affects the import
+	hash.Add(flags);
+	AddProperties(hash,pimpl->mIntProperties);
+	AddProperties(hash,pimpl->mFloatProperties);
+	AddProperties(hash,pimpl->mStringProperties);
+	AddProperties(hash,pimpl->mMatrixProperties);
+
+	// custom loaders and steps take part in the import as well. They are known by name
+	// only, the cache is bypassed for those which don't have one.
+	for (size_t i = 0; i < pimpl->mImporter.size(); ++i) {
+		if (pimpl->mImporterFactories[i]) {
+			continue;
+		}
+		const aiImporterDesc* desc = pimpl->mImporter[i]->GetInfo();
+		if (!desc || !desc->mName || !*desc->mName) {
+			DefaultLogger::get()->info("Import cache: custom loader without a name, bypassing the cache");
+			return std::string();
+		}
+		hash.Add(static_cast<uint32_t>(i));
+		hash.Add(std::string(desc->mName));
+	}
+	for (size_t i = 0; i < pimpl->mPostProcessingSteps.size(); ++i) {
+		if (pimpl->mStepFactories[i]) {
+			continue;
+		}
+		const char* name = pimpl->mPostProcessingSteps[i]->GetName();
+		if (!name || !*name) {
+			DefaultLogger::get()->info("Import cache: custom post-processing step without a name, bypassing the cache");
+			return std::string();
+		}
+		hash.Add(static_cast<uint32_t>(i));
+		hash.Add(std::string(name));
+	}
+
+	return hash.ToString();
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene* ImportCache::Lookup(const Importer* pImp, IOSystem* pIOHandler, const std::string& key)
+{
+	uint64_t entrySize;
+	{
+		IndexLock lock(directory);
+		if (!lock.IsLocked()) {
+			return NULL;
+		}
+		ReadIndex();
+
+		EntryList::iterator it = Find(key);
+		if (it == entries.end()) {
+			return NULL;
+		}
+		entrySize = (*it).size;
+	}
+
+	// reading the entry can take a while, other processes may use the index meanwhile.
+	// Files the loader has read besides the input file must still be the same.
+	bool valid = true;
+	ImportDependencyList dependencies;
+	if (!ReadDependencies(key,dependencies)) {
+		valid = false;
+	}
+	for (ImportDependencyList::const_iterator it = dependencies.begin(); valid && it != dependencies.end(); ++it) {
+		if (GetFileDigest(pIOHandler,(*it).path) != (*it).digest) {
+			DefaultLogger::get()->info("Import cache: " + (*it).path + " has changed");
+			valid = false;
+		}
+	}
+
+	DefaultIOSystem io;
+	const std::string path = GetPath(key);
+
+	aiScene* scene = NULL;
+	IOStream* stream = valid ? io.Open(path.c_str(),"rb") : NULL;
+	if (stream) {
+		const bool complete = stream->FileSize() == entrySize;
+		io.Close(stream);
+
+		if (complete) {
+			AssbinImporter loader;
+			scene = loader.ReadFile(pImp,path,&io);
+		}
+	}
+
+	IndexLock lock(directory);
+	if (!lock.IsLocked()) {
+		return scene;
+	}
+	ReadIndex();
+
+	EntryList::iterator it = Find(key);
+	if (it != entries.end()) {
+		// drop entries which are outdated or have been removed or damaged from outside
+		if (!scene) {
+			DefaultLogger::get()->warn("Import cache: dropping " + std::string(valid ? "unreadable" : "outdated") + " entry " + key);
+			Remove(it);
+		}
+		else {
+			entries.splice(entries.end(),entries,it);
+		}
+		WriteIndex();
+	}
+	return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCache::Store(const std::string& key, const aiScene* scene, const ImportDependencyList& dependencies)
+{
+	if (key.empty()) {
+		return false;
+	}
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		if (scene->mMeshes[i]->HasMeshlets() || scene->mMeshes[i]->HasSkinStream()) {
+			DefaultLogger::get()->debug("Import cache: not storing scene, Assbin can't hold meshlets and skin streams");
+			return false;
+		}
+	}
+	if (HasMetaData(scene->mRootNode)) {
+		DefaultLogger::get()->debug("Import cache: not storing scene, Assbin can't hold node metadata");
+		return false;
+	}
+
+	DefaultIOSystem io;
+	const std::string path = GetPath(key);
+	const std::string depPath = GetDependencyPath(key);
+
+	std::ostringstream tempName;
+	tempName << '.' << GetCurrentPid() << ".tmp";
+	const std::string temp = path + tempName.str();
+	const std::string depTemp = depPath + tempName.str();
+
+	// write to temporary files first so other readers never see an incomplete entry
+	if (!WriteDependencies(depTemp,dependencies)) {
+		DefaultLogger::get()->warn("Import cache: unable to write " + depTemp);
+		return false;
+	}
+	ExportSceneAssbin(temp.c_str(),&io,scene,NULL);
+	IOStream* stream = io.Open(temp.c_str(),"rb");
+	if (!stream) {
+		::remove(depTemp.c_str());
+		DefaultLogger::get()->warn("Import cache: unable to write " + temp);
+		return false;
+	}
+	const uint64_t entrySize = stream->FileSize();
+	io.Close(stream);
+
+	IndexLock lock(directory);
+	if (!lock.IsLocked()) {
+		::remove(temp.c_str());
+		::remove(depTemp.c_str());
+		return false;
+	}
+	ReadIndex();
+
+	// rename() doesn't replace existing files on all platforms
+	EntryList::iterator it = Find(key);
+	const bool replaceable = it != entries.end() ? Remove(it) : RemoveFile(path) && RemoveFile(depPath);
+	if (!replaceable) {
+		::remove(temp.c_str());
+		::remove(depTemp.c_str());
+		DefaultLogger::get()->warn("Import cache: unable to replace " + path + ", it is still in use");
+		WriteIndex();
+		return false;
+	}
+	if (0 != ::rename(depTemp.c_str(),depPath.c_str()) || 0 != ::rename(temp.c_str(),path.c_str())) {
+		::remove(temp.c_str());
+		::remove(depTemp.c_str());
+		::remove(depPath.c_str());
+		DefaultLogger::get()->warn("Import cache: unable to write " + path);
+		WriteIndex();
+		return false;
+	}
+
+	Entry entry;
+	entry.key = key;
+	entry.size = entrySize;
+	entries.push_back(entry);
+	size += entrySize;
+
+	// evict the least recently used entries, possibly including the new one
+	Evict();
+	WriteIndex();
+	return !entries.empty() && entries.back().key == key;
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportCache::GetPath(const std::string& key) const
+{
+	return directory + key + ".assbin";
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportCache::GetDependencyPath(const std::string& key) const
+{
+	return directory + key + ".deps";
+}
+
+// ------------------------------------------------------------------------------------------------
+// The dependencies of an entry are listed one per line, the digest of the file's contents
+// or '-' if it didn't exist, followed by its name.
+bool ImportCache::ReadDependencies(const std::string& key, ImportDependencyList& out) const
+{
+	DefaultIOSystem io;
+	IOStream* stream = io.Open(GetDependencyPath(key).c_str(),"rb");
+	if (!stream) {
+		return false;
+	}
+
+	std::string text(stream->FileSize(),'\0');
+	if (!text.empty()) {
+		text.resize(stream->Read(&text[0],1,text.size()));
+	}
+	io.Close(stream);
+
+	std::istringstream in(text);
+	std::string line;
+	while (std::getline(in,line)) {
+		const std::string::size_type sep = line.find(' ');
+		if (sep == std::string::npos || sep + 1 == line.length()) {
+			return false;
+		}
+		ImportDependency dep;
+		dep.digest = line.substr(0,sep);
+		dep.path = line.substr(sep + 1);
+		if (dep.digest == "-") {
+			dep.digest.clear();
+		}
+		out.push_back(dep);
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportCache::WriteDependencies(const std::string& file, const ImportDependencyList& dependencies) const
+{
+	std::ostringstream out;
+	for (ImportDependencyList::const_iterator it = dependencies.begin(); it != dependencies.end(); ++it) {
+		out << ((*it).digest.empty() ? std::string("-") : (*it).digest) << ' ' << (*it).path << '\n';
+	}
+	const std::string text = out.str();
+
+	DefaultIOSystem io;
+	IOStream* stream = io.Open(file.c_str(),"wb");
+	if (!stream) {
+		return false;
+	}
+	const bool ok = text.empty() || stream->Write(text.data(),1,text.length()) == text.length();
+	io.Close(stream);
+	return ok;
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportCache::EntryList::iterator ImportCache::Find(const std::string& key)
+{
+	EntryList::iterator it = entries.begin();
+	for (; it != entries.end(); ++it) {
+		if ((*it).key == key) {
+			break;
+		}
+	}
+	return it;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Entries which are still in use can't be removed on all platforms, i.e. zero-copy scenes
+// on Windows map their entry while they live. They stay listed, so they still count towards
+// the size limit and are removed by a later attempt.
+bool ImportCache::Remove(EntryList::iterator it)
+{
+	const std::string path = GetPath((*it).key);
+	if (!RemoveFile(path)) {
+		DefaultLogger::get()->debug("Import cache: unable to remove " + path + ", it is still in use");
+		return false;
+	}
+	::remove(GetDependencyPath((*it).key).c_str());
+	size -= (*it).size;
+	entries.erase(it);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Removes the least recently used entries until the cache fits its size limit
+void ImportCache::Evict()
+{
+	for (EntryList::iterator it = entries.begin(); size > maxSize && it != entries.end(); ) {
+		EntryList::iterator next = it;
+		++next;
+		Remove(it);
+		it = next;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// The index lists one entry per line, its key followed by its size. Least recently used first.
+// It is read again before each change because other processes may have changed it.
+void ImportCache::ReadIndex()
+{
+	entries.clear();
+	size = 0;
+
+	DefaultIOSystem io;
+	IOStream* stream = io.Open((directory + IndexFile).c_str(),"rb");
+	if (!stream) {
+		return;
+	}
+
+	std::string text(stream->FileSize(),'\0');
+	if (!text.empty()) {
+		text.resize(stream->Read(&text[0],1,text.size()));
+	}
+	io.Close(stream);
+
+	std::istringstream in(text);
+	Entry entry;
+	while (in >> entry.key >> entry.size) {
+		entries.push_back(entry);
+		size += entry.size;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportCache::WriteIndex()
+{
+	std::ostringstream out;
+	for (EntryList::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+		out << (*it).key << ' ' << (*it).size << '\n';
+	}
+	const std::string text = out.str();
+
+	DefaultIOSystem io;
+	IOStream* stream = io.Open((directory + IndexFile).c_str(),"wb");
+	if (!stream) {
+		DefaultLogger::get()->warn("Import cache: unable to write index to " + directory);
+		return;
+	}
+	if (!text.empty()) {
+		stream->Write(text.data(),1,text.length());
+	}
+	io.Close(stream);
+}
+
+#endif // ASSIMP_BUILD_NO_IMPORT_CACHE
@@ -0,0 +1,240 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ImportCache.h
+ *  @brief Caches post-processed scenes on disk, see #AI_CONFIG_IMPORT_CACHE_DIRECTORY
+ */
+#ifndef AI_IMPORTCACHE_H_INC
+#define AI_IMPORTCACHE_H_INC
+
+#include "../include/assimp/defs.h"
+
+// The cache stores scenes in Assbin format, so it needs both directions
+#if (defined ASSIMP_BUILD_NO_EXPORT) || (defined ASSIMP_BUILD_NO_ASSBIN_EXPORTER) || (defined ASSIMP_BUILD_NO_ASSBIN_IMPORTER)
+#	ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+#		define ASSIMP_BUILD_NO_IMPORT_CACHE
+#	endif
+#endif
+
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+
+#include "../include/assimp/IOSystem.hpp"
+
+#include <stdint.h>
+#include <string>
+#include <list>
+#include <vector>
+
+struct aiScene;
+
+namespace Assimp {
+
+class Importer;
+class ImporterPimpl;
+
+// ------------------------------------------------------------------------------------------------
+/** @brief A file other than the input file which an import has read or looked for.
+ *
+ *  Loaders open material libraries, animations, textures and the like by themselves,
+ *  their contents affect the imported scene just like the input file does. */
+struct ImportDependency
+{
+	/** Name of the file as the loader passed it to the IOSystem */
+	std::string path;
+
+	/** Digest of the file's contents, empty if the file didn't exist */
+	std::string digest;
+};
+
+typedef std::vector<ImportDependency> ImportDependencyList;
+
+// ------------------------------------------------------------------------------------------------
+/** @brief IOSystem wrapper which records the files a loader reads.
+ *
+ *  The import cache reads the input file through it on a cache miss. Each file but
+ *  the input file is recorded with the digest of its contents when it is first
+ *  opened, files which are looked for but don't exist are recorded as well. The 
+ *  digest of the input file is taken while the loader reads it. */
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API DependencyRecorder : public IOSystem
+{
+public:
+
+	/** @param wrapped IOSystem to read the files from. It is not owned.
+	 *  @param file The input file, which is not recorded */
+	DependencyRecorder(IOSystem* wrapped, const std::string& file);
+
+	~DependencyRecorder();
+
+public:
+
+	/** Returns the input file followed by the other files read or looked for
+	 *  so far. The input file is read once more if the loader hasn't read all 
+	 *  of it front to back. */
+	ImportDependencyList GetDependencies() const;
+
+public:
+
+	bool Exists( const char* pFile) const;
+
+	char getOsSeparator() const;
+
+	IOStream* Open(const char* pFile, const char* pMode = "rb");
+
+	void Close( IOStream* pFile);
+
+	bool ComparePaths (const char* one, const char* two) const;
+
+	// digest of the input file as far as it has been read
+	struct InputDigest;
+
+private:
+
+	void Record(const std::string& path, bool exists) const;
+
+private:
+
+	IOSystem* wrapped;
+	std::string file;
+	mutable ImportDependencyList dependencies;
+	InputDigest* input;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Content-addressed store of imported scenes in a local directory.
+ *
+ *  Entries are keyed on a 128 bit digest of the input file's name, size and modification
+ *  time, the post-processing flags, all configuration properties of the Importer and the
+ *  names of its custom loaders and steps. Each entry is an Assbin file named after its
+ *  key, along with the digests of the input file's contents and of all other files the
+ *  loader has read. An entry is only used while all of these files are unchanged, 
+ *  contents are only read and hashed if there is an entry for the key. A small
+ *  index file keeps the entries in least-recently-used order, the oldest are removed 
+ *  when the total size exceeds the limit. Several processes may share a directory, the
+ *  index is locked while it is used. If the lock can't be taken in time, the cache is
+ *  bypassed. */
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API ImportCache
+{
+public:
+
+	/** Opens the cache in a directory.
+	 *  @param directory Existing directory to keep the cache in 
+	 *  @param maxSize Maximum total size of all entries, in bytes */
+	ImportCache(const std::string& directory, uint64_t maxSize);
+
+	~ImportCache();
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Computes the key for an import. The file's contents are not read.
+	 *  @param pIOHandler IOSystem to open the file with
+	 *  @param file Input file
+	 *  @param flags Post-processing flags of the import
+	 *  @param pimpl Importer whose properties affect the result
+	 *  @return Key, empty if the file can't be read or the Importer has a
+ *    custom loader or step without a name */
+	static std::string ComputeKey(IOSystem* pIOHandler, const std::string& file,
+		unsigned int flags, const ImporterPimpl* pimpl);
+
+	// -------------------------------------------------------------------
+	/** Reads the scene stored for a key and marks it as recently used.
+	 *  Entries whose dependencies have changed are removed.
+	 *  @param pImp Importer to read the scene with
+	 *  @param pIOHandler IOSystem to check the dependencies with
+	 *  @param key Key from ComputeKey()
+	 *  @return Scene, NULL if there is no valid one stored for the key */
+	aiScene* Lookup(const Importer* pImp, IOSystem* pIOHandler, const std::string& key);
+
+	// -------------------------------------------------------------------
+	/** Stores a scene for a key, evicting old entries if necessary.
+	 *  Scenes with data Assbin can't represent are not stored.
+	 *  @param dependencies Other files the scene has been read from,
+	 *    see DependencyRecorder
+	 *  @return true if the scene has been stored */
+	bool Store(const std::string& key, const aiScene* scene,
+		const ImportDependencyList& dependencies = ImportDependencyList());
+
+	// -------------------------------------------------------------------
+	/** Returns the total size of all entries as of the last access, in bytes */
+	uint64_t GetSize() const {
+		return size;
+	}
+
+	/** Returns the number of entries as of the last access */
+	size_t GetEntryCount() const {
+		return entries.size();
+	}
+
+private:
+
+	struct Entry
+	{
+		std::string key;
+		uint64_t size;
+	};
+
+	// least recently used first
+	typedef std::list<Entry> EntryList;
+
+	std::string GetPath(const std::string& key) const;
+	std::string GetDependencyPath(const std::string& key) const;
+	bool ReadDependencies(const std::string& key, ImportDependencyList& out) const;
+	bool WriteDependencies(const std::string& file, const ImportDependencyList& dependencies) const;
+	EntryList::iterator Find(const std::string& key);
+	bool Remove(EntryList::iterator it);
+	void Evict();
+	void ReadIndex();
+	void WriteIndex();
+
+private:
+
+	std::string directory;
+	uint64_t maxSize;
+	uint64_t size;
+	EntryList entries;
+};
+
+} // ! Assimp
+
+#endif // ASSIMP_BUILD_NO_IMPORT_CACHE
+#endif // AI_IMPORTCACHE_H_INC
@@ -63,14 +63,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Importer.h"
 #include "BaseImporter.h"
 #include "BaseProcess.h"
+#include "PostProcessScheduler.h"
 
 #include "DefaultIOStream.h"
 #include "DefaultIOSystem.h"
+#include "CompressedIOStream.h"
+#include "ProbeIOSystem.h"
+#include "ZipArchiveIOSystem.h"
+#include "ImportCache.h"
 #include "DefaultProgressHandler.h"
 #include "GenericProperty.h"
 #include "ProcessHelper.h"
+#include "ProgressReporter.h"
 #include "ScenePreprocessor.h"
 #include "ScenePrivate.h"
+#include "SceneCombiner.h"
 #include "MemoryIOWrapper.h"
 #include "Profiler.h"
 #include "TinyFormatter.h"
@@ -84,14 +91,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #	include "ValidateDataStructure.h"
 #endif
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/once.hpp>
+#endif
+
 using namespace Assimp::Profiling;
 using namespace Assimp::Formatter;
 
 namespace Assimp {
 	// ImporterRegistry.cpp
-	void GetImporterInstanceList(std::vector< BaseImporter* >& out);
+	void GetImporterFactoryList(std::vector< ImporterFactory >& out);
 	// PostStepRegistry.cpp
-	void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out);
+	void GetPostProcessingStepFactoryList(std::vector< PostProcessingStepFactory >& out);
 }
 
 using namespace Assimp;
@@ -137,6 +148,184 @@ void AllocateFromAssimpHeap::operator delete[] ( void* data)	{
 	return ::operator delete[](data);
 }
 
+// ------------------------------------------------------------------------------------------------
+void ImporterIndex::Add(const aiImporterDesc* info, const std::set<std::string>& extensions,
+	const std::vector<MagicToken>& tokens)
+{
+	const unsigned int index = static_cast<unsigned int>(mInfo.size());
+	mInfo.push_back(info);
+	mExtensions.push_back(extensions);
+	mMagicTokens.push_back(tokens);
+
+	for(std::set<std::string>::const_iterator it = extensions.begin(); it != extensions.end(); ++it) {
+		std::string ext = *it;
+		const std::string::size_type dot = ext.find_last_of('.');
+		if (dot != std::string::npos) {
+			ext.erase(0,dot+1);
+		}
+		std::transform(ext.begin(),ext.end(),ext.begin(),::tolower);
+
+		std::vector<unsigned int>& list = mByExtension[ext];
+
+		// 'mesh.xml' and 'scene.xml' would add the same importer twice
+		if (list.empty() || list.back() != index) {
+			list.push_back(index);
+		}
+	}
+}
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Build the shared registry. Each importer and step is instanced once to collect its static data.
+SharedRegistry BuildSharedRegistry()
+{
+	SharedRegistry registry;
+	GetImporterFactoryList(registry.mImporterFactories);
+
+	std::set<std::string> extensions;
+	std::vector<MagicToken> tokens;
+	for (std::vector<ImporterFactory>::const_iterator it = registry.mImporterFactories.begin(); 
+		it != registry.mImporterFactories.end(); ++it) {
+
+		boost::scoped_ptr<BaseImporter> imp((*it)());
+		extensions.clear();
+		tokens.clear();
+		imp->GetExtensionList(extensions);
+		imp->GetMagicTokens(tokens);
+		registry.mImporterIndex.Add(imp->GetInfo(),extensions,tokens);
+	}
+
+	GetPostProcessingStepFactoryList(registry.mStepFactories);
+
+	// some steps are inactive without shared data
+	SharedPostProcessInfo shared;
+	for (std::vector<PostProcessingStepFactory>::const_iterator it = registry.mStepFactories.begin(); 
+		it != registry.mStepFactories.end(); ++it) {
+
+		boost::scoped_ptr<BaseProcess> step((*it)());
+		step->SetSharedData(&shared);
+
+		unsigned int flags = 0;
+		for (unsigned int mask = 1; mask; mask <<= 1) {
+			if (step->IsActive(mask)) {
+				flags |= mask;
+			}
+		}
+		registry.mStepFlags.push_back(flags);
+	}
+	return registry;
+}
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+boost::once_flag registryOnce = BOOST_ONCE_INIT;
+const SharedRegistry* sharedRegistry = NULL;
+
+// only ever called through boost::call_once()
+void InitSharedRegistry()
+{
+	static const SharedRegistry registry = BuildSharedRegistry();
+	sharedRegistry = &registry;
+}
+#endif
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+// The registry is built on first use. With threading support, boost::call_once() makes sure
+// it is built exactly once even if several Importers are created concurrently. Compilers
+// don't all guarantee thread-safe initialization of local statics (MSVC before 2015 doesn't),
+// so without threading support the first Importer must not be created concurrently.
+const SharedRegistry& Assimp::GetSharedRegistry()
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	boost::call_once(registryOnce,&InitSharedRegistry);
+	return *sharedRegistry;
+#else
+	static const SharedRegistry registry = BuildSharedRegistry();
+	return registry;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+// Rebuild the lookup tables for format detection after the list of importers changed
+static void UpdateImporterIndex(ImporterPimpl* pimpl)
+{
+	const SharedRegistry& registry = GetSharedRegistry();
+	const std::vector<ImporterFactory>& factories = registry.mImporterFactories;
+	const ImporterIndex& shared = registry.mImporterIndex;
+
+	ImporterIndex& index = pimpl->mCustomIndex;
+	index = ImporterIndex();
+
+	std::set<std::string> extensions;
+	std::vector<MagicToken> tokens;
+	for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
+		const ImporterFactory factory = pimpl->mImporterFactories[a];
+
+		// built-in importers are looked up to avoid instancing them
+		if (factory) {
+			const size_t s = std::distance(factories.begin(), std::find(factories.begin(),factories.end(),factory));
+			index.Add(shared.mInfo[s],shared.mExtensions[s],shared.mMagicTokens[s]);
+			continue;
+		}
+
+		BaseImporter* imp = pimpl->mImporter[a];
+		extensions.clear();
+		tokens.clear();
+		imp->GetExtensionList(extensions);
+		imp->GetMagicTokens(tokens);
+		index.Add(imp->GetInfo(),extensions,tokens);
+	}
+	pimpl->mIndex = &index;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the importer at a given index, instance it on first use
+static BaseImporter* GetImporterAt(ImporterPimpl* pimpl, size_t index)
+{
+	BaseImporter*& imp = pimpl->mImporter[index];
+	if (!imp) {
+		imp = pimpl->mImporterFactories[index]();
+	}
+	return imp;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the post-processing step at a given index, instance it on first use
+static BaseProcess* GetPostProcessingStepAt(ImporterPimpl* pimpl, size_t index)
+{
+	BaseProcess*& step = pimpl->mPostProcessingSteps[index];
+	if (!step) {
+		step = pimpl->mStepFactories[index]();
+		step->SetSharedData(pimpl->mPPShared);
+	}
+	return step;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the profiler region name of a post-processing stage. Steps are named after their class,
+// see BaseProcess::GetName(), so helper steps serving several flags get regions of their own.
+static std::string GetStageName(const std::vector<BaseProcess*>& steps, 
+	const std::vector<unsigned int>& stepIndices, 
+	const PostProcessScheduler::Stage& stage)
+{
+	std::string name = "postprocess";
+	for (unsigned int s = stage.first; s < stage.first + stage.count; ++s) {
+		name += (s == stage.first ? " " : ", ");
+
+		const char* const stepName = steps[s]->GetName();
+		if (stepName) {
+			name += stepName;
+		}
+		else {
+			// custom steps without a name are told apart by their position
+			name += std::string(format() << "Step" << stepIndices[s]);
+		}
+	}
+	return name;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Importer constructor. 
 Importer::Importer() 
@@ -155,23 +344,37 @@ Importer::Importer()
 	pimpl->mProgressHandler = new DefaultProgressHandler();
 	pimpl->mIsDefaultProgressHandler = true;
 
-	GetImporterInstanceList(pimpl->mImporter);
-	GetPostProcessingStepInstanceList(pimpl->mPostProcessingSteps);
+	// Importers and post-processing steps are instanced on first use, until then we
+	// take all we need to know about them from the shared registry.
+	const SharedRegistry& registry = GetSharedRegistry();
+
+	pimpl->mImporterFactories = registry.mImporterFactories;
+	pimpl->mImporter.resize(pimpl->mImporterFactories.size(),NULL);
+	pimpl->mIndex = &registry.mImporterIndex;
+
+	pimpl->mStepFactories = registry.mStepFactories;
+	pimpl->mStepFlags = registry.mStepFlags;
+	pimpl->mPostProcessingSteps.resize(pimpl->mStepFactories.size(),NULL);
 
-	// Allocate a SharedPostProcessInfo object and store pointers to it in all post-process steps in the list.
+	// Allocate a SharedPostProcessInfo object, steps get a pointer to it when they are instanced.
 	pimpl->mPPShared = new SharedPostProcessInfo();
-	for (std::vector<BaseProcess*>::iterator it =  pimpl->mPostProcessingSteps.begin();
-		it != pimpl->mPostProcessingSteps.end(); 
-		++it)	{
 
-		(*it)->SetSharedData(pimpl->mPPShared);
-	}
+	pimpl->mCancelRequested.Set(false);
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	pimpl->mAsyncThread = NULL;
+	pimpl->mAsyncRunning.Set(false);
+#endif
 }
 
 // ------------------------------------------------------------------------------------------------
 // Destructor of Importer
 Importer::~Importer()
 {
+	// Stop a running ReadFileAsync() call
+	ImportFuture pending(this);
+	pending.Cancel();
+	pending.Get();
+
 	// Delete all import plugins
 	for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)
 		delete pimpl->mImporter[a];
@@ -214,6 +417,8 @@ aiReturn Importer::RegisterPPStep(BaseProcess* pImp)
 	ASSIMP_BEGIN_EXCEPTION_REGION();
 
 		pimpl->mPostProcessingSteps.push_back(pImp);
+		pimpl->mStepFactories.push_back(NULL);
+		pimpl->mStepFlags.push_back(~0u);
 		DefaultLogger::get()->info("Registering custom post-processing step");
 	
 	ASSIMP_END_EXCEPTION_REGION(aiReturn);
@@ -249,6 +454,8 @@ aiReturn Importer::RegisterLoader(BaseImporter* pImp)
 
 	// add the loader
 	pimpl->mImporter.push_back(pImp);
+	pimpl->mImporterFactories.push_back(NULL);
+	UpdateImporterIndex(pimpl);
 	DefaultLogger::get()->info("Registering custom importer for these file extensions: " + baked);
 	ASSIMP_END_EXCEPTION_REGION(aiReturn);
 	return AI_SUCCESS;
@@ -268,7 +475,9 @@ aiReturn Importer::UnregisterLoader(BaseImporter* pImp)
 		pimpl->mImporter.end(),pImp);
 
 	if (it != pimpl->mImporter.end())	{
+		pimpl->mImporterFactories.erase(pimpl->mImporterFactories.begin() + std::distance(pimpl->mImporter.begin(),it));
 		pimpl->mImporter.erase(it);
+		UpdateImporterIndex(pimpl);
 
 		std::set<std::string> st;
 		pImp->GetExtensionList(st);
@@ -295,6 +504,9 @@ aiReturn Importer::UnregisterPPStep(BaseProcess* pImp)
 		pimpl->mPostProcessingSteps.end(),pImp);
 
 	if (it != pimpl->mPostProcessingSteps.end())	{
+		const size_t index = std::distance(pimpl->mPostProcessingSteps.begin(),it);
+		pimpl->mStepFactories.erase(pimpl->mStepFactories.begin() + index);
+		pimpl->mStepFlags.erase(pimpl->mStepFlags.begin() + index);
 		pimpl->mPostProcessingSteps.erase(it);
 		DefaultLogger::get()->info("Unregistering custom post-processing step");
 		return AI_SUCCESS;
@@ -465,7 +677,7 @@ bool Importer::ValidateFlags(unsigned int pFlags) const
 		
 			bool have = false;
 			for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)	{
-				if (pimpl->mPostProcessingSteps[a]-> IsActive(mask) ) {
+				if ((pimpl->mStepFlags[a] & mask) && GetPostProcessingStepAt(pimpl,a)->IsActive(mask) ) {
 				
 					have = true;
 					break;
@@ -575,6 +787,57 @@ void WriteLogOpening(const std::string& file)
 		);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Returns the first importer which claims the given file by its extension. Importers 
+// registered for the extension are asked first, the others may still claim it.
+static BaseImporter* FindReaderByExtension(ImporterPimpl* pimpl, 
+	const std::string& pFile, IOSystem* pIOHandler)
+{
+	const std::vector<unsigned int>* candidates = NULL;
+
+	const ImporterIndex::ExtensionMap::const_iterator it = 
+		pimpl->mIndex->mByExtension.find(BaseImporter::GetExtension(pFile));
+
+	if (it != pimpl->mIndex->mByExtension.end()) {
+		candidates = &(*it).second;
+		for (std::vector<unsigned int>::const_iterator c = candidates->begin(); c != candidates->end(); ++c) {
+			BaseImporter* imp = GetImporterAt(pimpl,*c);
+			if (imp->CanRead( pFile, pIOHandler, false)) {
+				return imp;
+			}
+		}
+	}
+
+	for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
+		if (candidates && std::binary_search(candidates->begin(),candidates->end(),a)) {
+			continue;
+		}
+		BaseImporter* imp = GetImporterAt(pimpl,a);
+		if( imp->CanRead( pFile, pIOHandler, false)) {
+			return imp;
+		}
+	}
+	return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the first importer which recognizes the contents of the probed file. Importers
+// with magic tokens are only asked if one of their tokens is found in the header.
+static BaseImporter* FindReaderBySignature(ImporterPimpl* pimpl, ProbeIOSystem& probe)
+{
+	for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
+		const std::vector<MagicToken>& tokens = pimpl->mIndex->mMagicTokens[a];
+		if (!tokens.empty() && !BaseImporter::MatchMagicTokens(tokens,probe.GetHeader(),probe.GetHeaderSize())) {
+			continue;
+		}
+		BaseImporter* imp = GetImporterAt(pimpl,a);
+		if( imp->CanRead( probe.GetFile(), &probe, true)) {
+			return imp;
+		}
+	}
+	return NULL;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Reads the given file and returns its contents if successful.
 const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
@@ -582,6 +845,16 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 	ASSIMP_BEGIN_EXCEPTION_REGION();
 	const std::string pFile(_pFile);
 
+	// Unless this is the worker thread of ReadFileAsync(), collect a finished
+	// asynchronous import the caller hasn't waited for. This also clears a 
+	// cancel request which came too late to affect it.
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	if (!pimpl->mAsyncRunning.IsSet())
+#endif
+	{
+		ImportFuture(this).Get();
+	}
+
 	// ----------------------------------------------------------------------
 	// Put a large try block around everything to catch all std::exception's
 	// that might be thrown by STL containers or by new(). 
@@ -602,8 +875,17 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			FreeScene();
 		}
 
+		// A file which doesn't exist may be the entry of a zip archive, i.e. "bundle.zip/model.obj".
+		// The loader then reads it and all other files next to it from the archive.
+		IOSystem* sourceIO = pimpl->mIOHandler;
+		boost::scoped_ptr<ZipMemberIOSystem> zipIO;
+		if (!sourceIO->Exists(pFile)) {
+			zipIO.reset(new ZipMemberIOSystem(sourceIO));
+			sourceIO = zipIO.get();
+		}
+
 		// First check if the file is accessable at all
-		if( !pimpl->mIOHandler->Exists( pFile))	{
+		if( !sourceIO->Exists( pFile))	{
 
 			pimpl->mErrorString = "Unable to open file \"" + pFile + "\".";
 			DefaultLogger::get()->error(pimpl->mErrorString);
@@ -615,13 +897,71 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			profiler->BeginRegion("total");
 		}
 
-		// Find an worker class which can handle the file
-		BaseImporter* imp = NULL;
-		for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
+		// Serve the scene from the import cache if we have seen this file before
+		const std::string cacheDirectory = GetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY,"");
+		IOSystem* ioHandler = sourceIO;
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+		boost::scoped_ptr<ImportCache> cache;
+		boost::scoped_ptr<DependencyRecorder> recorder;
+		std::string cacheKey;
+		if (!cacheDirectory.empty()) {
+			cache.reset(new ImportCache(cacheDirectory,
+				static_cast<uint64_t>(GetPropertyInteger(AI_CONFIG_IMPORT_CACHE_MAX_SIZE,AI_IMPORT_CACHE_DEFAULT_MAX_SIZE)) << 20));
+
+			cacheKey = ImportCache::ComputeKey(sourceIO,pFile,pFlags,pimpl);
+			pimpl->mScene = cache->Lookup(this,sourceIO,cacheKey);
+			if (pimpl->mScene) {
+				DefaultLogger::get()->info("Found the scene in the import cache");
+				ScenePriv(pimpl->mScene)->mPPStepsApplied |= pFlags;
+
+				if (profiler) {
+					profiler->EndRegion("total");
+				}
+				return pimpl->mScene;
+			}
+
+			// remember which other files the loader reads, they are part of the entry
+			recorder.reset(new DependencyRecorder(sourceIO,pFile));
+			ioHandler = recorder.get();
+		}
+#else
+		if (!cacheDirectory.empty()) {
+			DefaultLogger::get()->warn("The import cache is not available due to build settings");
+		}
+#endif
 
-			if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, false)) {
-				imp = pimpl->mImporter[a];
-				break;
+		if (profiler) {
+			profiler->BeginRegion("detect");
+		}
+
+		// Read the header of the file once, all importers check it from memory
+		ProbeIOSystem probe(ioHandler, pFile);
+
+		// progress is reported in bytes of the file as stored, compressed files aren't inflated to count them
+		const uint32_t fileSize = static_cast<uint32_t>(probe.GetFileSize());
+
+		// Find an worker class which can handle the file
+		BaseImporter* imp = FindReaderByExtension(pimpl, pFile, &probe);
+
+		// A gzip compressed file nobody claims is read through a decompressing
+		// IOSystem. Its format is detected from the name without the suffix.
+		std::string file = pFile;
+		IOSystem* io = ioHandler;
+		boost::scoped_ptr<CompressedIOSystem> compressedIO;
+
+		std::string stripped;
+		if (!imp && CompressedIOSystem::HasCompressedSuffix(pFile,&stripped)) {
+			compressedIO.reset(new CompressedIOSystem(ioHandler));
+			ProbeIOSystem compressedProbe(compressedIO.get(), stripped, false);
+
+			imp = FindReaderByExtension(pimpl, stripped, &compressedProbe);
+			if (!imp) {
+				imp = FindReaderBySignature(pimpl, compressedProbe);
+			}
+			if (imp) {
+				DefaultLogger::get()->info("Reading compressed file, format detected from " + stripped);
+				file = stripped;
+				io = compressedIO.get();
 			}
 		}
 
@@ -630,13 +970,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			const std::string::size_type s = pFile.find_last_of('.');
 			if (s != std::string::npos) {
 				DefaultLogger::get()->info("File extension not known, trying signature-based detection");
-				for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)	{
-
-					if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, true)) {
-						imp = pimpl->mImporter[a];
-						break;
-					}
-				}
+				imp = FindReaderBySignature(pimpl, probe);
 			}
 			// Put a proper error message if no suitable importer was found
 			if( !imp)	{
@@ -646,13 +980,8 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			}
 		}
 
-		// Get file size for progress handler
-		IOStream * fileIO = pimpl->mIOHandler->Open( pFile );
-		uint32_t fileSize = 0;
-		if (fileIO)
-		{
-			fileSize = fileIO->FileSize();
-			pimpl->mIOHandler->Close( fileIO );
+		if (profiler) {
+			profiler->EndRegion("detect");
 		}
 
 		// Dispatch the reading to the worker class for this format
@@ -663,7 +992,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			profiler->BeginRegion("import");
 		}
 
-		pimpl->mScene = imp->ReadFile( this, pFile, pimpl->mIOHandler);
+		pimpl->mScene = imp->ReadFile( this, file, io);
 		pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
 
 		if (profiler) {
@@ -677,11 +1006,19 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 			// The ValidateDS process is an exception. It is executed first, even before ScenePreprocessor is called.
 			if (pFlags & aiProcess_ValidateDataStructure)
 			{
+				if (profiler) {
+					profiler->BeginRegion("validate");
+				}
+
 				ValidateDSProcess ds;
 				ds.ExecuteOnScene (this);
 				if (!pimpl->mScene) {
 					return NULL;
 				}
+
+				if (profiler) {
+					profiler->EndRegion("validate");
+				}
 			}
 #endif // no validation
 
@@ -699,6 +1036,12 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 
 			// Ensure that the validation process won't be called twice
 			ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
+
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+			if (cache && pimpl->mScene) {
+				cache->Store(cacheKey,pimpl->mScene,recorder->GetDependencies());
+			}
+#endif
 		}
 		// if failed, extract the error string
 		else if( !pimpl->mScene) {
@@ -732,6 +1075,85 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags)
 	return pimpl->mScene;
 }
 
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Worker thread of ReadFileAsync()
+struct AsyncReadFile
+{
+	AsyncReadFile(Importer* imp, const char* file, unsigned int flags)
+		: imp(imp), file(file), flags(flags)
+	{}
+
+	void operator() ()
+	{
+		imp->ReadFile(file.c_str(),flags);
+		imp->Pimpl()->mAsyncRunning.Set(false);
+	}
+
+	Importer* imp;
+	std::string file;
+	unsigned int flags;
+};
+
+} // ! anon namespace
+#endif
+
+// ------------------------------------------------------------------------------------------------
+// Reads the given file in a worker thread
+ImportFuture Importer::ReadFileAsync( const char* pFile, unsigned int pFlags)
+{
+	// only one import at a time
+	ImportFuture(this).Get();
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	pimpl->mAsyncRunning.Set();
+	pimpl->mAsyncThread = new boost::thread(AsyncReadFile(this,pFile,pFlags));
+#else
+	ReadFile(pFile,pFlags);
+#endif
+	return ImportFuture(this);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImportFuture::IsReady() const
+{
+	ai_assert(NULL != mImporter);
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	const ImporterPimpl* pimpl = mImporter->Pimpl();
+	return !pimpl->mAsyncRunning.IsSet();
+#else
+	return true;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* ImportFuture::Get()
+{
+	ai_assert(NULL != mImporter);
+	ImporterPimpl* pimpl = mImporter->Pimpl();
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	if (pimpl->mAsyncThread) {
+		pimpl->mAsyncThread->join();
+		delete pimpl->mAsyncThread;
+		pimpl->mAsyncThread = NULL;
+	}
+#endif
+	// a cancel request which came too late must not affect the next import
+	pimpl->mCancelRequested.Set(false);
+	return pimpl->mScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImportFuture::Cancel()
+{
+	ai_assert(NULL != mImporter);
+	if (!IsReady()) {
+		mImporter->Pimpl()->mCancelRequested.Set();
+	}
+}
 
 // ------------------------------------------------------------------------------------------------
 // Apply post-processing to the currently bound scene
@@ -778,22 +1200,66 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags)
 	}
 #endif // ! DEBUG
 
-	boost::scoped_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
+	// Post-processing steps reallocate vertex and index arrays at will, 
+	// so meshes which reference external memory get their own copy
+	SceneCombiner::DetachExternalData(pimpl->mScene);
+
+	// collect the steps which are going to run
+	std::vector<BaseProcess*> steps;
+	std::vector<unsigned int> stepIndices;
 	for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)	{
 
-		BaseProcess* process = pimpl->mPostProcessingSteps[a];
-		pimpl->mProgressHandler->UpdatePostProcess( a, pimpl->mPostProcessingSteps.size() );
-		if( process->IsActive( pFlags))	{
+		// built-in steps which won't run are never instanced
+		BaseProcess* process = (pimpl->mStepFlags[a] & pFlags) ? GetPostProcessingStepAt(pimpl,a) : NULL;
+		if( process && process->IsActive( pFlags))	{
+			steps.push_back(process);
+			stepIndices.push_back(a);
+		}
+	}
 
-			if (profiler) {
-				profiler->BeginRegion("postprocess");
-			}
+	// each step reports its progress within its share of the post-processing phase
+	const float numSteps = static_cast<float>(pimpl->mPostProcessingSteps.size());
+	for( unsigned int a = 0; a < steps.size(); a++)	{
+		const size_t next = a + 1 < steps.size() ? stepIndices[a+1] : pimpl->mPostProcessingSteps.size();
+		steps[a]->SetProgressRange(0.5f + 0.5f * stepIndices[a] / numSteps, 0.5f * (next - stepIndices[a]) / numSteps);
+	}
 
-			process->ExecuteOnScene	( this );
+	// consecutive per-mesh steps are pipelined, unless the data structure 
+	// is to be revalidated after each single step
+	std::vector<PostProcessScheduler::Stage> stages;
+	if (GetPropertyBool(AI_CONFIG_PP_PIPELINE_MESHES,true) && !pimpl->bExtraVerbose) {
+		PostProcessScheduler::BuildStages(steps,stages);
+	}
+	else {
+		for( unsigned int a = 0; a < steps.size(); a++)	{
+			const PostProcessScheduler::Stage stage = {a,1,false};
+			stages.push_back(stage);
+		}
+	}
 
-			if (profiler) {
-				profiler->EndRegion("postprocess");
-			}
+	boost::scoped_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME,0)?new Profiler():NULL);
+	for( unsigned int a = 0; a < stages.size(); a++)	{
+		const PostProcessScheduler::Stage& stage = stages[a];
+		pimpl->mProgressHandler->UpdatePostProcess( stepIndices[stage.first], pimpl->mPostProcessingSteps.size() );
+
+		if (pimpl->mCancelRequested.IsSet()) {
+			pimpl->mErrorString = AI_IMPORT_CANCELLED_TEXT;
+			DefaultLogger::get()->error(pimpl->mErrorString);
+
+			delete pimpl->mScene;
+			pimpl->mScene = NULL;
+			break;
+		}
+
+		const std::string region = profiler ? GetStageName(steps,stepIndices,stage) : std::string();
+		if (profiler) {
+			profiler->BeginRegion(region);
+		}
+
+		PostProcessScheduler::ExecuteStage(this,steps,stage);
+
+		if (profiler) {
+			profiler->EndRegion(region);
 		}
 		if( !pimpl->mScene) {
 			break; 
@@ -850,7 +1316,7 @@ const aiImporterDesc* Importer::GetImporterInfo(size_t index) const
 	if (index >= pimpl->mImporter.size()) {
 		return NULL;
 	}
-	return pimpl->mImporter[index]->GetInfo();
+	return pimpl->mIndex->mInfo[index];
 }
 
 
@@ -860,7 +1326,7 @@ BaseImporter* Importer::GetImporter (size_t index) const
 	if (index >= pimpl->mImporter.size()) {
 		return NULL;
 	}
-	return pimpl->mImporter[index];
+	return GetImporterAt(pimpl,index);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -886,15 +1352,10 @@ size_t Importer::GetImporterIndex (const char* szExtension) const
 	}
 	std::transform(ext.begin(),ext.end(), ext.begin(), tolower);
 
-	std::set<std::string> str;
-	for (std::vector<BaseImporter*>::const_iterator i =  pimpl->mImporter.begin();i != pimpl->mImporter.end();++i)	{
-		str.clear();
-
-		(*i)->GetExtensionList(str);
-		for (std::set<std::string>::const_iterator it = str.begin(); it != str.end(); ++it) {
-			if (ext == *it) {
-				return std::distance(static_cast< std::vector<BaseImporter*>::const_iterator >(pimpl->mImporter.begin()), i);
-			}
+	for (size_t i = 0; i < pimpl->mImporter.size(); ++i)	{
+		const std::set<std::string>& str = pimpl->mIndex->mExtensions[i];
+		if (str.find(ext) != str.end()) {
+			return i;
 		}
 	}
 	ASSIMP_END_EXCEPTION_REGION(size_t);
@@ -907,8 +1368,8 @@ void Importer::GetExtensionList(aiString& szOut) const
 {
 	ASSIMP_BEGIN_EXCEPTION_REGION();
 	std::set<std::string> str;
-	for (std::vector<BaseImporter*>::const_iterator i =  pimpl->mImporter.begin();i != pimpl->mImporter.end();++i)	{
-		(*i)->GetExtensionList(str);
+	for (size_t i = 0; i < pimpl->mImporter.size(); ++i)	{
+		str.insert(pimpl->mIndex->mExtensions[i].begin(),pimpl->mIndex->mExtensions[i].end());
 	}
 
 	for (std::set<std::string>::const_iterator it = str.begin();; ) {
@@ -43,9 +43,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INCLUDED_AI_IMPORTER_H
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include "../include/assimp/matrix4x4.h"
+#include "BaseImporter.h"
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/thread.hpp>
+#endif
 
 struct aiScene;
 
@@ -56,8 +62,71 @@ namespace Assimp	{
 	class BaseProcess;
 	class SharedPostProcessInfo;
 
+	/** Creates a new instance of a built-in importer */
+	typedef BaseImporter* (*ImporterFactory)();
+
+	/** Creates a new instance of a built-in post-processing step */
+	typedef BaseProcess* (*PostProcessingStepFactory)();
+
 	
 //! @cond never
+// ---------------------------------------------------------------------------
+/** @brief Lookup tables for format detection, one entry per importer.
+ *
+ *  Filled from the importers' static data, so it can be built without 
+ *  keeping instances of them around. */
+struct ImporterIndex
+{
+	// importer indices by file extension, in ascending order
+	typedef std::map<std::string, std::vector<unsigned int> > ExtensionMap;
+
+	/** Importers by the last part of their file extensions (i.e. 'xml' 
+	 *  for 'mesh.xml'), lowercase. */
+	ExtensionMap mByExtension;
+
+	/** File extensions of each importer, see BaseImporter::GetExtensionList() */
+	std::vector< std::set<std::string> > mExtensions;
+
+	/** Magic tokens of each importer, see BaseImporter::GetMagicTokens() */
+	std::vector< std::vector<MagicToken> > mMagicTokens;
+
+	/** Description of each importer, see BaseImporter::GetInfo() */
+	std::vector< const aiImporterDesc* > mInfo;
+
+	// -------------------------------------------------------------------
+	/** Append an importer to the tables */
+	void Add(const aiImporterDesc* info, const std::set<std::string>& extensions,
+		const std::vector<MagicToken>& tokens);
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Process-wide registry of the built-in importers and 
+ *    post-processing steps.
+ *
+ *  It is built on first use and never changes afterwards, thus it is shared
+ *  by all Importer instances. Importers and steps are only instanced by an 
+ *  Importer once it actually needs them. */
+struct SharedRegistry
+{
+	/** Factories of all built-in importers */
+	std::vector< ImporterFactory > mImporterFactories;
+
+	/** Lookup tables for #mImporterFactories */
+	ImporterIndex mImporterIndex;
+
+	/** Factories of all built-in post-processing steps, in order of execution */
+	std::vector< PostProcessingStepFactory > mStepFactories;
+
+	/** The flags each step in #mStepFactories responds to, i.e. each
+	 *  single flag for which BaseProcess::IsActive() returns true. */
+	std::vector< unsigned int > mStepFlags;
+};
+
+// ---------------------------------------------------------------------------
+/** Get the process-wide registry, build it if necessary */
+const SharedRegistry& GetSharedRegistry();
+
+
 // ---------------------------------------------------------------------------
 /** @brief Internal PIMPL implementation for Assimp::Importer
  *
@@ -89,12 +158,29 @@ public:
 	ProgressHandler* mProgressHandler;
 	bool mIsDefaultProgressHandler;
 
-	/** Format-specific importer worker objects - one for each format we can read.*/
+	/** Format-specific importer worker objects - one for each format we can read.
+	 *  Built-in importers are NULL until they are needed the first time. */
 	std::vector< BaseImporter* > mImporter;
 
-	/** Post processing steps we can apply at the imported data. */
+	/** Factory of each entry in #mImporter, NULL for custom loaders */
+	std::vector< ImporterFactory > mImporterFactories;
+
+	/** Lookup tables for #mImporter. Refers to the shared registry unless
+	 *  the list of importers has been changed, then to #mCustomIndex. */
+	const ImporterIndex* mIndex;
+	ImporterIndex mCustomIndex;
+
+	/** Post processing steps we can apply at the imported data. Built-in
+	 *  steps are NULL until they are needed the first time. */
 	std::vector< BaseProcess* > mPostProcessingSteps;
 
+	/** Factory of each entry in #mPostProcessingSteps, NULL for custom steps */
+	std::vector< PostProcessingStepFactory > mStepFactories;
+
+	/** Flags each entry in #mPostProcessingSteps responds to, ~0u for
+	 *  custom steps. See SharedRegistry::mStepFlags */
+	std::vector< unsigned int > mStepFlags;
+
 	/** The imported data, if ReadFile() was successful, NULL otherwise. */
 	aiScene* mScene;
 
@@ -119,6 +205,19 @@ public:
 
 	/** Used by post-process steps to share data */
 	SharedPostProcessInfo* mPPShared;
+
+	/** Set by ImportFuture::Cancel(), loaders and post-process steps 
+	 *  poll it to abort the running import */
+	AtomicFlag mCancelRequested;
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	/** Worker thread of the running ReadFileAsync() call, NULL if none */
+	boost::thread* mAsyncThread;
+
+	/** Set by ReadFileAsync() before the worker thread is started, 
+	 *  cleared by the worker thread once the import has finished */
+	AtomicFlag mAsyncRunning;
+#endif
 };
 //! @endcond
 
@@ -46,6 +46,8 @@ directly (unless you are adding new loaders), instead use the
 corresponding preprocessor flag to selectively disable formats.
 */
 
+#include "Importer.h"
+
 // ------------------------------------------------------------------------------------------------
 // Importers
 // (include_new_importers_here)
@@ -181,139 +183,146 @@ corresponding preprocessor flag to selectively disable formats.
 namespace Assimp {
 
 // ------------------------------------------------------------------------------------------------
-void GetImporterInstanceList(std::vector< BaseImporter* >& out)
+template <typename T>
+static BaseImporter* CreateImporter()
+{
+    return new T();
+}
+
+// ------------------------------------------------------------------------------------------------
+void GetImporterFactoryList(std::vector< ImporterFactory >& out)
 {
     // ----------------------------------------------------------------------------
-    // Add an instance of each worker class here
+    // Add a factory for each worker class here
     // (register_new_importers_here)
     // ----------------------------------------------------------------------------
     out.reserve(64);
 #if (!defined ASSIMP_BUILD_NO_X_IMPORTER)
-    out.push_back( new XFileImporter());
+    out.push_back( &CreateImporter< XFileImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_OBJ_IMPORTER)
-    out.push_back( new ObjFileImporter());
+    out.push_back( &CreateImporter< ObjFileImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_3DS_IMPORTER)
-    out.push_back( new Discreet3DSImporter());
+    out.push_back( &CreateImporter< Discreet3DSImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_MD3_IMPORTER)
-    out.push_back( new MD3Importer());
+    out.push_back( &CreateImporter< MD3Importer > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_MD2_IMPORTER)
-    out.push_back( new MD2Importer());
+    out.push_back( &CreateImporter< MD2Importer > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_PLY_IMPORTER)
-    out.push_back( new PLYImporter());
+    out.push_back( &CreateImporter< PLYImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_MDL_IMPORTER)
-    out.push_back( new MDLImporter());
+    out.push_back( &CreateImporter< MDLImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_ASE_IMPORTER)
-    out.push_back( new ASEImporter());
+    out.push_back( &CreateImporter< ASEImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_HMP_IMPORTER)
-    out.push_back( new HMPImporter());
+    out.push_back( &CreateImporter< HMPImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_SMD_IMPORTER)
-    out.push_back( new SMDImporter());
+    out.push_back( &CreateImporter< SMDImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_MDC_IMPORTER)
-    out.push_back( new MDCImporter());
+    out.push_back( &CreateImporter< MDCImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_MD5_IMPORTER)
-    out.push_back( new MD5Importer());
+    out.push_back( &CreateImporter< MD5Importer > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_STL_IMPORTER)
-    out.push_back( new STLImporter());
+    out.push_back( &CreateImporter< STLImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_LWO_IMPORTER)
-    out.push_back( new LWOImporter());
+    out.push_back( &CreateImporter< LWOImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_DXF_IMPORTER)
-    out.push_back( new DXFImporter());
+    out.push_back( &CreateImporter< DXFImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_NFF_IMPORTER)
-    out.push_back( new NFFImporter());
+    out.push_back( &CreateImporter< NFFImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_RAW_IMPORTER)
-    out.push_back( new RAWImporter());
+    out.push_back( &CreateImporter< RAWImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_OFF_IMPORTER)
-    out.push_back( new OFFImporter());
+    out.push_back( &CreateImporter< OFFImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_AC_IMPORTER)
-    out.push_back( new AC3DImporter());
+    out.push_back( &CreateImporter< AC3DImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_BVH_IMPORTER)
-    out.push_back( new BVHLoader());
+    out.push_back( &CreateImporter< BVHLoader > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_IRRMESH_IMPORTER)
-    out.push_back( new IRRMeshImporter());
+    out.push_back( &CreateImporter< IRRMeshImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_IRR_IMPORTER)
-    out.push_back( new IRRImporter());
+    out.push_back( &CreateImporter< IRRImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_Q3D_IMPORTER)
-    out.push_back( new Q3DImporter());
+    out.push_back( &CreateImporter< Q3DImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_B3D_IMPORTER)
-    out.push_back( new B3DImporter());
+    out.push_back( &CreateImporter< B3DImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_COLLADA_IMPORTER)
-    out.push_back( new ColladaLoader());
+    out.push_back( &CreateImporter< ColladaLoader > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_TERRAGEN_IMPORTER)
-    out.push_back( new TerragenImporter());
+    out.push_back( &CreateImporter< TerragenImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_CSM_IMPORTER)
-    out.push_back( new CSMImporter());
+    out.push_back( &CreateImporter< CSMImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_3D_IMPORTER)
-    out.push_back( new UnrealImporter());
+    out.push_back( &CreateImporter< UnrealImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_LWS_IMPORTER)
-    out.push_back( new LWSImporter());
+    out.push_back( &CreateImporter< LWSImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_OGRE_IMPORTER)
-    out.push_back( new Ogre::OgreImporter());
+    out.push_back( &CreateImporter< Ogre::OgreImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_OPENGEX_IMPORTER )
-    out.push_back( new OpenGEX::OpenGEXImporter() );
+    out.push_back( &CreateImporter< OpenGEX::OpenGEXImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_MS3D_IMPORTER)
-    out.push_back( new MS3DImporter());
+    out.push_back( &CreateImporter< MS3DImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_COB_IMPORTER)
-    out.push_back( new COBImporter());
+    out.push_back( &CreateImporter< COBImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_BLEND_IMPORTER)
-    out.push_back( new BlenderImporter());
+    out.push_back( &CreateImporter< BlenderImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_Q3BSP_IMPORTER)
-    out.push_back( new Q3BSPFileImporter() );
+    out.push_back( &CreateImporter< Q3BSPFileImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_NDO_IMPORTER)
-    out.push_back( new NDOImporter() );
+    out.push_back( &CreateImporter< NDOImporter > );
 #endif
 #if (!defined ASSIMP_BUILD_NO_IFC_IMPORTER)
-    out.push_back( new IFCImporter() );
+    out.push_back( &CreateImporter< IFCImporter > );
 #endif
 #if ( !defined ASSIMP_BUILD_NO_XGL_IMPORTER )
-    out.push_back( new XGLImporter() );
+    out.push_back( &CreateImporter< XGLImporter > );
 #endif
 #if ( !defined ASSIMP_BUILD_NO_FBX_IMPORTER )
-    out.push_back( new FBXImporter() );
+    out.push_back( &CreateImporter< FBXImporter > );
 #endif
 #if ( !defined ASSIMP_BUILD_NO_BK3D_IMPORTER )
-	out.push_back(new Bk3dImporter());
+	out.push_back( &CreateImporter< Bk3dImporter > );
 #endif
 #if ( !defined ASSIMP_BUILD_NO_ASSBIN_IMPORTER )
-    out.push_back( new AssbinImporter() );
+    out.push_back( &CreateImporter< AssbinImporter > );
 #endif
 
 #ifndef ASSIMP_BUILD_NO_C4D_IMPORTER
-    out.push_back( new C4DImporter() );
+    out.push_back( &CreateImporter< C4DImporter > );
 #endif
 }
 
@@ -90,18 +90,50 @@ void ImproveCacheLocalityProcess::SetupProperties(const Importer* pImp)
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void ImproveCacheLocalityProcess::Execute( aiScene* pScene)
+{
+	ExecuteMeshByMesh(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImproveCacheLocalityProcess::GetDataAccess( unsigned int& read, unsigned int& write) const
+{
+	read = PPData_MeshLocal;
+	write = PPData_Faces;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ImproveCacheLocalityProcess::IsPerMesh() const
+{
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImproveCacheLocalityProcess::BeginMeshes( aiScene* pScene)
+{
+	meshResults.assign(pScene->mNumMeshes,0.f);
+	if (pScene->mNumMeshes) {
+		DefaultLogger::get()->debug("ImproveCacheLocalityProcess begin");
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImproveCacheLocalityProcess::ExecuteForMesh( aiScene* pScene, unsigned int meshIndex)
+{
+	meshResults[meshIndex] = ProcessMesh( pScene->mMeshes[meshIndex],meshIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ImproveCacheLocalityProcess::EndMeshes( aiScene* pScene)
 {
 	if (!pScene->mNumMeshes) {
 		DefaultLogger::get()->debug("ImproveCacheLocalityProcess skipped; there are no meshes");
 		return;
 	}
 
-	DefaultLogger::get()->debug("ImproveCacheLocalityProcess begin");
-
 	float out = 0.f;
 	unsigned int numf = 0, numm = 0;
 	for( unsigned int a = 0; a < pScene->mNumMeshes; a++){
-		const float res = ProcessMesh( pScene->mMeshes[a],a);
+		const float res = meshResults[a];
 		if (res) {
 			numf += pScene->mMeshes[a]->mNumFaces;
 			out  += res;
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_IMPROVECACHELOCALITY_H_INC
 
 #include "BaseProcess.h"
+#include <vector>
 #include "../include/assimp/types.h"
 
 struct aiMesh;
@@ -71,6 +72,18 @@ public:
 	// Check whether the pp step is active
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "ImproveCacheLocalityProcess"; }
+
+	// -------------------------------------------------------------------
+	/** Per-mesh execution, see BaseProcess::IsPerMesh() */
+	void GetDataAccess( unsigned int& read, unsigned int& write) const;
+	bool IsPerMesh() const;
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteForMesh( aiScene* pScene, unsigned int meshIndex);
+	void EndMeshes( aiScene* pScene);
+
 	// -------------------------------------------------------------------
 	// Executes the pp step on a given scene
 	void Execute( aiScene* pScene);
@@ -91,6 +104,9 @@ private:
 	//! Configuration parameter: specifies the size of the cache to
 	//! optimize the vertex data for.
 	unsigned int configCacheDepth;
+
+	/** Results of the meshes processed by ExecuteForMesh() */
+	std::vector<float> meshResults;
 };
 
 } // end of namespace Assimp
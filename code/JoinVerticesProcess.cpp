@@ -77,21 +77,49 @@ bool JoinVerticesProcess::IsActive( unsigned int pFlags) const
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void JoinVerticesProcess::Execute( aiScene* pScene)
+{
+	ExecuteMeshByMesh(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+void JoinVerticesProcess::GetDataAccess( unsigned int& read, unsigned int& write) const
+{
+	read = PPData_MeshLocal;
+	write = PPData_MeshLocal | PPData_SceneFlags;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool JoinVerticesProcess::IsPerMesh() const
+{
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void JoinVerticesProcess::BeginMeshes( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("JoinVerticesProcess begin");
+	meshResults.assign(pScene->mNumMeshes,std::pair<int,int>(0,0));
+}
 
-	// get the total number of vertices BEFORE the step is executed
-	int iNumOldVertices = 0;
-	if (!DefaultLogger::isNullLogger()) {
-		for( unsigned int a = 0; a < pScene->mNumMeshes; a++)	{
-			iNumOldVertices +=	pScene->mMeshes[a]->mNumVertices;
-		}
-	}
+// ------------------------------------------------------------------------------------------------
+void JoinVerticesProcess::ExecuteForMesh( aiScene* pScene, unsigned int meshIndex)
+{
+	aiMesh* const mesh = pScene->mMeshes[meshIndex];
 
-	// execute the step
-	int iNumVertices = 0;
-	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-		iNumVertices +=	ProcessMesh( pScene->mMeshes[a],a);
+	// get the number of vertices BEFORE the step is executed
+	meshResults[meshIndex].first = mesh->mNumVertices;
+	meshResults[meshIndex].second = ProcessMesh( mesh,meshIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+void JoinVerticesProcess::EndMeshes( aiScene* pScene)
+{
+	int iNumOldVertices = 0, iNumVertices = 0;
+	for( unsigned int a = 0; a < meshResults.size(); a++)	{
+		iNumOldVertices += meshResults[a].first;
+		iNumVertices +=	meshResults[a].second;
+	}
+	meshResults.clear();
 
 	// if logging is active, print detailed statistics
 	if (!DefaultLogger::isNullLogger())
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_JOINVERTICESPROCESS_H_INC
 
 #include "BaseProcess.h"
+#include <vector>
 #include "../include/assimp/types.h"
 struct aiMesh;
 
@@ -74,6 +75,18 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "JoinVerticesProcess"; }
+
+	// -------------------------------------------------------------------
+	/** Per-mesh execution, see BaseProcess::IsPerMesh() */
+	void GetDataAccess( unsigned int& read, unsigned int& write) const;
+	bool IsPerMesh() const;
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteForMesh( aiScene* pScene, unsigned int meshIndex);
+	void EndMeshes( aiScene* pScene);
+
 	// -------------------------------------------------------------------
 	/** Executes the post processing step on the given imported data.
 	* At the moment a process is not supposed to fail.
@@ -90,6 +103,9 @@ public:
 	int ProcessMesh( aiMesh* pMesh, unsigned int meshIndex);
 
 private:
+
+	/** Vertex counts (before, after) of the meshes processed by ExecuteForMesh() */
+	std::vector< std::pair<int,int> > meshResults;
 };
 
 } // end of namespace Assimp
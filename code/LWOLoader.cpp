@@ -95,15 +95,22 @@ bool LWOImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler, bool
 
 	// if check for extension is not enough, check for the magic tokens 
 	if (!extension.length() || checkSig) {
-		uint32_t tokens[3]; 
-		tokens[0] = AI_LWO_FOURCC_LWOB;
-		tokens[1] = AI_LWO_FOURCC_LWO2;
-		tokens[2] = AI_LWO_FOURCC_LXOB;
-		return CheckMagicToken(pIOHandler,pFile,tokens,3,8);
+		return CheckMagicTokens(pIOHandler,pFile);
 	}
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens checked by CanRead()
+void LWOImporter::GetMagicTokens(std::vector<MagicToken>& tokens) const
+{
+	uint32_t magic[3]; 
+	magic[0] = AI_LWO_FOURCC_LWOB;
+	magic[1] = AI_LWO_FOURCC_LWO2;
+	magic[2] = AI_LWO_FOURCC_LXOB;
+	AddMagicTokens(tokens,magic,3,8);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties
 void LWOImporter::SetupProperties(const Importer* pImp)
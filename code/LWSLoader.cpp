@@ -151,14 +151,21 @@ bool LWSImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler,bool c
 
 	// if check for extension is not enough, check for the magic tokens LWSC and LWMO
 	if (!extension.length() || checkSig) {
-		uint32_t tokens[2]; 
-		tokens[0] = AI_MAKE_MAGIC("LWSC");
-		tokens[1] = AI_MAKE_MAGIC("LWMO");
-		return CheckMagicToken(pIOHandler,pFile,tokens,2);
+		return CheckMagicTokens(pIOHandler,pFile);
 	}
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens checked by CanRead()
+void LWSImporter::GetMagicTokens(std::vector<MagicToken>& tokens) const
+{
+	uint32_t magic[2]; 
+	magic[0] = AI_MAKE_MAGIC("LWSC");
+	magic[1] = AI_MAKE_MAGIC("LWMO");
+	AddMagicTokens(tokens,magic,2);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get list of file extensions
 const aiImporterDesc* LWSImporter::GetInfo () const
@@ -301,6 +308,19 @@ unexpected_end:
 	DefaultLogger::get()->error("LWS: Encountered unexpected end of file while parsing object motion");
 }
 
+// ------------------------------------------------------------------------------------------------
+// Set a node name of the form <name>_(<hex id>). The name is cropped to fit into an aiString.
+static void SetNodeName(aiString& out, const std::string& name, unsigned int combined)
+{
+	char suffix[16];
+	::sprintf(suffix,"_(%08X)",combined);
+
+	const size_t len = std::min(name.length(),MAXLEN-1-::strlen(suffix));
+	::memcpy(out.data,name.c_str(),len);
+	::strcpy(out.data+len,suffix);
+	out.length = len + ::strlen(suffix);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup a nice name for a node 
 void LWSImporter::SetupNodeName(aiNode* nd, LWS::NodeDesc& src)
@@ -318,11 +338,11 @@ void LWSImporter::SetupNodeName(aiNode* nd, LWS::NodeDesc& src)
 			else ++s;
             std::string::size_type t = src.path.substr(s).find_last_of(".");
 			
-			nd->mName.length = ::sprintf(nd->mName.data,"%s_(%08X)",src.path.substr(s).substr(0,t).c_str(),combined);
+			SetNodeName(nd->mName,src.path.substr(s).substr(0,t),combined);
 			return;
 		}
 	}
-	nd->mName.length = ::sprintf(nd->mName.data,"%s_(%08X)",src.name,combined);
+	SetNodeName(nd->mName,src.name ? src.name : "",combined);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -42,6 +42,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "LimitBoneWeightsProcess.h"
+#include "ParallelFor.h"
 #include "../include/assimp/postprocess.h"
 #include "../include/assimp/DefaultLogger.hpp"
 #include "../include/assimp/scene.h"
@@ -49,12 +50,134 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace Assimp;
 
+namespace {
+
+typedef LimitBoneWeightsProcess::Weight Weight;
+
+// number of vertices in a single work item of the parallel pass
+const unsigned int VERTICES_PER_ITEM = 4096;
+
+// ------------------------------------------------------------------------------------------------
+// Quantize the normalized weights of a vertex, unused slots get a weight of 0
+template <typename T>
+void QuantizeWeights(T* pOut, const Weight* pWeights, unsigned int pNum, unsigned int pSlots, float pScale, unsigned int pMax)
+{
+	unsigned int sum = 0;
+	for (unsigned int i = 0; i < pSlots; ++i) {
+		const unsigned int q = i < pNum ? static_cast<unsigned int>(pWeights[i].mWeight * pScale * pMax + 0.5f) : 0;
+		pOut[i] = static_cast<T>(q);
+		sum += q;
+	}
+	// the weights are sorted, the largest one takes the rounding error
+	if (sum) {
+		pOut[0] = static_cast<T>(pOut[0] + pMax - sum);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Functor to limit the weights of all vertices of a mesh with ParallelFor(). The
+// weights of a vertex are stored consecutively in a single array for all vertices.
+struct VertexWorker
+{
+	VertexWorker(unsigned int pMaxWeights, unsigned int pNumVertices, const unsigned int* pOffsets,
+		Weight* pWeights, unsigned int* pNumWeights, aiSkinStream* pStream, unsigned int* pRemoved)
+		: maxWeights(pMaxWeights), numVertices(pNumVertices), offsets(pOffsets), weights(pWeights)
+		, numWeights(pNumWeights), stream(pStream), removed(pRemoved)
+	{}
+
+	void operator() (unsigned int pItem)
+	{
+		const unsigned int end = std::min(numVertices, (pItem + 1) * VERTICES_PER_ITEM);
+		unsigned int rem = 0;
+		for (unsigned int v = pItem * VERTICES_PER_ITEM; v < end; ++v) {
+			Weight* const w = weights + offsets[v];
+			unsigned int num = offsets[v+1] - offsets[v];
+
+			if (num > maxWeights) {
+				// more than the defined maximum -> move the largest weights to the front, in 
+				// descending order. That's why we defined the < operator in such a weird way.
+				std::partial_sort(w, w + maxWeights, w + num);
+				rem += num - maxWeights;
+				num = maxWeights;
+
+				// and renormalize the weights
+				float sum = 0.0f;
+				for (unsigned int i = 0; i < num; ++i) {
+					sum += w[i].mWeight;
+				}
+				if (0.0f != sum) {
+					const float invSum = 1.0f / sum;
+					for (unsigned int i = 0; i < num; ++i) {
+						w[i].mWeight *= invSum;
+					}
+				}
+			}
+			else if (stream) {
+				std::sort(w, w + num);
+			}
+			numWeights[v] = num;
+
+			if (stream) {
+				WriteSkin(v, w, num);
+			}
+		}
+		removed[pItem] = rem;
+	}
+
+	// Store the sorted weights of a vertex in the skin stream
+	void WriteSkin(unsigned int v, const Weight* w, unsigned int num)
+	{
+		const unsigned int slots = stream->mNumInfluences;
+		const unsigned int n = std::min(num, slots);
+
+		// if there are more weights than slots, the remaining ones are renormalized
+		float sum = 0.0f;
+		for (unsigned int i = 0; i < n; ++i) {
+			sum += w[i].mWeight;
+		}
+		const float scale = 0.0f != sum ? 1.0f / sum : 0.0f;
+
+		unsigned short* const indices = stream->mBoneIndices + v * slots;
+		for (unsigned int i = 0; i < slots; ++i) {
+			indices[i] = i < n ? static_cast<unsigned short>(w[i].mBone) : 0;
+		}
+
+		switch (stream->mWeightBits)
+		{
+		case 8:
+			QuantizeWeights(stream->mWeights + v * slots, w, n, slots, scale, 0xff);
+			break;
+		case 16:
+			QuantizeWeights(reinterpret_cast<unsigned short*>(stream->mWeights) + v * slots, w, n, slots, scale, 0xffff);
+			break;
+		default:
+			{
+				float* const out = reinterpret_cast<float*>(stream->mWeights) + v * slots;
+				for (unsigned int i = 0; i < slots; ++i) {
+					out[i] = i < n ? w[i].mWeight * scale : 0.0f;
+				}
+			}
+		}
+	}
+
+	unsigned int maxWeights, numVertices;
+	const unsigned int* offsets;
+	Weight* weights;
+	unsigned int* numWeights;
+	aiSkinStream* stream;
+	unsigned int* removed;
+};
+
+} // !anon namespace
+
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 LimitBoneWeightsProcess::LimitBoneWeightsProcess()
 {
 	mMaxWeights = AI_LMW_MAX_WEIGHTS;
+	mSkinStreamInfluences = 0;
+	mSkinStreamBits = 32;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -88,113 +211,133 @@ void LimitBoneWeightsProcess::SetupProperties(const Importer* pImp)
 {
 	// get the current value of the property
 	this->mMaxWeights = pImp->GetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS,AI_LMW_MAX_WEIGHTS);
+
+	// the skin stream has either 4 or 8 slots per vertex
+	const int influences = pImp->GetPropertyInteger(AI_CONFIG_PP_LBW_SKIN_STREAM,0);
+	this->mSkinStreamInfluences = influences <= 0 ? 0 : (influences <= 4 ? 4 : 8);
+	if (influences > 8) {
+		DefaultLogger::get()->warn("LimitBoneWeightsProcess: skin streams have at most 8 influences per vertex");
+	}
+
+	const int bits = pImp->GetPropertyInteger(AI_CONFIG_PP_LBW_SKIN_STREAM_BITS,32);
+	this->mSkinStreamBits = (bits == 8 || bits == 16) ? bits : 32;
 }
 
 // ------------------------------------------------------------------------------------------------
-// Unites identical vertices in the given mesh
+// Limits the bone weight count for all vertices in the given mesh
 void LimitBoneWeightsProcess::ProcessMesh( aiMesh* pMesh)
 {
+	// an existing skin stream is replaced or outdated
+	delete pMesh->mSkinStream;
+	pMesh->mSkinStream = NULL;
+
 	if( !pMesh->HasBones())
 		return;
 
-	// collect all bone weights per vertex
-	typedef std::vector< std::vector< Weight > > WeightsPerVertex;
-	WeightsPerVertex vertexWeights( pMesh->mNumVertices);
-
-	// collect all weights per vertex
+	// collect all bone weights per vertex in a single array. Count them first
+	// to find the range of each vertex.
+	std::vector<unsigned int> offsets( pMesh->mNumVertices + 1, 0);
 	for( unsigned int a = 0; a < pMesh->mNumBones; a++)
 	{
 		const aiBone* bone = pMesh->mBones[a];
 		for( unsigned int b = 0; b < bone->mNumWeights; b++)
-		{
-			const aiVertexWeight& w = bone->mWeights[b];
-			vertexWeights[w.mVertexId].push_back( Weight( a, w.mWeight));
-		}
+			++offsets[bone->mWeights[b].mVertexId + 1];
 	}
+	for( unsigned int a = 0; a < pMesh->mNumVertices; a++)
+		offsets[a+1] += offsets[a];
 
-	unsigned int removed = 0, old_bones = pMesh->mNumBones;
+	if( !offsets.back())
+		return;
 
-	// now cut the weight count if it exceeds the maximum
-	bool bChanged = false;
-	for( WeightsPerVertex::iterator vit = vertexWeights.begin(); vit != vertexWeights.end(); ++vit)
+	std::vector<Weight> weights( offsets.back());
 	{
-		if( vit->size() <= mMaxWeights)
-			continue;
+		std::vector<unsigned int> next( offsets.begin(), offsets.end() - 1);
+		for( unsigned int a = 0; a < pMesh->mNumBones; a++)
+		{
+			const aiBone* bone = pMesh->mBones[a];
+			for( unsigned int b = 0; b < bone->mNumWeights; b++)
+			{
+				const aiVertexWeight& w = bone->mWeights[b];
+				weights[next[w.mVertexId]++] = Weight( a, w.mWeight);
+			}
+		}
+	}
 
-		bChanged = true;
+	aiSkinStream* stream = NULL;
+	if (mSkinStreamInfluences) {
+		if (pMesh->mNumBones > USHRT_MAX + 1) {
+			DefaultLogger::get()->warn("LimitBoneWeightsProcess: too many bones for a skin stream");
+		}
+		else {
+			stream = pMesh->mSkinStream = new aiSkinStream();
+			stream->mNumVertices = pMesh->mNumVertices;
+			stream->mNumInfluences = mSkinStreamInfluences;
+			stream->mWeightBits = mSkinStreamBits;
+			stream->mBoneIndices = new unsigned short[pMesh->mNumVertices * mSkinStreamInfluences];
+			stream->mWeights = new unsigned char[pMesh->mNumVertices * mSkinStreamInfluences * mSkinStreamBits / 8];
+		}
+	}
 
-		// more than the defined maximum -> first sort by weight in descending order. That's 
-		// why we defined the < operator in such a weird way.
-		std::sort( vit->begin(), vit->end());
+	// now cut the weight count if it exceeds the maximum and fill the skin stream
+	std::vector<unsigned int> numWeights( pMesh->mNumVertices);
+	const unsigned int numItems = (pMesh->mNumVertices + VERTICES_PER_ITEM - 1) / VERTICES_PER_ITEM;
+	std::vector<unsigned int> removedPerItem( numItems);
 
-		// now kill everything beyond the maximum count
-		unsigned int m = vit->size();
-		vit->erase( vit->begin() + mMaxWeights, vit->end());
-		removed += m-vit->size();
+	VertexWorker worker( mMaxWeights, pMesh->mNumVertices, &offsets[0], &weights[0], 
+		&numWeights[0], stream, &removedPerItem[0]);
+	ParallelFor( numItems, worker);
 
-		// and renormalize the weights
-		float sum = 0.0f;
-        for( std::vector<Weight>::const_iterator it = vit->begin(); it != vit->end(); ++it ) {
-            sum += it->mWeight;
-        }
-        if( 0.0f != sum ) {
-            const float invSum = 1.0f / sum;
-            for( std::vector<Weight>::iterator it = vit->begin(); it != vit->end(); ++it ) {
-                it->mWeight *= invSum;
-            }
-        }
-	}
+	unsigned int removed = 0, old_bones = pMesh->mNumBones;
+	for( unsigned int a = 0; a < numItems; a++)
+		removed += removedPerItem[a];
 
-	if (bChanged)	{
-		// rebuild the vertex weight array for all bones 
-		typedef std::vector< std::vector< aiVertexWeight > > WeightsPerBone;
-		WeightsPerBone boneWeights( pMesh->mNumBones);
-		for( unsigned int a = 0; a < vertexWeights.size(); a++)
+	if (!removed)
+		return;
+
+	// rebuild the vertex weight array for all bones. There are less weights than
+	// before, so the old arrays can be reused.
+	std::vector<unsigned int> boneWeights( pMesh->mNumBones, 0);
+	for( unsigned int a = 0; a < pMesh->mNumVertices; a++)
+	{
+		const Weight* w = &weights[offsets[a]];
+		for( unsigned int b = 0; b < numWeights[a]; b++)
 		{
-			const std::vector<Weight>& vw = vertexWeights[a];
-			for( std::vector<Weight>::const_iterator it = vw.begin(); it != vw.end(); ++it)
-				boneWeights[it->mBone].push_back( aiVertexWeight( a, it->mWeight));
+			aiBone* bone = pMesh->mBones[w[b].mBone];
+			ai_assert( boneWeights[w[b].mBone] < bone->mNumWeights);
+			bone->mWeights[boneWeights[w[b].mBone]++] = aiVertexWeight( a, w[b].mWeight);
 		}
+	}
 
-		// and finally copy the vertex weight list over to the mesh's bones
-		std::vector<bool> abNoNeed(pMesh->mNumBones,false);
-		bChanged = false;
-
-		for( unsigned int a = 0; a < pMesh->mNumBones; a++)
+	// and remove all bones which lost all of their weights
+	std::vector<unsigned int> newIndex( pMesh->mNumBones);
+	unsigned int numBones = 0;
+	for( unsigned int a = 0; a < pMesh->mNumBones; a++)
+	{
+		aiBone* bone = pMesh->mBones[a];
+		if( !boneWeights[a])
 		{
-			const std::vector<aiVertexWeight>& bw = boneWeights[a];
-			aiBone* bone = pMesh->mBones[a];
-
-			if ( bw.empty() )
-			{
-				abNoNeed[a] = bChanged = true;
-				continue;
-			}
-
-			// copy the weight list. should always be less weights than before, so we don't need a new allocation
-			ai_assert( bw.size() <= bone->mNumWeights);
-			bone->mNumWeights = static_cast<unsigned int>( bw.size() );
-			::memcpy( bone->mWeights, &bw[0], bw.size() * sizeof( aiVertexWeight));
+			delete bone;
+			newIndex[a] = UINT_MAX;
+			continue;
 		}
+		bone->mNumWeights = boneWeights[a];
+		newIndex[a] = numBones;
+		pMesh->mBones[numBones++] = bone;
+	}
 
-		if (bChanged)	{
-			// the number of new bones is smaller than before, so we can reuse the old array
-			aiBone** ppcCur = pMesh->mBones;aiBone** ppcSrc = ppcCur;
-
-			for (std::vector<bool>::const_iterator iter  = abNoNeed.begin();iter != abNoNeed.end()  ;++iter)	{
-				if (*iter)	{
-					delete *ppcSrc;
-					--pMesh->mNumBones;
-				}
-				else *ppcCur++ = *ppcSrc;
-				++ppcSrc;
-			}
+	if (stream && numBones != pMesh->mNumBones)	{
+		// unused slots may refer to a removed bone
+		for( unsigned int a = 0; a < stream->mNumVertices * stream->mNumInfluences; a++)
+		{
+			const unsigned int n = newIndex[stream->mBoneIndices[a]];
+			stream->mBoneIndices[a] = n == UINT_MAX ? 0 : static_cast<unsigned short>(n);
 		}
+	}
+	pMesh->mNumBones = numBones;
 
-		if (!DefaultLogger::isNullLogger()) {
-			char buffer[1024];
-			::sprintf(buffer,"Removed %i weights. Input bones: %i. Output bones: %i",removed,old_bones,pMesh->mNumBones);
-			DefaultLogger::get()->info(buffer);
-		}
+	if (!DefaultLogger::isNullLogger()) {
+		char buffer[1024];
+		::sprintf(buffer,"Removed %i weights. Input bones: %i. Output bones: %i",removed,old_bones,pMesh->mNumBones);
+		DefaultLogger::get()->info(buffer);
 	}
 }
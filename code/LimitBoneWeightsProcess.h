@@ -68,7 +68,7 @@ namespace Assimp
 * to a certain maximum value. If a vertex is affected by more than that number
 * of bones, the bone weight with the least influence on this vertex are removed.
 * The other weights on this bone are then renormalized to assure the sum weight
-* to be 1.
+* to be 1. Optionally, the weights are also stored per vertex in aiMesh::mSkinStream.
 */
 class ASSIMP_API LimitBoneWeightsProcess : public BaseProcess
 {
@@ -87,6 +87,10 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "LimitBoneWeightsProcess"; }
+
 	// -------------------------------------------------------------------
 	/** Called prior to ExecuteOnScene().
 	* The function is a request to the process to update its configuration
@@ -97,7 +101,8 @@ public:
 public:
 
 	// -------------------------------------------------------------------
-	/** Limits the bone weight count for all vertices in the given mesh.
+	/** Limits the bone weight count for all vertices in the given mesh
+	* and generates the skin stream if requested.
 	* @param pMesh The mesh to process.
 	*/
 	void ProcessMesh( aiMesh* pMesh);
@@ -135,6 +140,13 @@ public:
 public:
 	/** Maximum number of bones influencing any single vertex. */
 	unsigned int mMaxWeights;
+
+	/** Number of influences per vertex in the skin stream, 0 if no skin
+	 *  stream is generated. */
+	unsigned int mSkinStreamInfluences;
+
+	/** Size of the weights in the skin stream, in bits */
+	unsigned int mSkinStreamBits;
 };
 
 } // end of namespace Assimp
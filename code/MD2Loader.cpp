@@ -109,13 +109,19 @@ bool MD2Importer::CanRead( const std::string& pFile, IOSystem* pIOHandler, bool
 
 	// if check for extension is not enough, check for the magic tokens 
 	if (!extension.length() || checkSig) {
-		uint32_t tokens[1]; 
-		tokens[0] = AI_MD2_MAGIC_NUMBER_LE;
-		return CheckMagicToken(pIOHandler,pFile,tokens,1);
+		return CheckMagicTokens(pIOHandler,pFile);
 	}
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens checked by CanRead()
+void MD2Importer::GetMagicTokens(std::vector<MagicToken>& tokens) const
+{
+	const uint32_t magic = AI_MD2_MAGIC_NUMBER_LE;
+	AddMagicTokens(tokens,&magic,1);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get a list of all extensions supported by this loader
 const aiImporterDesc* MD2Importer::GetInfo () const
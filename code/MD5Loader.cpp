@@ -733,7 +733,8 @@ void MD5Importer::LoadMD5CameraFile ()
 	for (std::vector<unsigned int>::const_iterator it = cuts.begin(); it != cuts.end()-1; ++it) {
 	
 		aiAnimation* anim = *tmp++ = new aiAnimation();
-		anim->mName.length = ::sprintf(anim->mName.data,"anim%u_from_%u_to_%u",(unsigned int)(it-cuts.begin()),(*it),*(it+1));
+		::snprintf(anim->mName.data,MAXLEN,"anim%u_from_%u_to_%u",(unsigned int)(it-cuts.begin()),(*it),*(it+1));
+		anim->mName.length = ::strlen(anim->mName.data);
 		
 		anim->mTicksPerSecond = cameraParser.fFrameRate;
 		anim->mChannels = new aiNodeAnim*[anim->mNumChannels = 1];
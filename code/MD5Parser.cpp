@@ -224,7 +224,7 @@ bool MD5Parser::ParseSection(Section& out)
 			continue; \
 		} \
 	} \
-	out.length = (size_t)(szEnd - szStart); \
+	out.length = std::min((size_t)(szEnd - szStart),MAXLEN-1); \
 	::memcpy(out.data,szStart,out.length); \
 	out.data[out.length] = '\0';
 
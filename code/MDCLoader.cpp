@@ -113,13 +113,19 @@ bool MDCImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler, bool
 
 	// if check for extension is not enough, check for the magic tokens 
 	if (!extension.length() || checkSig) {
-		uint32_t tokens[1]; 
-		tokens[0] = AI_MDC_MAGIC_NUMBER_LE;
-		return CheckMagicToken(pIOHandler,pFile,tokens,1);
+		return CheckMagicTokens(pIOHandler,pFile);
 	}
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens checked by CanRead()
+void MDCImporter::GetMagicTokens(std::vector<MagicToken>& tokens) const
+{
+	const uint32_t magic = AI_MDC_MAGIC_NUMBER_LE;
+	AddMagicTokens(tokens,&magic,1);
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc* MDCImporter::GetInfo () const
 {
@@ -104,20 +104,27 @@ bool MDLImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler, bool
 
 	// if check for extension is not enough, check for the magic tokens 
 	if (extension == "mdl"  || !extension.length() || checkSig) {
-		uint32_t tokens[8]; 
-		tokens[0] = AI_MDL_MAGIC_NUMBER_LE_HL2a;
-		tokens[1] = AI_MDL_MAGIC_NUMBER_LE_HL2b;
-		tokens[2] = AI_MDL_MAGIC_NUMBER_LE_GS7;
-		tokens[3] = AI_MDL_MAGIC_NUMBER_LE_GS5b;
-		tokens[4] = AI_MDL_MAGIC_NUMBER_LE_GS5a;
-		tokens[5] = AI_MDL_MAGIC_NUMBER_LE_GS4;
-		tokens[6] = AI_MDL_MAGIC_NUMBER_LE_GS3;
-		tokens[7] = AI_MDL_MAGIC_NUMBER_LE;
-		return CheckMagicToken(pIOHandler,pFile,tokens,8,0);
+		return CheckMagicTokens(pIOHandler,pFile);
 	}
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens checked by CanRead()
+void MDLImporter::GetMagicTokens(std::vector<MagicToken>& tokens) const
+{
+	uint32_t magic[8]; 
+	magic[0] = AI_MDL_MAGIC_NUMBER_LE_HL2a;
+	magic[1] = AI_MDL_MAGIC_NUMBER_LE_HL2b;
+	magic[2] = AI_MDL_MAGIC_NUMBER_LE_GS7;
+	magic[3] = AI_MDL_MAGIC_NUMBER_LE_GS5b;
+	magic[4] = AI_MDL_MAGIC_NUMBER_LE_GS5a;
+	magic[5] = AI_MDL_MAGIC_NUMBER_LE_GS4;
+	magic[6] = AI_MDL_MAGIC_NUMBER_LE_GS3;
+	magic[7] = AI_MDL_MAGIC_NUMBER_LE;
+	AddMagicTokens(tokens,magic,8,0);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties
 void MDLImporter::SetupProperties(const Importer* pImp)
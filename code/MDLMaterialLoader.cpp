@@ -535,7 +535,8 @@ void MDLImporter::ParseSkinLump_3DGS_MDL7(
 		size_t iLen2 = iLen+1;
 		iLen2 = iLen2 > MAXLEN ? MAXLEN : iLen2;
 		memcpy(szFile.data,(const char*)szCurrent,iLen2);
-		szFile.length = iLen;
+		szFile.length = iLen2-1;
+		szFile.data[szFile.length] = '\0';
 
 		szCurrent += iLen2;
 
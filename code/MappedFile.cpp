@@ -0,0 +1,148 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file MappedFile.cpp
+ *  @brief Implementation of the MappedFile class for Windows and POSIX systems
+ */
+
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#	include <windows.h>
+#	include <io.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#	include <sys/types.h>
+#	include <sys/stat.h>
+#	include <sys/mman.h>
+#	include <unistd.h>
+#	define AI_MAPPEDFILE_POSIX
+#endif
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+MappedFile::MappedFile()
+: data()
+, size()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+	Unmap();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool MappedFile::Map(FILE* file)
+{
+	Unmap();
+	if (!file) {
+		return false;
+	}
+
+#if defined(_WIN32)
+	HANDLE handle = reinterpret_cast<HANDLE>(::_get_osfhandle(::_fileno(file)));
+	if (handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!::GetFileSizeEx(handle,&fileSize) || fileSize.QuadPart <= 0 || 
+		static_cast<uint64_t>(fileSize.QuadPart) > static_cast<uint64_t>(SIZE_MAX)) {
+		return false;
+	}
+
+	HANDLE mapping = ::CreateFileMappingA(handle,NULL,PAGE_WRITECOPY,0,0,NULL);
+	if (!mapping) {
+		return false;
+	}
+	void* view = ::MapViewOfFile(mapping,FILE_MAP_COPY,0,0,0);
+
+	// the view keeps the mapping object alive
+	::CloseHandle(mapping);
+	if (!view) {
+		return false;
+	}
+
+	data = static_cast<uint8_t*>(view);
+	size = static_cast<size_t>(fileSize.QuadPart);
+	return true;
+
+#elif defined(AI_MAPPEDFILE_POSIX)
+	const int fd = ::fileno(file);
+	struct stat st;
+	if (fd < 0 || ::fstat(fd,&st) != 0 || st.st_size <= 0 || 
+		static_cast<uint64_t>(st.st_size) > static_cast<uint64_t>(SIZE_MAX)) {
+		return false;
+	}
+
+	void* view = ::mmap(NULL,static_cast<size_t>(st.st_size),PROT_READ | PROT_WRITE,MAP_PRIVATE,fd,0);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+
+	data = static_cast<uint8_t*>(view);
+	size = static_cast<size_t>(st.st_size);
+	return true;
+
+#else
+	return false;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void MappedFile::Unmap()
+{
+	if (!data) {
+		return;
+	}
+
+#if defined(_WIN32)
+	::UnmapViewOfFile(data);
+#elif defined(AI_MAPPEDFILE_POSIX)
+	::munmap(data,size);
+#endif
+
+	data = NULL;
+	size = 0;
+}
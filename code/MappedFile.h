@@ -0,0 +1,101 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file MappedFile.h
+ *  @brief Maps files into memory
+ */
+#ifndef AI_MAPPEDFILE_H_INC
+#define AI_MAPPEDFILE_H_INC
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stddef.h>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Copy-on-write mapping of a whole file.
+ *
+ *  Pages are loaded on first access and may be modified, modifications are never written 
+ *  back to the file. The mapping stays valid after the file handle has been closed. */
+// ------------------------------------------------------------------------------------------------
+class MappedFile
+{
+public:
+
+	MappedFile();
+	~MappedFile();
+
+public:
+
+	/** Maps the file behind a C stdio handle.
+	 *  @param file File opened for reading, it is not closed
+	 *  @return false if the platform doesn't support mapping files or the call failed */
+	bool Map(FILE* file);
+
+	/** Releases the mapping, invalidates all pointers into it */
+	void Unmap();
+
+	/** Returns the first byte of the file, NULL if nothing is mapped.
+	 *  The start of the mapping is page aligned. */
+	uint8_t* GetData() const {
+		return data;
+	}
+
+	/** Returns the number of bytes mapped */
+	size_t GetSize() const {
+		return size;
+	}
+
+private:
+
+	// noncopyable
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+	uint8_t* data;
+	size_t size;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_MAPPEDFILE_H_INC
@@ -56,49 +56,98 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 using namespace Assimp;
+
+static const std::string MaterialExt = ".mtl";
+
 namespace Assimp	{
 
 // ------------------------------------------------------------------------------------------------
 // Worker function for exporting a scene to Wavefront OBJ. Prototyped and registered in Exporter.cpp
 void ExportSceneObj(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
+	// open both the main OBJ file and the material script, the exporter streams directly into them
+	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
+	if(outfile == NULL) {
+		throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
+	} 
+
+	const std::string mtlFile = pFile + MaterialExt;
+	boost::scoped_ptr<IOStream> outfileMat (pIOSystem->Open(mtlFile,"wt"));
+	if(outfileMat == NULL) {
+		throw DeadlyExportError("could not open output .mtl file: " + mtlFile);
+	} 
+
 	// invoke the exporter 
-	ObjExporter exporter(pFile, pScene);
+	ObjExporter exporter(pFile, pScene, outfile.get(), outfileMat.get());
+}
 
-	// we're still here - export successfully completed. Write both the main OBJ file and the material script
+} // end of namespace Assimp
+
+// ------------------------------------------------------------------------------------------------
+// Formats a single 'v', 'vt' or 'vn' line
+struct ObjVectorFormatter
+{
+	ObjVectorFormatter(const char* prefix, const std::vector<aiVector3D>& vecs)
+		: prefix(prefix), vecs(&vecs)
+	{}
+
+	void operator() (TextWriter& out, size_t i) const
 	{
-		boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
-		if(outfile == NULL) {
-			throw DeadlyExportError("could not open output .obj file: " + std::string(pFile));
-		} 
-		outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+		const aiVector3D& v = (*vecs)[i];
+		out << prefix << v.x << ' ' << v.y << ' ' << v.z << '\n';
 	}
+
+	const char* prefix;
+	const std::vector<aiVector3D>* vecs;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Formats a single face of a mesh instance
+struct ObjExporter::FaceFormatter
+{
+	explicit FaceFormatter(const std::vector<Face>& faces)
+		: faces(&faces)
+	{}
+
+	void operator() (TextWriter& out, size_t i) const
 	{
-		boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(exporter.GetMaterialLibFileName(),"wt"));
-		if(outfile == NULL) {
-			throw DeadlyExportError("could not open output .mtl file: " + std::string(exporter.GetMaterialLibFileName()));
-		} 
-		outfile->Write( exporter.mOutputMat.str().c_str(), static_cast<size_t>(exporter.mOutputMat.tellp()),1);
-	}
-}
+		const Face& f = (*faces)[i];
+		out << f.kind << ' ';
+		BOOST_FOREACH(const FaceVertex& fv, f.indices) {
+			out << ' ' << fv.vp;
+
+			if (f.kind != 'p') {
+				if (fv.vt || f.kind == 'f') {
+					out << '/';
+				}
+				if (fv.vt) {
+					out << fv.vt;
+				}
+				if (f.kind == 'f' && fv.vn) {
+					out << '/' << fv.vn;
+				}
+			}
+		}
 
-} // end of namespace Assimp
+		out << '\n';
+	}
 
-static const std::string MaterialExt = ".mtl";
+	const std::vector<Face>* faces;
+};
 
 // ------------------------------------------------------------------------------------------------
-ObjExporter :: ObjExporter(const char* _filename, const aiScene* pScene)
-: filename(_filename)
+ObjExporter :: ObjExporter(const char* _filename, const aiScene* pScene, IOStream* output, IOStream* outputMat)
+: mOutput(output)
+, mOutputMat(outputMat)
+, filename(_filename)
 , pScene(pScene)
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
-	mOutputMat.imbue(l);
-
 	WriteGeometryFile();
 	WriteMaterialFile();
+
+	mOutput.Flush();
+	mOutputMat.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -121,7 +170,7 @@ std::string ObjExporter :: GetMaterialLibFileName()
 }
 
 // ------------------------------------------------------------------------------------------------
-void ObjExporter :: WriteHeader(std::ostringstream& out)
+void ObjExporter :: WriteHeader(TextWriter& out)
 {
 	out << "# File produced by Open Asset Import Library (http://www.assimp.sf.net)" << endl;
 	out << "# (assimp v" << aiGetVersionMajor() << '.' << aiGetVersionMinor() << '.' << aiGetVersionRevision() << ")" << endl  << endl;
@@ -217,25 +266,22 @@ void ObjExporter :: WriteGeometryFile()
 	// write vertex positions
 	vpMap.getVectors(vp);
 	mOutput << "# " << vp.size() << " vertex positions" << endl;
-	BOOST_FOREACH(const aiVector3D& v, vp) {
-		mOutput << "v  " << v.x << " " << v.y << " " << v.z << endl;
-	}
+	ObjVectorFormatter vpFormat("v  ",vp);
+	WriteParallel(mOutput,vp.size(),vpFormat);
 	mOutput << endl;
 
 	// write uv coordinates
 	vtMap.getVectors(vt);
 	mOutput << "# " << vt.size() << " UV coordinates" << endl;
-	BOOST_FOREACH(const aiVector3D& v, vt) {
-		mOutput << "vt " << v.x << " " << v.y << " " << v.z << endl;
-	}
+	ObjVectorFormatter vtFormat("vt ",vt);
+	WriteParallel(mOutput,vt.size(),vtFormat);
 	mOutput << endl;
 
 	// write vertex normals
 	vnMap.getVectors(vn);
 	mOutput << "# " << vn.size() << " vertex normals" << endl;
-	BOOST_FOREACH(const aiVector3D& v, vn) {
-		mOutput << "vn " << v.x << " " << v.y << " " << v.z << endl;
-	}
+	ObjVectorFormatter vnFormat("vn ",vn);
+	WriteParallel(mOutput,vn.size(),vnFormat);
 	mOutput << endl;
 
 	// now write all mesh instances
@@ -246,26 +292,8 @@ void ObjExporter :: WriteGeometryFile()
 		}
 		mOutput << "usemtl " << m.matname << endl;
 
-		BOOST_FOREACH(const Face& f, m.faces) {
-			mOutput << f.kind << ' ';
-			BOOST_FOREACH(const FaceVertex& fv, f.indices) {
-				mOutput << ' ' << fv.vp;
-
-				if (f.kind != 'p') {
-					if (fv.vt || f.kind == 'f') {
-						mOutput << '/';
-					}
-					if (fv.vt) {
-						mOutput << fv.vt;
-					}
-					if (f.kind == 'f' && fv.vn) {
-						mOutput << '/' << fv.vn;
-					}
-				}
-			}
-
-			mOutput << endl;
-		}
+		FaceFormatter faceFormat(m.faces);
+		WriteParallel(mOutput,m.faces.size(),faceFormat);
 		mOutput << endl;
 	}
 }
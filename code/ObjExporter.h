@@ -45,7 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_OBJEXPORTER_H_INC
 
 #include "../include/assimp/types.h"
-#include <sstream>
+#include "TextWriter.h"
 #include <vector>
 #include <map>
 
@@ -62,8 +62,9 @@ namespace Assimp
 class ObjExporter
 {
 public:
-	/// Constructor for a specific scene to export
-	ObjExporter(const char* filename, const aiScene* pScene);
+	/// Constructor for a specific scene to export. The geometry is written
+	/// to output, the material library to outputMat.
+	ObjExporter(const char* filename, const aiScene* pScene, IOStream* output, IOStream* outputMat);
 
 public:
 
@@ -72,8 +73,8 @@ public:
 	
 public:
 
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput, mOutputMat;
+	/// writers for the geometry and the material library
+	TextWriter mOutput, mOutputMat;
 
 private:
 
@@ -100,7 +101,9 @@ private:
 		std::vector<Face> faces;
 	};
 
-	void WriteHeader(std::ostringstream& out);
+	struct FaceFormatter;
+
+	void WriteHeader(TextWriter& out);
 
 	void WriteMaterialFile();
 	void WriteGeometryFile();
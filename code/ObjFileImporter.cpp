@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileImporter.h"
 #include "ObjFileParser.h"
 #include "ObjFileData.h"
+#include "ProgressReporter.h"
 #include <boost/scoped_ptr.hpp>
 #include "../include/assimp/Importer.hpp"
 #include "../include/assimp/scene.h"
@@ -161,7 +162,8 @@ void ObjFileImporter::InternReadFile( const std::string& pFile, aiScene* pScene,
     }
 
     // parse the file into a temporary representation
-    ObjFileParser parser(m_Buffer, strModelName, pIOHandler);
+    ProgressReporter reporter(progress, cancel, m_Buffer.size());
+    ObjFileParser parser(m_Buffer, strModelName, pIOHandler, &reporter);
 
     // And create the proper return structures out of it
     CreateDataFromImport(parser.GetModel(), pScene);
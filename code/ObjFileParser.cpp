@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../include/assimp/types.h"
 #include "DefaultIOSystem.h"
 #include "BaseImporter.h"
+#include "ProgressReporter.h"
 #include "../include/assimp/DefaultLogger.hpp"
 #include "../include/assimp/material.h"
 #include "../include/assimp/Importer.hpp"
@@ -62,12 +63,13 @@ const std::string ObjFileParser::DEFAULT_MATERIAL = AI_DEFAULT_MATERIAL_NAME;
 
 // -------------------------------------------------------------------
 //	Constructor with loaded data and directories.
-ObjFileParser::ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem *io ) :
+ObjFileParser::ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem *io, ProgressReporter* progress ) :
     m_DataIt(Data.begin()),
     m_DataItEnd(Data.end()),
     m_pModel(NULL),
     m_uiLine(0),
-    m_pIO( io )
+    m_pIO( io ),
+    m_pProgress( progress )
 {
     std::fill_n(m_buffer,BUFFERSIZE,0);
 
@@ -81,8 +83,13 @@ ObjFileParser::ObjFileParser(std::vector<char> &Data,const std::string &strModel
     m_pModel->m_MaterialLib.push_back( DEFAULT_MATERIAL );
     m_pModel->m_MaterialMap[ DEFAULT_MATERIAL ] = m_pModel->m_pDefaultMaterial;
     
-    // Start parsing the file
-    parseFile();
+    // Start parsing the file, the destructor won't run if it fails
+    try {
+        parseFile();
+    } catch( ... ) {
+        delete m_pModel;
+        throw;
+    }
 }
 
 // -------------------------------------------------------------------
@@ -107,8 +114,13 @@ void ObjFileParser::parseFile()
     if (m_DataIt == m_DataItEnd)
         return;
 
+    const DataArrayIt begin = m_DataIt;
     while (m_DataIt != m_DataItEnd)
     {
+        if (m_pProgress) {
+            m_pProgress->Update(m_DataIt - begin);
+        }
+
         switch (*m_DataIt)
         {
         case 'v': // Parse a vertex texture coordinate
@@ -60,6 +60,7 @@ struct Point2;
 }
 class ObjFileImporter;
 class IOSystem;
+class ProgressReporter;
 
 ///	\class	ObjFileParser
 ///	\brief	Parser for a obj waveform file
@@ -72,8 +73,8 @@ public:
     typedef std::vector<char>::const_iterator ConstDataArrayIt;
 
 public:
-    ///	\brief	Constructor with data array.
-    ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem* io);
+    ///	\brief	Constructor with data array, progress is reported in bytes if a reporter is given.
+    ObjFileParser(std::vector<char> &Data,const std::string &strModelName, IOSystem* io, ProgressReporter* progress = NULL);
     ///	\brief	Destructor
     ~ObjFileParser();
     ///	\brief	Model getter.
@@ -136,6 +137,8 @@ private:
     char m_buffer[BUFFERSIZE];
     ///	Pointer to IO system instance.
     IOSystem *m_pIO;
+    /// Progress reporter, may be NULL
+    ProgressReporter *m_pProgress;
 };
 
 }	// Namespace Assimp
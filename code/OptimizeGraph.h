@@ -73,6 +73,10 @@ public:
 	// -------------------------------------------------------------------
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "OptimizeGraphProcess"; }
+
 	// -------------------------------------------------------------------
 	void Execute( aiScene* pScene);
 	
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "SceneCombiner.h"
 #include "Exceptional.h"
+#include "ProgressReporter.h"
 
 using namespace Assimp;
 
@@ -136,7 +137,8 @@ void OptimizeMeshesProcess::Execute( aiScene* pScene)
 	}
 
 	// and process all nodes in the scenegraph recursively
-	ProcessNode(pScene->mRootNode);
+	ProgressReporter reporter = GetProgressReporter(num_old);
+	ProcessNode(pScene->mRootNode,reporter);
 	if (!output.size()) {
 		throw DeadlyImportError("OptimizeMeshes: No meshes remaining; there's definitely something wrong");
 	}
@@ -158,9 +160,10 @@ void OptimizeMeshesProcess::Execute( aiScene* pScene)
 
 // ------------------------------------------------------------------------------------------------
 // Process meshes for a single node
-void OptimizeMeshesProcess::ProcessNode( aiNode* pNode)
+void OptimizeMeshesProcess::ProcessNode( aiNode* pNode, ProgressReporter& reporter)
 {
 	for (unsigned int i = 0; i < pNode->mNumMeshes;++i) {
+		reporter.Update(output.size());
 		unsigned int& im = pNode->mMeshes[i];
 
 		if (meshes[im].instance_cnt > 1) {
@@ -179,6 +182,9 @@ void OptimizeMeshesProcess::ProcessNode( aiNode* pNode)
 					verts += mScene->mMeshes[am]->mNumVertices;
 					faces += mScene->mMeshes[am]->mNumFaces;
 
+					// the merged mesh takes its place, the scene must not delete it if we're cancelled
+					mScene->mMeshes[am] = NULL;
+
 					--pNode->mNumMeshes;
                     for( unsigned int n = a; n < pNode->mNumMeshes; ++n ) {
                         pNode->mMeshes[ n ] = pNode->mMeshes[ n + 1 ];
@@ -195,6 +201,7 @@ void OptimizeMeshesProcess::ProcessNode( aiNode* pNode)
 				aiMesh* out;
 				SceneCombiner::MergeMeshes(&out,0,merge_list.begin(),merge_list.end());
 				output.push_back(out);
+				mScene->mMeshes[im] = out;
 			} else {
 				output.push_back(mScene->mMeshes[im]);
 			}
@@ -204,7 +211,7 @@ void OptimizeMeshesProcess::ProcessNode( aiNode* pNode)
 
 
     for( unsigned int i = 0; i < pNode->mNumChildren; ++i ) {
-        ProcessNode( pNode->mChildren[ i ] );
+        ProcessNode( pNode->mChildren[ i ], reporter );
     }
 }
 
@@ -94,6 +94,10 @@ public:
 	// -------------------------------------------------------------------
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "OptimizeMeshesProcess"; }
+
 	// -------------------------------------------------------------------
 	void Execute( aiScene* pScene);
 	
@@ -138,8 +142,9 @@ protected:
 	// -------------------------------------------------------------------
 	/** @brief Do the actual optimization on all meshes of this node
 	 *  @param pNode Node we're working with
+	 *  @param reporter Receives the number of output meshes so far
 	 */
-	void ProcessNode( aiNode* pNode);
+	void ProcessNode( aiNode* pNode, ProgressReporter& reporter);
 
 	// -------------------------------------------------------------------
 	/** @brief Returns true if b can be joined with a
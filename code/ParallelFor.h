@@ -0,0 +1,191 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file  ParallelFor.h
+ *  @brief Helper to distribute independent work items over worker threads
+ */
+#ifndef AI_PARALLELFOR_H_INC
+#define AI_PARALLELFOR_H_INC
+
+#include "../include/assimp/defs.h"
+#include "Exceptional.h"
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/thread.hpp>
+#	include <boost/thread/mutex.hpp>
+#endif
+
+#include <string>
+#include <algorithm>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Set the number of workers used by ParallelFor().
+ *
+ *  The setting is process-wide and must not be changed while imports are
+ *  running. It is mainly meant for tests and benchmarks, e.g. to run the
+ *  parallel code paths on a single core machine. Ignored if threading
+ *  support is disabled.
+ *  @param numThreads Number of workers, 0 (the default) picks the number
+ *    of hardware threads. */
+ASSIMP_API void SetParallelForThreads(unsigned int numThreads);
+
+/** @brief Get the number of workers set by SetParallelForThreads() */
+ASSIMP_API unsigned int GetParallelForThreads();
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+namespace detail {
+
+// ------------------------------------------------------------------------------------------------
+/** Shared state of all workers of a single ParallelFor() call */
+struct ParallelForState
+{
+	boost::mutex mutex;
+	unsigned int next, count;
+	bool failed;
+	std::string error;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Worker body. Each worker fetches the next unprocessed item until all
+ *  items are done or one of them has thrown. */
+template <typename Fn>
+struct ParallelForWorker
+{
+	ParallelForWorker(Fn& fn, ParallelForState& state)
+		: fn(&fn), state(&state)
+	{}
+
+	void operator() ()
+	{
+		for (;;) {
+			unsigned int i;
+			{
+				boost::mutex::scoped_lock lock(state->mutex);
+				if (state->failed || state->next >= state->count) {
+					return;
+				}
+				i = state->next++;
+			}
+
+			try {
+				(*fn)(i);
+			}
+			catch (const std::exception& e) {
+				boost::mutex::scoped_lock lock(state->mutex);
+				if (!state->failed) {
+					state->failed = true;
+					state->error = e.what();
+				}
+			}
+			catch (...) {
+				boost::mutex::scoped_lock lock(state->mutex);
+				if (!state->failed) {
+					state->failed = true;
+					state->error = "Unknown exception in worker thread";
+				}
+			}
+		}
+	}
+
+	Fn* fn;
+	ParallelForState* state;
+};
+
+} // ! detail
+#endif
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Invoke fn(i) for every i in [0,count).
+ *
+ *  The items are distributed over a number of worker threads and may be
+ *  processed in any order, so they must not depend on each other. If
+ *  threading support is disabled (#ASSIMP_BUILD_SINGLETHREADED) this is
+ *  a plain loop. If an item throws, the remaining items are skipped and a
+ *  DeadlyImportError carrying the message is thrown in the calling thread.
+ *
+ *  @param count Number of items
+ *  @param fn Functor with an operator()(unsigned int). It is shared by
+ *    all workers, so it must be safe to call concurrently.
+ *  @param maxThreads Upper limit for the number of workers, 0 for no limit
+ *    other than SetParallelForThreads() resp. the number of hardware threads. */
+template <typename Fn>
+inline void ParallelFor(unsigned int count, Fn& fn, unsigned int maxThreads = 0)
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	unsigned int numThreads = GetParallelForThreads();
+	if (!numThreads) {
+		numThreads = boost::thread::hardware_concurrency();
+	}
+	if (maxThreads) {
+		numThreads = std::min(numThreads,maxThreads);
+	}
+	numThreads = std::min(numThreads,count);
+
+	if (numThreads > 1) {
+		detail::ParallelForState state;
+		state.next = 0;
+		state.count = count;
+		state.failed = false;
+
+		boost::thread_group group;
+		for (unsigned int t = 0; t < numThreads; ++t) {
+			group.create_thread(detail::ParallelForWorker<Fn>(fn,state));
+		}
+		group.join_all();
+
+		if (state.failed) {
+			throw DeadlyImportError(state.error);
+		}
+		return;
+	}
+#else
+	(void)maxThreads;
+#endif
+	for (unsigned int i = 0; i < count; ++i) {
+		fn(i);
+	}
+}
+
+} // ! Assimp
+
+#endif // AI_PARALLELFOR_H_INC
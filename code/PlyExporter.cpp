@@ -60,30 +60,24 @@ namespace Assimp	{
 // Worker function for exporting a scene to PLY. Prototyped and registered in Exporter.cpp
 void ExportScenePly(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
-	// invoke the exporter 
-	PlyExporter exporter(pFile, pScene);
-
-	// we're still here - export successfully completed. Write the file.
 	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
 	if(outfile == NULL) {
 		throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
 	}
 
-	outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+	// invoke the exporter, it streams directly into the file
+	PlyExporter exporter(pFile, pScene, outfile.get());
 }
 
 void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
-	// invoke the exporter 
-	PlyExporter exporter(pFile, pScene, true);
-
-	// we're still here - export successfully completed. Write the file.
 	boost::scoped_ptr<IOStream> outfile(pIOSystem->Open(pFile, "wb"));
 	if (outfile == NULL) {
 		throw DeadlyExportError("could not open output .ply file: " + std::string(pFile));
 	}
 
-	outfile->Write(exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()), 1);
+	// invoke the exporter, it streams directly into the file
+	PlyExporter exporter(pFile, pScene, outfile.get(), true);
 }
 
 } // end of namespace Assimp
@@ -94,15 +88,12 @@ void ExportScenePlyBinary(const char* pFile, IOSystem* pIOSystem, const aiScene*
 #define PLY_EXPORT_HAS_COLORS (PLY_EXPORT_HAS_TEXCOORDS << AI_MAX_NUMBER_OF_TEXTURECOORDS)
 
 // ------------------------------------------------------------------------------------------------
-PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, bool binary)
-: filename(_filename)
+PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, IOStream* output, bool binary)
+: mOutput(output)
+, filename(_filename)
 , pScene(pScene)
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
-
 	unsigned int faces = 0u, vertices = 0u, components = 0u;
 	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 		const aiMesh& m = *pScene->mMeshes[i];
@@ -210,75 +201,114 @@ PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, bool bina
 		}
 		ofs += pScene->mMeshes[i]->mNumVertices;
 	}
+
+	mOutput.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
-void PlyExporter::WriteMeshVerts(const aiMesh* m, unsigned int components)
+// Formats a single vertex line, see WriteMeshVerts()
+struct PlyVertexFormatter
 {
-	static const float inf = std::numeric_limits<float>::infinity();
-	
-	// If a component (for instance normal vectors) is present in at least one mesh in the scene,
-	// then default values are written for meshes that do not contain this component.
-	for (unsigned int i = 0; i < m->mNumVertices; ++i) {
-		mOutput << 
-			m->mVertices[i].x << " " << 
-			m->mVertices[i].y << " " << 
+	PlyVertexFormatter(const aiMesh* m, unsigned int components)
+		: m(m), components(components)
+	{}
+
+	void operator() (TextWriter& out, size_t i) const
+	{
+		static const float inf = std::numeric_limits<float>::infinity();
+
+		out << 
+			m->mVertices[i].x << ' ' << 
+			m->mVertices[i].y << ' ' << 
 			m->mVertices[i].z
 		;
 		if(components & PLY_EXPORT_HAS_NORMALS) {
 			if (m->HasNormals() && is_not_qnan(m->mNormals[i].x) && std::fabs(m->mNormals[i].x) != inf) {
-				mOutput << 
-					" " << m->mNormals[i].x << 
-					" " << m->mNormals[i].y << 
-					" " << m->mNormals[i].z;
+				out << 
+					' ' << m->mNormals[i].x << 
+					' ' << m->mNormals[i].y << 
+					' ' << m->mNormals[i].z;
 			}
 			else {
-				mOutput << " 0.0 0.0 0.0"; 
+				out << " 0.0 0.0 0.0"; 
 			}
 		}
 
 		for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
 			if (m->HasTextureCoords(c)) {
-				mOutput << 
-					" " << m->mTextureCoords[c][i].x << 
-					" " << m->mTextureCoords[c][i].y;
+				out << 
+					' ' << m->mTextureCoords[c][i].x << 
+					' ' << m->mTextureCoords[c][i].y;
 			}
 			else {
-				mOutput << " -1.0 -1.0"; 
+				out << " -1.0 -1.0"; 
 			}
 		}
 
 		for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
 			if (m->HasVertexColors(c)) {
-				mOutput << 
-					" " << m->mColors[c][i].r << 
-					" " << m->mColors[c][i].g <<
-					" " << m->mColors[c][i].b <<
-					" " << m->mColors[c][i].a;
+				out << 
+					' ' << m->mColors[c][i].r << 
+					' ' << m->mColors[c][i].g <<
+					' ' << m->mColors[c][i].b <<
+					' ' << m->mColors[c][i].a;
 			}
 			else {
-				mOutput << " -1.0 -1.0 -1.0 -1.0"; 
+				out << " -1.0 -1.0 -1.0 -1.0"; 
 			}
 		}
 
 		if(components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
 			if (m->HasTangentsAndBitangents()) {
-				mOutput << 
-				" " << m->mTangents[i].x << 
-				" " << m->mTangents[i].y << 
-				" " << m->mTangents[i].z << 
-				" " << m->mBitangents[i].x << 
-				" " << m->mBitangents[i].y << 
-				" " << m->mBitangents[i].z
+				out << 
+				' ' << m->mTangents[i].x << 
+				' ' << m->mTangents[i].y << 
+				' ' << m->mTangents[i].z << 
+				' ' << m->mBitangents[i].x << 
+				' ' << m->mBitangents[i].y << 
+				' ' << m->mBitangents[i].z
 				;
 			}
 			else {
-				mOutput << " 0.0 0.0 0.0 0.0 0.0 0.0"; 
+				out << " 0.0 0.0 0.0 0.0 0.0 0.0"; 
 			}
 		}
 
-		mOutput << endl;
+		out << '\n';
 	}
+
+	const aiMesh* m;
+	unsigned int components;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Formats a single face line, see WriteMeshIndices()
+struct PlyFaceFormatter
+{
+	PlyFaceFormatter(const aiMesh* m, unsigned int offset)
+		: m(m), offset(offset)
+	{}
+
+	void operator() (TextWriter& out, size_t i) const
+	{
+		const aiFace& f = m->mFaces[i];
+		out << f.mNumIndices << ' ';
+		for(unsigned int c = 0; c < f.mNumIndices; ++c) {
+			out << (f.mIndices[c] + offset) << (c == f.mNumIndices-1 ? '\n' : ' ');
+		}
+	}
+
+	const aiMesh* m;
+	unsigned int offset;
+};
+
+// ------------------------------------------------------------------------------------------------
+void PlyExporter::WriteMeshVerts(const aiMesh* m, unsigned int components)
+{
+	// If a component (for instance normal vectors) is present in at least one mesh in the scene,
+	// then default values are written for meshes that do not contain this component.
+	PlyVertexFormatter fmt(m,components);
+	WriteParallel(mOutput,m->mNumVertices,fmt);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -290,42 +320,42 @@ void PlyExporter::WriteMeshVertsBinary(const aiMesh* m, unsigned int components)
 	aiVector2D defaultUV(-1, -1);
 	aiColor4D defaultColor(-1, -1, -1, -1);
 	for (unsigned int i = 0; i < m->mNumVertices; ++i) {
-		mOutput.write(reinterpret_cast<const char*>(&m->mVertices[i].x), 12);
+		mOutput.Write(reinterpret_cast<const char*>(&m->mVertices[i].x), 12);
 		if (components & PLY_EXPORT_HAS_NORMALS) {
 			if (m->HasNormals()) {
-				mOutput.write(reinterpret_cast<const char*>(&m->mNormals[i].x), 12);
+				mOutput.Write(reinterpret_cast<const char*>(&m->mNormals[i].x), 12);
 			}
 			else {
-				mOutput.write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
+				mOutput.Write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
 			}
 		}
 
 		for (unsigned int n = PLY_EXPORT_HAS_TEXCOORDS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_TEXTURECOORDS; n <<= 1, ++c) {
 			if (m->HasTextureCoords(c)) {
-				mOutput.write(reinterpret_cast<const char*>(&m->mTextureCoords[c][i].x), 6);
+				mOutput.Write(reinterpret_cast<const char*>(&m->mTextureCoords[c][i].x), 6);
 			}
 			else {
-				mOutput.write(reinterpret_cast<const char*>(&defaultUV.x), 6);
+				mOutput.Write(reinterpret_cast<const char*>(&defaultUV.x), 6);
 			}
 		}
 
 		for (unsigned int n = PLY_EXPORT_HAS_COLORS, c = 0; (components & n) && c != AI_MAX_NUMBER_OF_COLOR_SETS; n <<= 1, ++c) {
 			if (m->HasVertexColors(c)) {
-				mOutput.write(reinterpret_cast<const char*>(&m->mColors[c][i].r), 16);
+				mOutput.Write(reinterpret_cast<const char*>(&m->mColors[c][i].r), 16);
 			}
 			else {
-				mOutput.write(reinterpret_cast<const char*>(&defaultColor.r), 16);
+				mOutput.Write(reinterpret_cast<const char*>(&defaultColor.r), 16);
 			}
 		}
 
 		if (components & PLY_EXPORT_HAS_TANGENTS_BITANGENTS) {
 			if (m->HasTangentsAndBitangents()) {
-				mOutput.write(reinterpret_cast<const char*>(&m->mTangents[i].x), 12);
-				mOutput.write(reinterpret_cast<const char*>(&m->mBitangents[i].x), 12);
+				mOutput.Write(reinterpret_cast<const char*>(&m->mTangents[i].x), 12);
+				mOutput.Write(reinterpret_cast<const char*>(&m->mBitangents[i].x), 12);
 			}
 			else {
-				mOutput.write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
-				mOutput.write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
+				mOutput.Write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
+				mOutput.Write(reinterpret_cast<const char*>(&defaultNormal.x), 12);
 			}
 		}
 	}
@@ -334,23 +364,18 @@ void PlyExporter::WriteMeshVertsBinary(const aiMesh* m, unsigned int components)
 // ------------------------------------------------------------------------------------------------
 void PlyExporter::WriteMeshIndices(const aiMesh* m, unsigned int offset)
 {
-	for (unsigned int i = 0; i < m->mNumFaces; ++i) {
-		const aiFace& f = m->mFaces[i];
-		mOutput << f.mNumIndices << " ";
-		for(unsigned int c = 0; c < f.mNumIndices; ++c) {
-			mOutput << (f.mIndices[c] + offset) << (c == f.mNumIndices-1 ? endl : " ");
-		}
-	}
+	PlyFaceFormatter fmt(m,offset);
+	WriteParallel(mOutput,m->mNumFaces,fmt);
 }
 
 void PlyExporter::WriteMeshIndicesBinary(const aiMesh* m, unsigned int offset)
 {
 	for (unsigned int i = 0; i < m->mNumFaces; ++i) {
 		const aiFace& f = m->mFaces[i];
-		mOutput.write(reinterpret_cast<const char*>(&f.mNumIndices), 4);
+		mOutput.Write(reinterpret_cast<const char*>(&f.mNumIndices), 4);
 		for (unsigned int c = 0; c < f.mNumIndices; ++c) {
 			unsigned int index = f.mIndices[c] + offset;
-			mOutput.write(reinterpret_cast<const char*>(&index), 4);
+			mOutput.Write(reinterpret_cast<const char*>(&index), 4);
 		}
 	}
 }
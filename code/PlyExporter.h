@@ -44,7 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_PLYEXPORTER_H_INC
 #define AI_PLYEXPORTER_H_INC
 
-#include <sstream>
+#include "TextWriter.h"
 
 struct aiScene;
 struct aiNode;
@@ -59,13 +59,13 @@ namespace Assimp
 class PlyExporter
 {
 public:
-	/// Constructor for a specific scene to export
-	PlyExporter(const char* filename, const aiScene* pScene, bool binary = false);
+	/// Constructor for a specific scene to export, the output is written to the given stream
+	PlyExporter(const char* filename, const aiScene* pScene, IOStream* output, bool binary = false);
 
 public:
 
-	/// public stringstreams to write all output into
-	std::ostringstream mOutput;
+	/// writer for all output
+	TextWriter mOutput;
 
 private:
 
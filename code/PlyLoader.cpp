@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "PlyLoader.h"
 #include "Macros.h"
+#include "ProgressReporter.h"
 #include <boost/scoped_ptr.hpp>
 #include "../include/assimp/IOSystem.hpp"
 #include "../include/assimp/scene.h"
@@ -154,7 +155,7 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 		if (TokenMatch(szMe,"ascii",5))
 		{
 			SkipLine(szMe,(const char**)&szMe);
-			if(!PLY::DOM::ParseInstance(szMe,&sPlyDom))
+			if(!PLY::DOM::ParseInstance(szMe,&sPlyDom,progress,cancel))
 				throw DeadlyImportError( "Invalid .ply file: Unable to build DOM (#1)");
 		}
 		else if (!::strncmp(szMe,"binary_",7))
@@ -172,7 +173,7 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 
 			// skip the line, parse the rest of the header and build the DOM
 			SkipLine(szMe,(const char**)&szMe);
-			if(!PLY::DOM::ParseInstanceBinary(szMe,&sPlyDom,bIsBE))
+			if(!PLY::DOM::ParseInstanceBinary(szMe,&sPlyDom,bIsBE,progress,cancel))
 				throw DeadlyImportError( "Invalid .ply file: Unable to build DOM (#2)");
 		}
 		else throw DeadlyImportError( "Invalid .ply file: Unknown file format");
@@ -183,6 +184,7 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 		throw DeadlyImportError( "Invalid .ply file: Missing format specification");
 	}
 	this->pcDOM = &sPlyDom;
+	ThrowIfCancelled(cancel);
 
 	// now load a list of vertices. This must be sucessfull in order to procede
 	std::vector<aiVector3D> avPositions;
@@ -239,6 +241,7 @@ void PLYImporter::InternReadFile( const std::string& pFile,
 	ReplaceDefaultMaterial(&avFaces,&avMaterials);
 
 	// now convert this to a list of aiMesh instances
+	ThrowIfCancelled(cancel);
 	std::vector<aiMesh*> avMeshes;
 	avMeshes.reserve(avMaterials.size()+1);
 	ConvertMeshes(&avFaces,&avPositions,&avNormals,
@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "fast_atof.h"
 #include "../include/assimp/DefaultLogger.hpp"
 #include "ByteSwapper.h"
+#include "ProgressReporter.h"
 
 
 using namespace Assimp;
@@ -471,10 +472,22 @@ bool PLY::DOM::ParseHeader (const char* pCur,const char** pCurOut,bool isBinary)
 	return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+size_t PLY::DOM::CountInstances() const
+{
+	size_t total = 0;
+	for (std::vector<PLY::Element>::const_iterator i = alElements.begin();i != alElements.end();++i) {
+		total += (*i).NumOccur;
+	}
+	return total;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool PLY::DOM::ParseElementInstanceLists (
 	const char* pCur,
-	const char** pCurOut)
+	const char** pCurOut,
+	ProgressHandler* progress,
+	const AtomicFlag* cancel)
 {
 	ai_assert(NULL != pCur && NULL != pCurOut);
 
@@ -486,11 +499,15 @@ bool PLY::DOM::ParseElementInstanceLists (
 	std::vector<PLY::Element>::const_iterator i = alElements.begin();
 	std::vector<PLY::ElementInstanceList>::iterator a = alElementData.begin();
 
-	// parse all element instances
+	// parse all element instances, each list covers its share of the progress
+	const float total = static_cast<float>(std::max(static_cast<size_t>(1),CountInstances()));
+	size_t done = 0;
 	for (;i != alElements.end();++i,++a)
 	{
+		ProgressReporter reporter(progress,cancel,(*i).NumOccur,0.5f * done / total,0.5f * (*i).NumOccur / total);
 		(*a).alInstances.resize((*i).NumOccur);
-		PLY::ElementInstanceList::ParseInstanceList(pCur,&pCur,&(*i),&(*a));
+		PLY::ElementInstanceList::ParseInstanceList(pCur,&pCur,&(*i),&(*a),&reporter);
+		done += (*i).NumOccur;
 	}
 
 	DefaultLogger::get()->debug("PLY::DOM::ParseElementInstanceLists() succeeded");
@@ -502,7 +519,9 @@ bool PLY::DOM::ParseElementInstanceLists (
 bool PLY::DOM::ParseElementInstanceListsBinary (
 	const char* pCur,
 	const char** pCurOut,
-	bool p_bBE)
+	bool p_bBE,
+	ProgressHandler* progress,
+	const AtomicFlag* cancel)
 {
 	ai_assert(NULL != pCur && NULL != pCurOut);
 
@@ -514,11 +533,15 @@ bool PLY::DOM::ParseElementInstanceListsBinary (
 	std::vector<PLY::Element>::const_iterator i = alElements.begin();
 	std::vector<PLY::ElementInstanceList>::iterator a = alElementData.begin();
 
-	// parse all element instances
+	// parse all element instances, each list covers its share of the progress
+	const float total = static_cast<float>(std::max(static_cast<size_t>(1),CountInstances()));
+	size_t done = 0;
 	for (;i != alElements.end();++i,++a)
 	{
+		ProgressReporter reporter(progress,cancel,(*i).NumOccur,0.5f * done / total,0.5f * (*i).NumOccur / total);
 		(*a).alInstances.resize((*i).NumOccur);
-		PLY::ElementInstanceList::ParseInstanceListBinary(pCur,&pCur,&(*i),&(*a),p_bBE);
+		PLY::ElementInstanceList::ParseInstanceListBinary(pCur,&pCur,&(*i),&(*a),p_bBE,&reporter);
+		done += (*i).NumOccur;
 	}
 
 	DefaultLogger::get()->debug("PLY::DOM::ParseElementInstanceListsBinary() succeeded");
@@ -527,7 +550,8 @@ bool PLY::DOM::ParseElementInstanceListsBinary (
 }
 
 // ------------------------------------------------------------------------------------------------
-bool PLY::DOM::ParseInstanceBinary (const char* pCur,DOM* p_pcOut,bool p_bBE)
+bool PLY::DOM::ParseInstanceBinary (const char* pCur,DOM* p_pcOut,bool p_bBE,
+	ProgressHandler* progress, const AtomicFlag* cancel)
 {
 	ai_assert(NULL != pCur && NULL != p_pcOut);
 
@@ -538,7 +562,7 @@ bool PLY::DOM::ParseInstanceBinary (const char* pCur,DOM* p_pcOut,bool p_bBE)
 		DefaultLogger::get()->debug("PLY::DOM::ParseInstanceBinary() failure");
 		return false;
 	}
-	if(!p_pcOut->ParseElementInstanceListsBinary(pCur,&pCur,p_bBE))
+	if(!p_pcOut->ParseElementInstanceListsBinary(pCur,&pCur,p_bBE,progress,cancel))
 	{
 		DefaultLogger::get()->debug("PLY::DOM::ParseInstanceBinary() failure");
 		return false;
@@ -548,7 +572,8 @@ bool PLY::DOM::ParseInstanceBinary (const char* pCur,DOM* p_pcOut,bool p_bBE)
 }
 
 // ------------------------------------------------------------------------------------------------
-bool PLY::DOM::ParseInstance (const char* pCur,DOM* p_pcOut)
+bool PLY::DOM::ParseInstance (const char* pCur,DOM* p_pcOut,
+	ProgressHandler* progress, const AtomicFlag* cancel)
 {
 	ai_assert(NULL != pCur);
 	ai_assert(NULL != p_pcOut);
@@ -561,7 +586,7 @@ bool PLY::DOM::ParseInstance (const char* pCur,DOM* p_pcOut)
 		DefaultLogger::get()->debug("PLY::DOM::ParseInstance() failure");
 		return false;
 	}
-	if(!p_pcOut->ParseElementInstanceLists(pCur,&pCur))
+	if(!p_pcOut->ParseElementInstanceLists(pCur,&pCur,progress,cancel))
 	{
 		DefaultLogger::get()->debug("PLY::DOM::ParseInstance() failure");
 		return false;
@@ -575,7 +600,8 @@ bool PLY::ElementInstanceList::ParseInstanceList (
 	const char* pCur,
 	const char** pCurOut,
 	const PLY::Element* pcElement, 
-	PLY::ElementInstanceList* p_pcOut)
+	PLY::ElementInstanceList* p_pcOut,
+	ProgressReporter* progress /* = NULL */)
 {
 	ai_assert(NULL != pCur && NULL != pCurOut && NULL != pcElement && NULL != p_pcOut);
 
@@ -585,6 +611,9 @@ bool PLY::ElementInstanceList::ParseInstanceList (
 		// However, there could be comments
 		for (unsigned int i = 0; i < pcElement->NumOccur;++i)
 		{
+			if (progress) {
+				progress->Update(i);
+			}
 			PLY::DOM::SkipComments(pCur,&pCur);
 			SkipLine(pCur,&pCur);
 		}
@@ -594,6 +623,9 @@ bool PLY::ElementInstanceList::ParseInstanceList (
 		// be sure to have enough storage
 		for (unsigned int i = 0; i < pcElement->NumOccur;++i)
 		{
+			if (progress) {
+				progress->Update(i);
+			}
 			PLY::DOM::SkipComments(pCur,&pCur);
 			PLY::ElementInstance::ParseInstance(pCur, &pCur,pcElement,
 				&p_pcOut->alInstances[i]);
@@ -609,7 +641,8 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary (
 	const char** pCurOut,
 	const PLY::Element* pcElement,
 	PLY::ElementInstanceList* p_pcOut,
-	bool p_bBE /* = false */)
+	bool p_bBE /* = false */,
+	ProgressReporter* progress /* = NULL */)
 {
 	ai_assert(NULL != pCur && NULL != pCurOut && NULL != pcElement && NULL != p_pcOut);
 
@@ -619,6 +652,9 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary (
 	// of the unknown element)
 	for (unsigned int i = 0; i < pcElement->NumOccur;++i)
 	{
+		if (progress) {
+			progress->Update(i);
+		}
 		PLY::ElementInstance::ParseInstanceBinary(pCur, &pCur,pcElement,
 			&p_pcOut->alInstances[i], p_bBE);
 	}
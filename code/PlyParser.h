@@ -51,6 +51,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace Assimp
 {
 
+class ProgressHandler;
+class ProgressReporter;
+class AtomicFlag;
+
 // http://local.wasp.uwa.edu.au/~pbourke/dataformats/ply/
 // http://w3.impa.br/~lvelho/outgoing/sossai/old/ViHAP_D4.4.2_PLY_format_v1.1.pdf
 // http://www.okino.com/conv/exp_ply.htm
@@ -395,14 +399,16 @@ public:
 	std::vector< ElementInstance > alInstances;
 
 	// -------------------------------------------------------------------
-	//! Parse an element instance list
+	//! Parse an element instance list, progress is reported per instance
 	static bool ParseInstanceList (const char* pCur,const char** pCurOut,
-		const Element* pcElement, ElementInstanceList* p_pcOut);
+		const Element* pcElement, ElementInstanceList* p_pcOut,
+		ProgressReporter* progress = NULL);
 
 	// -------------------------------------------------------------------
-	//! Parse a binary element instance list
+	//! Parse a binary element instance list, progress is reported per instance
 	static bool ParseInstanceListBinary (const char* pCur,const char** pCurOut,
-		const Element* pcElement, ElementInstanceList* p_pcOut,bool p_bBE);
+		const Element* pcElement, ElementInstanceList* p_pcOut,bool p_bBE,
+		ProgressReporter* progress = NULL);
 };
 // ---------------------------------------------------------------------------------
 /** \brief Class to represent the document object model of an ASCII or binary 
@@ -423,10 +429,13 @@ public:
 	std::vector<ElementInstanceList> alElementData;
 
 	//! Parse the DOM for a PLY file. The input string is assumed
-	//! to be terminated with zero
-	static bool ParseInstance (const char* pCur,DOM* p_pcOut);
+	//! to be terminated with zero. Progress is reported to the handler
+	//! and the cancellation flag is checked while the instances are read.
+	static bool ParseInstance (const char* pCur,DOM* p_pcOut,
+		ProgressHandler* progress = NULL, const AtomicFlag* cancel = NULL);
 	static bool ParseInstanceBinary (const char* pCur,
-		DOM* p_pcOut,bool p_bBE);
+		DOM* p_pcOut,bool p_bBE,
+		ProgressHandler* progress = NULL, const AtomicFlag* cancel = NULL);
 
 	//! Skip all comment lines after this
 	static bool SkipComments (const char* pCur,const char** pCurOut);
@@ -439,12 +448,18 @@ private:
 
 	// -------------------------------------------------------------------
 	//! Read in all element instance lists
-	bool ParseElementInstanceLists (const char* pCur,const char** pCurOut);
+	bool ParseElementInstanceLists (const char* pCur,const char** pCurOut,
+		ProgressHandler* progress, const AtomicFlag* cancel);
 
 	// -------------------------------------------------------------------
 	//! Read in all element instance lists for a binary file format
 	bool ParseElementInstanceListsBinary (const char* pCur,
-		const char** pCurOut,bool p_bBE);
+		const char** pCurOut,bool p_bBE,
+		ProgressHandler* progress, const AtomicFlag* cancel);
+
+	// -------------------------------------------------------------------
+	//! Total number of element instances in the file
+	size_t CountInstances() const;
 };
 
 // ---------------------------------------------------------------------------------
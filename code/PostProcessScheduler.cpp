@@ -0,0 +1,164 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  PostProcessScheduler.cpp
+ *  @brief Implementation of the PostProcessScheduler class
+ */
+
+#include "PostProcessScheduler.h"
+#include "ParallelFor.h"
+#include "ProgressReporter.h"
+#include "Importer.h"
+#include "../include/assimp/DefaultLogger.hpp"
+#include "../include/assimp/scene.h"
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// ParallelFor() work item, runs all steps of a stage on a single mesh
+struct MeshPipeline
+{
+	MeshPipeline(aiScene* pScene, BaseProcess* const* steps, unsigned int count, 
+		const AtomicFlag* cancel)
+		: pScene(pScene)
+		, steps(steps)
+		, count(count)
+		, cancel(cancel)
+	{}
+
+	void operator() (unsigned int i)
+	{
+		ThrowIfCancelled(cancel);
+		for (unsigned int s = 0; s < count; ++s) {
+			steps[s]->ExecuteForMesh(pScene,i);
+		}
+	}
+
+	aiScene* pScene;
+	BaseProcess* const* steps;
+	unsigned int count;
+	const AtomicFlag* cancel;
+};
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+void PostProcessScheduler::BuildStages(const std::vector<BaseProcess*>& steps, 
+	std::vector<Stage>& out)
+{
+	out.clear();
+	for (unsigned int i = 0; i < steps.size();) {
+		Stage stage;
+		stage.first = i;
+		stage.count = 1;
+		stage.pipelined = steps[i]->IsPerMesh();
+
+		if (stage.pipelined) {
+			// mesh-local data is passed on from step to step on the same mesh, 
+			// anything else is written in EndMeshes() and must not be needed 
+			// by the BeginMeshes() of a later step in the same stage
+			unsigned int read, write, globalWrites;
+			steps[i]->GetDataAccess(read,write);
+			globalWrites = write & ~PPData_MeshLocal;
+
+			for (unsigned int n = i+1; n < steps.size() && steps[n]->IsPerMesh(); ++n, ++stage.count) {
+				steps[n]->GetDataAccess(read,write);
+				if (read & ~PPData_MeshLocal & globalWrites) {
+					break;
+				}
+				globalWrites |= write & ~PPData_MeshLocal;
+			}
+		}
+		out.push_back(stage);
+		i += stage.count;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void PostProcessScheduler::ExecuteStage(Importer* pImp, 
+	const std::vector<BaseProcess*>& steps, 
+	const Stage& stage)
+{
+	ai_assert(NULL != pImp && NULL != pImp->Pimpl()->mScene);
+	ai_assert(stage.first + stage.count <= steps.size());
+
+	if (!stage.pipelined) {
+		for (unsigned int s = stage.first; s < stage.first + stage.count && pImp->Pimpl()->mScene; ++s) {
+			steps[s]->ExecuteOnScene(pImp);
+		}
+		return;
+	}
+
+	aiScene* const pScene = pImp->Pimpl()->mScene;
+	BaseProcess* const* const first = &steps[stage.first];
+
+	for (unsigned int s = 0; s < stage.count; ++s) {
+		first[s]->progress = pImp->GetProgressHandler();
+		first[s]->cancel = &pImp->Pimpl()->mCancelRequested;
+		first[s]->SetupProperties(pImp);
+	}
+
+	// catch exceptions thrown inside the PostProcess-Steps
+	try {
+		for (unsigned int s = 0; s < stage.count; ++s) {
+			first[s]->BeginMeshes(pScene);
+		}
+
+		MeshPipeline pipeline(pScene,first,stage.count,&pImp->Pimpl()->mCancelRequested);
+		ParallelFor(pScene->mNumMeshes,pipeline);
+
+		for (unsigned int s = 0; s < stage.count; ++s) {
+			first[s]->EndMeshes(pScene);
+		}
+	} catch( const std::exception& err )	{
+
+		// extract error description
+		pImp->Pimpl()->mErrorString = err.what();
+		DefaultLogger::get()->error(pImp->Pimpl()->mErrorString);
+
+		// and kill the partially imported data
+		delete pImp->Pimpl()->mScene;
+		pImp->Pimpl()->mScene = NULL;
+	}
+}
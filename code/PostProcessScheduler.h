@@ -0,0 +1,100 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  PostProcessScheduler.h
+ *  @brief Runs consecutive per-mesh post processing steps as a pipeline
+ */
+#ifndef AI_POSTPROCESSSCHEDULER_H_INC
+#define AI_POSTPROCESSSCHEDULER_H_INC
+
+#include "BaseProcess.h"
+#include <vector>
+
+namespace Assimp	{
+
+// ---------------------------------------------------------------------------
+/** Groups the active post processing steps into stages and executes them.
+ *
+ *  A stage is either a single step which sees the whole scene or a run of
+ *  consecutive per-mesh steps (see BaseProcess::IsPerMesh()). The steps of
+ *  a run are executed back-to-back on each mesh, different meshes are 
+ *  distributed over the worker threads. Every other step is a barrier.
+ *  A run is split when a step reads scene-global data an earlier step of 
+ *  the run writes, as declared by BaseProcess::GetDataAccess().
+ */
+class ASSIMP_API PostProcessScheduler
+{
+public:
+
+	/** A group of steps, [first,first+count) in the step list */
+	struct Stage
+	{
+		unsigned int first, count;
+
+		/** false for a single step which is run by ExecuteOnScene() */
+		bool pipelined;
+	};
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Splits a list of active steps into stages.
+	 *  @param steps Steps to be executed, in order
+	 *  @param out Receives the stages, in order */
+	static void BuildStages(const std::vector<BaseProcess*>& steps, 
+		std::vector<Stage>& out);
+
+	// -------------------------------------------------------------------
+	/** Executes one stage on the scene bound to an importer. Just like 
+	 *  BaseProcess::ExecuteOnScene() the scene is deleted and the 
+	 *  importer's error string set if a step fails.
+	 *  @param pImp Importer the scene is bound to
+	 *  @param steps Step list the stage was built from
+	 *  @param stage Stage to execute */
+	static void ExecuteStage(Importer* pImp, 
+		const std::vector<BaseProcess*>& steps, 
+		const Stage& stage);
+};
+
+} // end of namespace Assimp
+
+#endif // AI_POSTPROCESSSCHEDULER_H_INC
@@ -47,6 +47,7 @@ corresponding preprocessor flag to selectively disable steps.
 */
 
 #include "ProcessHelper.h"
+#include "Importer.h"
 
 #ifndef ASSIMP_BUILD_NO_CALCTANGENTS_PROCESS
 #	include "CalcTangentsProcess.h"
@@ -120,74 +121,90 @@ corresponding preprocessor flag to selectively disable steps.
 #ifndef ASSIMP_BUILD_NO_DEBONE_PROCESS
 #	include "DeboneProcess.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_GENERATEMESHLETS_PROCESS
+#	include "GenerateMeshletsProcess.h"
+#endif
+#ifndef ASSIMP_BUILD_NO_COMPRESSANIMATIONS_PROCESS
+#	include "CompressAnimationsProcess.h"
+#endif
 
 namespace Assimp {
 
 // ------------------------------------------------------------------------------------------------
-void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
+template <typename T>
+static BaseProcess* CreateStep()
+{
+	return new T();
+}
+
+// ------------------------------------------------------------------------------------------------
+void GetPostProcessingStepFactoryList(std::vector< PostProcessingStepFactory >& out)
 {
 	// ----------------------------------------------------------------------------
-	// Add an instance of each post processing step here in the order 
+	// Add a factory for each post processing step here in the order 
 	// of sequence it is executed. Steps that are added here are not
 	// validated - as RegisterPPStep() does - all dependencies must be given.
 	// ----------------------------------------------------------------------------
 	out.reserve(25);
 #if (!defined ASSIMP_BUILD_NO_MAKELEFTHANDED_PROCESS)
-	out.push_back( new MakeLeftHandedProcess());
+	out.push_back( &CreateStep< MakeLeftHandedProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_FLIPUVS_PROCESS)
-	out.push_back( new FlipUVsProcess());
+	out.push_back( &CreateStep< FlipUVsProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_FLIPWINDINGORDER_PROCESS)
-	out.push_back( new FlipWindingOrderProcess());
+	out.push_back( &CreateStep< FlipWindingOrderProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_REMOVEVC_PROCESS)
-	out.push_back( new RemoveVCProcess());
+	out.push_back( &CreateStep< RemoveVCProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_REMOVE_REDUNDANTMATERIALS_PROCESS)
-	out.push_back( new RemoveRedundantMatsProcess());
+	out.push_back( &CreateStep< RemoveRedundantMatsProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_FINDINSTANCES_PROCESS)
-	out.push_back( new FindInstancesProcess());
+	out.push_back( &CreateStep< FindInstancesProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_OPTIMIZEGRAPH_PROCESS)
-	out.push_back( new OptimizeGraphProcess());
+	out.push_back( &CreateStep< OptimizeGraphProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_FINDDEGENERATES_PROCESS)
-	out.push_back( new FindDegeneratesProcess());
+	out.push_back( &CreateStep< FindDegeneratesProcess >);
 #endif
 #ifndef ASSIMP_BUILD_NO_GENUVCOORDS_PROCESS
-	out.push_back( new ComputeUVMappingProcess());
+	out.push_back( &CreateStep< ComputeUVMappingProcess >);
 #endif
 #ifndef ASSIMP_BUILD_NO_TRANSFORMTEXCOORDS_PROCESS
-	out.push_back( new TextureTransformStep());
+	out.push_back( &CreateStep< TextureTransformStep >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_PRETRANSFORMVERTICES_PROCESS)
-	out.push_back( new PretransformVertices());
+	out.push_back( &CreateStep< PretransformVertices >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_TRIANGULATE_PROCESS)
-	out.push_back( new TriangulateProcess());
+	out.push_back( &CreateStep< TriangulateProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_SORTBYPTYPE_PROCESS)
-	out.push_back( new SortByPTypeProcess());
+	out.push_back( &CreateStep< SortByPTypeProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_FINDINVALIDDATA_PROCESS)
-	out.push_back( new FindInvalidDataProcess());
+	out.push_back( &CreateStep< FindInvalidDataProcess >);
+#endif
+#if (!defined ASSIMP_BUILD_NO_COMPRESSANIMATIONS_PROCESS)
+	out.push_back( &CreateStep< CompressAnimationsProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_OPTIMIZEMESHES_PROCESS)
-	out.push_back( new OptimizeMeshesProcess());
+	out.push_back( &CreateStep< OptimizeMeshesProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_FIXINFACINGNORMALS_PROCESS)
-	out.push_back( new FixInfacingNormalsProcess());
+	out.push_back( &CreateStep< FixInfacingNormalsProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_SPLITBYBONECOUNT_PROCESS)
-	out.push_back( new SplitByBoneCountProcess());
+	out.push_back( &CreateStep< SplitByBoneCountProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_SPLITLARGEMESHES_PROCESS)
-	out.push_back( new SplitLargeMeshesProcess_Triangle());
+	out.push_back( &CreateStep< SplitLargeMeshesProcess_Triangle >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_GENFACENORMALS_PROCESS)
-	out.push_back( new GenFaceNormalsProcess());
+	out.push_back( &CreateStep< GenFaceNormalsProcess >);
 #endif
 
 	// .........................................................................
@@ -195,35 +212,50 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 	// XXX this is actually a design weakness that dates back to the time
 	// when Importer would maintain the postprocessing step list exclusively.
 	// Now that others access it too, we need a better solution.
-	out.push_back( new ComputeSpatialSortProcess());
+	out.push_back( &CreateStep< ComputeSpatialSortProcess >);
 	// .........................................................................
 
 #if (!defined ASSIMP_BUILD_NO_GENVERTEXNORMALS_PROCESS)
-	out.push_back( new GenVertexNormalsProcess());
+	out.push_back( &CreateStep< GenVertexNormalsProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_CALCTANGENTS_PROCESS)
-	out.push_back( new CalcTangentsProcess());
+	out.push_back( &CreateStep< CalcTangentsProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_JOINVERTICES_PROCESS)
-	out.push_back( new JoinVerticesProcess());
+	out.push_back( &CreateStep< JoinVerticesProcess >);
 #endif
 
 	// .........................................................................
-	out.push_back( new DestroySpatialSortProcess());
+	out.push_back( &CreateStep< DestroySpatialSortProcess >);
 	// .........................................................................
 
 #if (!defined ASSIMP_BUILD_NO_SPLITLARGEMESHES_PROCESS)
-	out.push_back( new SplitLargeMeshesProcess_Vertex());
+	out.push_back( &CreateStep< SplitLargeMeshesProcess_Vertex >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_DEBONE_PROCESS)
-	out.push_back( new DeboneProcess());
+	out.push_back( &CreateStep< DeboneProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_LIMITBONEWEIGHTS_PROCESS)
-	out.push_back( new LimitBoneWeightsProcess());
+	out.push_back( &CreateStep< LimitBoneWeightsProcess >);
 #endif
 #if (!defined ASSIMP_BUILD_NO_IMPROVECACHELOCALITY_PROCESS)
-	out.push_back( new ImproveCacheLocalityProcess());
+	out.push_back( &CreateStep< ImproveCacheLocalityProcess >);
 #endif
+#if (!defined ASSIMP_BUILD_NO_GENERATEMESHLETS_PROCESS)
+	out.push_back( &CreateStep< GenerateMeshletsProcess >);
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
+{
+	std::vector< PostProcessingStepFactory > factories;
+	GetPostProcessingStepFactoryList(factories);
+
+	out.reserve(out.size() + factories.size());
+	for (std::vector< PostProcessingStepFactory >::const_iterator it = factories.begin(); it != factories.end(); ++it) {
+		out.push_back( (*it)() );
+	}
 }
 
 }
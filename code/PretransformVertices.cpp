@@ -46,8 +46,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "PretransformVertices.h"
 #include "ProcessHelper.h"
-#include "SceneCombiner.h"
+#include "SceneCombiner.h"
 #include "Exceptional.h"
+#include "ProgressReporter.h"
 
 using namespace Assimp;
 
@@ -59,6 +60,7 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 PretransformVertices::PretransformVertices()
 :	configKeepHierarchy (false), configNormalize(false), configTransform(false), configTransformation()
+,	configInstances(false), configMaxOutputBytes(0)
 {
 }
 
@@ -87,6 +89,84 @@ void PretransformVertices::SetupProperties(const Importer* pImp)
 	configTransform = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_PTV_ADD_ROOT_TRANSFORMATION,0));
 
 	configTransformation = pImp->GetPropertyMatrix(AI_CONFIG_PP_PTV_ROOT_TRANSFORMATION, aiMatrix4x4());
+
+	// Get the current value of AI_CONFIG_PP_PTV_INSTANCES and AI_CONFIG_PP_PTV_MAX_OUTPUT_MB
+	configInstances = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_PTV_INSTANCES,0));
+
+	const int maxMB = pImp->GetPropertyInteger(AI_CONFIG_PP_PTV_MAX_OUTPUT_MB,0);
+	configMaxOutputBytes = maxMB > 0 ? static_cast<uint64_t>(maxMB) << 20u : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Transform an array of positions. The loop is unrolled four vertices at a time and the
+// matrix is kept in locals so the compiler can keep it in registers and vectorize the
+// arithmetic, which is noticeably faster than aiMatrix4x4::operator* for large batches.
+static void TransformPositions(const aiMatrix4x4& m, const aiVector3D* in, aiVector3D* out, unsigned int num)
+{
+	const float a1 = m.a1, a2 = m.a2, a3 = m.a3, a4 = m.a4;
+	const float b1 = m.b1, b2 = m.b2, b3 = m.b3, b4 = m.b4;
+	const float c1 = m.c1, c2 = m.c2, c3 = m.c3, c4 = m.c4;
+
+	unsigned int i = 0;
+	for (const unsigned int end4 = num & ~3u; i < end4; i += 4) {
+		for (unsigned int k = 0; k < 4; ++k) {
+			const float x = in[i+k].x, y = in[i+k].y, z = in[i+k].z;
+			out[i+k].x = a1*x + a2*y + a3*z + a4;
+			out[i+k].y = b1*x + b2*y + b3*z + b4;
+			out[i+k].z = c1*x + c2*y + c3*z + c4;
+		}
+	}
+	for (; i < num; ++i) {
+		const float x = in[i].x, y = in[i].y, z = in[i].z;
+		out[i].x = a1*x + a2*y + a3*z + a4;
+		out[i].y = b1*x + b2*y + b3*z + b4;
+		out[i].z = c1*x + c2*y + c3*z + c4;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Transform and renormalize an array of direction vectors (normals, tangents), see above.
+static void TransformDirections(const aiMatrix3x3& m, const aiVector3D* in, aiVector3D* out, unsigned int num)
+{
+	const float a1 = m.a1, a2 = m.a2, a3 = m.a3;
+	const float b1 = m.b1, b2 = m.b2, b3 = m.b3;
+	const float c1 = m.c1, c2 = m.c2, c3 = m.c3;
+
+	for (unsigned int i = 0; i < num; ++i) {
+		const float x = in[i].x, y = in[i].y, z = in[i].z;
+		out[i].x = a1*x + a2*y + a3*z;
+		out[i].y = b1*x + b2*y + b3*z;
+		out[i].z = c1*x + c2*y + c3*z;
+	}
+	for (unsigned int i = 0; i < num; ++i) {
+		out[i].Normalize();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the number of bytes the vertex and face data of a mesh occupies. Bones are not
+// accounted for, PretransformVertices drops them anyway.
+static uint64_t GetMeshDataSize(const aiMesh* mesh)
+{
+	uint64_t iVertex = sizeof(aiVector3D);
+	if (mesh->HasNormals()) {
+		iVertex += sizeof(aiVector3D);
+	}
+	if (mesh->HasTangentsAndBitangents()) {
+		iVertex += sizeof(aiVector3D) * 2;
+	}
+	for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS && mesh->HasVertexColors(a);++a) {
+		iVertex += sizeof(aiColor4D);
+	}
+	for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS && mesh->HasTextureCoords(a);++a) {
+		iVertex += sizeof(aiVector3D);
+	}
+
+	uint64_t iRet = iVertex * mesh->mNumVertices;
+	for (unsigned int a = 0; a < mesh->mNumFaces;++a) {
+		iRet += sizeof(aiFace) + sizeof(unsigned int) * mesh->mFaces[a].mNumIndices;
+	}
+	return iRet;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -129,7 +209,7 @@ void PretransformVertices::CountVerticesAndFaces( aiScene* pcScene, aiNode* pcNo
 	for (unsigned int i = 0; i < pcNode->mNumMeshes;++i)
 	{
 		aiMesh* pcMesh = pcScene->mMeshes[ pcNode->mMeshes[i] ]; 
-		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh))
+		if (iMat == pcMesh->mMaterialIndex && !meshInstanced[pcNode->mMeshes[i]] && iVFormat == GetMeshVFormat(pcMesh))
 		{
 			*piVertices += pcMesh->mNumVertices;
 			*piFaces += pcMesh->mNumFaces;
@@ -153,7 +233,7 @@ void PretransformVertices::CollectData( aiScene* pcScene, aiNode* pcNode, unsign
 	for (unsigned int i = 0; i < pcNode->mNumMeshes;++i)
 	{
 		aiMesh* pcMesh = pcScene->mMeshes[ pcNode->mMeshes[i] ]; 
-		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh))
+		if (iMat == pcMesh->mMaterialIndex && !meshInstanced[pcNode->mMeshes[i]] && iVFormat == GetMeshVFormat(pcMesh))
 		{
 			// Decrement mesh reference counter
 			unsigned int& num_ref = num_refs[pcNode->mMeshes[i]];
@@ -187,9 +267,9 @@ void PretransformVertices::CollectData( aiScene* pcScene, aiNode* pcNode, unsign
 			else
 			{
 				// copy positions, transform them to worldspace
-				for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)	{
-					pcMeshOut->mVertices[aiCurrent[AI_PTVS_VERTEX]+n] = pcNode->mTransformation * pcMesh->mVertices[n];
-				}
+				TransformPositions(pcNode->mTransformation,pcMesh->mVertices,
+					pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX],pcMesh->mNumVertices);
+
 				aiMatrix4x4 mWorldIT = pcNode->mTransformation;
 				mWorldIT.Inverse().Transpose();
 
@@ -199,18 +279,16 @@ void PretransformVertices::CollectData( aiScene* pcScene, aiNode* pcNode, unsign
 				if (iVFormat & 0x2)
 				{
 					// copy normals, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)	{
-						pcMeshOut->mNormals[aiCurrent[AI_PTVS_VERTEX]+n] = 
-							(m * pcMesh->mNormals[n]).Normalize();
-					}
+					TransformDirections(m,pcMesh->mNormals,
+						pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX],pcMesh->mNumVertices);
 				}
 				if (iVFormat & 0x4)
 				{
 					// copy tangents and bitangents, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices;++n)	{
-						pcMeshOut->mTangents  [aiCurrent[AI_PTVS_VERTEX]+n] = (m * pcMesh->mTangents[n]).Normalize();
-						pcMeshOut->mBitangents[aiCurrent[AI_PTVS_VERTEX]+n] = (m * pcMesh->mBitangents[n]).Normalize();
-					}
+					TransformDirections(m,pcMesh->mTangents,
+						pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX],pcMesh->mNumVertices);
+					TransformDirections(m,pcMesh->mBitangents,
+						pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX],pcMesh->mNumVertices);
 				}
 			}
 			unsigned int p = 0;
@@ -246,6 +324,7 @@ void PretransformVertices::CollectData( aiScene* pcScene, aiNode* pcNode, unsign
 				unsigned int* pi;
 				if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
 					pi = f_dst.mIndices = f_src.mIndices; 
+					f_src.mIndices = NULL;
 
 					// offset all vertex indices
 					for (unsigned int hahn = 0; hahn < num_idx;++hahn){
@@ -299,7 +378,7 @@ void PretransformVertices::GetVFormatList( aiScene* pcScene, unsigned int iMat,
 	for (unsigned int i = 0; i < pcScene->mNumMeshes;++i)
 	{
 		aiMesh* pcMesh = pcScene->mMeshes[ i ]; 
-		if (iMat == pcMesh->mMaterialIndex)	{
+		if (iMat == pcMesh->mMaterialIndex && !meshInstanced[i])	{
 			aiOut.push_back(GetMeshVFormat(pcMesh));
 		}
 	}
@@ -326,9 +405,7 @@ void PretransformVertices::ApplyTransform(aiMesh* mesh, const aiMatrix4x4& mat)
 	if (!mat.IsIdentity()) {
 		
 		if (mesh->HasPositions()) {
-			for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-				mesh->mVertices[i] = mat * mesh->mVertices[i];
-			}
+			TransformPositions(mat,mesh->mVertices,mesh->mVertices,mesh->mNumVertices);
 		}
 		if (mesh->HasNormals() || mesh->HasTangentsAndBitangents()) {
 			aiMatrix4x4 mWorldIT = mat;
@@ -338,15 +415,11 @@ void PretransformVertices::ApplyTransform(aiMesh* mesh, const aiMatrix4x4& mat)
 			aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
 
 			if (mesh->HasNormals()) {
-				for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-					mesh->mNormals[i] = (m * mesh->mNormals[i]).Normalize();
-				}
+				TransformDirections(m,mesh->mNormals,mesh->mNormals,mesh->mNumVertices);
 			}
 			if (mesh->HasTangentsAndBitangents()) {
-				for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-					mesh->mTangents[i]   = (m * mesh->mTangents[i]).Normalize();
-					mesh->mBitangents[i] = (m * mesh->mBitangents[i]).Normalize();
-				}
+				TransformDirections(m,mesh->mTangents,mesh->mTangents,mesh->mNumVertices);
+				TransformDirections(m,mesh->mBitangents,mesh->mBitangents,mesh->mNumVertices);
 			}
 		}
 	}
@@ -365,6 +438,11 @@ void PretransformVertices::BuildWCSMeshes(std::vector<aiMesh*>& out, aiMesh** in
 	for (unsigned int i = 0; i < node->mNumMeshes;++i) {
 		aiMesh* mesh = in[node->mMeshes[i]];
 
+		// shared meshes stay in local space
+		if (meshInstanced[node->mMeshes[i]]) {
+			continue;
+		}
+
 		// check whether we can operate on this mesh
 		if (!mesh->mBones || *reinterpret_cast<aiMatrix4x4*>(mesh->mBones) == node->mTransformation) {
 			// yes, we can.
@@ -430,6 +508,89 @@ void PretransformVertices::BuildMeshRefCountArray(aiNode* nd, unsigned int * ref
 		BuildMeshRefCountArray(nd->mChildren[i],refs);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Estimate the number of bytes of geometry the step will output
+uint64_t PretransformVertices::EstimateOutputSize(const aiScene* pcScene, const aiNode* nd)
+{
+	uint64_t iRet = 0;
+	for (unsigned int i = 0; i < nd->mNumMeshes;++i) {
+		if (meshInstanced[nd->mMeshes[i]]) {
+			// shared meshes are accounted for only once, by the caller
+			continue;
+		}
+		iRet += GetMeshDataSize(pcScene->mMeshes[nd->mMeshes[i]]);
+	}
+
+	// call children
+	for (unsigned int i = 0; i < nd->mNumChildren;++i)
+		iRet += EstimateOutputSize(pcScene,nd->mChildren[i]);
+	return iRet;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Collect all references to shared meshes, with their absolute transformation
+void PretransformVertices::CollectInstances(aiNode* nd,
+	std::vector< std::pair<unsigned int, aiMatrix4x4> >& out)
+{
+	for (unsigned int i = 0; i < nd->mNumMeshes;++i) {
+		if (meshInstanced[nd->mMeshes[i]]) {
+			out.push_back(std::make_pair(nd->mMeshes[i],nd->mTransformation));
+		}
+	}
+
+	// call children
+	for (unsigned int i = 0; i < nd->mNumChildren;++i)
+		CollectInstances(nd->mChildren[i],out);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Move all references to shared meshes into child nodes
+void PretransformVertices::BuildInstanceNodes(aiNode* nd,
+	std::vector< std::pair<aiNode*, aiMatrix4x4> >& out)
+{
+	// call children first, we're going to append to the list
+	for (unsigned int i = 0; i < nd->mNumChildren;++i)
+		BuildInstanceNodes(nd->mChildren[i],out);
+
+	unsigned int numShared = 0;
+	for (unsigned int i = 0; i < nd->mNumMeshes;++i) {
+		numShared += meshInstanced[nd->mMeshes[i]] ? 1 : 0;
+	}
+	if (!numShared) {
+		return;
+	}
+
+	aiNode* inst = new aiNode();
+	inst->mParent = nd;
+	inst->mName = nd->mName;
+	inst->mName.Append("_instance");
+	inst->mMeshes = new unsigned int[inst->mNumMeshes = numShared];
+
+	unsigned int numKept = 0;
+	for (unsigned int i = 0, n = 0; i < nd->mNumMeshes;++i) {
+		if (meshInstanced[nd->mMeshes[i]]) {
+			inst->mMeshes[n++] = nd->mMeshes[i];
+		}
+		else nd->mMeshes[numKept++] = nd->mMeshes[i];
+	}
+	nd->mNumMeshes = numKept;
+	if (!numKept) {
+		delete[] nd->mMeshes;
+		nd->mMeshes = NULL;
+	}
+
+	aiNode** children = new aiNode*[nd->mNumChildren+1];
+	if (nd->mNumChildren) {
+		::memcpy(children,nd->mChildren,sizeof(aiNode*)*nd->mNumChildren);
+	}
+	children[nd->mNumChildren++] = inst;
+	delete[] nd->mChildren;
+	nd->mChildren = children;
+
+	// the transformation is assigned once the hierarchy has been reset to identity
+	out.push_back(std::make_pair(inst,nd->mTransformation));
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void PretransformVertices::Execute( aiScene* pScene)
@@ -448,6 +609,39 @@ void PretransformVertices::Execute( aiScene* pScene)
 		pScene->mRootNode->mTransformation = configTransformation;
 	}
 
+	// In instance mode, meshes referenced more than once are neither copied nor
+	// transformed. Every reference becomes a node carrying its absolute transformation.
+	std::vector<unsigned int> s(pScene->mNumMeshes,0);
+	BuildMeshRefCountArray(pScene->mRootNode,&s[0]);
+
+	meshInstanced.assign(pScene->mNumMeshes,false);
+	unsigned int iNumShared = 0;
+	if (configInstances) {
+		for (unsigned int i = 0; i < pScene->mNumMeshes;++i) {
+			if (s[i] > 1) {
+				meshInstanced[i] = true;
+				++iNumShared;
+			}
+		}
+	}
+
+	// Refuse to run if the flattened geometry would exceed the configured budget
+	if (configMaxOutputBytes) {
+		uint64_t iEstimate = EstimateOutputSize(pScene,pScene->mRootNode);
+		for (unsigned int i = 0; i < pScene->mNumMeshes;++i) {
+			if (meshInstanced[i]) {
+				iEstimate += GetMeshDataSize(pScene->mMeshes[i]);
+			}
+		}
+		if (iEstimate > configMaxOutputBytes) {
+			char buffer[512];
+			::sprintf(buffer,"PretransformVertices: Estimated output size of %u MB exceeds the budget of %u MB",
+				static_cast<unsigned int>(iEstimate >> 20u),
+				static_cast<unsigned int>(configMaxOutputBytes >> 20u));
+			throw DeadlyImportError(buffer);
+		}
+	}
+
 	// first compute absolute transformation matrices for all nodes
 	ComputeAbsoluteTransform(pScene->mRootNode);
 
@@ -462,8 +656,13 @@ void PretransformVertices::Execute( aiScene* pScene)
 
 		delete[] mesh->mBones;
 		mesh->mBones = NULL;
+		mesh->mNumBones = 0;
 	}
 
+	// references to shared meshes (instance mode only)
+	std::vector< std::pair<unsigned int, aiMatrix4x4> > instances;
+	std::vector< std::pair<aiNode*, aiMatrix4x4> > instanceNodes;
+
 	// now build a list of output meshes
 	std::vector<aiMesh*> apcOutMeshes;
 
@@ -473,6 +672,11 @@ void PretransformVertices::Execute( aiScene* pScene)
 	// is required.
 	if( configKeepHierarchy ) {
 
+		// move references to shared meshes into nodes of their own
+		if (iNumShared) {
+			BuildInstanceNodes(pScene->mRootNode,instanceNodes);
+		}
+
 		// Hack: store the matrix we're transforming a mesh with in aiMesh::mBones
 		BuildWCSMeshes(apcOutMeshes,pScene->mMeshes,pScene->mNumMeshes, pScene->mRootNode);
 
@@ -489,7 +693,9 @@ void PretransformVertices::Execute( aiScene* pScene)
 
 		// now iterate through all meshes and transform them to worldspace
 		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-			ApplyTransform(pScene->mMeshes[i],*reinterpret_cast<aiMatrix4x4*>( pScene->mMeshes[i]->mBones ));
+			if (pScene->mMeshes[i]->mBones) {
+				ApplyTransform(pScene->mMeshes[i],*reinterpret_cast<aiMatrix4x4*>( pScene->mMeshes[i]->mBones ));
+			}
 
 			// prevent improper destruction
 			pScene->mMeshes[i]->mBones    = NULL;
@@ -501,62 +707,90 @@ void PretransformVertices::Execute( aiScene* pScene)
 		apcOutMeshes.reserve(pScene->mNumMaterials<<1u);
 		std::list<unsigned int> aiVFormats;
 
-		std::vector<unsigned int> s(pScene->mNumMeshes,0);
-		BuildMeshRefCountArray(pScene->mRootNode,&s[0]);
-
-		for (unsigned int i = 0; i < pScene->mNumMaterials;++i)		{
-			// get the list of all vertex formats for this material
-			aiVFormats.clear();
-			GetVFormatList(pScene,i,aiVFormats);
-			aiVFormats.sort();
-			aiVFormats.unique();
-			for (std::list<unsigned int>::const_iterator j =  aiVFormats.begin();j != aiVFormats.end();++j)	{
-				unsigned int iVertices = 0;
-				unsigned int iFaces = 0; 
-				CountVerticesAndFaces(pScene,pScene->mRootNode,i,*j,&iFaces,&iVertices);
-				if (0 != iFaces && 0 != iVertices)
-				{
-					apcOutMeshes.push_back(new aiMesh());
-					aiMesh* pcMesh = apcOutMeshes.back();
-					pcMesh->mNumFaces = iFaces;
-					pcMesh->mNumVertices = iVertices;
-					pcMesh->mFaces = new aiFace[iFaces];
-					pcMesh->mVertices = new aiVector3D[iVertices];
-					pcMesh->mMaterialIndex = i;
-					if ((*j) & 0x2)pcMesh->mNormals = new aiVector3D[iVertices];
-					if ((*j) & 0x4)
-					{
-						pcMesh->mTangents    = new aiVector3D[iVertices];
-						pcMesh->mBitangents  = new aiVector3D[iVertices];
-					}
-					iFaces = 0;
-					while ((*j) & (0x100 << iFaces))
+		if (iNumShared) {
+			CollectInstances(pScene->mRootNode,instances);
+		}
+
+		// the output meshes are not part of the scene yet, drop them if the import is cancelled
+		ProgressReporter reporter = GetProgressReporter(pScene->mNumMaterials);
+		try {
+			for (unsigned int i = 0; i < pScene->mNumMaterials;++i)		{
+				reporter.Update(i);
+
+				// get the list of all vertex formats for this material
+				aiVFormats.clear();
+				GetVFormatList(pScene,i,aiVFormats);
+				aiVFormats.sort();
+				aiVFormats.unique();
+				for (std::list<unsigned int>::const_iterator j =  aiVFormats.begin();j != aiVFormats.end();++j)	{
+					unsigned int iVertices = 0;
+					unsigned int iFaces = 0; 
+					CountVerticesAndFaces(pScene,pScene->mRootNode,i,*j,&iFaces,&iVertices);
+					if (0 != iFaces && 0 != iVertices)
 					{
-						pcMesh->mTextureCoords[iFaces] = new aiVector3D[iVertices];
-						if ((*j) & (0x10000 << iFaces))pcMesh->mNumUVComponents[iFaces] = 3;
-						else pcMesh->mNumUVComponents[iFaces] = 2;
-						iFaces++;
+						apcOutMeshes.push_back(new aiMesh());
+						aiMesh* pcMesh = apcOutMeshes.back();
+						pcMesh->mNumFaces = iFaces;
+						pcMesh->mNumVertices = iVertices;
+						pcMesh->mFaces = new aiFace[iFaces];
+						pcMesh->mVertices = new aiVector3D[iVertices];
+						pcMesh->mMaterialIndex = i;
+						if ((*j) & 0x2)pcMesh->mNormals = new aiVector3D[iVertices];
+						if ((*j) & 0x4)
+						{
+							pcMesh->mTangents    = new aiVector3D[iVertices];
+							pcMesh->mBitangents  = new aiVector3D[iVertices];
+						}
+						iFaces = 0;
+						while ((*j) & (0x100 << iFaces))
+						{
+							pcMesh->mTextureCoords[iFaces] = new aiVector3D[iVertices];
+							if ((*j) & (0x10000 << iFaces))pcMesh->mNumUVComponents[iFaces] = 3;
+							else pcMesh->mNumUVComponents[iFaces] = 2;
+							iFaces++;
+						}
+						iFaces = 0;
+						while ((*j) & (0x1000000 << iFaces))
+							pcMesh->mColors[iFaces++] = new aiColor4D[iVertices];
+
+						// fill the mesh ...
+						unsigned int aiTemp[2] = {0,0};
+						CollectData(pScene,pScene->mRootNode,i,*j,pcMesh,aiTemp,&s[0]);
 					}
-					iFaces = 0;
-					while ((*j) & (0x1000000 << iFaces))
-						pcMesh->mColors[iFaces++] = new aiColor4D[iVertices];
-
-					// fill the mesh ...
-					unsigned int aiTemp[2] = {0,0};
-					CollectData(pScene,pScene->mRootNode,i,*j,pcMesh,aiTemp,&s[0]);
 				}
 			}
 		}
+		catch (...) {
+			for (std::vector<aiMesh*>::iterator it = apcOutMeshes.begin(); it != apcOutMeshes.end(); ++it) {
+				delete *it;
+			}
+			throw;
+		}
 
 		// If no meshes are referenced in the node graph it is possible that we get no output meshes. 
-		if (apcOutMeshes.empty())	{		
+		if (apcOutMeshes.empty() && !iNumShared)	{		
 			throw DeadlyImportError("No output meshes: all meshes are orphaned and are not referenced by any nodes");
 		}
 		else
 		{
+			// shared meshes are appended unmodified to the list of output meshes
+			std::vector<unsigned int> remap(pScene->mNumMeshes,UINT_MAX);
+			for (unsigned int i = 0; i < pScene->mNumMeshes;++i) {
+				if (meshInstanced[i]) {
+					remap[i] = static_cast<unsigned int>(apcOutMeshes.size());
+					apcOutMeshes.push_back(pScene->mMeshes[i]);
+				}
+			}
+			for (std::vector< std::pair<unsigned int, aiMatrix4x4> >::iterator it = instances.begin(); it != instances.end(); ++it) {
+				(*it).first = remap[(*it).first];
+			}
+
 			// now delete all meshes in the scene and build a new mesh list
 			for (unsigned int i = 0; i < pScene->mNumMeshes;++i)
 			{
+				if (meshInstanced[i]) {
+					continue;
+				}
 				aiMesh* mesh = pScene->mMeshes[i];
 				mesh->mNumBones = 0;
 				mesh->mBones    = NULL;
@@ -628,7 +862,8 @@ void PretransformVertices::Execute( aiScene* pScene)
 		pScene->mRootNode = new aiNode();
 		pScene->mRootNode->mName.Set("<dummy_root>");
 
-		if (1 == pScene->mNumMeshes && !pScene->mNumLights && !pScene->mNumCameras)
+		const unsigned int iNumJoined = pScene->mNumMeshes - iNumShared;
+		if (1 == pScene->mNumMeshes && instances.empty() && !pScene->mNumLights && !pScene->mNumCameras)
 		{
 			pScene->mRootNode->mNumMeshes = 1;
 			pScene->mRootNode->mMeshes = new unsigned int[1];
@@ -636,11 +871,11 @@ void PretransformVertices::Execute( aiScene* pScene)
 		}
 		else
 		{
-			pScene->mRootNode->mNumChildren = pScene->mNumMeshes+pScene->mNumLights+pScene->mNumCameras;
+			pScene->mRootNode->mNumChildren = iNumJoined+(unsigned int)instances.size()+pScene->mNumLights+pScene->mNumCameras;
 			aiNode** nodes = pScene->mRootNode->mChildren = new aiNode*[pScene->mRootNode->mNumChildren];
 
 			// generate mesh nodes
-			for (unsigned int i = 0; i < pScene->mNumMeshes;++i,++nodes)
+			for (unsigned int i = 0; i < iNumJoined;++i,++nodes)
 			{
 				aiNode* pcNode = *nodes = new aiNode();
 				pcNode->mParent = pScene->mRootNode;
@@ -651,6 +886,19 @@ void PretransformVertices::Execute( aiScene* pScene)
 				pcNode->mMeshes = new unsigned int[1];
 				pcNode->mMeshes[0] = i;
 			}
+			// generate instance nodes, one for each reference to a shared mesh
+			for (unsigned int i = 0; i < instances.size();++i,++nodes)
+			{
+				aiNode* pcNode = *nodes = new aiNode();
+				pcNode->mParent = pScene->mRootNode;
+				pcNode->mName.length = ::sprintf(pcNode->mName.data,"instance_%i",i);
+				pcNode->mTransformation = instances[i].second;
+
+				pcNode->mNumMeshes = 1;
+				pcNode->mMeshes = new unsigned int[1];
+				pcNode->mMeshes[0] = instances[i].first;
+				instanceNodes.push_back(std::make_pair(pcNode,instances[i].second));
+			}
 			// generate light nodes
 			for (unsigned int i = 0; i < pScene->mNumLights;++i,++nodes)
 			{
@@ -672,6 +920,11 @@ void PretransformVertices::Execute( aiScene* pScene)
 	else {
 		// ... and finally set the transformation matrix of all nodes to identity
 		MakeIdentityTransform(pScene->mRootNode);
+
+		// except for the nodes referencing shared meshes
+		for (unsigned int i = 0; i < instanceNodes.size();++i) {
+			instanceNodes[i].first->mTransformation = instanceNodes[i].second;
+		}
 	}
 
 	if (configNormalize) {
@@ -679,7 +932,18 @@ void PretransformVertices::Execute( aiScene* pScene)
 		aiVector3D min,max;
 		MinMaxChooser<aiVector3D> ()(min,max);
 
+		std::vector<bool> shared(pScene->mNumMeshes,false);
+		for (unsigned int a = 0; a < instanceNodes.size(); ++a) {
+			const aiNode* nd = instanceNodes[a].first;
+			for (unsigned int i = 0; i < nd->mNumMeshes;++i) {
+				shared[nd->mMeshes[i]] = true;
+			}
+		}
+
 		for (unsigned int a = 0; a <  pScene->mNumMeshes; ++a) {
+			if (shared[a]) {
+				continue;
+			}
 			aiMesh* m = pScene->mMeshes[a];
 			for (unsigned int i = 0; i < m->mNumVertices;++i) {
 				min = std::min(m->mVertices[i],min);
@@ -687,17 +951,57 @@ void PretransformVertices::Execute( aiScene* pScene)
 			}
 		}
 
+		// shared meshes: transform the corners of their bounding box to worldspace.
+		// The result is conservative, but it doesn't touch every vertex per instance.
+		std::vector<aiVector3D> bbox;
+		if (!instanceNodes.empty()) {
+			bbox.resize(pScene->mNumMeshes*2);
+			for (unsigned int a = 0; a <  pScene->mNumMeshes; ++a) {
+				if (shared[a]) {
+					ArrayBounds(pScene->mMeshes[a]->mVertices,pScene->mMeshes[a]->mNumVertices,bbox[a*2],bbox[a*2+1]);
+				}
+			}
+		}
+		for (unsigned int a = 0; a < instanceNodes.size(); ++a) {
+			const aiNode* nd = instanceNodes[a].first;
+			for (unsigned int i = 0; i < nd->mNumMeshes;++i) {
+				const aiVector3D& bmin = bbox[nd->mMeshes[i]*2], &bmax = bbox[nd->mMeshes[i]*2+1];
+				for (unsigned int c = 0; c < 8; ++c) {
+					const aiVector3D corner = nd->mTransformation * aiVector3D(
+						c & 1 ? bmax.x : bmin.x, c & 2 ? bmax.y : bmin.y, c & 4 ? bmax.z : bmin.z);
+					min = std::min(corner,min);
+					max = std::max(corner,max);
+				}
+			}
+		}
+
 		// find the dominant axis
 		aiVector3D d = max-min;
 		const float div = std::max(d.x,std::max(d.y,d.z))*0.5f;
 	
 		d = min+d*0.5f;
 		for (unsigned int a = 0; a <  pScene->mNumMeshes; ++a) {
+			if (shared[a]) {
+				continue;
+			}
 			aiMesh* m = pScene->mMeshes[a];
 			for (unsigned int i = 0; i < m->mNumVertices;++i) {
 				m->mVertices[i] = (m->mVertices[i]-d)/div;
 			}
 		}
+
+		// shared meshes stay untouched, the normalization goes to their instances
+		if (!instanceNodes.empty()) {
+			aiMatrix4x4 scale, translate;
+			aiMatrix4x4::Scaling(aiVector3D(1.f/div,1.f/div,1.f/div),scale);
+			aiMatrix4x4::Translation(-d,translate);
+
+			const aiMatrix4x4 norm = scale * translate;
+			for (unsigned int a = 0; a < instanceNodes.size(); ++a) {
+				aiNode* nd = instanceNodes[a].first;
+				nd->mTransformation = norm * nd->mTransformation;
+			}
+		}
 	}
 
 	// print statistics
@@ -718,6 +1022,12 @@ void PretransformVertices::Execute( aiScene* pScene)
 		sprintf(buffer,"Moved %i meshes to WCS (number of output meshes: %i)",
 			iOldMeshes,pScene->mNumMeshes);
 		DefaultLogger::get()->info(buffer);
+
+		if (iNumShared) {
+			sprintf(buffer,"Kept %i shared meshes in local space (%i instances)",
+				iNumShared,(int)instanceNodes.size());
+			DefaultLogger::get()->info(buffer);
+		}
 	}
 }
 
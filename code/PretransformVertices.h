@@ -72,6 +72,10 @@ public:
 	// Check whether step is active
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "PretransformVertices"; }
+
 	// -------------------------------------------------------------------
 	// Execute step on a given scene
 	void Execute( aiScene* pScene);
@@ -97,6 +101,30 @@ public:
 		return configKeepHierarchy;
 	}
 
+	// -------------------------------------------------------------------
+	/** @brief Toggle instancing mode. Meshes referenced by more than one
+	 *  node are kept in local space and shared by all instances, see
+	 *  #AI_CONFIG_PP_PTV_INSTANCES.
+	 */
+	void SetInstancing(bool d) {
+		configInstances = d;
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Check whether instancing mode is currently enabled.
+	 */
+	bool IsInstancing() const {
+		return configInstances;
+	}
+
+	// -------------------------------------------------------------------
+	/** @brief Set the maximum estimated size of the output geometry,
+	 *  in bytes. 0 disables the check.
+	 */
+	void SetOutputBudget(uint64_t bytes) {
+		configMaxOutputBytes = bytes;
+	}
+
 private:
 
 	// -------------------------------------------------------------------
@@ -152,6 +180,22 @@ private:
 	// Build reference counters for all meshes
 	void BuildMeshRefCountArray(aiNode* nd, unsigned int * refs);
 
+	// -------------------------------------------------------------------
+	// Estimate the number of bytes of geometry the step will output
+	uint64_t EstimateOutputSize(const aiScene* pcScene, const aiNode* nd);
+
+	// -------------------------------------------------------------------
+	// Collect all references to shared meshes, with their absolute
+	// transformation. The references are removed from the nodes.
+	void CollectInstances(aiNode* nd,
+		std::vector< std::pair<unsigned int, aiMatrix4x4> >& out);
+
+	// -------------------------------------------------------------------
+	// Move all references to shared meshes into child nodes which
+	// keep the absolute transformation of their parent.
+	void BuildInstanceNodes(aiNode* nd,
+		std::vector< std::pair<aiNode*, aiMatrix4x4> >& out);
+
 
 
 	//! Configuration option: keep scene hierarchy as long as possible
@@ -159,6 +203,15 @@ private:
 	bool configNormalize;
 	bool configTransform;
 	aiMatrix4x4 configTransformation;
+
+	//! Configuration option: keep shared meshes in local space
+	bool configInstances;
+
+	//! Configuration option: maximum estimated output size, 0 if unlimited
+	uint64_t configMaxOutputBytes;
+
+	//! Per input mesh: set if the mesh is kept shared (instance mode only)
+	std::vector<bool> meshInstanced;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,243 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ProbeIOSystem.cpp
+ *  @brief Implementation of the IOSystem wrapper used for format detection
+ */
+
+#include "ProbeIOSystem.h"
+#include "../include/assimp/ai_assert.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+/** Read-only stream over the probed file. The header is served from memory, everything
+ *  beyond it is read from the file, which is only opened on demand. */
+class ProbeIOStream : public IOStream
+{
+public:
+
+	ProbeIOStream(const ProbeIOSystem* probe)
+		: probe(probe)
+		, source()
+		, pos()
+	{}
+
+	~ProbeIOStream() {
+		if (source) {
+			probe->GetWrapped()->Close(source);
+		}
+	}
+
+public:
+
+	size_t Read(void* pvBuffer, size_t pSize, size_t pCount) {
+		if (!pSize || !pCount) {
+			return 0;
+		}
+
+		const size_t headerSize = probe->GetHeaderSize();
+		if (pos + pSize * pCount <= headerSize || (probe->IsFileSizeKnown() && headerSize == probe->GetFileSize())) {
+			const size_t cnt = std::min(pCount,(headerSize - std::min(pos,headerSize)) / pSize);
+			::memcpy(pvBuffer,probe->GetHeader() + pos,cnt * pSize);
+			pos += cnt * pSize;
+			return cnt;
+		}
+
+		if (!source) {
+			source = probe->GetWrapped()->Open(probe->GetFile(),"rb");
+			if (!source) {
+				return 0;
+			}
+		}
+		if (source->Tell() != pos && AI_SUCCESS != source->Seek(pos,aiOrigin_SET)) {
+			return 0;
+		}
+		const size_t cnt = source->Read(pvBuffer,pSize,pCount);
+		pos += cnt * pSize;
+		return cnt;
+	}
+
+	size_t Write(const void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+		return 0;
+	}
+
+	aiReturn Seek(size_t pOffset, aiOrigin pOrigin) {
+		if (aiOrigin_END == pOrigin) {
+			const size_t size = FileSize();
+			if (pOffset > size) {
+				return AI_FAILURE;
+			}
+			pos = size - pOffset;
+			return AI_SUCCESS;
+		}
+
+		const size_t target = aiOrigin_SET == pOrigin ? pOffset : pos + pOffset;
+
+		// don't determine the size just to check the offset, reads past the end fail anyway
+		if (probe->IsFileSizeKnown() && target > probe->GetFileSize()) {
+			return AI_FAILURE;
+		}
+		pos = target;
+		return AI_SUCCESS;
+	}
+
+	size_t Tell() const {
+		return pos;
+	}
+
+	size_t FileSize() const {
+		// ask the stream we read from anyway instead of opening the file again
+		if (!probe->IsFileSizeKnown() && source) {
+			return source->FileSize();
+		}
+		return probe->GetFileSize();
+	}
+
+	void Flush() {
+	}
+
+private:
+
+	const ProbeIOSystem* probe;
+	IOStream* source;
+	size_t pos;
+};
+
+}
+
+// ------------------------------------------------------------------------------------------------
+ProbeIOSystem::ProbeIOSystem(IOSystem* wrapped, const std::string& file, bool askSize, size_t headerSize)
+: wrapped(wrapped)
+, file(file)
+, fileSize()
+, fileSizeKnown()
+, valid()
+{
+	ai_assert(NULL != wrapped);
+
+	IOStream* stream = wrapped->Open(file,"rb");
+	if (!stream) {
+		return;
+	}
+
+	if (askSize) {
+		fileSize = stream->FileSize();
+		fileSizeKnown = true;
+	}
+
+	header.resize(askSize ? std::min(headerSize,fileSize) : headerSize);
+	if (!header.empty()) {
+		header.resize(stream->Read(&header[0],1,header.size()));
+	}
+	wrapped->Close(stream);
+
+	// a short read means the header is the whole file, whatever the stream claimed
+	if (header.size() < headerSize) {
+		fileSize = header.size();
+		fileSizeKnown = true;
+	}
+	valid = true;
+}
+
+// ------------------------------------------------------------------------------------------------
+ProbeIOSystem::~ProbeIOSystem()
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t ProbeIOSystem::GetFileSize() const
+{
+	if (!fileSizeKnown && valid) {
+		IOStream* stream = wrapped->Open(file,"rb");
+		if (stream) {
+			fileSize = stream->FileSize();
+			wrapped->Close(stream);
+		}
+		fileSizeKnown = true;
+	}
+	return fileSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ProbeIOSystem::Exists( const char* pFile) const
+{
+	return (valid && file == pFile) || wrapped->Exists(pFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+char ProbeIOSystem::getOsSeparator() const
+{
+	return wrapped->getOsSeparator();
+}
+
+// ------------------------------------------------------------------------------------------------
+IOStream* ProbeIOSystem::Open(const char* pFile, const char* pMode)
+{
+	ai_assert(NULL != pFile && NULL != pMode);
+
+	if (!valid || file != pFile || ::strchr(pMode,'w') || ::strchr(pMode,'a') || ::strchr(pMode,'+')) {
+		return wrapped->Open(pFile,pMode);
+	}
+
+	return new ProbeIOStream(this);
+}
+
+// ------------------------------------------------------------------------------------------------
+void ProbeIOSystem::Close( IOStream* pFile)
+{
+	// importers may also delete our streams directly, so they aren't tracked
+	if (dynamic_cast<ProbeIOStream*>(pFile)) {
+		delete pFile;
+	}
+	else wrapped->Close(pFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ProbeIOSystem::ComparePaths (const char* one, const char* two) const
+{
+	return wrapped->ComparePaths(one,two);
+}
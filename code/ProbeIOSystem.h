@@ -0,0 +1,147 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file ProbeIOSystem.h
+ *  @brief Serves the header of a file from memory during format detection
+ */
+#ifndef AI_PROBEIOSYSTEM_H_INC
+#define AI_PROBEIOSYSTEM_H_INC
+
+#include "../include/assimp/IOStream.hpp"
+#include "../include/assimp/IOSystem.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+// Number of bytes read from the start of a file for format detection
+#ifndef AI_PROBE_HEADER_SIZE
+#	define AI_PROBE_HEADER_SIZE 4096
+#endif
+
+// ------------------------------------------------------------------------------------------------
+/** @brief IOSystem wrapper which reads the header of a single file once.
+ *
+ *  All importers check the file through this wrapper during format detection. Opening
+ *  the probed file for reading returns a stream which serves the header from memory, 
+ *  so BaseImporter::SearchFileHeaderForToken(), BaseImporter::CheckMagicToken() and
+ *  the like don't touch the file again. Reads beyond the header open the file itself.
+ *  All other files are passed through to the wrapped IOSystem. */
+// ------------------------------------------------------------------------------------------------
+class ProbeIOSystem : public IOSystem
+{
+public:
+
+	/** Reads the header of a file.
+	 *  @param wrapped IOSystem to read the files from. It is not owned.
+	 *  @param file File to probe
+	 *  @param askSize Ask for the size of the file right away. Pass false for streams
+	 *    which can't tell it cheaply, i.e. #CompressedIOStream, the size is then only
+	 *    determined if it is needed.
+	 *  @param headerSize Maximum number of bytes to keep in memory */
+	ProbeIOSystem(IOSystem* wrapped, const std::string& file, bool askSize = true,
+		size_t headerSize = AI_PROBE_HEADER_SIZE);
+
+	~ProbeIOSystem();
+
+public:
+
+	/** Checks whether the probed file could be opened */
+	bool IsValid() const {
+		return valid;
+	}
+
+	/** Returns the first bytes of the probed file */
+	const char* GetHeader() const {
+		return header.empty() ? NULL : &header[0];
+	}
+
+	/** Returns the number of bytes returned by GetHeader() */
+	size_t GetHeaderSize() const {
+		return header.size();
+	}
+
+	/** Returns the total size of the probed file. If it wasn't asked for up front
+	 *  and the header doesn't cover the whole file, the wrapped IOSystem is asked now. */
+	size_t GetFileSize() const;
+
+	/** Checks whether the size of the probed file is known without asking
+	 *  the wrapped IOSystem */
+	bool IsFileSizeKnown() const {
+		return fileSizeKnown;
+	}
+
+	/** Returns the name of the probed file */
+	const std::string& GetFile() const {
+		return file;
+	}
+
+	/** Returns the wrapped IOSystem */
+	IOSystem* GetWrapped() const {
+		return wrapped;
+	}
+
+public:
+
+	bool Exists( const char* pFile) const;
+
+	char getOsSeparator() const;
+
+	IOStream* Open(const char* pFile, const char* pMode = "rb");
+
+	void Close( IOStream* pFile);
+
+	bool ComparePaths (const char* one, const char* two) const;
+
+private:
+
+	IOSystem* wrapped;
+	std::string file;
+	std::vector<char> header;
+	mutable size_t fileSize;
+	mutable bool fileSizeKnown;
+	bool valid;
+};
+
+} // ! Assimp
+
+#endif // AI_PROBEIOSYSTEM_H_INC
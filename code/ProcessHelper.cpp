@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <limits>
+#include <algorithm>
+#include <stdint.h>
 
 namespace Assimp {
 
@@ -203,6 +205,68 @@ VertexWeightTable* ComputeVertexBoneWeightTable(const aiMesh* pMesh)
 }
 
 
+// -------------------------------------------------------------------------------
+// Spread the lower 10 bits of a value so that there are two zero bits between each
+static inline uint32_t SpreadBits10(uint32_t v)
+{
+	v &= 0x3ff;
+	v = (v | (v << 16)) & 0x030000ff;
+	v = (v | (v <<  8)) & 0x0300f00f;
+	v = (v | (v <<  4)) & 0x030c30c3;
+	v = (v | (v <<  2)) & 0x09249249;
+	return v;
+}
+
+// -------------------------------------------------------------------------------
+void ComputeMortonFaceOrder(const aiMesh* pMesh, std::vector<unsigned int>& out)
+{
+	out.clear();
+	if (!pMesh->mNumFaces) {
+		return;
+	}
+
+	// compute all face centroids and their bounds
+	std::vector<aiVector3D> centroids(pMesh->mNumFaces);
+	aiVector3D min( 1e10f, 1e10f, 1e10f), max(-1e10f,-1e10f,-1e10f);
+	for (unsigned int i = 0; i < pMesh->mNumFaces;++i) {
+		const aiFace& face = pMesh->mFaces[i];
+
+		aiVector3D c;
+		for (unsigned int n = 0; n < face.mNumIndices;++n) {
+			c += pMesh->mVertices[face.mIndices[n]];
+		}
+		if (face.mNumIndices) {
+			c /= static_cast<float>(face.mNumIndices);
+		}
+		centroids[i] = c;
+		min = std::min(min,c);
+		max = std::max(max,c);
+	}
+
+	// quantize to 10 bits per axis and interleave. The sort key carries the
+	// face index in its lower half so equal codes keep their original order.
+	const aiVector3D ext = max - min;
+	const float sx = ext.x > 0.f ? 1023.f / ext.x : 0.f;
+	const float sy = ext.y > 0.f ? 1023.f / ext.y : 0.f;
+	const float sz = ext.z > 0.f ? 1023.f / ext.z : 0.f;
+
+	std::vector<uint64_t> keys(pMesh->mNumFaces);
+	for (unsigned int i = 0; i < pMesh->mNumFaces;++i) {
+		const aiVector3D d = centroids[i] - min;
+		const uint32_t code = SpreadBits10(static_cast<uint32_t>(d.x * sx)) |
+			(SpreadBits10(static_cast<uint32_t>(d.y * sy)) << 1) |
+			(SpreadBits10(static_cast<uint32_t>(d.z * sz)) << 2);
+
+		keys[i] = (static_cast<uint64_t>(code) << 32) | i;
+	}
+	std::sort(keys.begin(),keys.end());
+
+	out.resize(pMesh->mNumFaces);
+	for (unsigned int i = 0; i < pMesh->mNumFaces;++i) {
+		out[i] = static_cast<unsigned int>(keys[i] & 0xffffffff);
+	}
+}
+
 // -------------------------------------------------------------------------------
 const char* TextureTypeToString(aiTextureType in)
 {
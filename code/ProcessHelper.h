@@ -315,6 +315,17 @@ const char* TextureTypeToString(aiTextureType in);
 const char* MappingTypeToString(aiTextureMapping in);
 
 
+// -------------------------------------------------------------------------------
+/** @brief Compute a spatially coherent ordering of the faces of a mesh
+ *
+ *  The faces are sorted by the Morton code (z-order) of their centroids,
+ *  quantized to the bounding box of all centroids. Consecutive ranges of
+ *  the resulting order are spatially compact.
+ *  @param pMesh Input mesh, must have positions
+ *  @param[out] out Receives the face indices in z-order */
+void ComputeMortonFaceOrder(const aiMesh* pMesh, std::vector<unsigned int>& out);
+
+
 // flags for MakeSubmesh()
 #define AI_SUBMESH_FLAGS_SANS_BONES	0x1
 
@@ -333,23 +344,56 @@ class ComputeSpatialSortProcess : public BaseProcess
 			aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
 	}
 
+	const char* GetName() const
+	{
+		return "ComputeSpatialSortProcess";
+	}
+
 	void Execute( aiScene* pScene)
 	{
-		typedef std::pair<SpatialSort, float> _Type; 
+		ExecuteMeshByMesh(pScene);
+	}
+
+	void GetDataAccess( unsigned int& read, unsigned int& write) const
+	{
+		read = PPData_Positions;
+		write = 0;
+	}
+
+	bool IsPerMesh() const
+	{
+		return true;
+	}
+
+	// the cache is published up front, entry i is filled when mesh i comes along
+	void BeginMeshes( aiScene* pScene)
+	{
 		DefaultLogger::get()->debug("Generate spatially-sorted vertex cache");
 
-		std::vector<_Type>* p = new std::vector<_Type>(pScene->mNumMeshes); 
-		std::vector<_Type>::iterator it = p->begin();
+		cache = new std::vector<_Type>(pScene->mNumMeshes); 
+		shared->AddProperty(AI_SPP_SPATIAL_SORT,cache);
+	}
 
-		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i, ++it)	{
-			aiMesh* mesh = pScene->mMeshes[i];
-			_Type& blubb = *it;
-			blubb.first.Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D));
-			blubb.second = ComputePositionEpsilon(mesh);
-		}
+	void ExecuteForMesh( aiScene* pScene, unsigned int meshIndex)
+	{
+		aiMesh* mesh = pScene->mMeshes[meshIndex];
+		_Type& blubb = (*cache)[meshIndex];
+		blubb.first.Fill(mesh->mVertices,mesh->mNumVertices,sizeof(aiVector3D));
+		blubb.second = ComputePositionEpsilon(mesh);
+	}
 
-		shared->AddProperty(AI_SPP_SPATIAL_SORT,p);
+	void EndMeshes( aiScene* /*pScene*/)
+	{
+		cache = NULL;
 	}
+
+	typedef std::pair<SpatialSort, float> _Type; 
+	std::vector<_Type>* cache;
+
+public:
+	ComputeSpatialSortProcess()
+		: cache()
+	{}
 };
 
 // -------------------------------------------------------------------------------
@@ -362,10 +406,30 @@ class DestroySpatialSortProcess : public BaseProcess
 			aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
 	}
 
+	const char* GetName() const
+	{
+		return "DestroySpatialSortProcess";
+	}
+
 	void Execute( aiScene* /*pScene*/)
 	{
 		shared->RemoveProperty(AI_SPP_SPATIAL_SORT);
 	}
+
+	void GetDataAccess( unsigned int& read, unsigned int& write) const
+	{
+		read = write = 0;
+	}
+
+	bool IsPerMesh() const
+	{
+		return true;
+	}
+
+	void EndMeshes( aiScene* /*pScene*/)
+	{
+		shared->RemoveProperty(AI_SPP_SPATIAL_SORT);
+	}
 };
 
 
@@ -0,0 +1,141 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+
+/** @file  ProgressReporter.h
+ *  @brief Throttled progress reports and cancellation checks for loaders
+ */
+#ifndef AI_PROGRESSREPORTER_H_INC
+#define AI_PROGRESSREPORTER_H_INC
+
+#include "../include/assimp/ProgressHandler.hpp"
+#include "Exceptional.h"
+#include "AtomicFlag.h"
+#include <algorithm>
+
+// ------------------------------------------------------------------------------------------------
+/** Error text of an import aborted by the progress handler or by 
+ *  ImportFuture::Cancel() */
+#define AI_IMPORT_CANCELLED_TEXT "Import cancelled"
+
+// ------------------------------------------------------------------------------------------------
+/** Maximum number of progress reports of a single ProgressReporter */
+#if (!defined AI_PROGRESS_MAX_REPORTS)
+#	define AI_PROGRESS_MAX_REPORTS 100
+#endif
+
+namespace Assimp	{
+
+// ------------------------------------------------------------------------------------------------
+/** Throws if the import has been cancelled, see ImportFuture::Cancel() 
+ *  @param cancel Cancellation flag, may be NULL */
+inline void ThrowIfCancelled(const AtomicFlag* cancel)
+{
+	if (cancel && cancel->IsSet()) {
+		throw DeadlyImportError(AI_IMPORT_CANCELLED_TEXT);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+/** Reports the progress of a long loop, i.e. over the bytes of a file 
+ *  or the faces of a mesh, to a ProgressHandler.
+ *
+ *  Update() is meant to be called once per iteration. It is cheap unless
+ *  a report is due, which is the case at most #AI_PROGRESS_MAX_REPORTS 
+ *  times, regardless of the amount of work. Each report checks whether 
+ *  the import has been cancelled, either by the progress handler 
+ *  returning false or through the cancellation flag. */
+class ProgressReporter
+{
+public:
+
+	/** @param handler Receives the reports, may be NULL
+	 *  @param cancel Cancellation flag, may be NULL
+	 *  @param total Total amount of work
+	 *  @param base Progress at the start of the loop, in [0,1]
+	 *  @param range Share of the total progress covered by the loop. The 
+	 *    default is the file reading phase, see ProgressHandler::UpdateFileRead() */
+	ProgressReporter(ProgressHandler* handler, const AtomicFlag* cancel, 
+		size_t total, float base = 0.f, float range = 0.5f)
+		: handler(handler)
+		, cancel(cancel)
+		, total(total)
+		, step(std::max(static_cast<size_t>(1),total / AI_PROGRESS_MAX_REPORTS))
+		, next(step)
+		, base(base)
+		, range(range)
+	{}
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Report that done units of work have been processed 
+	 *  @throw DeadlyImportError if the import has been cancelled */
+	inline void Update(size_t done)
+	{
+		if (done >= next) {
+			Report(done);
+		}
+	}
+
+private:
+
+	void Report(size_t done)
+	{
+		next = done + step;
+		ThrowIfCancelled(cancel);
+
+		const float f = total ? std::min(1.f,static_cast<float>(done) / total) : 1.f;
+		if (handler && !handler->Update(base + f * range)) {
+			throw DeadlyImportError(AI_IMPORT_CANCELLED_TEXT);
+		}
+	}
+
+	ProgressHandler* const handler;
+	const AtomicFlag* const cancel;
+	const size_t total, step;
+	size_t next;
+	const float base, range;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_PROGRESSREPORTER_H_INC
@@ -103,12 +103,12 @@ bool Q3BSPFileParser::readData( const std::string &rMapName )
 	m_Data.resize( size );
 
 	const size_t readSize = pMapFile->Read( &m_Data[0], sizeof( char ), size );
+	m_pZipArchive->Close( pMapFile );
 	if ( readSize != size )
 	{
 		m_Data.clear();
 		return false;
 	}
-	m_pZipArchive->Close( pMapFile );
 
 	return true;
 }
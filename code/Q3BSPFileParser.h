@@ -51,7 +51,6 @@ namespace Q3BSP
 
 class Q3BSPZipArchive;
 struct Q3BSPModel;
-class ZipFile;
 
 }
 
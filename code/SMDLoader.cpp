@@ -652,8 +652,7 @@ void SMDImporter::CreateOutputMaterials()
 
 		if (aszTextures[iMat].length())
 		{
-			::strcpy(szName.data, aszTextures[iMat].c_str() );
-			szName.length = aszTextures[iMat].length();
+			szName = aiString(aszTextures[iMat]);
 			pcMat->AddProperty(&szName,AI_MATKEY_TEXTURE_DIFFUSE(0));
 		}
 	}
@@ -58,48 +58,40 @@ namespace Assimp	{
 // Worker function for exporting a scene to Stereolithograpy. Prototyped and registered in Exporter.cpp
 void ExportSceneSTL(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
-	// invoke the exporter 
-	STLExporter exporter(pFile, pScene);
-
-	// we're still here - export successfully completed. Write the file.
 	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
 	if(outfile == NULL) {
 		throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
 	}
 
-	outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+	// invoke the exporter, it streams directly into the file
+	STLExporter exporter(pFile, pScene, outfile.get());
 }
 void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties)
 {
-	// invoke the exporter 
-	STLExporter exporter(pFile, pScene, true);
-
-	// we're still here - export successfully completed. Write the file.
-	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wt"));
+	boost::scoped_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wb"));
 	if(outfile == NULL) {
 		throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
 	}
 
-	outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+	// invoke the exporter, it streams directly into the file
+	STLExporter exporter(pFile, pScene, outfile.get(), true);
 }
 
 } // end of namespace Assimp
 
 
 // ------------------------------------------------------------------------------------------------
-STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, bool binary)
-: filename(_filename)
+STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, IOStream* output, bool binary)
+: mOutput(output)
+, filename(_filename)
 , pScene(pScene)
 , endl("\n") 
 {
-	// make sure that all formatting happens using the standard, C locale and not the user's current locale
-	const std::locale& l = std::locale("C");
-	mOutput.imbue(l);
 	if (binary) {
 		char buf[80] = {0} ;
 		buf[0] = 'A'; buf[1] = 's'; buf[2] = 's'; buf[3] = 'i'; buf[4] = 'm'; buf[5] = 'p';
 		buf[6] = 'S'; buf[7] = 'c'; buf[8] = 'e'; buf[9] = 'n'; buf[10] = 'e';
-		mOutput.write(buf, 80);
+		mOutput.Write(buf, 80);
 		unsigned int meshnum = 0;
 		for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 			for (unsigned int j = 0; j < pScene->mMeshes[i]->mNumFaces; ++j) {
@@ -107,7 +99,7 @@ STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, bool bi
 			}
 		}
 		AI_SWAP4(meshnum);
-		mOutput.write((char *)&meshnum, 4);
+		mOutput.Write((char *)&meshnum, 4);
 		for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 			WriteMeshBinary(pScene->mMeshes[i]);
 		}
@@ -120,12 +112,20 @@ STLExporter :: STLExporter(const char* _filename, const aiScene* pScene, bool bi
 		}
 		mOutput << "endsolid " << name << endl;
 	}
+
+	mOutput.Flush();
 }
 
 // ------------------------------------------------------------------------------------------------
-void STLExporter :: WriteMesh(const aiMesh* m)
+// Formats a single facet, see WriteMesh()
+struct STLFacetFormatter
 {
-	for (unsigned int i = 0; i < m->mNumFaces; ++i) {
+	explicit STLFacetFormatter(const aiMesh* m)
+		: m(m)
+	{}
+
+	void operator() (TextWriter& out, size_t i) const
+	{
 		const aiFace& f = m->mFaces[i];
 
 		// we need per-face normals. We specified aiProcess_GenNormals as pre-requisite for this exporter,
@@ -137,16 +137,25 @@ void STLExporter :: WriteMesh(const aiMesh* m)
 			}
 			nor.Normalize();
 		}
-		mOutput << " facet normal " << nor.x << " " << nor.y << " " << nor.z << endl;
-		mOutput << "  outer loop" << endl; 
+		out << " facet normal " << nor.x << ' ' << nor.y << ' ' << nor.z << '\n';
+		out << "  outer loop\n"; 
 		for(unsigned int a = 0; a < f.mNumIndices; ++a) {
 			const aiVector3D& v  = m->mVertices[f.mIndices[a]];
-			mOutput << "  vertex " << v.x << " " << v.y << " " << v.z << endl;
+			out << "  vertex " << v.x << ' ' << v.y << ' ' << v.z << '\n';
 		}
 
-		mOutput << "  endloop" << endl; 
-		mOutput << " endfacet" << endl << endl; 
+		out << "  endloop\n"; 
+		out << " endfacet\n\n"; 
 	}
+
+	const aiMesh* m;
+};
+
+// ------------------------------------------------------------------------------------------------
+void STLExporter :: WriteMesh(const aiMesh* m)
+{
+	STLFacetFormatter fmt(m);
+	WriteParallel(mOutput,m->mNumFaces,fmt);
 }
 
 void STLExporter :: WriteMeshBinary(const aiMesh* m)
@@ -164,15 +173,15 @@ void STLExporter :: WriteMeshBinary(const aiMesh* m)
 		}
 		float nx = nor.x, ny = nor.y, nz = nor.z;
 		AI_SWAP4(nx); AI_SWAP4(ny); AI_SWAP4(nz);
-		mOutput.write((char *)&nx, 4); mOutput.write((char *)&ny, 4); mOutput.write((char *)&nz, 4);
+		mOutput.Write((char *)&nx, 4); mOutput.Write((char *)&ny, 4); mOutput.Write((char *)&nz, 4);
 		for(unsigned int a = 0; a < f.mNumIndices; ++a) {
 			const aiVector3D& v  = m->mVertices[f.mIndices[a]];
 			float vx = v.x, vy = v.y, vz = v.z;
 			AI_SWAP4(vx); AI_SWAP4(vy); AI_SWAP4(vz);
-			mOutput.write((char *)&vx, 4); mOutput.write((char *)&vy, 4); mOutput.write((char *)&vz, 4);
+			mOutput.Write((char *)&vx, 4); mOutput.Write((char *)&vy, 4); mOutput.Write((char *)&vz, 4);
 		}
 		char dummy[2] = {0};
-		mOutput.write(dummy, 2);
+		mOutput.Write(dummy, 2);
 	}
 }
 
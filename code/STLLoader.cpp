@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STLLoader.h"
 #include "ParsingUtils.h"
 #include "fast_atof.h"
+#include "ProgressReporter.h"
 #include <boost/scoped_ptr.hpp>
 #include "../include/assimp/IOSystem.hpp"
 #include "../include/assimp/scene.h"
@@ -250,9 +251,13 @@ void STLImporter::LoadASCIIFile()
 	pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
 	pMesh->mNormals  = new aiVector3D[pMesh->mNumVertices];
 	
+	ProgressReporter reporter(progress,cancel,fileSize);
+
 	unsigned int curFace = 0, curVertex = 3;
 	for ( ;; )
 	{
+		reporter.Update(sz - mBuffer);
+
 		// go to the next token
 		if(!SkipSpacesAndLineEnd(&sz))
 		{
@@ -399,7 +404,9 @@ bool STLImporter::LoadBinaryFile()
 	vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
 	vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
 
+	ProgressReporter reporter(progress,cancel,pMesh->mNumFaces);
 	for (unsigned int i = 0; i < pMesh->mNumFaces;++i)	{
+		reporter.Update(i);
 
 		// NOTE: Blender sometimes writes empty normals ... this is not
 		// our fault ... the RemoveInvalidData helper step should fix that
@@ -979,7 +979,8 @@ void SceneCombiner::CopySceneFlat(aiScene** _dest,const aiScene* src)
 }
 
 // ------------------------------------------------------------------------------------------------
-void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate)
+void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate,
+	unsigned int share)
 {
 	ai_assert(NULL != _dest && NULL != src);
 
@@ -994,10 +995,20 @@ void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate)
 	CopyPtrArray(dest->mAnimations,src->mAnimations,
 		dest->mNumAnimations);
 
-	// copy textures
+	// copy textures. Texel data tends to be the largest part of a scene and is 
+	// rarely modified, so callers may choose to reference it instead.
 	dest->mNumTextures = src->mNumTextures;
-	CopyPtrArray(dest->mTextures,src->mTextures,
-		dest->mNumTextures);
+	if (share & AI_INT_COPY_SCENE_SHARE_TEXTURES) {
+		if (dest->mNumTextures) {
+			dest->mTextures = new aiTexture*[dest->mNumTextures];
+			::memcpy(dest->mTextures,src->mTextures,sizeof(aiTexture*)*dest->mNumTextures);
+		}
+		else dest->mTextures = NULL;
+	}
+	else {
+		CopyPtrArray(dest->mTextures,src->mTextures,
+			dest->mNumTextures);
+	}
 
 	// copy materials
 	dest->mNumMaterials = src->mNumMaterials;
@@ -1031,6 +1042,64 @@ void SceneCombiner::CopyScene(aiScene** _dest,const aiScene* src,bool allocate)
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::DetachSharedData(aiScene* dest,const aiScene* src)
+{
+	ai_assert(NULL != dest && NULL != src);
+
+	if (!dest->mTextures || !src->mNumTextures) {
+		return;
+	}
+
+	// textures might have been replaced, reordered or removed in the
+	// copy, so only pointers we actually share are released.
+	std::set<const aiTexture*> shared(src->mTextures,src->mTextures+src->mNumTextures);
+	for (unsigned int i = 0; i < dest->mNumTextures; ++i) {
+		if (shared.find(dest->mTextures[i]) != shared.end()) {
+			dest->mTextures[i] = NULL;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::DetachExternalData(aiScene* scene)
+{
+	ai_assert(NULL != scene);
+
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		aiMesh* mesh = scene->mMeshes[i];
+		if (!mesh->mExternalData) {
+			continue;
+		}
+
+		GetArrayCopy( mesh->mVertices,   mesh->mNumVertices );
+		GetArrayCopy( mesh->mNormals ,   mesh->mNumVertices );
+		GetArrayCopy( mesh->mTangents,   mesh->mNumVertices );
+		GetArrayCopy( mesh->mBitangents, mesh->mNumVertices );
+
+		for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
+			GetArrayCopy( mesh->mTextureCoords[n], mesh->mNumVertices );
+		}
+		for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_COLOR_SETS; ++n) {
+			GetArrayCopy( mesh->mColors[n], mesh->mNumVertices );
+		}
+
+		// post-processing steps replace the indices of single faces,
+		// so every face gets its own allocation again.
+		for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+			aiFace& face = mesh->mFaces[f];
+			GetArrayCopy( face.mIndices, face.mNumIndices );
+		}
+		mesh->mExternalData = 0;
+	}
+
+	ScenePrivateData* priv = ScenePriv(scene);
+	if (priv) {
+		delete priv->mStorage;
+		priv->mStorage = NULL;
+	}
+}
+
 // ------------------------------------------------------------------------------------------------
 void SceneCombiner::Copy     (aiMesh** _dest, const aiMesh* src)
 {
@@ -1065,6 +1134,21 @@ void SceneCombiner::Copy     (aiMesh** _dest, const aiMesh* src)
 		aiFace& f = dest->mFaces[i];
 		GetArrayCopy(f.mIndices,f.mNumIndices);
 	}
+
+	// make a deep copy of all meshlets
+	GetArrayCopy(dest->mMeshlets,dest->mNumMeshlets);
+	for (unsigned int i = 0; i < dest->mNumMeshlets;++i)
+	{
+		aiMeshlet& m = dest->mMeshlets[i];
+		GetArrayCopy(m.mVertices,m.mNumVertices);
+	}
+
+	if (src->mSkinStream) {
+		dest->mSkinStream = new aiSkinStream(*src->mSkinStream);
+	}
+
+	// all arrays are owned by the copy
+	dest->mExternalData = 0;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -143,6 +143,14 @@ struct NodeAttachmentInfo
  */
 #define AI_INT_MERGE_SCENE_GEN_UNIQUE_NAMES_IF_NECESSARY 0x10
 
+// ---------------------------------------------------------------------------
+/** @def AI_INT_COPY_SCENE_SHARE_TEXTURES
+ *  SceneCombiner::CopyScene: don't copy embedded textures, reference
+ *  the aiTexture instances of the source scene instead. The copy must
+ *  be released with SceneCombiner::DetachSharedData before it is deleted.
+ */
+#define AI_INT_COPY_SCENE_SHARE_TEXTURES 0x1
+
 
 typedef std::pair<aiBone*,unsigned int> BoneSrcIndex;
 
@@ -337,8 +345,35 @@ public:
 	 *
 	 *  @param dest Receives a pointer to the destination scene
 	 *  @param src Source scene - remains unmodified.
+	 *  @param share Combination of the AI_INT_COPY_SCENE_XXX flags,
+	 *    selects data which is shared with the source scene rather
+	 *    than copied.
+	 */
+	static void CopyScene(aiScene** dest,const aiScene* source,bool allocate = true,
+		unsigned int share = 0);
+
+
+	// -------------------------------------------------------------------
+	/** Release all data a scene shares with its source scene
+	 *
+	 *  Must be called before deleting a scene obtained from CopyScene
+	 *  with sharing enabled. Data which has been replaced in the copy
+	 *  in the meantime is not affected.
+	 *  @param dest Scene copy
+	 *  @param src Source scene passed to CopyScene()
+	 */
+	static void DetachSharedData(aiScene* dest,const aiScene* source);
+
+
+	// -------------------------------------------------------------------
+	/** Give all meshes of a scene their own copy of external data
+	 *
+	 *  Vertex components and face indices of meshes with 
+	 *  aiMesh::mExternalData set are copied to separate allocations,
+	 *  afterwards the scene storage is released.
+	 *  @param scene Scene to be modified
 	 */
-	static void CopyScene(aiScene** dest,const aiScene* source,bool allocate = true);
+	static void DetachExternalData(aiScene* scene);
 
 
 	// -------------------------------------------------------------------
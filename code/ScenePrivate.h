@@ -49,14 +49,26 @@ namespace Assimp	{
 
 	class Importer;
 
+// Base class for memory which is referenced by the data structures of a
+// scene, i.e. by meshes with aiMesh::mExternalData set.
+class SceneStorage {
+public:
+	virtual ~SceneStorage() {}
+};
+
 struct ScenePrivateData {
 	
 	ScenePrivateData()
 		: mOrigImporter()
 		, mPPStepsApplied()
 		, mIsCopy()
+		, mStorage()
 	{}
 
+	~ScenePrivateData() {
+		delete mStorage;
+	}
+
 	// Importer that originally loaded the scene though the C-API
 	// If set, this object is owned by this private data instance.
 	Assimp::Importer* mOrigImporter;
@@ -70,6 +82,10 @@ struct ScenePrivateData {
 	// and mOrigImporter are no longer safe to rely on and only
 	// serve informative purposes.
 	bool mIsCopy;
+
+	// Storage referenced by the scene, owned by this private data
+	// instance. NULL unless a mesh has aiMesh::mExternalData set.
+	SceneStorage* mStorage;
 };
 
 // Access private data stored in the scene
@@ -66,6 +66,10 @@ public:
 	// -------------------------------------------------------------------
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "SortByPTypeProcess"; }
+
 	// -------------------------------------------------------------------
 	void Execute( aiScene* pScene);
 
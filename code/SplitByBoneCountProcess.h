@@ -75,6 +75,10 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "SplitByBoneCountProcess"; }
+
 	/** Called prior to ExecuteOnScene().
 	* The function is a request to the process to update its configuration
 	* basing on the Importer's configuration property list.
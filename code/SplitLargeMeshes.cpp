@@ -55,6 +55,7 @@ using namespace Assimp;
 SplitLargeMeshesProcess_Triangle::SplitLargeMeshesProcess_Triangle()
 {
 	LIMIT = AI_SLM_DEFAULT_MAX_TRIANGLES;
+	SPATIAL = false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -106,6 +107,7 @@ void SplitLargeMeshesProcess_Triangle::SetupProperties( const Importer* pImp)
 {
     // get the current value of the split property
 	this->LIMIT = pImp->GetPropertyInteger(AI_CONFIG_PP_SLM_TRIANGLE_LIMIT,AI_SLM_DEFAULT_MAX_TRIANGLES);
+	this->SPATIAL = pImp->GetPropertyBool(AI_CONFIG_PP_SLM_SPATIAL_SPLIT,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -154,6 +156,12 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
 	{
 		DefaultLogger::get()->info("Mesh exceeds the triangle limit. It will be split ...");
 
+		if (SPATIAL)
+		{
+			SplitMeshSpatially(a,pMesh,LIMIT,UINT_MAX,avList);
+			return;
+		}
+
 		// we need to split this mesh into sub meshes
 		// determine the size of a submesh
 		const unsigned int iSubMeshes = (pMesh->mNumFaces / LIMIT) + 1;
@@ -349,10 +357,221 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
 	return;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Build a single submesh from a list of source faces and the list of source vertices they use
+static aiMesh* BuildSpatialSubMesh(const aiMesh* pMesh,
+	const std::vector<unsigned int>& vFaces,
+	const std::vector<unsigned int>& vVertices,
+	const std::vector<unsigned int>& vRemap,
+	const VertexWeightTable* avPerVertexWeights,
+	std::vector< std::vector<aiVertexWeight> >& vBoneWeights)
+{
+	aiMesh* pcMesh = new aiMesh();
+	pcMesh->mMaterialIndex = pMesh->mMaterialIndex;
+
+	// the name carries the adjacency information between the meshes
+	pcMesh->mName = pMesh->mName;
+
+	const unsigned int iCnt = (unsigned int)vVertices.size();
+	pcMesh->mNumVertices = iCnt;
+
+	// allocate storage
+	if (pMesh->HasPositions())
+		pcMesh->mVertices = new aiVector3D[iCnt];
+
+	if (pMesh->HasNormals())
+		pcMesh->mNormals = new aiVector3D[iCnt];
+
+	if (pMesh->HasTangentsAndBitangents())
+	{
+		pcMesh->mTangents = new aiVector3D[iCnt];
+		pcMesh->mBitangents = new aiVector3D[iCnt];
+	}
+	for (unsigned int c = 0; pMesh->HasTextureCoords(c);++c)
+	{
+		pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
+		pcMesh->mTextureCoords[c] = new aiVector3D[iCnt];
+	}
+	for (unsigned int c = 0; pMesh->HasVertexColors(c);++c)
+	{
+		pcMesh->mColors[c] = new aiColor4D[iCnt];
+	}
+
+	// copy all vertex components
+	for (unsigned int i = 0; i < iCnt;++i)
+	{
+		const unsigned int iIndex = vVertices[i];
+		if (pMesh->HasPositions())
+			pcMesh->mVertices[i] = pMesh->mVertices[iIndex];
+
+		if (pMesh->HasNormals())
+			pcMesh->mNormals[i] = pMesh->mNormals[iIndex];
+
+		if (pMesh->HasTangentsAndBitangents())
+		{
+			pcMesh->mTangents[i] = pMesh->mTangents[iIndex];
+			pcMesh->mBitangents[i] = pMesh->mBitangents[iIndex];
+		}
+		for (unsigned int c = 0; pMesh->HasTextureCoords(c);++c)
+			pcMesh->mTextureCoords[c][i] = pMesh->mTextureCoords[c][iIndex];
+
+		for (unsigned int c = 0; pMesh->HasVertexColors(c);++c)
+			pcMesh->mColors[c][i] = pMesh->mColors[c][iIndex];
+	}
+
+	// copy the faces, remapping their indices
+	pcMesh->mNumFaces = (unsigned int)vFaces.size();
+	pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+	for (unsigned int p = 0; p < pcMesh->mNumFaces;++p)
+	{
+		const aiFace& src = pMesh->mFaces[vFaces[p]];
+		aiFace& dest = pcMesh->mFaces[p];
+
+		dest.mNumIndices = src.mNumIndices;
+		dest.mIndices = new unsigned int[src.mNumIndices];
+		for (unsigned int v = 0; v < src.mNumIndices;++v)
+			dest.mIndices[v] = vRemap[src.mIndices[v]];
+
+		// need to update the output primitive types
+		switch (src.mNumIndices)
+		{
+		case 1:
+			pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
+			break;
+		case 2:
+			pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
+			break;
+		case 3:
+			pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+			break;
+		default:
+			pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
+		}
+	}
+
+	// gather the bone weights of all vertices we took over
+	if (avPerVertexWeights)
+	{
+		for (unsigned int i = 0; i < iCnt;++i)
+		{
+			const VertexWeightTable& table = avPerVertexWeights[vVertices[i]];
+			for (VertexWeightTable::const_iterator it = table.begin(); it != table.end(); ++it)
+				vBoneWeights[(*it).first].push_back(aiVertexWeight(i,(*it).second));
+		}
+
+		pcMesh->mBones = new aiBone*[pMesh->mNumBones];
+		for (unsigned int k = 0; k < pMesh->mNumBones;++k)
+		{
+			std::vector<aiVertexWeight>& weights = vBoneWeights[k];
+			if (weights.empty())
+				continue;
+
+			const aiBone* pcOldBone = pMesh->mBones[k];
+			aiBone* pcOut = pcMesh->mBones[pcMesh->mNumBones++] = new aiBone();
+			pcOut->mName = pcOldBone->mName;
+			pcOut->mOffsetMatrix = pcOldBone->mOffsetMatrix;
+			pcOut->mNumWeights = (unsigned int)weights.size();
+			pcOut->mWeights = new aiVertexWeight[pcOut->mNumWeights];
+			::memcpy(pcOut->mWeights,&weights[0],pcOut->mNumWeights * sizeof(aiVertexWeight));
+			weights.clear();
+		}
+		if (!pcMesh->mNumBones)
+		{
+			delete[] pcMesh->mBones;
+			pcMesh->mBones = NULL;
+		}
+	}
+	return pcMesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Split a mesh into spatially compact submeshes
+void SplitLargeMeshesProcess_Triangle::SplitMeshSpatially(
+	unsigned int a,
+	aiMesh* pMesh,
+	unsigned int iMaxFaces,
+	unsigned int iMaxVertices,
+	std::vector<std::pair<aiMesh*, unsigned int> >& avList)
+{
+	// walk the faces along a z-order curve over their centroids
+	std::vector<unsigned int> vOrder;
+	if (pMesh->HasPositions())
+	{
+		ComputeMortonFaceOrder(pMesh,vOrder);
+	}
+	else
+	{
+		vOrder.resize(pMesh->mNumFaces);
+		for (unsigned int i = 0; i < pMesh->mNumFaces;++i)
+			vOrder[i] = i;
+	}
+
+	// build a per-vertex weight list if necessary
+	VertexWeightTable* avPerVertexWeights = ComputeVertexBoneWeightTable(pMesh);
+	std::vector< std::vector<aiVertexWeight> > vBoneWeights(pMesh->mNumBones);
+
+	// flat vertex remapping table, shared by all submeshes. An entry is only
+	// valid if its stamp equals the index of the current submesh, so the
+	// table never needs to be cleared.
+	std::vector<unsigned int> vRemap(pMesh->mNumVertices);
+	std::vector<unsigned int> vStamp(pMesh->mNumVertices,UINT_MAX);
+
+	std::vector<unsigned int> vFaces, vVertices;
+	unsigned int iSubMesh = 0, f = 0;
+	while (f < pMesh->mNumFaces)
+	{
+		vFaces.clear();
+		vVertices.clear();
+
+		for (; f < pMesh->mNumFaces && vFaces.size() < iMaxFaces;++f)
+		{
+			const aiFace& face = pMesh->mFaces[vOrder[f]];
+
+			// doesn't catch duplicate indices within a face, but that only
+			// makes the estimate more conservative
+			unsigned int iNeed = 0;
+			for (unsigned int v = 0; v < face.mNumIndices;++v)
+			{
+				if (vStamp[face.mIndices[v]] != iSubMesh)
+					++iNeed;
+			}
+			// always take at least one face, otherwise we'd never terminate
+			if (!vFaces.empty() && vVertices.size() + iNeed > iMaxVertices)
+				break;
+
+			for (unsigned int v = 0; v < face.mNumIndices;++v)
+			{
+				const unsigned int iIndex = face.mIndices[v];
+				if (vStamp[iIndex] != iSubMesh)
+				{
+					vStamp[iIndex] = iSubMesh;
+					vRemap[iIndex] = (unsigned int)vVertices.size();
+					vVertices.push_back(iIndex);
+				}
+			}
+			vFaces.push_back(vOrder[f]);
+		}
+
+		aiMesh* pcMesh = BuildSpatialSubMesh(pMesh,vFaces,vVertices,vRemap,
+			avPerVertexWeights,vBoneWeights);
+
+		// add the newly created mesh to the list
+		avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
+		++iSubMesh;
+	}
+
+	// delete the per-vertex weight list again
+	delete[] avPerVertexWeights;
+
+	// now delete the old mesh data
+	delete pMesh;
+}
+
 // ------------------------------------------------------------------------------------------------
 SplitLargeMeshesProcess_Vertex::SplitLargeMeshesProcess_Vertex()
 {
 	LIMIT = AI_SLM_DEFAULT_MAX_VERTICES;
+	SPATIAL = false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -403,6 +622,7 @@ void SplitLargeMeshesProcess_Vertex::Execute( aiScene* pScene)
 void SplitLargeMeshesProcess_Vertex::SetupProperties( const Importer* pImp)
 {
 	this->LIMIT = pImp->GetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT,AI_SLM_DEFAULT_MAX_VERTICES);
+	this->SPATIAL = pImp->GetPropertyBool(AI_CONFIG_PP_SLM_SPATIAL_SPLIT,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -414,6 +634,12 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 {
 	if (pMesh->mNumVertices > SplitLargeMeshesProcess_Vertex::LIMIT)
 	{
+		if (SPATIAL)
+		{
+			SplitLargeMeshesProcess_Triangle::SplitMeshSpatially(a,pMesh,UINT_MAX,LIMIT,avList);
+			return;
+		}
+
 		typedef std::vector< std::pair<unsigned int,float> > VertexWeightTable;
 
 		// build a per-vertex weight list if necessary
@@ -426,9 +652,14 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 		//const unsigned int iOutVertexNum2 = pMesh->mNumVertices /iSubMeshes;
 
 		// create a std::vector<unsigned int> to indicate which vertices
-		// have already been copied
+		// have already been copied. The entry is only valid if the
+		// matching stamp equals the index of the current submesh, so the
+		// table never needs to be cleared between submeshes.
 		std::vector<unsigned int> avWasCopied;
 		avWasCopied.resize(pMesh->mNumVertices,0xFFFFFFFF);
+		std::vector<unsigned int> avCopyStamp;
+		avCopyStamp.resize(pMesh->mNumVertices,0xFFFFFFFF);
+		unsigned int iSubMesh = 0;
 
 		// try to find a good estimate for the number of output faces
 		// per mesh. Add 12.5% as buffer
@@ -455,18 +686,6 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 				::memset(pcMesh->mBones,0,sizeof(void*)*pMesh->mNumBones);
 			}
 
-			// clear the temporary helper array
-			if (iBase)
-			{
-				// we can't use memset here we unsigned int needn' be 32 bits
-				for (std::vector<unsigned int>::iterator
-					iter = avWasCopied.begin(),end = avWasCopied.end();
-					iter != end;++iter)
-				{
-					(*iter) = 0xffffffff;
-				}
-			}
-
 			// output vectors
 			std::vector<aiFace> vFaces;
 
@@ -508,7 +727,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 					unsigned int iIndex = pMesh->mFaces[iBase].mIndices[v];
 
 					// check whether we do already have this vertex
-					if (0xFFFFFFFF == avWasCopied[iIndex])
+					if (iSubMesh != avCopyStamp[iIndex])
 					{
 						iNeed++; 
 					}
@@ -548,7 +767,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 					unsigned int iIndex = pMesh->mFaces[iBase].mIndices[v];
 
 					// check whether we do already have this vertex
-					if (0xFFFFFFFF != avWasCopied[iIndex])
+					if (iSubMesh == avCopyStamp[iIndex])
 					{
 						rFace.mIndices[v] = avWasCopied[iIndex];
 						continue;
@@ -590,7 +809,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 					rFace.mIndices[v] = pcMesh->mNumVertices;
 					if (avPerVertexWeights)
 					{
-						VertexWeightTable& table = avPerVertexWeights[ pcMesh->mNumVertices ];
+						VertexWeightTable& table = avPerVertexWeights[ iIndex ];
 						if( !table.empty() )
 						{
 							for (VertexWeightTable::const_iterator
@@ -609,6 +828,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 					}
 
 					avWasCopied[iIndex] = pcMesh->mNumVertices;
+					avCopyStamp[iIndex] = iSubMesh;
 					pcMesh->mNumVertices++;
 				}
 				iBase++;
@@ -657,6 +877,7 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
 
 			// add the newly created mesh to the list
 			avList.push_back(std::pair<aiMesh*, unsigned int>(pcMesh,a));
+			++iSubMesh;
 
 			if (iBase == pMesh->mNumFaces)
 			{
@@ -100,6 +100,10 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "SplitLargeMeshesProcess_Triangle"; }
+
 
 	// -------------------------------------------------------------------
 	/** Called prior to ExecuteOnScene().
@@ -117,6 +121,14 @@ public:
 	inline unsigned int GetLimit() const
 		{return LIMIT;}
 
+	//! Enable or disable spatially coherent splitting
+	inline void SetSpatialSplit(bool b)
+		{SPATIAL = b;}
+
+	//! Get whether spatially coherent splitting is enabled
+	inline bool GetSpatialSplit() const
+		{return SPATIAL;}
+
 public:
 
 	// -------------------------------------------------------------------
@@ -137,9 +149,29 @@ public:
 	static void UpdateNode(aiNode* pcNode,
 		const std::vector<std::pair<aiMesh*, unsigned int> >& avList);
 
+	// -------------------------------------------------------------------
+	/** Split a mesh into sub meshes covering compact regions of space.
+	*
+	* Faces are visited in z-order of their centroids and appended to the
+	* current sub mesh until either limit would be exceeded. Vertices are
+	* unique within each sub mesh. The source mesh is deleted.
+	* Shared by both variants of the step.
+	* @param a Index of the mesh in the scene
+	* @param pcMesh Mesh to be split
+	* @param iMaxFaces Maximum number of faces per sub mesh
+	* @param iMaxVertices Maximum number of vertices per sub mesh
+	* @param avList Receives the sub meshes
+	*/
+	static void SplitMeshSpatially (unsigned int a, aiMesh* pcMesh,
+		unsigned int iMaxFaces, unsigned int iMaxVertices,
+		std::vector<std::pair<aiMesh*, unsigned int> >& avList);
+
 public:
 	//! Triangle limit 
 	unsigned int LIMIT;
+
+	//! Split along a z-order curve instead of consecutive face ranges
+	bool SPATIAL;
 };
 
 
@@ -165,6 +197,10 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "SplitLargeMeshesProcess_Vertex"; }
+
 	// -------------------------------------------------------------------
 	/** Called prior to ExecuteOnScene().
 	* The function is a request to the process to update its configuration
@@ -181,6 +217,14 @@ public:
 	inline unsigned int GetLimit() const
 		{return LIMIT;}
 
+	//! Enable or disable spatially coherent splitting
+	inline void SetSpatialSplit(bool b)
+		{SPATIAL = b;}
+
+	//! Get whether spatially coherent splitting is enabled
+	inline bool GetSpatialSplit() const
+		{return SPATIAL;}
+
 public:
 
 	// -------------------------------------------------------------------
@@ -196,10 +240,14 @@ public:
 		std::vector<std::pair<aiMesh*, unsigned int> >& avList);
 
 	// NOTE: Reuse SplitLargeMeshesProcess_Triangle::UpdateNode()
+	// and SplitLargeMeshesProcess_Triangle::SplitMeshSpatially()
 
 public:
-	//! Triangle limit 
+	//! Vertex limit 
 	unsigned int LIMIT;
+
+	//! Split along a z-order curve instead of consecutive face ranges
+	bool SPATIAL;
 };
 
 } // end of namespace Assimp
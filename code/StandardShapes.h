@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_STANDARD_SHAPES_H_INC
 #define AI_STANDARD_SHAPES_H_INC
 
+#include "../include/assimp/defs.h"
 #include "../include/assimp/vector3.h"
 #include <vector>
 
@@ -55,7 +56,7 @@ namespace Assimp	{
 /** \brief Helper class to generate vertex buffers for standard geometric
  *  shapes, such as cylinders, cones, boxes, spheres, elipsoids ... .
  */
-class StandardShapes
+class ASSIMP_API StandardShapes
 {
 	// class cannot be instanced
 	StandardShapes() {}
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_SUBDISIVION_H_INC
 
 #include <cstddef>
+#include "../include/assimp/defs.h"
 struct aiMesh;
 
 namespace Assimp	{
@@ -51,7 +52,7 @@ namespace Assimp	{
 /** Helper class to evaluate subdivision surfaces. Different algorithms
  *  are provided for choice. */
 // ------------------------------------------------------------------------------
-class Subdivider
+class ASSIMP_API Subdivider
 {
 public:
 
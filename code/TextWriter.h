@@ -0,0 +1,326 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file  TextWriter.h
+ *  @brief Buffered, locale-independent text output to an IOStream
+ */
+#ifndef AI_TEXTWRITER_H_INC
+#define AI_TEXTWRITER_H_INC
+
+#include "../include/assimp/IOStream.hpp"
+#include "../include/assimp/ai_assert.h"
+#include "Exceptional.h"
+#include "ParallelFor.h"
+#include "fast_ftoa.h"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace Assimp {
+
+// Size of the output buffer of a TextWriter which writes to an IOStream
+#define AI_TEXTWRITER_BUFFER_SIZE 65536
+
+// Number of items formatted per work item by WriteParallel()
+#define AI_TEXTWRITER_PARALLEL_CHUNK 8192
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Replacement for std::ostringstream in the text exporters.
+ *
+ *  The output is collected in a fixed size buffer and passed on to an
+ *  IOStream whenever the buffer is full, so the exporters don't need to
+ *  keep the whole file in memory. Numbers are always formatted using the
+ *  C locale, floats with the shortest representation which reads back
+ *  exactly (see fast_ftoa()).
+ *
+ *  A TextWriter constructed without a stream collects all output in
+ *  memory instead, see GetData(). */
+// ------------------------------------------------------------------------------------------------
+class TextWriter
+{
+public:
+
+	/** Construct a writer which collects all output in memory */
+	TextWriter()
+		: mStream()
+		, mBufferSize()
+	{}
+
+	/** Construct a writer for a stream. The stream is not owned by the writer. */
+	explicit TextWriter(IOStream* stream, size_t bufferSize = AI_TEXTWRITER_BUFFER_SIZE)
+		: mStream(stream)
+		, mBufferSize(bufferSize)
+	{
+		ai_assert(stream && bufferSize);
+		mBuffer.reserve(bufferSize);
+	}
+
+	~TextWriter()
+	{
+		// errors can't be reported from here, Flush() explicitly to get them
+		try {
+			Flush();
+		}
+		catch (...) {
+		}
+	}
+
+public:
+
+	// -------------------------------------------------------------------
+	/** Append raw bytes */
+	void Write(const void* data, size_t size)
+	{
+		const char* const p = static_cast<const char*>(data);
+		if (mStream && mBuffer.size() + size > mBufferSize) {
+			Flush();
+			if (size >= mBufferSize) {
+				WriteToStream(p,size);
+				return;
+			}
+		}
+		mBuffer.insert(mBuffer.end(),p,p+size);
+	}
+
+	// -------------------------------------------------------------------
+	/** Pass all buffered output on to the stream. Throws a
+	 *  DeadlyExportError if the stream does not accept all of it.
+	 *  No-op for writers without a stream. */
+	void Flush()
+	{
+		if (mStream && !mBuffer.empty()) {
+			const size_t size = mBuffer.size();
+			const size_t written = mStream->Write(&mBuffer[0],1,size);
+			mBuffer.clear();
+			if (written != size) {
+				throw DeadlyExportError("Failed to write output, the disk might be full");
+			}
+		}
+	}
+
+	// -------------------------------------------------------------------
+	/** Get the data collected so far. For writers with a stream this is
+	 *  only the part which has not been flushed yet. */
+	const char* GetData() const {
+		return mBuffer.empty() ? "" : &mBuffer[0];
+	}
+
+	size_t GetSize() const {
+		return mBuffer.size();
+	}
+
+	// -------------------------------------------------------------------
+	/** Drop all data which has not been flushed yet */
+	void Clear() {
+		mBuffer.clear();
+	}
+
+public:
+
+	TextWriter& operator << (const char* s) {
+		Write(s,::strlen(s));
+		return *this;
+	}
+
+	TextWriter& operator << (const std::string& s) {
+		Write(s.data(),s.length());
+		return *this;
+	}
+
+	TextWriter& operator << (char c) {
+		if (mStream && mBuffer.size() >= mBufferSize) {
+			Flush();
+		}
+		mBuffer.push_back(c);
+		return *this;
+	}
+
+	TextWriter& operator << (int i) {
+		return WriteSigned(i);
+	}
+
+	TextWriter& operator << (long i) {
+		return WriteSigned(i);
+	}
+
+	TextWriter& operator << (long long i) {
+		return WriteSigned(i);
+	}
+
+	TextWriter& operator << (unsigned int i) {
+		return WriteUnsigned(i);
+	}
+
+	TextWriter& operator << (unsigned long i) {
+		return WriteUnsigned(i);
+	}
+
+	TextWriter& operator << (unsigned long long i) {
+		return WriteUnsigned(i);
+	}
+
+	TextWriter& operator << (float f) {
+		char buff[AI_FAST_FTOA_BUFFER_SIZE];
+		Write(buff,fast_ftoa(buff,f));
+		return *this;
+	}
+
+	TextWriter& operator << (double d) {
+		char buff[AI_FAST_FTOA_BUFFER_SIZE];
+		Write(buff,fast_dtoa(buff,d));
+		return *this;
+	}
+
+private:
+
+	template <typename T>
+	TextWriter& WriteSigned(T i) {
+		if (i < 0) {
+			*this << '-';
+			// negate in the unsigned domain to get the minimum value right
+			return WriteUnsigned(0ull - static_cast<unsigned long long>(i));
+		}
+		return WriteUnsigned(static_cast<unsigned long long>(i));
+	}
+
+	template <typename T>
+	TextWriter& WriteUnsigned(T i) {
+		char buff[24];
+		char* p = buff + sizeof(buff);
+		do {
+			*--p = static_cast<char>('0' + i % 10);
+			i /= 10;
+		}
+		while (i);
+		Write(p,buff + sizeof(buff) - p);
+		return *this;
+	}
+
+	void WriteToStream(const char* data, size_t size) {
+		if (mStream->Write(data,1,size) != size) {
+			throw DeadlyExportError("Failed to write output, the disk might be full");
+		}
+	}
+
+private:
+
+	IOStream* mStream;
+	size_t mBufferSize;
+	std::vector<char> mBuffer;
+};
+
+namespace detail {
+
+// ------------------------------------------------------------------------------------------------
+/** Work item of WriteParallel(): formats one chunk of items into a
+ *  writer of its own. */
+template <typename Fn>
+struct TextWriterChunk
+{
+	TextWriterChunk(Fn& fn, std::vector<TextWriter>& chunks, size_t first, size_t end)
+		: fn(&fn), chunks(&chunks), first(first), end(end)
+	{}
+
+	void operator() (unsigned int i)
+	{
+		TextWriter& w = (*chunks)[i];
+		w.Clear();
+
+		const size_t begin = first + i * AI_TEXTWRITER_PARALLEL_CHUNK;
+		const size_t last = std::min(begin + AI_TEXTWRITER_PARALLEL_CHUNK,end);
+		for (size_t n = begin; n < last; ++n) {
+			(*fn)(w,n);
+		}
+	}
+
+	Fn* fn;
+	std::vector<TextWriter>* chunks;
+	size_t first, end;
+};
+
+} // ! detail
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Write a large number of independent items, formatting them in parallel.
+ *
+ *  The items are split into chunks of #AI_TEXTWRITER_PARALLEL_CHUNK which
+ *  are formatted on worker threads (see ParallelFor()) and appended to
+ *  the output in order, so the result is the same as calling fmt(out,i)
+ *  for every item in turn. Only a limited number of chunks is held in
+ *  memory at a time.
+ *
+ *  @param out Output writer
+ *  @param count Number of items
+ *  @param fmt Functor with an operator()(TextWriter&, size_t) which
+ *    writes a single item. It is shared by all workers, so it must
+ *    be safe to call concurrently. */
+template <typename Fn>
+inline void WriteParallel(TextWriter& out, size_t count, Fn& fmt)
+{
+	if (count <= AI_TEXTWRITER_PARALLEL_CHUNK) {
+		for (size_t i = 0; i < count; ++i) {
+			fmt(out,i);
+		}
+		return;
+	}
+
+	const size_t batch = 64 * AI_TEXTWRITER_PARALLEL_CHUNK;
+	std::vector<TextWriter> chunks;
+
+	for (size_t first = 0; first < count; first += batch) {
+		const size_t end = std::min(first + batch, count);
+		const unsigned int numChunks = static_cast<unsigned int>(
+			(end - first + AI_TEXTWRITER_PARALLEL_CHUNK - 1) / AI_TEXTWRITER_PARALLEL_CHUNK);
+
+		chunks.resize(numChunks);
+		detail::TextWriterChunk<Fn> job(fmt,chunks,first,end);
+		ParallelFor(numChunks,job);
+
+		for (unsigned int i = 0; i < numChunks; ++i) {
+			out.Write(chunks[i].GetData(),chunks[i].GetSize());
+		}
+	}
+}
+
+} // ! Assimp
+
+#endif // AI_TEXTWRITER_H_INC
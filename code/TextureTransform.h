@@ -204,6 +204,10 @@ public:
 	// -------------------------------------------------------------------
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "TextureTransformStep"; }
+
 	// -------------------------------------------------------------------
 	void Execute( aiScene* pScene);
 
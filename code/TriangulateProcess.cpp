@@ -65,6 +65,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "PolyTools.h"
 #include <boost/scoped_array.hpp>
+#include <algorithm>
 
 //#define AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
 //#define AI_BUILD_TRIANGULATE_DEBUG_POLYS
@@ -100,15 +101,42 @@ bool TriangulateProcess::IsActive( unsigned int pFlags) const
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void TriangulateProcess::Execute( aiScene* pScene)
+{
+	ExecuteMeshByMesh(pScene);
+}
+
+// ------------------------------------------------------------------------------------------------
+void TriangulateProcess::GetDataAccess( unsigned int& read, unsigned int& write) const
+{
+	read = PPData_Positions | PPData_Faces;
+	write = PPData_Faces;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool TriangulateProcess::IsPerMesh() const
+{
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void TriangulateProcess::BeginMeshes( aiScene* pScene)
 {
 	DefaultLogger::get()->debug("TriangulateProcess begin");
+	meshResults.assign(pScene->mNumMeshes,0);
+}
+
+// ------------------------------------------------------------------------------------------------
+void TriangulateProcess::ExecuteForMesh( aiScene* pScene, unsigned int meshIndex)
+{
+	meshResults[meshIndex] = TriangulateMesh( pScene->mMeshes[meshIndex]);
+}
+
+// ------------------------------------------------------------------------------------------------
+void TriangulateProcess::EndMeshes( aiScene* /*pScene*/)
+{
+	const bool bHas = std::find(meshResults.begin(),meshResults.end(),1) != meshResults.end();
+	meshResults.clear();
 
-	bool bHas = false;
-	for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
-	{
-		if(	TriangulateMesh( pScene->mMeshes[a]))
-			bHas = true;
-	}
 	if (bHas)DefaultLogger::get()->info ("TriangulateProcess finished. All polygons have been triangulated.");
 	else     DefaultLogger::get()->debug("TriangulateProcess finished. There was nothing to be done.");
 }
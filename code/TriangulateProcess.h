@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_TRIANGULATEPROCESS_H_INC
 
 #include "BaseProcess.h"
+#include <vector>
 
 struct aiMesh;
 
@@ -73,6 +74,18 @@ public:
 	*/
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "TriangulateProcess"; }
+
+	// -------------------------------------------------------------------
+	/** Per-mesh execution, see BaseProcess::IsPerMesh() */
+	void GetDataAccess( unsigned int& read, unsigned int& write) const;
+	bool IsPerMesh() const;
+	void BeginMeshes( aiScene* pScene);
+	void ExecuteForMesh( aiScene* pScene, unsigned int meshIndex);
+	void EndMeshes( aiScene* pScene);
+
 	// -------------------------------------------------------------------
 	/** Executes the post processing step on the given imported data.
 	* At the moment a process is not supposed to fail.
@@ -86,6 +99,11 @@ public:
 	 * @param pMesh The mesh to triangulate.
 	 */
 	bool TriangulateMesh( aiMesh* pMesh);
+
+private:
+
+	/** Results of the meshes processed by ExecuteForMesh() */
+	std::vector<unsigned char> meshResults;
 };
 
 } // end of namespace Assimp
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BaseImporter.h"
 #include "fast_atof.h"
 #include "ProcessHelper.h"
+#include "ParallelFor.h"
 #include <boost/scoped_array.hpp>
 
 // CRT headers
@@ -61,6 +62,8 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ValidateDSProcess::ValidateDSProcess()
+: mScene()
+, configLevel(AI_VDS_LEVEL_FULL)
 {}
 
 // ------------------------------------------------------------------------------------------------
@@ -74,6 +77,50 @@ bool ValidateDSProcess::IsActive( unsigned int pFlags) const
 {
 	return (pFlags & aiProcess_ValidateDataStructure) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the step
+void ValidateDSProcess::SetupProperties(const Importer* pImp)
+{
+	configLevel = pImp->GetPropertyInteger(AI_CONFIG_PP_VDS_LEVEL,AI_VDS_LEVEL_FULL);
+}
+
+// ------------------------------------------------------------------------------------------------
+// ParallelFor() work item, validates one entry of an aiScene::mXXX array
+template <typename T>
+struct ValidateDSProcess::ArrayWorker
+{
+	ArrayWorker(ValidateDSProcess* proc, T** parray)
+		: proc(proc), parray(parray)
+	{}
+
+	void operator() (unsigned int i)
+	{
+		proc->Validate(parray[i]);
+	}
+
+	ValidateDSProcess* proc;
+	T** parray;
+};
+
+// ------------------------------------------------------------------------------------------------
+// ParallelFor() work item, validates a single node animation channel
+struct ValidateDSProcess::ChannelWorker
+{
+	typedef std::vector< std::pair<const aiAnimation*, const aiNodeAnim*> > ChannelList;
+
+	ChannelWorker(ValidateDSProcess* proc, const ChannelList& channels)
+		: proc(proc), channels(&channels)
+	{}
+
+	void operator() (unsigned int i)
+	{
+		proc->Validate((*channels)[i].first,(*channels)[i].second);
+	}
+
+	ValidateDSProcess* proc;
+	const ChannelList* channels;
+};
 // ------------------------------------------------------------------------------------------------
 AI_WONT_RETURN void ValidateDSProcess::ReportError(const char* msg,...)
 {
@@ -139,8 +186,11 @@ inline void ValidateDSProcess::DoValidation(T** parray, unsigned int size,
 				ReportError("aiScene::%s[%i] is NULL (aiScene::%s is %i)",
 					firstName,i,secondName,size);
 			}
-			Validate(parray[i]);
 		}
+
+		// the entries are independent of each other
+		ArrayWorker<T> worker(this,parray);
+		ParallelFor(size,worker);
 	}
 }
 
@@ -222,10 +272,21 @@ void ValidateDSProcess::Execute( aiScene* pScene)
 		ReportError("aiScene::mMeshes is non-null although there are no meshes");
 	}
 	
-	// validate all animations
+	// validate all animations. Most files have a single animation with
+	// lots of channels, so the channels are distributed instead.
 	if (pScene->mNumAnimations) {
 		DoValidation(pScene->mAnimations,pScene->mNumAnimations,
 			"mAnimations","mNumAnimations");
+
+		ChannelWorker::ChannelList channels;
+		for (unsigned int i = 0; i < pScene->mNumAnimations;++i) {
+			const aiAnimation* anim = pScene->mAnimations[i];
+			for (unsigned int a = 0; a < anim->mNumChannels;++a) {
+				channels.push_back(std::make_pair(anim,anim->mChannels[a]));
+			}
+		}
+		ChannelWorker worker(this,channels);
+		ParallelFor(static_cast<unsigned int>(channels.size()),worker);
 	}
 	else if (pScene->mAnimations)	{
 		ReportError("aiScene::mAnimations is non-null although there are no animations");
@@ -279,6 +340,10 @@ void ValidateDSProcess::Execute( aiScene* pScene)
 // ------------------------------------------------------------------------------------------------
 void ValidateDSProcess::Validate( const aiLight* pLight)
 {
+	if (configLevel < AI_VDS_LEVEL_FULL) {
+		return;
+	}
+
 	if (pLight->mType == aiLightSource_UNDEFINED)
 		ReportWarning("aiLight::mType is aiLightSource_UNDEFINED");
 
@@ -301,6 +366,10 @@ void ValidateDSProcess::Validate( const aiLight* pLight)
 // ------------------------------------------------------------------------------------------------
 void ValidateDSProcess::Validate( const aiCamera* pCamera)
 {
+	if (configLevel < AI_VDS_LEVEL_FULL) {
+		return;
+	}
+
 	if (pCamera->mClipPlaneFar <= pCamera->mClipPlaneNear)
 		ReportError("aiCamera::mClipPlaneFar must be >= aiCamera::mClipPlaneNear");
 
@@ -390,40 +459,56 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 	}
 
 	// now check whether the face indexing layout is correct:
-	// unique vertices, pseudo-indexed.
-	std::vector<bool> abRefList;
-	abRefList.resize(pMesh->mNumVertices,false);
+	// unique vertices, pseudo-indexed. The MSB flag is temporarily used 
+	// by the extra verbose mode to tell us that the JoinVerticesProcess 
+	// might have been executed already. 
+	const bool bVerbose = !(mScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT);
+	const bool bRefs = bVerbose || configLevel >= AI_VDS_LEVEL_FULL;
+
+	std::vector<unsigned char> abRefList;
+	if (bRefs) {
+		abRefList.resize(pMesh->mNumVertices,0);
+	}
 	for (unsigned int i = 0; i < pMesh->mNumFaces;++i)
 	{
-		aiFace& face = pMesh->mFaces[i];
+		const aiFace& face = pMesh->mFaces[i];
 		if (face.mNumIndices > AI_MAX_FACE_INDICES) {
 			ReportError("Face %u has too many faces: %u, but the limit is %u",i,face.mNumIndices,AI_MAX_FACE_INDICES);
 		}
 
+		// range check without branches, look for the culprit only if it fails
+		const unsigned int* const indices = face.mIndices;
+		unsigned int iMax = 0;
+		for (unsigned int a = 0; a < face.mNumIndices;++a) {
+			iMax = std::max(iMax,indices[a]);
+		}
+		if (face.mNumIndices && iMax >= pMesh->mNumVertices) {
+			for (unsigned int a = 0; a < face.mNumIndices;++a)	{
+				if (indices[a] >= pMesh->mNumVertices)	{
+					ReportError("aiMesh::mFaces[%i]::mIndices[%i] is out of range",i,a);
+				}
+			}
+		}
+
+		if (!bRefs) {
+			continue;
+		}
 		for (unsigned int a = 0; a < face.mNumIndices;++a)
 		{
-			if (face.mIndices[a] >= pMesh->mNumVertices)	{
-				ReportError("aiMesh::mFaces[%i]::mIndices[%i] is out of range",i,a);
-			}
-			// the MSB flag is temporarily used by the extra verbose
-			// mode to tell us that the JoinVerticesProcess might have 
-			// been executed already.
-			if ( !(this->mScene->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT ) && abRefList[face.mIndices[a]])
+			unsigned char& ref = abRefList[indices[a]];
+			if (bVerbose && ref)
 			{
 				ReportError("aiMesh::mVertices[%i] is referenced twice - second "
-					"time by aiMesh::mFaces[%i]::mIndices[%i]",face.mIndices[a],i,a);
+					"time by aiMesh::mFaces[%i]::mIndices[%i]",indices[a],i,a);
 			}
-			abRefList[face.mIndices[a]] = true;
+			ref = 1;
 		}
 	}
 
 	// check whether there are vertices that aren't referenced by a face
-	bool b = false;
-	for (unsigned int i = 0; i < pMesh->mNumVertices;++i)	{
-		if (!abRefList[i])b = true;
+	if (configLevel >= AI_VDS_LEVEL_FULL && std::find(abRefList.begin(),abRefList.end(),0) != abRefList.end())	{
+		ReportWarning("There are unreferenced vertices");
 	}
-	abRefList.clear();
-	if (b)ReportWarning("There are unreferenced vertices");
 
 	// texture channel 2 may not be set if channel 1 is zero ...
 	{
@@ -464,7 +549,7 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 				pMesh->mNumBones);
 		}
 		boost::scoped_array<float> afSum(NULL);
-		if (pMesh->mNumVertices)
+		if (pMesh->mNumVertices && configLevel >= AI_VDS_LEVEL_FULL)
 		{
 			afSum.reset(new float[pMesh->mNumVertices]);
 			for (unsigned int i = 0; i < pMesh->mNumVertices;++i)
@@ -496,7 +581,7 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 			}
 		}
 		// check whether all bone weights for a vertex sum to 1.0 ...
-		for (unsigned int i = 0; i < pMesh->mNumVertices;++i)
+		for (unsigned int i = 0; afSum.get() && i < pMesh->mNumVertices;++i)
 		{
 			if (afSum[i] && (afSum[i] <= 0.94 || afSum[i] >= 1.05))	{
 				ReportWarning("aiMesh::mVertices[%i]: bone weight sum != 1.0 (sum is %f)",i,afSum[i]);
@@ -507,6 +592,82 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh)
 	{
 		ReportError("aiMesh::mBones is non-null although there are no bones");
 	}
+
+	// validate the meshlets, they must cover all faces in order
+	if (pMesh->mNumMeshlets)
+	{
+		if (!pMesh->mMeshlets)
+		{
+			ReportError("aiMesh::mMeshlets is NULL (aiMesh::mNumMeshlets is %i)",
+				pMesh->mNumMeshlets);
+		}
+		unsigned int iExpectedOffset = 0;
+		for (unsigned int i = 0; i < pMesh->mNumMeshlets;++i)
+		{
+			const aiMeshlet& meshlet = pMesh->mMeshlets[i];
+			if (meshlet.mFaceOffset != iExpectedOffset)
+			{
+				ReportError("aiMesh::mMeshlets[%i]::mFaceOffset is %i, expected %i",
+					i,meshlet.mFaceOffset,iExpectedOffset);
+			}
+			iExpectedOffset += meshlet.mNumFaces;
+			if (iExpectedOffset > pMesh->mNumFaces)
+			{
+				ReportError("aiMesh::mMeshlets[%i] exceeds the face array",i);
+			}
+			if (!meshlet.mNumVertices || !meshlet.mVertices)
+			{
+				ReportError("aiMesh::mMeshlets[%i] references no vertices",i);
+			}
+			for (unsigned int a = 0; a < meshlet.mNumVertices;++a)
+			{
+				if (meshlet.mVertices[a] >= pMesh->mNumVertices)
+				{
+					ReportError("aiMesh::mMeshlets[%i]::mVertices[%i] is out of range",i,a);
+				}
+			}
+		}
+		if (iExpectedOffset != pMesh->mNumFaces)
+		{
+			ReportError("aiMesh::mMeshlets don't cover all faces of the mesh");
+		}
+	}
+	else if (pMesh->mMeshlets)
+	{
+		ReportError("aiMesh::mMeshlets is non-null although there are no meshlets");
+	}
+
+	// validate the skin stream
+	if (pMesh->mSkinStream)
+	{
+		const aiSkinStream* stream = pMesh->mSkinStream;
+		if (stream->mNumVertices != pMesh->mNumVertices)
+		{
+			ReportError("aiMesh::mSkinStream::mNumVertices is %i, expected %i",
+				stream->mNumVertices,pMesh->mNumVertices);
+		}
+		if (stream->mNumInfluences != 4 && stream->mNumInfluences != 8)
+		{
+			ReportError("aiMesh::mSkinStream::mNumInfluences is %i, must be 4 or 8",
+				stream->mNumInfluences);
+		}
+		if (stream->mWeightBits != 8 && stream->mWeightBits != 16 && stream->mWeightBits != 32)
+		{
+			ReportError("aiMesh::mSkinStream::mWeightBits is %i, must be 8, 16 or 32",
+				stream->mWeightBits);
+		}
+		if (!stream->mBoneIndices || !stream->mWeights)
+		{
+			ReportError("aiMesh::mSkinStream has no bone indices or weights");
+		}
+		for (unsigned int i = 0; i < stream->mNumVertices * stream->mNumInfluences;++i)
+		{
+			if (stream->mBoneIndices[i] >= pMesh->mNumBones)
+			{
+				ReportError("aiMesh::mSkinStream::mBoneIndices[%i] is out of range",i);
+			}
+		}
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -525,7 +686,10 @@ void ValidateDSProcess::Validate( const aiMesh* pMesh,
 		if (pBone->mWeights[i].mVertexId >= pMesh->mNumVertices)	{
 			ReportError("aiBone::mWeights[%i].mVertexId is out of range",i);
 		}
-		else if (!pBone->mWeights[i].mWeight || pBone->mWeights[i].mWeight > 1.0f)	{
+		if (!afSum) {
+			continue;
+		}
+		if (!pBone->mWeights[i].mWeight || pBone->mWeights[i].mWeight > 1.0f)	{
 			ReportWarning("aiBone::mWeights[%i].mWeight has an invalid value",i);
 		}
 		afSum[pBone->mWeights[i].mVertexId] += pBone->mWeights[i].mWeight;
@@ -537,7 +701,7 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation)
 {
 	Validate(&pAnimation->mName);
 
-	// validate all materials
+	// validate all materials, the channels themselves are validated by Execute()
 	if (pAnimation->mNumChannels)	
 	{
 		if (!pAnimation->mChannels)	{
@@ -551,7 +715,6 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation)
 				ReportError("aiAnimation::mChannels[%i] is NULL (aiAnimation::mNumChannels is %i)",
 					i, pAnimation->mNumChannels);
 			}
-			Validate(pAnimation, pAnimation->mChannels[i]);
 		}
 	}
 	else ReportError("aiAnimation::mNumChannels is 0. At least one node animation channel must be there.");
@@ -722,28 +885,30 @@ void ValidateDSProcess::Validate( const aiMaterial* pMaterial)
 	// make some more specific tests 
 	float fTemp;
 	int iShading;
-	if (AI_SUCCESS == aiGetMaterialInteger( pMaterial,AI_MATKEY_SHADING_MODEL,&iShading))	{
-		switch ((aiShadingMode)iShading)
-		{
-		case aiShadingMode_Blinn:
-		case aiShadingMode_CookTorrance:
-		case aiShadingMode_Phong:
+	if (configLevel >= AI_VDS_LEVEL_FULL)	{
+		if (AI_SUCCESS == aiGetMaterialInteger( pMaterial,AI_MATKEY_SHADING_MODEL,&iShading))	{
+			switch ((aiShadingMode)iShading)
+			{
+			case aiShadingMode_Blinn:
+			case aiShadingMode_CookTorrance:
+			case aiShadingMode_Phong:
 
-			if (AI_SUCCESS != aiGetMaterialFloat(pMaterial,AI_MATKEY_SHININESS,&fTemp))	{
-				ReportWarning("A specular shading model is specified but there is no "
-					"AI_MATKEY_SHININESS key");
-			}
-			if (AI_SUCCESS == aiGetMaterialFloat(pMaterial,AI_MATKEY_SHININESS_STRENGTH,&fTemp) && !fTemp)	{
-				ReportWarning("A specular shading model is specified but the value of the "
-					"AI_MATKEY_SHININESS_STRENGTH key is 0.0");
-			}
-			break;
-		default: ;
-		};
-	}
+				if (AI_SUCCESS != aiGetMaterialFloat(pMaterial,AI_MATKEY_SHININESS,&fTemp))	{
+					ReportWarning("A specular shading model is specified but there is no "
+						"AI_MATKEY_SHININESS key");
+				}
+				if (AI_SUCCESS == aiGetMaterialFloat(pMaterial,AI_MATKEY_SHININESS_STRENGTH,&fTemp) && !fTemp)	{
+					ReportWarning("A specular shading model is specified but the value of the "
+						"AI_MATKEY_SHININESS_STRENGTH key is 0.0");
+				}
+				break;
+			default: ;
+			};
+		}
 
-	if (AI_SUCCESS == aiGetMaterialFloat( pMaterial,AI_MATKEY_OPACITY,&fTemp) && (!fTemp || fTemp > 1.01f))	{
-		ReportWarning("Invalid opacity value (must be 0 < opacity < 1.0)");
+		if (AI_SUCCESS == aiGetMaterialFloat( pMaterial,AI_MATKEY_OPACITY,&fTemp) && (!fTemp || fTemp > 1.01f))	{
+			ReportWarning("Invalid opacity value (must be 0 < opacity < 1.0)");
+		}
 	}
 
 	// Check whether there are invalid texture keys
@@ -806,6 +971,9 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
 	if (!pNodeAnim->mNumPositionKeys && !pNodeAnim->mScalingKeys && !pNodeAnim->mNumRotationKeys)
 		ReportError("Empty node animation channel");
 
+	// the key times are only checked for plausibility
+	const bool bKeyTimes = configLevel >= AI_VDS_LEVEL_FULL;
+
 	// otherwise check whether one of the keys exceeds the total duration of the animation
 	if (pNodeAnim->mNumPositionKeys)
 	{
@@ -815,7 +983,7 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
 				pNodeAnim->mNumPositionKeys);
 		}
 		double dLast = -10e10;
-		for (unsigned int i = 0; i < pNodeAnim->mNumPositionKeys;++i)
+		for (unsigned int i = 0; bKeyTimes && i < pNodeAnim->mNumPositionKeys;++i)
 		{
 			// ScenePreprocessor will compute the duration if still the default value
 			// (Aramis) Add small epsilon, comparison tended to fail if max_time == duration,
@@ -846,7 +1014,7 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
 				pNodeAnim->mNumRotationKeys);
 		}
 		double dLast = -10e10;
-		for (unsigned int i = 0; i < pNodeAnim->mNumRotationKeys;++i)
+		for (unsigned int i = 0; bKeyTimes && i < pNodeAnim->mNumRotationKeys;++i)
 		{
 			if (pAnimation->mDuration > 0. && pNodeAnim->mRotationKeys[i].mTime > pAnimation->mDuration+0.001)
 			{
@@ -873,7 +1041,7 @@ void ValidateDSProcess::Validate( const aiAnimation* pAnimation,
 				pNodeAnim->mNumScalingKeys);
 		}
 		double dLast = -10e10;
-		for (unsigned int i = 0; i < pNodeAnim->mNumScalingKeys;++i)
+		for (unsigned int i = 0; bKeyTimes && i < pNodeAnim->mNumScalingKeys;++i)
 		{
 			if (pAnimation->mDuration > 0. && pNodeAnim->mScalingKeys[i].mTime > pAnimation->mDuration+0.001)
 			{
@@ -65,7 +65,7 @@ namespace Assimp	{
 /** Validates the whole ASSIMP scene data structure for correctness.
  *  ImportErrorException is thrown of the scene is corrupt.*/
 // --------------------------------------------------------------------------------------
-class ValidateDSProcess : public BaseProcess
+class ASSIMP_API ValidateDSProcess : public BaseProcess
 {
 public:
 
@@ -76,9 +76,23 @@ public:
 	// -------------------------------------------------------------------
 	bool IsActive( unsigned int pFlags) const;
 
+	// -------------------------------------------------------------------
+	/** Profiler region name, see BaseProcess::GetName() */
+	const char* GetName() const { return "ValidateDSProcess"; }
+
+	// -------------------------------------------------------------------
+	void SetupProperties(const Importer* pImp);
+
 	// -------------------------------------------------------------------
 	void Execute( aiScene* pScene);
 
+	// -------------------------------------------------------------------
+	/** Set the extent of the checks, one of the AI_VDS_LEVEL_XXX values */
+	inline void SetLevel(int level)
+	{
+		configLevel = level;
+	}
+
 protected:
 
 	// -------------------------------------------------------------------
@@ -103,11 +117,13 @@ protected:
 	// -------------------------------------------------------------------
 	/** Validates a bone
 	 * @param pMesh Input mesh
-	 * @param pBone Input bone*/
+	 * @param pBone Input bone
+	 * @param afSum Receives the weight sums per vertex, NULL if the 
+	 *   weights are not to be checked*/
 	void Validate( const aiMesh* pMesh,const aiBone* pBone,float* afSum);
 
 	// -------------------------------------------------------------------
-	/** Validates an animation
+	/** Validates an animation, except for its channels
 	 * @param pAnimation Input animation*/
 	void Validate( const aiAnimation* pAnimation);
 
@@ -175,7 +191,14 @@ private:
 	inline void DoValidationWithNameCheck(T** array, unsigned int size, 
 		const char* firstName, const char* secondName);
 
+	// ParallelFor() work items
+	template <typename T> struct ArrayWorker;
+	struct ChannelWorker;
+
 	aiScene* mScene;
+
+	/** Configuration option: extent of the checks, AI_VDS_LEVEL_XXX */
+	int configLevel;
 };
 
 
@@ -92,13 +92,19 @@ bool XFileImporter::CanRead( const std::string& pFile, IOSystem* pIOHandler, boo
 		return true;
 	}
 	if (!extension.length() || checkSig) {
-		uint32_t token[1];
-		token[0] = AI_MAKE_MAGIC("xof ");
-		return CheckMagicToken(pIOHandler,pFile,token,1,0);
+		return CheckMagicTokens(pIOHandler,pFile);
 	}
 	return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Magic tokens checked by CanRead()
+void XFileImporter::GetMagicTokens(std::vector<MagicToken>& tokens) const
+{
+	const uint32_t magic = AI_MAKE_MAGIC("xof ");
+	AddMagicTokens(tokens,&magic,1,0);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get file extension list
 const aiImporterDesc* XFileImporter::GetInfo () const
@@ -205,10 +211,8 @@ aiNode* XFileImporter::CreateNodes( aiScene* pScene, aiNode* pParent, const XFil
 
 	// create node
 	aiNode* node = new aiNode;
-	node->mName.length = pNode->mName.length();
+	node->mName = aiString(pNode->mName);
 	node->mParent = pParent;
-	memcpy( node->mName.data, pNode->mName.c_str(), pNode->mName.length());
-	node->mName.data[node->mName.length] = 0;
 	node->mTransformation = pNode->mTrafoMatrix;
 
 	// convert meshes from the source node 
@@ -79,6 +79,41 @@ static void  dummy_free  (void* /*opaque*/, void* address)	{
 	return ::operator delete(address);
 }
 
+// ------------------------------------------------------------------------------------------------
+// MSZIP decompressor state. The parser reads from a sliding window which holds the unread 
+// rest of the previous blocks plus the blocks inflated on demand, so the memory needed 
+// doesn't depend on the uncompressed size of the file.
+struct XFileParser::InflateState
+{
+	InflateState(bool binary)
+	{
+		stream.opaque = NULL;
+		stream.zalloc = &dummy_alloc;
+		stream.zfree  = &dummy_free;
+		stream.data_type = (binary ? Z_BINARY : Z_ASCII);
+
+		// initialize the inflation algorithm
+		::inflateInit2(&stream, -MAX_WBITS);
+	}
+
+	~InflateState()
+	{
+		// terminate zlib
+		::inflateEnd(&stream);
+	}
+
+	z_stream stream;
+
+	// next MSZIP block header in the compressed data, and its end
+	const char* in;
+	const char* inEnd;
+
+	// decompressed data, with a terminating zero
+	std::vector<char> window;
+};
+
+#else
+struct XFileParser::InflateState {};
 #endif // !! ASSIMP_BUILD_NO_COMPRESSED_X
 
 // ------------------------------------------------------------------------------------------------
@@ -92,9 +127,6 @@ XFileParser::XFileParser( const std::vector<char>& pBuffer)
 	mLineNumber = 0;
 	mScene = NULL;
 
-	// vector to store uncompressed file for INFLATE'd X files
-	std::vector<char> uncompressed;
-
 	// set up memory pointers
 	P = &pBuffer.front();
 	End = P + pBuffer.size() - 1;
@@ -173,23 +205,12 @@ XFileParser::XFileParser( const std::vector<char>& pBuffer)
 		 * ///////////////////////////////////////////////////////////////////////
 		 */
 
-		// build a zlib stream
-		z_stream stream;
-		stream.opaque = NULL;
-		stream.zalloc = &dummy_alloc;
-		stream.zfree  = &dummy_free;
-		stream.data_type = (mIsBinaryFormat ? Z_BINARY : Z_ASCII);
-
-		// initialize the inflation algorithm
-		::inflateInit2(&stream, -MAX_WBITS);
-
 		// skip unknown data (checksum, flags?)
 		P += 6;
 
-		// First find out how much storage we'll need. Count sections.
-		const char* P1       = P;
-		unsigned int est_out = 0;
-
+		// Validate all block headers upfront, the blocks themselves are decompressed
+		// while the parser advances, see InflateBlocks()
+		const char* P1 = P;
 		while (P1 + 3 < End)
 		{
 			// read next offset
@@ -208,51 +229,17 @@ XFileParser::XFileParser( const std::vector<char>& pBuffer)
 
 			// and advance to the next offset
 			P1 += ofs;
-			est_out += MSZIP_BLOCK; // one decompressed block is 32786 in size
 		}
-		
-		// Allocate storage and terminating zero and do the actual uncompressing
-		uncompressed.resize(est_out + 1);
-		char* out = &uncompressed.front();
-		while (P + 3 < End)
-		{
-			uint16_t ofs = *((uint16_t*)P);
-			AI_SWAP2(ofs); 
-			P += 4;
-
-			if (P + ofs > End + 2) {
-				throw DeadlyImportError("X: Unexpected EOF in compressed chunk");
-			}
-
-			// push data to the stream
-			stream.next_in   = (Bytef*)P;
-			stream.avail_in  = ofs;
-			stream.next_out  = (Bytef*)out;
-			stream.avail_out = MSZIP_BLOCK;
-
-			// and decompress the data ....
-			int ret = ::inflate( &stream, Z_SYNC_FLUSH );
-			if (ret != Z_OK && ret != Z_STREAM_END)
-				throw DeadlyImportError("X: Failed to decompress MSZIP-compressed data");
 
-			::inflateReset( &stream );
-			::inflateSetDictionary( &stream, (const Bytef*)out , MSZIP_BLOCK - stream.avail_out );
+		mInflate.reset(new InflateState(mIsBinaryFormat));
+		mInflate->in = P;
+		mInflate->inEnd = End;
 
-			// and advance to the next offset
-			out +=  MSZIP_BLOCK - stream.avail_out;
-			P   += ofs;
-		}
+		// start with an empty window
+		mInflate->window.resize(1,'\0');
+		P = End = &mInflate->window[0];
 
-		// terminate zlib
-		::inflateEnd(&stream);
-		
-		// ok, update pointers to point to the uncompressed file data
-		P = &uncompressed[0];
-		End = out;
-
-		// FIXME: we don't need the compressed data anymore, could release
-		// it already for better memory usage. Consider breaking const-co.
-		DefaultLogger::get()->info("Successfully decompressed MSZIP-compressed file");
+		DefaultLogger::get()->info("Decompressing MSZIP-compressed file while parsing");
 #endif // !! ASSIMP_BUILD_NO_COMPRESSED_X
 	}
 	else
@@ -278,6 +265,77 @@ XFileParser::~XFileParser()
 	delete mScene;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool XFileParser::InflateBlocks( size_t num)
+{
+#ifdef ASSIMP_BUILD_NO_COMPRESSED_X
+	(void)num;
+	return false;
+#else
+	InflateState& z = *mInflate;
+	std::vector<char>& window = z.window;
+
+	// Move the unread data to the front of the window and append blocks until the request 
+	// is met. Inflate at least one block at a time to avoid refilling for every token.
+	size_t have = End - P;
+	::memmove(&window[0], P, have);
+
+	const size_t want = std::max( num, size_t(MSZIP_BLOCK));
+	while (have < want && z.in + 3 < z.inEnd)
+	{
+		uint16_t ofs = *((uint16_t*)z.in);
+		AI_SWAP2(ofs); 
+		z.in += 4;
+
+		if (z.in + ofs > z.inEnd + 2) {
+			throw DeadlyImportError("X: Unexpected EOF in compressed chunk");
+		}
+
+		window.resize( std::max( window.size(), have + MSZIP_BLOCK + 1));
+		char* out = &window[have];
+
+		// push data to the stream
+		z.stream.next_in   = (Bytef*)z.in;
+		z.stream.avail_in  = ofs;
+		z.stream.next_out  = (Bytef*)out;
+		z.stream.avail_out = MSZIP_BLOCK;
+
+		// and decompress the data ....
+		int ret = ::inflate( &z.stream, Z_SYNC_FLUSH );
+		if (ret != Z_OK && ret != Z_STREAM_END)
+			throw DeadlyImportError("X: Failed to decompress MSZIP-compressed data");
+
+		// each block uses the previous one as dictionary
+		::inflateReset( &z.stream );
+		::inflateSetDictionary( &z.stream, (const Bytef*)out , MSZIP_BLOCK - z.stream.avail_out );
+
+		// and advance to the next offset
+		have += MSZIP_BLOCK - z.stream.avail_out;
+		z.in += ofs;
+	}
+
+	// reading is safe because of the terminating zero
+	window[have] = '\0';
+	P = &window[0];
+	End = P + have;
+
+	return have >= num;
+#endif
+}
+
+// ------------------------------------------------------------------------------------------------
+void XFileParser::SkipBytes( size_t num)
+{
+	while (static_cast<size_t>(End - P) < num)
+	{
+		num -= End - P;
+		P = End;
+		if (!Require( 1))
+			return;
+	}
+	P += num;
+}
+
 // ------------------------------------------------------------------------------------------------
 void XFileParser::ParseFile()
 {
@@ -678,7 +736,7 @@ void XFileParser::ParseDataObjectMeshMaterialList( Mesh* pMesh)
 	// commented out version check, as version 03.03 exported from blender also has 2 semicolons
 	if( !mIsBinaryFormat) // && MajorVersion == 3 && MinorVersion <= 2)
 	{
-		if(P < End && *P == ';')
+		if(Require(1) && *P == ';')
 			++P;
 	}
 
@@ -1062,7 +1120,7 @@ std::string XFileParser::GetNextToken()
 		// in binary mode it will only return NAME and STRING token
 		// and (correctly) skip over other tokens.
 
-		if( End - P < 2) return s;
+		if( !Require(2)) return s;
 		unsigned int tok = ReadBinWord();
 		unsigned int len;
 
@@ -1071,37 +1129,37 @@ std::string XFileParser::GetNextToken()
 		{
 			case 1:
 				// name token
-				if( End - P < 4) return s;
+				if( !Require(4)) return s;
 				len = ReadBinDWord();
-				if( End - P < int(len)) return s;
+				if( !Require(len)) return s;
 				s = std::string(P, len);
 				P += len;
 				return s;
 			case 2:
 				// string token
-				if( End - P < 4) return s;
+				if( !Require(4)) return s;
 				len = ReadBinDWord();
-				if( End - P < int(len)) return s;
+				if( !Require(len)) return s;
 				s = std::string(P, len);
-				P += (len + 2);
+				SkipBytes(len + 2);
 				return s;
 			case 3:
 				// integer token
-				P += 4;
+				SkipBytes(4);
 				return "<integer>";
 			case 5:
 				// GUID token
-				P += 16;
+				SkipBytes(16);
 				return "<guid>";
 			case 6:
-				if( End - P < 4) return s;
+				if( !Require(4)) return s;
 				len = ReadBinDWord();
-				P += (len * 4);
+				SkipBytes(len * 4);
 				return "<int_list>";
 			case 7:
-				if( End - P < 4) return s;
+				if( !Require(4)) return s;
 				len = ReadBinDWord();
-				P += (len * mBinaryFloatSize);
+				SkipBytes(len * mBinaryFloatSize);
 				return "<flt_list>";
 			case 0x0a:
 				return "{";
@@ -1162,7 +1220,7 @@ std::string XFileParser::GetNextToken()
 		if( P >= End)
 			return s;
 
-		while( (P < End) && !isspace( (unsigned char) *P))
+		while( Require(1) && !isspace( (unsigned char) *P))
 		{
 			// either keep token delimiters when already holding a token, or return if first valid char
 			if( *P == ';' || *P == '}' || *P == '{' || *P == ',')
@@ -1186,13 +1244,15 @@ void XFileParser::FindNextNoneWhiteSpace()
 	bool running = true;
 	while( running )
 	{
-		while( P < End && isspace( (unsigned char) *P))
+		while( Require(1) && isspace( (unsigned char) *P))
 		{
 			if( *P == '\n')
 				mLineNumber++;
 			++P;
 		}
 
+		// two chars needed to detect comments, reading P[1] is safe because of the terminating zero
+		Require(2);
 		if( P >= End)
 			return;
 
@@ -1221,10 +1281,10 @@ void XFileParser::GetNextTokenAsString( std::string& poString)
 		ThrowException( "Expected quotation mark.");
 	++P;
 
-	while( P < End && *P != '"')
+	while( Require(1) && *P != '"')
 		poString.append( P++, 1);
 
-	if( P >= End-1)
+	if( !Require(2))
 		ThrowException( "Unexpected end of file while parsing string");
 
 	if( P[1] != ';' || P[0] != '"')
@@ -1238,7 +1298,7 @@ void XFileParser::ReadUntilEndOfLine()
 	if( mIsBinaryFormat)
 		return;
 
-	while( P < End)
+	while( Require(1))
 	{
 		if( *P == '\n' || *P == '\r')
 		{
@@ -1275,17 +1335,17 @@ unsigned int XFileParser::ReadInt()
 {
 	if( mIsBinaryFormat)
 	{
-		if( mBinaryNumCount == 0 && End - P >= 2)
+		if( mBinaryNumCount == 0 && Require(2))
 		{
 			unsigned short tmp = ReadBinWord(); // 0x06 or 0x03
-			if( tmp == 0x06 && End - P >= 4) // array of ints follows
+			if( tmp == 0x06 && Require(4)) // array of ints follows
 				mBinaryNumCount = ReadBinDWord();
 			else // single int follows
 				mBinaryNumCount = 1; 
 		}
 
 		--mBinaryNumCount;
-		if ( End - P >= 4) {
+		if ( Require(4)) {
 			return ReadBinDWord();
 		} else {
 			P = End;
@@ -1294,6 +1354,7 @@ unsigned int XFileParser::ReadInt()
 	} else
 	{
 		FindNextNoneWhiteSpace();
+		Require(2);
 
 		// TODO: consider using strtol10 instead???
 
@@ -1311,7 +1372,7 @@ unsigned int XFileParser::ReadInt()
 
 		// read digits
 		unsigned int number = 0;
-		while( P < End)
+		while( Require(1))
 		{
 			if( !isdigit( *P))
 				break;
@@ -1329,10 +1390,10 @@ float XFileParser::ReadFloat()
 {
 	if( mIsBinaryFormat)
 	{
-		if( mBinaryNumCount == 0 && End - P >= 2)
+		if( mBinaryNumCount == 0 && Require(2))
 		{
 			unsigned short tmp = ReadBinWord(); // 0x07 or 0x42
-			if( tmp == 0x07 && End - P >= 4) // array of floats following
+			if( tmp == 0x07 && Require(4)) // array of floats following
 				mBinaryNumCount = ReadBinDWord();
 			else // single float following
 				mBinaryNumCount = 1; 
@@ -1341,7 +1402,7 @@ float XFileParser::ReadFloat()
 		--mBinaryNumCount;
 		if( mBinaryFloatSize == 8)
 		{
-			if( End - P >= 8) {
+			if( Require(8)) {
 				float result = (float) (*(double*) P);
 				P += 8;
 				return result;
@@ -1351,7 +1412,7 @@ float XFileParser::ReadFloat()
 			}
 		} else
 		{
-			if( End - P >= 4) {
+			if( Require(4)) {
 				float result = *(float*) P;
 				P += 4;
 				return result;
@@ -1364,6 +1425,10 @@ float XFileParser::ReadFloat()
 
 	// text version
 	FindNextNoneWhiteSpace();
+
+	// no number is longer than this, the window must not move while it is parsed
+	Require(64);
+
 	// check for various special strings to allow reading files from faulty exporters
 	// I mean you, Blender!
 	// Reading is safe because of the terminating zero
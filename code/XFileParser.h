@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <string>
 #include <vector>
+#include <boost/scoped_ptr.hpp>
 
 #include "../include/assimp/types.h"
 
@@ -124,6 +125,18 @@ protected:
 
 	void ReadUntilEndOfLine();
 
+	//! makes sure at least num bytes are readable at P unless the file ends before.
+	//! Compressed files are decompressed block by block as the parser advances.
+	bool Require( size_t num) {
+		return static_cast<size_t>(End - P) >= num || (mInflate && InflateBlocks( num));
+	}
+
+	//! decompresses further MSZIP blocks behind the unread data
+	bool InflateBlocks( size_t num);
+
+	//! skips num bytes or up to the end of the file
+	void SkipBytes( size_t num);
+
 	unsigned short ReadBinWord();
 	unsigned int ReadBinDWord();
 	unsigned int ReadInt();
@@ -151,6 +164,11 @@ protected:
 	const char* P;
 	const char* End;
 
+	/// Decompressor state for MSZIP compressed files, NULL otherwise. 
+	/// P and End point into its sliding window then.
+	struct InflateState;
+	boost::scoped_ptr<InflateState> mInflate;
+
 	/// Line number when reading in text format
 	unsigned int mLineNumber;
 
@@ -0,0 +1,549 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ZipArchiveIOSystem.cpp
+ *  @brief Implementation of the zip archive IOSystem
+ */
+
+#include "ZipArchiveIOSystem.h"
+#include "../include/assimp/ai_assert.h"
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstring>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+//	Routes the file access of unzip through an assimp IOSystem.
+struct IOSystem2Unzip {
+
+	static voidpf open(voidpf opaque, const char* filename, int mode) {
+		IOSystem* io_system = (IOSystem*) opaque;
+
+		const char* mode_fopen = NULL;
+		if((mode & ZLIB_FILEFUNC_MODE_READWRITEFILTER)==ZLIB_FILEFUNC_MODE_READ) {
+			mode_fopen = "rb";
+		} else {
+			if(mode & ZLIB_FILEFUNC_MODE_EXISTING) {
+				mode_fopen = "r+b";
+			} else {
+				if(mode & ZLIB_FILEFUNC_MODE_CREATE) {
+					mode_fopen = "wb";
+				}
+			}
+		}
+
+		return (voidpf) io_system->Open(filename, mode_fopen);
+	}
+
+	static uLong read(voidpf /*opaque*/, voidpf stream, void* buf, uLong size) {
+		IOStream* io_stream = (IOStream*) stream;
+
+		return (uLong)io_stream->Read(buf, 1, size);
+	}
+
+	static uLong write(voidpf /*opaque*/, voidpf stream, const void* buf, uLong size) {
+		IOStream* io_stream = (IOStream*) stream;
+
+		return (uLong)io_stream->Write(buf, 1, size);
+	}
+
+	static long tell(voidpf /*opaque*/, voidpf stream) {
+		IOStream* io_stream = (IOStream*) stream;
+
+		return (long)io_stream->Tell();
+	}
+
+	static long seek(voidpf /*opaque*/, voidpf stream, uLong offset, int origin) {
+		IOStream* io_stream = (IOStream*) stream;
+
+		aiOrigin assimp_origin;
+		switch (origin) {
+			default:
+			case ZLIB_FILEFUNC_SEEK_CUR:
+				assimp_origin = aiOrigin_CUR;
+				break;
+			case ZLIB_FILEFUNC_SEEK_END:
+				assimp_origin = aiOrigin_END;
+				break;
+			case ZLIB_FILEFUNC_SEEK_SET:
+				assimp_origin = aiOrigin_SET;
+				break;
+		}
+
+		return (io_stream->Seek(offset, assimp_origin) == aiReturn_SUCCESS ? 0 : -1);
+	}
+
+	static int close(voidpf opaque, voidpf stream) {
+		IOSystem* io_system = (IOSystem*) opaque;
+		IOStream* io_stream = (IOStream*) stream;
+
+		io_system->Close(io_stream);
+
+		return 0;
+	}
+
+	static int testerror(voidpf /*opaque*/, voidpf /*stream*/) {
+		return 0;
+	}
+
+	static zlib_filefunc_def get(IOSystem* pIOHandler) {
+		zlib_filefunc_def mapping;
+
+		mapping.zopen_file = open;
+		mapping.zread_file = read;
+		mapping.zwrite_file = write;
+		mapping.ztell_file = tell;
+		mapping.zseek_file = seek;
+		mapping.zclose_file = close;
+		mapping.zerror_file = testerror;
+		mapping.opaque = (voidpf) pIOHandler;
+
+		return mapping;
+	}
+};
+
+} // anon
+
+// ------------------------------------------------------------------------------------------------
+ZipFile::ZipFile(ZipArchiveIOSystem* pArchive, const unz_file_pos& rPos, size_t size) 
+: m_pArchive(pArchive)
+, m_FilePos(rPos)
+, m_Size(size)
+, m_Pos(0)
+, m_InflatedPos(0) {
+	ai_assert(NULL != m_pArchive);
+}
+
+// ------------------------------------------------------------------------------------------------
+ZipFile::~ZipFile() {
+	if(m_pArchive->m_pActiveFile == this) {
+		unzCloseCurrentFile(m_pArchive->m_ZipFileHandle);
+		m_pArchive->m_pActiveFile = NULL;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Makes this entry the current file of the shared unzip handle. The entry is reopened from
+//	its start if another stream has been reading in between.
+bool ZipFile::activate() {
+	if(m_pArchive->m_pActiveFile == this) {
+		return true;
+	}
+
+	unzFile handle = m_pArchive->m_ZipFileHandle;
+	if(m_pArchive->m_pActiveFile != NULL) {
+		unzCloseCurrentFile(handle);
+		m_pArchive->m_pActiveFile->m_InflatedPos = 0;
+		m_pArchive->m_pActiveFile = NULL;
+	}
+
+	if(unzGoToFilePos(handle, &m_FilePos) != UNZ_OK || unzOpenCurrentFile(handle) != UNZ_OK) {
+		return false;
+	}
+
+	m_pArchive->m_pActiveFile = this;
+	m_InflatedPos = 0;
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Inflates and drops the given number of bytes.
+bool ZipFile::skip(size_t count) {
+	char buffer[4096];
+	while(count) {
+		const unsigned int chunk = static_cast<unsigned int>(std::min(count, sizeof(buffer)));
+		const int read = unzReadCurrentFile(m_pArchive->m_ZipFileHandle, buffer, chunk);
+		if(read <= 0) {
+			return false;
+		}
+		m_InflatedPos += read;
+		count -= read;
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t ZipFile::Read(void* pvBuffer, size_t pSize, size_t pCount) {
+	if(!pSize || !pCount || m_Pos >= m_Size) {
+		return 0;
+	}
+
+	// Only whole elements are returned
+	const size_t count = std::min(pCount, (m_Size - m_Pos) / pSize);
+	if(!count || !activate()) {
+		return 0;
+	}
+
+	// A backward seek since the last read requires the entry to be inflated again
+	if(m_InflatedPos > m_Pos) {
+		m_pArchive->m_pActiveFile = NULL;
+		unzCloseCurrentFile(m_pArchive->m_ZipFileHandle);
+		if(!activate()) {
+			return 0;
+		}
+	}
+	if(!skip(m_Pos - m_InflatedPos)) {
+		return 0;
+	}
+
+	size_t remaining = count * pSize;
+	char* out = static_cast<char*>(pvBuffer);
+	while(remaining) {
+		const unsigned int chunk = static_cast<unsigned int>(std::min(remaining, static_cast<size_t>(INT_MAX)));
+		const int read = unzReadCurrentFile(m_pArchive->m_ZipFileHandle, out, chunk);
+		if(read <= 0) {
+			break;
+		}
+		out += read;
+		remaining -= read;
+		m_InflatedPos += read;
+	}
+
+	const size_t bytes = count * pSize - remaining;
+	m_Pos += bytes;
+	return bytes / pSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t ZipFile::Write(const void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) {
+	return 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t ZipFile::FileSize() const {
+	return m_Size;
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Seeking only moves the logical position, the data is inflated by the next Read().
+aiReturn ZipFile::Seek(size_t pOffset, aiOrigin pOrigin) {
+	size_t pos;
+	switch(pOrigin) {
+		case aiOrigin_SET:
+			pos = pOffset;
+			break;
+		case aiOrigin_CUR:
+			pos = m_Pos + pOffset;
+			break;
+		case aiOrigin_END:
+			if(pOffset > m_Size) {
+				return aiReturn_FAILURE;
+			}
+			pos = m_Size - pOffset;
+			break;
+		default:
+			return aiReturn_FAILURE;
+	}
+
+	if(pos > m_Size) {
+		return aiReturn_FAILURE;
+	}
+	m_Pos = pos;
+	return aiReturn_SUCCESS;
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t ZipFile::Tell() const {
+	return m_Pos;
+}
+
+// ------------------------------------------------------------------------------------------------
+void ZipFile::Flush() {
+	// empty
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Constructor.
+ZipArchiveIOSystem::ZipArchiveIOSystem(IOSystem* pIOHandler, const std::string& rFile) 
+: m_ZipFileHandle(NULL)
+, m_ArchiveMap()
+, m_pActiveFile(NULL) {
+	ai_assert(NULL != pIOHandler);
+
+	if (! rFile.empty()) {
+		zlib_filefunc_def mapping = IOSystem2Unzip::get(pIOHandler);
+
+		m_ZipFileHandle = unzOpen2(rFile.c_str(), &mapping);
+
+		if(m_ZipFileHandle != NULL) {
+			mapArchive();
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Destructor.
+ZipArchiveIOSystem::~ZipArchiveIOSystem() {
+	// all streams should have been closed by now
+	ai_assert(NULL == m_pActiveFile);
+
+	m_ArchiveMap.clear();
+
+	if(m_ZipFileHandle != NULL) {
+		unzClose(m_ZipFileHandle);
+		m_ZipFileHandle = NULL;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Returns true, if the archive is already open.
+bool ZipArchiveIOSystem::isOpen() const {
+	return (m_ZipFileHandle != NULL);
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Returns true, if the filename is part of the archive.
+bool ZipArchiveIOSystem::Exists(const char* pFile) const {
+	ai_assert(pFile != NULL);
+
+	if (pFile == NULL) {
+		return false;
+	}
+	return m_ArchiveMap.find(SimplifyFilename(pFile)) != m_ArchiveMap.end();
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Returns the separator delimiter. Zip archives always use '/'.
+char ZipArchiveIOSystem::getOsSeparator() const {
+	return '/';
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Opens a file, which is part of the archive.
+IOStream *ZipArchiveIOSystem::Open(const char* pFile, const char* pMode) {
+	ai_assert(pFile != NULL);
+
+	// The archive is read-only
+	if (pFile == NULL || (pMode != NULL && (strchr(pMode, 'w') || strchr(pMode, 'a') || strchr(pMode, '+')))) {
+		return NULL;
+	}
+
+	std::map<std::string, ZipFileInfo>::const_iterator it = m_ArchiveMap.find(SimplifyFilename(pFile));
+	if(it == m_ArchiveMap.end()) {
+		return NULL;
+	}
+
+	return new ZipFile(this, it->second.m_FilePos, it->second.m_Size);
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Close a filestream.
+void ZipArchiveIOSystem::Close(IOStream *pFile) {
+	delete pFile;
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Returns the file-list of the archive.
+void ZipArchiveIOSystem::getFileList(std::vector<std::string> &rFileList) const {
+	rFileList.clear();
+	rFileList.reserve(m_ArchiveMap.size());
+
+	for(std::map<std::string, ZipFileInfo>::const_iterator it(m_ArchiveMap.begin()), end(m_ArchiveMap.end()); it != end; ++it) {
+		rFileList.push_back(it->first);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Returns the uncompressed size of an entry.
+size_t ZipArchiveIOSystem::getFileSize(const char* pFile) const {
+	ai_assert(pFile != NULL);
+
+	std::map<std::string, ZipFileInfo>::const_iterator it = m_ArchiveMap.find(SimplifyFilename(pFile));
+	return it == m_ArchiveMap.end() ? 0 : it->second.m_Size;
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Unifies separators and strips leading "./" and "/" from a file name.
+std::string ZipArchiveIOSystem::SimplifyFilename(const std::string& rFile) {
+	std::string name(rFile);
+	std::replace(name.begin(), name.end(), '\\', '/');
+
+	std::string::size_type start = 0;
+	for(;;) {
+		if(name.compare(start, 2, "./") == 0) {
+			start += 2;
+		}
+		else if(name.compare(start, 1, "/") == 0) {
+			++start;
+		}
+		else break;
+	}
+	return name.substr(start);
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Indexes the central directory of the archive. No entry data is read here.
+bool ZipArchiveIOSystem::mapArchive() {
+	if(m_ZipFileHandle == NULL) {
+		return false;
+	}
+
+	if(!m_ArchiveMap.empty() || unzGoToFirstFile(m_ZipFileHandle) != UNZ_OK) {
+		return true;
+	}
+
+	do {
+		char filename[FileNameSize];
+		unz_file_info fileInfo;
+		ZipFileInfo info;
+
+		if(unzGetCurrentFileInfo(m_ZipFileHandle, &fileInfo, filename, FileNameSize, NULL, 0, NULL, 0) != UNZ_OK) {
+			continue;
+		}
+
+		// Skip directory entries, they carry no data
+		const std::string name = SimplifyFilename(filename);
+		if(name.empty() || name[name.length()-1] == '/') {
+			continue;
+		}
+
+		if(unzGetFilePos(m_ZipFileHandle, &info.m_FilePos) == UNZ_OK) {
+			info.m_Size = fileInfo.uncompressed_size;
+			m_ArchiveMap.insert(std::make_pair(name, info));
+		}
+	} while(unzGoToNextFile(m_ZipFileHandle) == UNZ_OK);
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Constructor.
+ZipMemberIOSystem::ZipMemberIOSystem(IOSystem* pIOHandler)
+: m_pWrapped(pIOHandler) {
+	ai_assert(NULL != pIOHandler);
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Destructor.
+ZipMemberIOSystem::~ZipMemberIOSystem() {
+	for(std::map<std::string, ZipArchiveIOSystem*>::iterator it = m_Archives.begin(); it != m_Archives.end(); ++it) {
+		delete it->second;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Finds the archive a path points into, the path of the entry is returned in rMember.
+ZipArchiveIOSystem* ZipMemberIOSystem::findArchive(const std::string& rFile, std::string& rMember) const {
+	for(std::string::size_type sep = rFile.find_first_of("/\\"); sep != std::string::npos; sep = rFile.find_first_of("/\\", sep + 1)) {
+		if(sep < 4 || rFile[sep-4] != '.' || ::tolower(rFile[sep-3]) != 'z' || ::tolower(rFile[sep-2]) != 'i' || ::tolower(rFile[sep-1]) != 'p') {
+			continue;
+		}
+
+		const std::string path = rFile.substr(0, sep);
+		std::map<std::string, ZipArchiveIOSystem*>::iterator it = m_Archives.find(path);
+		if(it == m_Archives.end()) {
+			ZipArchiveIOSystem* archive = NULL;
+			if(m_pWrapped->Exists(path)) {
+				archive = new ZipArchiveIOSystem(m_pWrapped, path);
+				if(!archive->isOpen()) {
+					delete archive;
+					archive = NULL;
+				}
+			}
+			it = m_Archives.insert(std::make_pair(path, archive)).first;
+		}
+
+		if(it->second != NULL) {
+			rMember = rFile.substr(sep + 1);
+			return it->second;
+		}
+	}
+	return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Returns true, if the file exists or is an entry of an archive.
+bool ZipMemberIOSystem::Exists(const char* pFile) const {
+	ai_assert(pFile != NULL);
+
+	if(m_pWrapped->Exists(pFile)) {
+		return true;
+	}
+
+	std::string member;
+	const ZipArchiveIOSystem* archive = findArchive(pFile, member);
+	return archive != NULL && archive->Exists(member.c_str());
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Returns the separator of the wrapped IOSystem, both separators work within archives.
+char ZipMemberIOSystem::getOsSeparator() const {
+	return m_pWrapped->getOsSeparator();
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Opens a file, entries of archives are only opened for reading.
+IOStream* ZipMemberIOSystem::Open(const char* pFile, const char* pMode) {
+	ai_assert(pFile != NULL && pMode != NULL);
+
+	std::string member;
+	ZipArchiveIOSystem* archive = NULL;
+	if(!m_pWrapped->Exists(pFile)) {
+		archive = findArchive(pFile, member);
+	}
+	if(archive == NULL) {
+		return m_pWrapped->Open(pFile, pMode);
+	}
+
+	return archive->Open(member.c_str(), pMode);
+}
+
+// ------------------------------------------------------------------------------------------------
+//	Close a filestream.
+void ZipMemberIOSystem::Close(IOStream* pFile) {
+	// importers may also delete entry streams directly, so they aren't tracked
+	if(dynamic_cast<ZipFile*>(pFile)) {
+		delete pFile;
+	}
+	else m_pWrapped->Close(pFile);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool ZipMemberIOSystem::ComparePaths(const char* one, const char* two) const {
+	return m_pWrapped->ComparePaths(one, two);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+} // Namespace Assimp
@@ -0,0 +1,223 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ZipArchiveIOSystem.h
+ *  @brief Read-only IOSystem giving access to the entries of a zip archive
+ */
+#ifndef AI_ZIPARCHIVEIOSYSTEM_H_INC
+#define AI_ZIPARCHIVEIOSYSTEM_H_INC
+
+#include "../contrib/unzip/unzip.h"
+#include "../include/assimp/IOStream.hpp"
+#include "../include/assimp/IOSystem.hpp"
+#include <string>
+#include <vector>
+#include <map>
+
+namespace Assimp {
+
+class ZipArchiveIOSystem;
+
+// ------------------------------------------------------------------------------------------------
+///	\class		ZipFile
+///
+///	\brief	Read-only stream for a single archive entry.
+///
+///	Nothing is decompressed up front. Data is inflated on demand as it is read, so memory use
+///	does not depend on the entry size. Forward seeks skip data, backward seeks restart the 
+///	entry from its beginning. All streams of one archive share a single unzip handle.
+// ------------------------------------------------------------------------------------------------
+class ZipFile : public IOStream {
+
+	friend class ZipArchiveIOSystem;
+
+	protected:
+
+		ZipFile(ZipArchiveIOSystem* pArchive, const unz_file_pos& rPos, size_t size);
+
+	public:
+
+		~ZipFile();
+
+		size_t Read(void* pvBuffer, size_t pSize, size_t pCount );
+
+		size_t Write(const void* /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/);
+
+		size_t FileSize() const;
+
+		aiReturn Seek(size_t pOffset, aiOrigin pOrigin);
+
+		size_t Tell() const;
+
+		void Flush();
+
+	private:
+
+		bool activate();
+
+		bool skip(size_t count);
+
+	private:
+
+		ZipArchiveIOSystem* m_pArchive;
+
+		unz_file_pos m_FilePos;
+
+		size_t m_Size;
+
+		/// Logical read position as seen by the caller
+		size_t m_Pos;
+
+		/// Number of bytes already inflated from the entry
+		size_t m_InflatedPos;
+};
+
+// ------------------------------------------------------------------------------------------------
+///	\class		ZipArchiveIOSystem
+///	
+///	\brief	Implements a read-only IOSystem on top of a zip archive.
+///
+///	The constructor only reads the central directory of the archive. Entries are decompressed
+///	lazily when opened and read, see #ZipFile. The archive itself is accessed through the
+///	IOSystem passed on construction, so it may live anywhere the importer can read from.
+///	Entry names are matched with '/' as separator, leading "./" and "/" are ignored.
+///
+///	Streams returned by Open() must be released before the archive is destroyed. Close() and
+///	a plain delete of the stream are equivalent.
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API ZipArchiveIOSystem : public IOSystem {
+
+	friend class ZipFile;
+
+	public:
+
+		static const unsigned int FileNameSize = 256;
+
+	public:
+
+		ZipArchiveIOSystem(IOSystem* pIOHandler, const std::string & rFile);
+
+		~ZipArchiveIOSystem();
+
+		bool Exists(const char* pFile) const;
+
+		char getOsSeparator() const;
+
+		IOStream* Open(const char* pFile, const char* pMode = "rb");
+
+		void Close(IOStream* pFile);
+
+		bool isOpen() const;
+
+		void getFileList(std::vector<std::string> &rFileList) const;
+
+		/// Returns the uncompressed size of an entry, 0 if it does not exist.
+		size_t getFileSize(const char* pFile) const;
+
+		/// Brings a file name into the form used to index the archive entries.
+		static std::string SimplifyFilename(const std::string& rFile);
+
+	private:
+
+		bool mapArchive();
+
+	private:
+
+		struct ZipFileInfo {
+			unz_file_pos m_FilePos;
+			size_t m_Size;
+		};
+
+		unzFile m_ZipFileHandle;
+
+		std::map<std::string, ZipFileInfo> m_ArchiveMap;
+
+		/// Stream currently owning the open entry of #m_ZipFileHandle, if any
+		ZipFile* m_pActiveFile;
+};
+
+// ------------------------------------------------------------------------------------------------
+///	\class		ZipMemberIOSystem
+///	
+///	\brief	IOSystem wrapper which reaches into zip archives.
+///
+///	A path which doesn't exist, but begins with an existing archive, i.e. "bundle.zip/model.obj",
+///	is resolved to the entry "model.obj" of "bundle.zip". Files a loader opens next to a model
+///	in an archive are therefore found in the archive as well. Each archive is opened once and
+///	kept until the wrapper is destroyed, streams of its entries must be released before that.
+///	All other files are passed through to the wrapped IOSystem. The Importer reads files
+///	through this wrapper if they don't exist otherwise.
+// ------------------------------------------------------------------------------------------------
+class ZipMemberIOSystem : public IOSystem {
+
+	public:
+
+		/// @param pIOHandler IOSystem to read the files and archives from. It is not owned.
+		ZipMemberIOSystem(IOSystem* pIOHandler);
+
+		~ZipMemberIOSystem();
+
+		bool Exists(const char* pFile) const;
+
+		char getOsSeparator() const;
+
+		IOStream* Open(const char* pFile, const char* pMode = "rb");
+
+		void Close(IOStream* pFile);
+
+		bool ComparePaths(const char* one, const char* two) const;
+
+	private:
+
+		ZipArchiveIOSystem* findArchive(const std::string& rFile, std::string& rMember) const;
+
+	private:
+
+		IOSystem* m_pWrapped;
+
+		/// Archives opened so far, NULL for paths which aren't readable archives
+		mutable std::map<std::string, ZipArchiveIOSystem*> m_Archives;
+};
+
+// ------------------------------------------------------------------------------------------------
+
+} // Namespace Assimp
+
+#endif // AI_ZIPARCHIVEIOSYSTEM_H_INC
@@ -2,9 +2,13 @@
 #ifndef INCLUDED_ASSBIN_CHUNKS_H
 #define INCLUDED_ASSBIN_CHUNKS_H
 
-#define ASSBIN_VERSION_MAJOR 1
+#define ASSBIN_VERSION_MAJOR 2
 #define ASSBIN_VERSION_MINOR 0
 
+// Revision 1 stores all data inline in the chunks. It is still read, and
+// written by assimp_cmd for regression dumps.
+#define ASSBIN_VERSION_MAJOR_INLINE 1
+
 /** 
 @page assfile .ASS File formats
 
@@ -46,16 +50,36 @@ in <tt>&lt;root&gt;/tools/assimp_cmd/WriteDumb.cpp</tt> (yes, the 'b' is no typo
 1. File structure:
 -------------------------------------------------------------------------------
 
+Revision 1:
+
 ----------------------
 | Header (500 bytes) |
 ----------------------
 | Variable chunks    |
 ----------------------
 
+Revision 2 (see 4.):
+
+----------------------
+| Header (500 bytes) |
+----------------------
+| Structure size     |
+| Blob count         |
+----------------------
+| Variable chunks    |
+----------------------
+| Blob table         |
+----------------------
+| Padding            |
+----------------------
+| Blobs              |
+----------------------
+
 -------------------------------------------------------------------------------
 2. Definitions:
 -------------------------------------------------------------------------------
 
+long	is eight bytes wide, stored in little-endian byte order.
 integer	is four bytes wide, stored in little-endian byte order.
 short	is two bytes wide, stored in little-endian byte order.
 byte	is a single byte.
@@ -86,6 +110,7 @@ short       1 if the data after the header is compressed with the DEFLATE algori
             0 for uncompressed files.
                    For compressed files, the first integer after the header is
                    always the uncompressed data size
+            Always 0 for revision 2, blobs are compressed individually.
                 
 byte[256]	Zero-terminated source file name, UTF-8
 byte[128]	Zero-terminated command line parameters passed to assimp_cmd, UTF-8 
@@ -164,12 +189,63 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 
    - mNumAllocated is omitted, for obvious reasons :-)
 
+-------------------------------------------------------------------------------
+4. Revision 2:
+-------------------------------------------------------------------------------
+
+Large arrays are not stored inline in the chunks, but as blobs. Each blob
+starts at a multiple of ASSBIN_BLOB_ALIGNMENT bytes from the beginning of the
+file, so a reader can map the file and use uncompressed blobs in place. The 
+chunks refer to them by their index in the blob table.
+
+long		Size of the chunk data in bytes
+long		Number of entries in the blob table
+
+byte[n]		Chunks, as in revision 1, with the exceptions listed below
+
+            Blob table entries:
+integer		ASSBIN_BLOB_STORED or ASSBIN_BLOB_DEFLATE
+integer		Reserved, 0
+long		Offset of the blob from the beginning of the file
+long		Size of the blob in the file
+long		Size of the blob after decompression
+
+Blobs are stored in their in-memory layout, aiVector3D as three floats, 
+aiColor4D as four floats, aiTexel as four bytes.
+
+[[aiMesh]]
+
+   - Vertex components are blob indices instead of arrays. mTextureCoords 
+     are still prefixed by mNumUVComponents, but always have three 
+	 components.
+
+   - Faces are stored as
+       integer number of indices of every face, 0 if it varies 
+       integer blob index of all face indices as integer, in order
+     [if the number of indices varies]
+       integer blob index of the number of indices of each face as short
+
+[[aiTexture]]
+
+   - The texel data is a blob index, the number of bytes is
+     mWidth for compressed textures and mWidth*mHeight*4 otherwise.
+
 
  @endverbatim*/
 
 
 #define ASSBIN_HEADER_LENGTH 512
 
+// alignment of blobs in revision 2 files, in bytes
+#define ASSBIN_BLOB_ALIGNMENT	64
+
+// size of a blob table entry, in bytes
+#define ASSBIN_BLOB_ENTRY_LENGTH	32
+
+// blob compression in revision 2 files
+#define ASSBIN_BLOB_STORED		0
+#define ASSBIN_BLOB_DEFLATE		1
+
 // these are the magic chunk identifiers for the binary ASS file format
 #define ASSBIN_CHUNK_AICAMERA					0x1234
 #define ASSBIN_CHUNK_AILIGHT					0x1235
@@ -0,0 +1,227 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2008, assimp team
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the 
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file  fast_ftoa.h
+ *  @brief Fast, locale-independent formatting of floating-point numbers.
+ *
+ *  The counterpart of fast_atof.h for the exporters. Floats are written with
+ *  the shortest sequence of digits which reads back as the same value.
+ */
+#ifndef AI_FAST_FTOA_H_INC
+#define AI_FAST_FTOA_H_INC
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+#ifdef _MSC_VER 
+#  include <stdint.h>
+#else 
+#include "../include/assimp/Compiler/pstdint.h"
+#endif
+
+namespace Assimp {
+
+// Size of the buffers passed to fast_ftoa() and fast_dtoa(), including the terminating zero
+#define AI_FAST_FTOA_BUFFER_SIZE 32
+
+// Exact powers of ten up to 1e22, correctly rounded ones beyond
+const double fast_ftoa_table[61] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+	1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+	1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23,
+	1e24, 1e25, 1e26, 1e27, 1e28, 1e29, 1e30, 1e31,
+	1e32, 1e33, 1e34, 1e35, 1e36, 1e37, 1e38, 1e39,
+	1e40, 1e41, 1e42, 1e43, 1e44, 1e45, 1e46, 1e47,
+	1e48, 1e49, 1e50, 1e51, 1e52, 1e53, 1e54, 1e55,
+	1e56, 1e57, 1e58, 1e59, 1e60
+};
+
+// ------------------------------------------------------------------------------------
+// v * 10^e for |e| <= 60
+// ------------------------------------------------------------------------------------
+inline double fast_ftoa_scale(double v, int e)
+{
+	return e >= 0 ? v * fast_ftoa_table[e] : v / fast_ftoa_table[-e];
+}
+
+// ------------------------------------------------------------------------------------
+// Round v to prec significant digits. e is the decimal exponent of the first
+// digit and updated if rounding carries into a new digit.
+// ------------------------------------------------------------------------------------
+inline uint32_t fast_ftoa_round(double v, unsigned int prec, int& e)
+{
+	uint32_t m = static_cast<uint32_t>(fast_ftoa_scale(v,static_cast<int>(prec)-1-e) + 0.5);
+	if (m >= static_cast<uint32_t>(fast_ftoa_table[prec])) {
+		m /= 10;
+		++e;
+	}
+	return m;
+}
+
+// ------------------------------------------------------------------------------------
+// Convert a float to the shortest decimal string which reads back as the same
+// float. Fixed notation is used for exponents in [-5,9), scientific otherwise.
+// out must hold AI_FAST_FTOA_BUFFER_SIZE chars. Returns the length of the 
+// string, which is zero-terminated.
+// ------------------------------------------------------------------------------------
+inline unsigned int fast_ftoa(char* out, float f)
+{
+	char* p = out;
+
+	uint32_t bits;
+	::memcpy(&bits,&f,4);
+	if (bits & 0x80000000u) {
+		*p++ = '-';
+		bits &= 0x7fffffffu;
+	}
+
+	if ((bits & 0x7f800000u) == 0x7f800000u) {
+		::strcpy(p, (bits & 0x007fffffu) ? "nan" : "inf");
+		return static_cast<unsigned int>(p + 3 - out);
+	}
+	if (!bits) {
+		*p++ = '0';
+		*p = '\0';
+		return static_cast<unsigned int>(p - out);
+	}
+
+	float a;
+	::memcpy(&a,&bits,4);
+	const double v = a;
+
+	// decimal exponent of the first digit
+	int e = static_cast<int>(std::floor(std::log10(v)));
+	if (fast_ftoa_scale(1.0,e) > v) {
+		--e;
+	}
+	else if (fast_ftoa_scale(1.0,e+1) <= v) {
+		++e;
+	}
+
+	// 9 digits always suffice. If n digits read back correctly, more do as well,
+	// so the shortest length can be found by bisection.
+	unsigned int lo = 1, hi = 9;
+	while (lo < hi) {
+		const unsigned int mid = (lo + hi) / 2;
+		int me = e;
+		const uint32_t m = fast_ftoa_round(v,mid,me);
+		if (static_cast<float>(fast_ftoa_scale(m,me+1-static_cast<int>(mid))) == a) {
+			hi = mid;
+		}
+		else lo = mid + 1;
+	}
+
+	uint32_t m = fast_ftoa_round(v,lo,e);
+	char digits[10];
+	unsigned int n = lo;
+	for (unsigned int i = n; i > 0; --i) {
+		digits[i-1] = static_cast<char>('0' + m % 10);
+		m /= 10;
+	}
+	while (n > 1 && digits[n-1] == '0') {
+		--n;
+	}
+
+	if (e >= 0 && e < 9) {
+		for (unsigned int i = 0; i < n || static_cast<int>(i) <= e; ++i) {
+			if (static_cast<int>(i) == e + 1) {
+				*p++ = '.';
+			}
+			*p++ = i < n ? digits[i] : '0';
+		}
+	}
+	else if (e < 0 && e >= -5) {
+		*p++ = '0';
+		*p++ = '.';
+		for (int i = -1; i > e; --i) {
+			*p++ = '0';
+		}
+		::memcpy(p,digits,n);
+		p += n;
+	}
+	else {
+		*p++ = digits[0];
+		if (n > 1) {
+			*p++ = '.';
+			::memcpy(p,digits+1,n-1);
+			p += n-1;
+		}
+		*p++ = 'e';
+		if (e < 0) {
+			*p++ = '-';
+			e = -e;
+		}
+		else *p++ = '+';
+		*p++ = static_cast<char>('0' + e / 10);
+		*p++ = static_cast<char>('0' + e % 10);
+	}
+
+	*p = '\0';
+	return static_cast<unsigned int>(p - out);
+}
+
+// ------------------------------------------------------------------------------------
+// Convert a double to a string which reads back as the same double. Values
+// which are exactly representable as float are written like fast_ftoa() does.
+// ------------------------------------------------------------------------------------
+inline unsigned int fast_dtoa(char* out, double d)
+{
+	const float f = static_cast<float>(d);
+	if (static_cast<double>(f) == d || d != d) {
+		return fast_ftoa(out,f);
+	}
+
+	// rare, so the C library will do. It might use the decimal comma
+	// of the current locale, though.
+	const int len = ::sprintf(out,"%.17g",d);
+	for (char* p = out; *p; ++p) {
+		if (*p == ',') {
+			*p = '.';
+		}
+	}
+	return len > 0 ? static_cast<unsigned int>(len) : 0;
+}
+
+} // ! namespace Assimp
+
+#endif // AI_FAST_FTOA_H_INC
@@ -0,0 +1,144 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2011, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file  AnimationSampler.hpp
+ *  @brief Defines the CPP-API to evaluate node animations at runtime
+ */
+#ifndef INCLUDED_AI_ANIMATIONSAMPLER_HPP
+#define INCLUDED_AI_ANIMATIONSAMPLER_HPP
+
+#include "types.h"
+
+struct aiScene;
+struct aiNode;
+
+namespace Assimp	{
+	class AnimationSamplerPimpl;
+
+// ----------------------------------------------------------------------------------
+/** CPP-API: Evaluates an aiAnimation of a scene at arbitrary times and computes
+ *  the local and global transformations of all nodes of the scene.
+ *
+ *  The node hierarchy is flattened once on construction: nodes are indexed in
+ *  depth-first order, so a node's parent always has a lower index than the node
+ *  itself, and each animation channel is mapped to the index of its node. 
+ *
+ *  Every channel keeps a cursor to the keys used by the previous evaluation,
+ *  so playing an animation forward costs O(1) per channel and frame. Jumping 
+ *  to an arbitrary time falls back to a binary search of the keys.
+ *
+ *  Position and scaling keys are interpolated linearly, rotation keys 
+ *  spherically. Before the first and after the last key of a track, 
+ *  aiNodeAnim::mPreState and aiNodeAnim::mPostState are honoured.
+ *
+ *  The sampler does not copy the scene, which must stay valid and unchanged 
+ *  for the lifetime of the sampler. Samplers do not share mutable state, so 
+ *  any number of them can evaluate the same scene in parallel, one per 
+ *  thread or character.
+ */
+class ASSIMP_API AnimationSampler
+{
+public:
+
+	// -------------------------------------------------------------------
+	/** Constructs a sampler for an animation of a scene.
+	 *  @param pScene Scene to be animated.
+	 *  @param pAnimIndex Index of the animation in aiScene::mAnimations.
+	 *    If it is out of range, all nodes keep their default
+	 *    transformation. */
+	AnimationSampler( const aiScene* pScene, unsigned int pAnimIndex = 0);
+
+	~AnimationSampler();
+
+	// -------------------------------------------------------------------
+	/** Evaluates the animation at a given time and updates the local and 
+	 *  global transformations of all nodes.
+	 *  @param pTime Time, in seconds. It is converted to ticks using 
+	 *    aiAnimation::mTicksPerSecond, or 25 ticks per second if this is 
+	 *    not specified. The time is not wrapped into the duration of the
+	 *    animation. */
+	void Evaluate( double pTime);
+
+	// -------------------------------------------------------------------
+	/** Returns the number of nodes in the flattened node hierarchy */
+	unsigned int GetNumNodes() const;
+
+	// -------------------------------------------------------------------
+	/** Returns the node with a given index */
+	const aiNode* GetNode( unsigned int pIndex) const;
+
+	// -------------------------------------------------------------------
+	/** Returns the index of the parent of a given node, or UINT_MAX
+	 *  for the root node. */
+	unsigned int GetParentIndex( unsigned int pIndex) const;
+
+	// -------------------------------------------------------------------
+	/** Looks up the index of a node by name.
+	 *  @return Index of the first node with this name, or UINT_MAX if
+	 *    there is no such node. */
+	unsigned int FindNodeIndex( const char* pName) const;
+
+	// -------------------------------------------------------------------
+	/** Returns the transformations of all nodes relative to their parents,
+	 *  as computed by the last call to #Evaluate. Before the first call,
+	 *  these are the nodes' default transformations.
+	 *  @return Array of #GetNumNodes matrices, in node index order. */
+	const aiMatrix4x4* GetLocalTransforms() const;
+
+	// -------------------------------------------------------------------
+	/** Returns the transformations of all nodes in the coordinate space
+	 *  of the scene, as computed by the last call to #Evaluate.
+	 *  @return Array of #GetNumNodes matrices, in node index order. */
+	const aiMatrix4x4* GetGlobalTransforms() const;
+
+private:
+
+	// no copying, the cursors belong to exactly one sampler
+	AnimationSampler( const AnimationSampler&);
+	AnimationSampler& operator= ( const AnimationSampler&);
+
+	AnimationSamplerPimpl* pimpl;
+};
+
+} // Namespace Assimp
+
+#endif // INCLUDED_AI_ANIMATIONSAMPLER_HPP
@@ -112,6 +112,42 @@ public:
 		ExportFormatEntry() : mExportFunction(), mEnforcePP() {}
 	};
 
+	/** A single output of #ExportMany */
+	struct ExportRequest
+	{
+		/// ID string of the export format, see #Export
+		const char* mFormatId;
+
+		/// Full target file name
+		const char* mPath;
+
+		/// Additional preprocessing steps, see #Export
+		unsigned int mPreprocessing;
+
+		/// Export properties or NULL, not owned
+		const ExportProperties* mProperties;
+
+		/// IO handler to write this output through or NULL to use
+		/// the handler of the #Exporter. Not owned.
+		IOSystem* mIOSystem;
+
+		/// Receives the result of this export
+		aiReturn mResult;
+
+		/// Receives the error message if the export failed
+		std::string mError;
+
+		ExportRequest( const char* pFormatId, const char* pPath, unsigned int pPreprocessing = 0u, 
+			const ExportProperties* pProperties = NULL, IOSystem* pIOSystem = NULL)
+			: mFormatId(pFormatId)
+			, mPath(pPath)
+			, mPreprocessing(pPreprocessing)
+			, mProperties(pProperties)
+			, mIOSystem(pIOSystem)
+			, mResult(AI_FAILURE)
+		{}
+	};
+
 
 public:
 
@@ -216,6 +252,25 @@ public:
 	inline aiReturn Export( const aiScene* pScene, const std::string& pFormatId, const std::string& pPath,  unsigned int pPreprocessing = 0u, const ExportProperties* pProperties = NULL);
 
 
+	// -------------------------------------------------------------------
+	/** Exports the given scene to several files at once.
+	 *
+	 * Equivalent to calling #Export for every request, but requests 
+	 * that need the same preprocessing share a single preprocessed 
+	 * copy of the scene and all format writers run concurrently.
+	 * Custom exporters registered via #RegisterExporter must therefore
+	 * be safe to run in parallel with other exporters if used here,
+	 * and so must the IO handlers.
+	 * @param pScene The scene to export. Stays in possession of the caller,
+	 *   is not changed by the function.
+	 * @param pRequests Outputs to be written. The result of each export
+	 *   is stored in its #ExportRequest::mResult and #ExportRequest::mError.
+	 * @param pNumRequests Number of requests
+	 * @return AI_SUCCESS if all outputs were written. Otherwise 
+	 *   #GetErrorString returns the error of the first failed request. */
+	aiReturn ExportMany( const aiScene* pScene, ExportRequest* pRequests, size_t pNumRequests);
+
+
 	// -------------------------------------------------------------------
 	/** Returns an error description of an error that occurred in #Export
 	 *    or #ExportToBlob
@@ -89,6 +89,56 @@ struct aiImporterDesc;
 /** @namespace Assimp Assimp's CPP-API and all internal APIs */
 namespace Assimp	{
 
+// ----------------------------------------------------------------------------------
+/** CPP-API: Handle to an import started by Importer::ReadFileAsync().
+ *
+ *  The handle merely refers to the Importer, which keeps ownership of the
+ *  scene as usual. It may be copied freely, but must not be used after 
+ *  the Importer has been destroyed. 
+ */
+class ASSIMP_API ImportFuture	{
+
+public:
+
+	/** Constructs an invalid handle */
+	ImportFuture() : mImporter() {}
+
+	// -------------------------------------------------------------------
+	/** Check whether the handle refers to an import */
+	bool IsValid() const { return mImporter != 0; }
+
+	// -------------------------------------------------------------------
+	/** Check whether the import has finished, successfully or not.
+	 *  Never blocks. */
+	bool IsReady() const;
+
+	// -------------------------------------------------------------------
+	/** Wait until the import has finished.
+	 *  @return The imported scene, equal to Importer::GetScene(). NULL if 
+	 *    the import failed or has been cancelled, see 
+	 *    Importer::GetErrorString(). */
+	const aiScene* Get();
+
+	// -------------------------------------------------------------------
+	/** Ask the import to stop at the next opportunity. 
+	 *
+	 *  The request is checked between post-processing steps and 
+	 *  regularly while the OBJ, STL and FBX loaders read their file. 
+	 *  All other loaders read the whole file first, so cancelling
+	 *  them takes effect only once loading has finished. The import 
+	 *  frees whatever it has built so far and Get() returns NULL, 
+	 *  unless the import has finished before. The function does not 
+	 *  wait, call Get() to do so. */
+	void Cancel();
+
+private:
+
+	friend class Importer;
+	explicit ImportFuture(Importer* pImporter) : mImporter(pImporter) {}
+
+	Importer* mImporter;
+};
+
 // ----------------------------------------------------------------------------------
 /** CPP-API: The Importer class forms an C++ interface to the functionality of the 
 *   Open Asset Import Library.
@@ -389,7 +439,10 @@ public:
 	 *   instance. Use GetOrphanedScene() to take ownership of it.
 	 *
 	 * @note Assimp is able to determine the file format of a file
-	 * automatically. 
+	 * automatically. Files inside a zip archive are read by giving the
+	 * path of the archive followed by the entry, i.e. "bundle.zip/model.obj".
+	 * Other files the loader needs, such as material libraries, are then
+	 * read from the archive as well.
 	 */
 	const aiScene* ReadFile(
 		const char* pFile, 
@@ -438,6 +491,26 @@ public:
 		unsigned int pFlags,
 		const char* pHint = "");
 
+	// -------------------------------------------------------------------
+	/** Reads the given file in a worker thread. 
+	 *
+	 * The function returns immediately, the import itself is equivalent
+	 * to ReadFile(). Use the returned handle to wait for the result or to
+	 * cancel the import. Until the import has finished, no other method 
+	 * of this Importer instance may be called and the progress handler is
+	 * called from the worker thread. An import which is still running 
+	 * when the Importer is destroyed is cancelled, see 
+	 * ImportFuture::Cancel() for how quickly that happens.
+	 * If Assimp has been built without threading support 
+	 * (#ASSIMP_BUILD_SINGLETHREADED), the file is read right away and 
+	 * the import has finished when the function returns.
+	 * @param pFile Path and filename to the file to be imported.
+	 * @param pFlags Post processing steps, see ReadFile()
+	 * @return Handle to the running import */
+	ImportFuture ReadFileAsync(
+		const char* pFile,
+		unsigned int pFlags);
+
 	// -------------------------------------------------------------------
 	/** Apply post-processing to an already-imported scene.
 	 *
@@ -70,7 +70,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *  If enabled, measures the time needed for each part of the loading
  *  process (i.e. IO time, importing, postprocessing, ..) and dumps
  *  these timings to the DefaultLogger. See the @link perf Performance
- *  Page@endlink for more information on this topic.
+ *  Page@endlink for more information on this topic. Post-processing
+ *  is timed per stage, regions are named after the classes of the
+ *  steps they contain. 'assimp bench' uses these regions.
  * 
  * Property type: bool. Default value: false.
  */
@@ -89,6 +91,37 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_CONFIG_IMPORT_NO_SKELETON_MESHES \
 	"IMPORT_NO_SKELETON_MESHES"
 
+// ---------------------------------------------------------------------------
+/** @brief Directory of the import cache.
+ *
+ * If set, Importer::ReadFile() stores each imported and post-processed 
+ * scene as Assbin file in this directory. Later imports of the same file
+ * contents with the same post-processing flags and configuration 
+ * properties are read from there instead. Other files the loader has read,
+ * such as material libraries or external animations, must be unchanged as
+ * well, otherwise the file is imported again. Files which are opened 
+ * without going through the Importer's IOSystem are not tracked. If the 
+ * cache is busy for several seconds, it is bypassed. The directory must
+ * exist. 
+ * Property type: String. Default value: "" (no caching).
+ */
+#define AI_CONFIG_IMPORT_CACHE_DIRECTORY \
+	"IMPORT_CACHE_DIRECTORY"
+
+// ---------------------------------------------------------------------------
+/** @brief Maximum size of the import cache, in megabytes.
+ *
+ * If the cached files exceed this size, the least recently used ones 
+ * are removed. See #AI_CONFIG_IMPORT_CACHE_DIRECTORY.
+ * Property type: integer. Default value: 512
+ */
+#define AI_CONFIG_IMPORT_CACHE_MAX_SIZE \
+	"IMPORT_CACHE_MAX_SIZE"
+
+#if (!defined AI_IMPORT_CACHE_DEFAULT_MAX_SIZE)
+#	define AI_IMPORT_CACHE_DEFAULT_MAX_SIZE 512
+#endif
+
 
 
 # if 0 // not implemented yet
@@ -116,6 +149,36 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Various stuff to fine-tune the behavior of a specific post processing step.
 // ###########################################################################
 
+// ---------------------------------------------------------------------------
+/** @brief Extent of the checks done by the ValidateDataStructure step.
+ *
+ * #AI_VDS_LEVEL_STRUCTURE checks only what could make an application
+ * crash on the data: NULL pointers, array sizes, index ranges and 
+ * references between objects. #AI_VDS_LEVEL_FULL additionally checks 
+ * numeric plausibility, i.e. bone weights, animation key times and 
+ * camera, light and material values. 
+ * Property type: integer. Default value: #AI_VDS_LEVEL_FULL.
+ */
+#define AI_CONFIG_PP_VDS_LEVEL \
+	"PP_VDS_LEVEL"
+
+#define AI_VDS_LEVEL_STRUCTURE	0
+#define AI_VDS_LEVEL_FULL		1
+
+// ---------------------------------------------------------------------------
+/** @brief Pipeline the per-mesh post processing steps.
+ *
+ * If enabled, consecutive steps which process each mesh independently
+ * (i.e. triangulation, normal and tangent generation, vertex joining)
+ * are run back-to-back on one mesh before the next mesh is touched, 
+ * which keeps the mesh in cache and allows different meshes to be 
+ * processed concurrently. All other steps still see the whole scene.
+ * The results are identical either way.
+ * Property type: bool. Default value: true.
+ */
+#define AI_CONFIG_PP_PIPELINE_MESHES \
+	"PP_PIPELINE_MESHES"
+
 
 // ---------------------------------------------------------------------------
 /** @brief Maximum bone count per mesh for the SplitbyBoneCount step.
@@ -252,6 +315,33 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_CONFIG_PP_PTV_ROOT_TRANSFORMATION	\
 	"PP_PTV_ROOT_TRANSFORMATION"
 
+// ---------------------------------------------------------------------------
+/** @brief Configures the #aiProcess_PreTransformVertices step to keep
+ *  meshes which are referenced by more than one node in local space.
+ *
+ * Such meshes are neither copied nor transformed. Instead, each reference
+ * gets a node of its own which carries the absolute transformation of the
+ * referencing node, so the node graph becomes a table of instances sharing
+ * the same geometry. Meshes referenced only once are processed as usual.
+ * Use this for scenes with heavily instanced geometry, which would otherwise
+ * be duplicated once per instance.
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_PP_PTV_INSTANCES	\
+	"PP_PTV_INSTANCES"
+
+// ---------------------------------------------------------------------------
+/** @brief Configures the #aiProcess_PreTransformVertices step to refuse
+ *  scenes whose pretransformed geometry would exceed a memory budget.
+ *
+ * The size of the output geometry is estimated before any data is touched.
+ * If it exceeds the given number of megabytes, the step fails and the
+ * import is aborted.
+ * Property type: integer. Default value: 0 (no limit).
+ */
+#define AI_CONFIG_PP_PTV_MAX_OUTPUT_MB	\
+	"PP_PTV_MAX_OUTPUT_MB"
+
 // ---------------------------------------------------------------------------
 /** @brief Configures the #aiProcess_FindDegenerates step to
  *  remove degenerated primitives from the import - immediately.
@@ -318,6 +408,21 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #	define AI_SLM_DEFAULT_MAX_VERTICES		1000000
 #endif
 
+// ---------------------------------------------------------------------------
+/** @brief  Configures the "SplitLargeMeshes" PostProcess-Step to group faces
+ *  by spatial locality.
+ *
+ * By default, meshes are cut into consecutive face ranges, in the order the
+ * faces appear in the source mesh. If this property is set, faces are
+ * sorted along a z-order curve over their centroids first, so every
+ * sub-mesh covers a compact region with a tight bounding box and shares
+ * few vertices with its neighbours. Vertices are unique within each
+ * sub-mesh in this mode, for both the triangle and the vertex limit.
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_PP_SLM_SPATIAL_SPLIT \
+	"PP_SLM_SPATIAL_SPLIT"
+
 // ---------------------------------------------------------------------------
 /** @brief Set the maximum number of bones affecting a single vertex
  *
@@ -332,6 +437,29 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #	define AI_LMW_MAX_WEIGHTS	0x4
 #endif // !! AI_LMW_MAX_WEIGHTS
 
+// ---------------------------------------------------------------------------
+/** @brief Let the #aiProcess_LimitBoneWeights step generate a vertex-major
+ *  skin stream for all meshes with bones.
+ *
+ * The value is the number of influences stored per vertex, either 4 or 8.
+ * Other non-zero values are rounded up to the next of those. The result
+ * is stored in aiMesh::mSkinStream. 
+ * Property type: integer. Default value: 0 (no skin stream).
+ */
+#define AI_CONFIG_PP_LBW_SKIN_STREAM \
+	"PP_LBW_SKIN_STREAM"
+
+// ---------------------------------------------------------------------------
+/** @brief Set the size of the weights in the skin stream, in bits.
+ *
+ * 32 stores floats. 16 and 8 store unsigned integers normalized to their
+ * full range, the weights of a vertex sum up to exactly the maximum value. 
+ * This is used together with #AI_CONFIG_PP_LBW_SKIN_STREAM.
+ * Property type: integer. Default value: 32.
+ */
+#define AI_CONFIG_PP_LBW_SKIN_STREAM_BITS \
+	"PP_LBW_SKIN_STREAM_BITS"
+
 // ---------------------------------------------------------------------------
 /** @brief Lower the deboning threshold in order to remove more bones.
  *
@@ -355,6 +483,37 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define AI_CONFIG_PP_DB_ALL_OR_NONE \
 	"PP_DB_ALL_OR_NONE"
 
+/** @brief Default value for the #AI_CONFIG_PP_GM_MAX_VERTICES property
+ */
+#ifndef AI_GM_DEFAULT_MAX_VERTICES
+#	define AI_GM_DEFAULT_MAX_VERTICES 64
+#endif
+
+// ---------------------------------------------------------------------------
+/** @brief  Set the maximum number of vertices referenced by a meshlet.
+ *
+ * This is used by the #aiProcess_GenerateMeshlets step. 
+ * Property type: integer. Default value: #AI_GM_DEFAULT_MAX_VERTICES.
+ */
+#define AI_CONFIG_PP_GM_MAX_VERTICES \
+	"PP_GM_MAX_VERTICES"
+
+/** @brief Default value for the #AI_CONFIG_PP_GM_MAX_TRIANGLES property
+ */
+#ifndef AI_GM_DEFAULT_MAX_TRIANGLES
+#	define AI_GM_DEFAULT_MAX_TRIANGLES 126
+#endif
+
+// ---------------------------------------------------------------------------
+/** @brief  Set the maximum number of triangles in a meshlet.
+ *
+ * This is used by the #aiProcess_GenerateMeshlets step. 
+ * Property type: integer. Default value: #AI_GM_DEFAULT_MAX_TRIANGLES.
+ */
+#define AI_CONFIG_PP_GM_MAX_TRIANGLES \
+	"PP_GM_MAX_TRIANGLES"
+
+// ---------------------------------------------------------------------------
 /** @brief Default value for the #AI_CONFIG_PP_ICL_PTCACHE_SIZE property
  */
 #ifndef PP_ICL_PTCACHE_SIZE
@@ -487,6 +646,84 @@ enum aiComponent
 #define AI_CONFIG_PP_FID_ANIM_ACCURACY				\
 	"PP_FID_ANIM_ACCURACY"
 
+/** @brief Default value for the #AI_CONFIG_PP_CA_POSITION_ERROR property
+ */
+#ifndef AI_CA_DEFAULT_POSITION_ERROR
+#	define AI_CA_DEFAULT_POSITION_ERROR 0.001f
+#endif
+
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_CompressAnimations step:
+ *  Specifies the maximum distance between a position key which is removed 
+ *  and the position interpolated from the remaining keys at its time. 
+ *
+ * Property type: float. Default value: #AI_CA_DEFAULT_POSITION_ERROR.
+ */
+#define AI_CONFIG_PP_CA_POSITION_ERROR				\
+	"PP_CA_POSITION_ERROR"
+
+/** @brief Default value for the #AI_CONFIG_PP_CA_ROTATION_ERROR property
+ */
+#ifndef AI_CA_DEFAULT_ROTATION_ERROR
+#	define AI_CA_DEFAULT_ROTATION_ERROR 0.05f
+#endif
+
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_CompressAnimations step:
+ *  Specifies the maximum angle, in degrees, between a rotation key which 
+ *  is removed and the rotation interpolated from the remaining keys at 
+ *  its time.
+ *
+ * Property type: float. Default value: #AI_CA_DEFAULT_ROTATION_ERROR.
+ */
+#define AI_CONFIG_PP_CA_ROTATION_ERROR				\
+	"PP_CA_ROTATION_ERROR"
+
+/** @brief Default value for the #AI_CONFIG_PP_CA_SCALING_ERROR property
+ */
+#ifndef AI_CA_DEFAULT_SCALING_ERROR
+#	define AI_CA_DEFAULT_SCALING_ERROR 0.001f
+#endif
+
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_CompressAnimations step:
+ *  Specifies the maximum distance between a scaling key which is removed 
+ *  and the scaling interpolated from the remaining keys at its time.
+ *
+ * Property type: float. Default value: #AI_CA_DEFAULT_SCALING_ERROR.
+ */
+#define AI_CONFIG_PP_CA_SCALING_ERROR				\
+	"PP_CA_SCALING_ERROR"
+
+// ---------------------------------------------------------------------------
+/** @brief Input parameter to the #aiProcess_CompressAnimations step:
+ *  Bound the error of each channel by its effect on the nodes below it.
+ *
+ * The errors are measured in bone space by default, so the position error
+ * of a node far away from the animated one can be much larger than
+ * #AI_CONFIG_PP_CA_POSITION_ERROR. If this option is enabled, the rotation
+ * and scaling errors of a channel are further limited so that the origins 
+ * of all nodes and the vertices of all meshes below the animated node 
+ * move by at most the position error.
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_PP_CA_PROPAGATE_ERROR				\
+	"PP_CA_PROPAGATE_ERROR"
+
+// ---------------------------------------------------------------------------
+/** @brief Configures the #aiProcess_FindInstances step to recognize
+ *  rigidly transformed copies of meshes.
+ *
+ * Many CAD exporters bake instance transformations into the vertex data.
+ * If this option is enabled, meshes which are translated and/or rotated
+ * copies of an earlier mesh are replaced by a reference to that mesh from
+ * a child node which carries the transformation. Skinned meshes and
+ * mirrored or scaled copies are not detected.
+ * Property type: bool. Default value: false.
+ */
+#define AI_CONFIG_PP_FI_TRANSFORM_INVARIANT	\
+	"PP_FI_TRANSFORM_INVARIANT"
+
 
 // TransformUVCoords evaluates UV scalings
 #define AI_UVTRAFO_SCALING 0x1
@@ -603,7 +840,8 @@ enum aiComponent
 // ---------------------------------------------------------------------------
 /** @brief Set whether the fbx importer will preserve pivot points for
  *    transformations (as extra nodes). If set to false, pivots and offsets
- *    will be evaluated whenever possible.
+ *    will be evaluated whenever possible, and node animations are baked
+ *    into a single channel per node.
  *
  * The default value is true (1)
  * Property type: bool
@@ -879,6 +1117,18 @@ enum aiComponent
 
 #define AI_CONFIG_IMPORT_COLLADA_IGNORE_UP_DIRECTION "IMPORT_COLLADA_IGNORE_UP_DIRECTION"
 
+// ---------------------------------------------------------------------------
+/** @brief Specifies whether the Assbin loader references vertex and index 
+ *  data in the file instead of copying it.
+ *
+ * Applies to revision 2 files. The file is mapped into memory if it is read 
+ * through the default IOSystem, otherwise it is read with a single call. 
+ * Meshes which reference the file have aiMesh::mExternalData set, the memory 
+ * is released with the scene. Post-processing steps copy the data first.
+ * Property type: Bool. Default value: true.
+ */
+#define AI_CONFIG_IMPORT_ASSBIN_ZERO_COPY "IMPORT_ASSBIN_ZERO_COPY"
+
 
 // ---------- All the Export defines ------------
 
@@ -889,5 +1139,15 @@ enum aiComponent
 
 #define AI_CONFIG_EXPORT_XFILE_64BIT "EXPORT_XFILE_64BIT"
 
+/** @brief Specifies whether the Assbin exporter compresses vertex, index and
+ *  texel data.
+ *
+ * Compressed data can't be referenced in place by the loader, so this trades
+ * loading speed for file size.
+ * Property type: Bool. Default value: false.
+ */
+
+#define AI_CONFIG_EXPORT_ASSBIN_COMPRESS "EXPORT_ASSBIN_COMPRESS"
+
 
 #endif // !! AI_CONFIG_H_INC
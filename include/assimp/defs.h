@@ -115,6 +115,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 	 * OPTIMIZEANIMS
 	 * OPTIMIZEGRAPH
 	 * GENENTITYMESHES
+	 * GENERATEMESHLETS
+	 * COMPRESSANIMATIONS
 	 * FIXTEXTUREPATHS */
 	//////////////////////////////////////////////////////////////////////////
 
@@ -222,6 +224,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifdef ASSIMP_BUILD_BOOST_WORKAROUND
 
 	// threading support requires boost
+#ifdef ASSIMP_BUILD_MULTITHREADED
+#	error ASSIMP_BUILD_MULTITHREADED requires boost, it is incompatible with ASSIMP_BUILD_BOOST_WORKAROUND
+#endif
 #ifndef ASSIMP_BUILD_SINGLETHREADED
 #	define ASSIMP_BUILD_SINGLETHREADED
 #endif
@@ -232,10 +237,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 	/* Define ASSIMP_BUILD_SINGLETHREADED to compile assimp
 	 * without threading support. The library doesn't utilize
 	 * threads then and is itself not threadsafe.
-	 * If this flag is specified boost::threads is *not* required. */
+	 * If this flag is specified boost::threads is *not* required.
+	 * It is the default unless ASSIMP_BUILD_MULTITHREADED is defined,
+	 * see the ASSIMP_ENABLE_THREADING CMake option. */
 	//////////////////////////////////////////////////////////////////////////
-#ifndef ASSIMP_BUILD_SINGLETHREADED
-#	define ASSIMP_BUILD_SINGLETHREADED
+#ifndef ASSIMP_BUILD_MULTITHREADED
+#	ifndef ASSIMP_BUILD_SINGLETHREADED
+#		define ASSIMP_BUILD_SINGLETHREADED
+#	endif
 #endif
 
 #if defined(_DEBUG) || ! defined(NDEBUG)
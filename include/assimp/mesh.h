@@ -445,6 +445,187 @@ struct aiAnimMesh
 };
 
 
+// ---------------------------------------------------------------------------
+/** @brief A meshlet is a small cluster of faces of a mesh.
+ *
+ *  Meshlets are generated by the #aiProcess_GenerateMeshlets step. They
+ *  reference a bounded number of vertices and faces, so they can be
+ *  processed and culled as a unit, i.e. by mesh shaders or a GPU culling
+ *  pass. The faces of a meshlet are stored consecutively in the mesh's
+ *  face array.
+ */
+struct aiMeshlet
+{
+	/** Index of the first face of the meshlet in aiMesh::mFaces */
+	unsigned int mFaceOffset;
+
+	/** Number of faces in the meshlet, starting at #mFaceOffset */
+	unsigned int mNumFaces;
+
+	/** Number of unique vertices referenced by the faces of the meshlet.
+	 *  This is also the size of the #mVertices array. */
+	unsigned int mNumVertices;
+
+	/** Indices of the vertices referenced by the meshlet, into the
+	 *  vertex arrays of the mesh. Each vertex occurs only once. */
+	unsigned int* mVertices;
+
+	/** Center of the bounding sphere of the meshlet, in mesh space */
+	C_STRUCT aiVector3D mCenter;
+
+	/** Radius of the bounding sphere of the meshlet */
+	float mRadius;
+
+	/** Axis of the normal cone, i.e. the average facing direction of the
+	 *  faces in the meshlet. Unit length unless the cone is degenerate. */
+	C_STRUCT aiVector3D mConeAxis;
+
+	/** Cosine of the half opening angle of the normal cone. All face
+	 *  normals n of the meshlet satisfy dot(n,mConeAxis) >= mConeCutoff.
+	 *  The meshlet is back-facing for a viewing direction v if 
+	 *  dot(v,mConeAxis) >= sqrt(1-mConeCutoff^2). If the value is <= 0, 
+	 *  the cone is too wide to be used for culling. */
+	float mConeCutoff;
+
+#ifdef __cplusplus
+
+	//! Default constructor
+	aiMeshlet()
+		: mFaceOffset( 0 )
+		, mNumFaces( 0 )
+		, mNumVertices( 0 )
+		, mVertices( NULL )
+		, mRadius( 0.f )
+		, mConeCutoff( -1.f )
+	{
+	}
+
+	//! Copy constructor. Copy the vertex list as well.
+	aiMeshlet(const aiMeshlet& o)
+		: mFaceOffset( o.mFaceOffset )
+		, mNumFaces( o.mNumFaces )
+		, mNumVertices( o.mNumVertices )
+		, mVertices( NULL )
+		, mCenter( o.mCenter )
+		, mRadius( o.mRadius )
+		, mConeAxis( o.mConeAxis )
+		, mConeCutoff( o.mConeCutoff )
+	{
+		if (mNumVertices) {
+			mVertices = new unsigned int[mNumVertices];
+			::memcpy( mVertices, o.mVertices, mNumVertices * sizeof(unsigned int));
+		}
+	}
+
+	//! Assignment operator. Copy the vertex list as well.
+	aiMeshlet& operator = (const aiMeshlet& o)
+	{
+		if (&o == this)
+			return *this;
+
+		delete[] mVertices;
+		mFaceOffset = o.mFaceOffset;
+		mNumFaces = o.mNumFaces;
+		mNumVertices = o.mNumVertices;
+		mVertices = NULL;
+		if (mNumVertices) {
+			mVertices = new unsigned int[mNumVertices];
+			::memcpy( mVertices, o.mVertices, mNumVertices * sizeof(unsigned int));
+		}
+		mCenter = o.mCenter;
+		mRadius = o.mRadius;
+		mConeAxis = o.mConeAxis;
+		mConeCutoff = o.mConeCutoff;
+		return *this;
+	}
+
+	//! Destructor. Delete the vertex list
+	~aiMeshlet()
+	{
+		delete[] mVertices;
+	}
+#endif // __cplusplus
+};
+
+
+// ---------------------------------------------------------------------------
+/** @brief Vertex-major bone weights of a mesh, laid out for a vertex buffer.
+ *
+ *  The skin stream is generated by the #aiProcess_LimitBoneWeights step if
+ *  #AI_CONFIG_PP_LBW_SKIN_STREAM is set. It stores the same influences as
+ *  the bones of the mesh, but with a fixed number of slots per vertex.
+ *  The slots of a vertex are sorted by descending weight, unused slots
+ *  have bone index and weight 0. If there are more influences than slots,
+ *  only the largest are kept and renormalized.
+ *
+ *  Post-processing steps that change the vertex layout of a mesh don't
+ *  update the stream. #aiProcess_LimitBoneWeights runs after them if they 
+ *  are applied together, so this only matters for separate calls to
+ *  Importer::ApplyPostProcessing().
+ */
+struct aiSkinStream
+{
+	/** Number of vertices, same as aiMesh::mNumVertices */
+	unsigned int mNumVertices;
+
+	/** Number of bone influences per vertex, either 4 or 8 */
+	unsigned int mNumInfluences;
+
+	/** Size of a weight in bits. 32 for floats, 16 or 8 for unsigned
+	 *  integers that are normalized to their full range. The quantized
+	 *  weights of a vertex sum up to exactly 0xffff or 0xff. */
+	unsigned int mWeightBits;
+
+	/** Bone indices, #mNumInfluences per vertex. They are indices into
+	 *  the aiMesh::mBones array. */
+	unsigned short* mBoneIndices;
+
+	/** Bone weights, #mNumInfluences per vertex. The array is of type
+	 *  float, unsigned short or unsigned char, depending on #mWeightBits. */
+	unsigned char* mWeights;
+
+#ifdef __cplusplus
+
+	//! Default constructor
+	aiSkinStream()
+		: mNumVertices( 0 )
+		, mNumInfluences( 0 )
+		, mWeightBits( 32 )
+		, mBoneIndices( NULL )
+		, mWeights( NULL )
+	{
+	}
+
+	//! Copy constructor. Copy the arrays as well.
+	aiSkinStream(const aiSkinStream& o)
+		: mNumVertices( o.mNumVertices )
+		, mNumInfluences( o.mNumInfluences )
+		, mWeightBits( o.mWeightBits )
+		, mBoneIndices( NULL )
+		, mWeights( NULL )
+	{
+		const unsigned int num = mNumVertices * mNumInfluences;
+		if (num) {
+			mBoneIndices = new unsigned short[num];
+			::memcpy( mBoneIndices, o.mBoneIndices, num * sizeof(unsigned short));
+			mWeights = new unsigned char[num * mWeightBits / 8];
+			::memcpy( mWeights, o.mWeights, num * mWeightBits / 8);
+		}
+	}
+
+	//! Destructor. Delete the arrays
+	~aiSkinStream()
+	{
+		delete[] mBoneIndices;
+		delete[] mWeights;
+	}
+
+private:
+	aiSkinStream& operator = (const aiSkinStream& o);
+#endif // __cplusplus
+};
+
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material. 
 *
@@ -606,6 +787,26 @@ struct aiMesh
 	 *  mesh'es vertex components (usually positions, normals). */
 	C_STRUCT aiAnimMesh** mAnimMeshes;
 
+	/** The number of meshlets in this mesh. 
+	 *  Zero unless the #aiProcess_GenerateMeshlets step was applied. */
+	unsigned int mNumMeshlets;
+
+	/** Meshlets partitioning the faces of the mesh, NULL if not present.
+	 *  The meshlets cover the face array in order, without gaps. */
+	C_STRUCT aiMeshlet* mMeshlets;
+
+	/** Vertex-major copy of the bone weights, NULL if not present.
+	 *  Only generated by the #aiProcess_LimitBoneWeights step if
+	 *  #AI_CONFIG_PP_LBW_SKIN_STREAM is set. */
+	C_STRUCT aiSkinStream* mSkinStream;
+
+	/** Nonzero if the vertex components and the face indices of this
+	 *  mesh are not owned by the mesh, but point into storage owned by
+	 *  the scene, i.e. a memory-mapped Assbin file. Such data must not 
+	 *  be deleted or reallocated. Use SceneCombiner::DetachExternalData()
+	 *  to obtain a mesh which owns its data. */
+	unsigned int mExternalData;
+
 
 #ifdef __cplusplus
 
@@ -624,6 +825,10 @@ struct aiMesh
 		, mMaterialIndex( 0 )
 		, mNumAnimMeshes( 0 )
 		, mAnimMeshes( NULL )
+		, mNumMeshlets( 0 )
+		, mMeshlets( NULL )
+		, mSkinStream( NULL )
+		, mExternalData( 0 )
 	{
 		for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++)
 		{
@@ -638,15 +843,17 @@ struct aiMesh
 	//! Deletes all storage allocated for the mesh
 	~aiMesh()
 	{
-		delete [] mVertices; 
-		delete [] mNormals;
-		delete [] mTangents;
-		delete [] mBitangents;
-		for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++) {
-			delete [] mTextureCoords[a];
-		}
-		for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; a++) {
-			delete [] mColors[a];
+		if (!mExternalData)	{
+			delete [] mVertices; 
+			delete [] mNormals;
+			delete [] mTangents;
+			delete [] mBitangents;
+			for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; a++) {
+				delete [] mTextureCoords[a];
+			}
+			for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; a++) {
+				delete [] mColors[a];
+			}
 		}
 
 		// DO NOT REMOVE THIS ADDITIONAL CHECK
@@ -664,6 +871,9 @@ struct aiMesh
 			delete [] mAnimMeshes;
 		}
 
+		delete [] mMeshlets;
+		delete mSkinStream;
+
 		//delete [] mFaces;
 	}
 
@@ -728,6 +938,14 @@ struct aiMesh
 	inline bool HasBones() const
 		{ return mBones != NULL && mNumBones > 0; }
 
+	//! Check whether the mesh has been partitioned into meshlets
+	inline bool HasMeshlets() const
+		{ return mMeshlets != NULL && mNumMeshlets > 0; }
+
+	//! Check whether the mesh has a vertex-major skin stream
+	inline bool HasSkinStream() const
+		{ return mSkinStream != NULL; }
+
 #endif // __cplusplus
 };
 
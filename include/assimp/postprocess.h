@@ -231,7 +231,9 @@ enum aiPostProcessSteps
 	* property to supply your own limit to the post processing step.
 	*
 	* If you intend to perform the skinning in hardware, this post processing 
-	* step might be of interest to you.
+	* step might be of interest to you. Set <tt>#AI_CONFIG_PP_LBW_SKIN_STREAM</tt>
+	* to let it also store the weights per vertex, with a fixed number of
+	* influences, in aiMesh::mSkinStream.
 	*/
 	aiProcess_LimitBoneWeights = 0x200,
 
@@ -523,7 +525,42 @@ enum aiPostProcessSteps
 	 *  Use <tt>#AI_CONFIG_PP_DB_ALL_OR_NONE</tt> if you want bones removed if and 
 	 *	only if all bones within the scene qualify for removal.
     */
-	aiProcess_Debone  = 0x4000000
+	aiProcess_Debone  = 0x4000000,
+
+	// -------------------------------------------------------------------------
+	/** <hr>This step partitions each triangle mesh into meshlets - small 
+	 *  clusters of adjacent faces referencing a bounded number of vertices.
+	 *
+	 *  The faces of each mesh are reordered so every meshlet is a consecutive
+	 *  range of aiMesh::mFaces. For each meshlet, the list of referenced 
+	 *  vertices, a bounding sphere and a normal cone are computed and stored
+	 *  in aiMesh::mMeshlets. This allows cluster culling and mesh shader 
+	 *  rendering without a separate offline tool. 
+	 *
+	 *  Use <tt>#AI_CONFIG_PP_GM_MAX_VERTICES</tt> and 
+	 *  <tt>#AI_CONFIG_PP_GM_MAX_TRIANGLES</tt> to control the meshlet size.
+	 *  Meshes which contain anything but triangles are left untouched, so
+	 *  you probably want to combine this with #aiProcess_Triangulate and
+	 *  #aiProcess_SortByPType. As it reorders faces, it is executed after
+	 *  #aiProcess_ImproveCacheLocality.
+	 */
+	aiProcess_GenerateMeshlets = 0x8000000,
+
+	// -------------------------------------------------------------------------
+	/** <hr>This step removes redundant keys from all node animation channels.
+	 *
+	 *  A key is removed if it can be restored by interpolating the keys 
+	 *  around it - linearly for position and scaling keys and spherically 
+	 *  for rotation keys - within a configurable error. Channels which do
+	 *  not change at all are reduced to a single key. 
+	 *
+	 *  Use <tt>#AI_CONFIG_PP_CA_POSITION_ERROR</tt>, 
+	 *  <tt>#AI_CONFIG_PP_CA_ROTATION_ERROR</tt> and
+	 *  <tt>#AI_CONFIG_PP_CA_SCALING_ERROR</tt> to control the error per
+	 *  channel, and <tt>#AI_CONFIG_PP_CA_PROPAGATE_ERROR</tt> to bound the
+	 *  error of the nodes below each animated node, too.
+	 */
+	aiProcess_CompressAnimations = 0x10000000
 
 	// aiProcess_GenEntityMeshes = 0x100000,
 	// aiProcess_OptimizeAnimations = 0x200000
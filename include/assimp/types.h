@@ -108,11 +108,18 @@ namespace Intern		{
 extern "C" {
 #endif
 
-/** Maximum dimension for strings, ASSIMP strings are zero terminated. */
+/** Maximum dimension for strings, ASSIMP strings are zero terminated.
+ *  Builds can reduce the size by defining ASSIMP_AISTRING_MAXLEN, see the
+ *  ASSIMP_AISTRING_MAXLEN CMake option. The value must be the same for the
+ *  library and all code using it. */
+#ifndef ASSIMP_AISTRING_MAXLEN
+#	define ASSIMP_AISTRING_MAXLEN 1024
+#endif
+
 #ifdef __cplusplus
-const size_t MAXLEN = 1024;
+const size_t MAXLEN = ASSIMP_AISTRING_MAXLEN;
 #else
-#	define MAXLEN 1024
+#	define MAXLEN ASSIMP_AISTRING_MAXLEN
 #endif
 
 #include "./Compiler/pushpack1.h"
@@ -273,6 +280,18 @@ struct aiString
 		data[length] = '\0';
 	}
 
+	/** Assignment operator. Only copies the used part of the buffer,
+	 *  the implicit one would copy all MAXLEN bytes. */
+	aiString& operator = (const aiString& rOther) {
+		if (this == &rOther) {
+			return *this;
+		}
+		length = rOther.length>=MAXLEN?MAXLEN-1:rOther.length;
+		memcpy( data, rOther.data, length);
+		data[length] = '\0';
+		return *this;
+	}
+
 	/** Constructor from std::string */
 	explicit aiString(const std::string& pString) : 
 		length(pString.length()) 
@@ -282,22 +301,20 @@ struct aiString
 		data[length] = '\0';
 	}
 
-	/** Copy a std::string to the aiString */
+	/** Copy a std::string to the aiString. Longer strings are cropped
+	 *  to MAXLEN-1 characters like in the constructor. */
 	void Set( const std::string& pString) {
-		if( pString.length() > MAXLEN - 1) {
-			return;
-		}
 		length = pString.length();
+		length = length>=MAXLEN?MAXLEN-1:length;
 		memcpy( data, pString.c_str(), length);
 		data[length] = 0;
 	}
 
-	/** Copy a const char* to the aiString */
+	/** Copy a const char* to the aiString. Longer strings are cropped
+	 *  to MAXLEN-1 characters like in the constructor. */
 	void Set( const char* sz) {
-		const size_t len = ::strlen(sz);
-		if( len > MAXLEN - 1) {
-			return;
-		}
+		size_t len = ::strlen(sz);
+		len = len>=MAXLEN?MAXLEN-1:len;
 		length = len;
 		memcpy( data, sz, len);
 		data[len] = 0;
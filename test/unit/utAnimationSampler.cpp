@@ -0,0 +1,182 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <assimp/AnimationSampler.hpp>
+
+using namespace std;
+using namespace Assimp;
+
+class AnimationSamplerTest : public ::testing::Test
+{
+public:
+
+	virtual void SetUp();
+	virtual void TearDown();
+
+protected:
+
+	aiScene* pcScene;
+	aiNodeAnim* pcChannel;
+};
+
+#define NUM_KEYS 50
+
+// ------------------------------------------------------------------------------------------------
+static bool CompareMatrices(const aiMatrix4x4& a, const aiMatrix4x4& b, float epsilon = 1e-4f)
+{
+	for (unsigned int i = 0; i < 4; ++i) {
+		for (unsigned int j = 0; j < 4; ++j) {
+			if (fabs(a[i][j] - b[i][j]) > epsilon) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSamplerTest::SetUp()
+{
+	// root -> arm -> hand, the hand is 10 units away from the arm
+	pcScene = new aiScene();
+	pcScene->mRootNode = new aiNode();
+	pcScene->mRootNode->mName.Set("root");
+	aiMatrix4x4::Translation(aiVector3D(0.f,5.f,0.f),pcScene->mRootNode->mTransformation);
+
+	aiNode* pcArm = new aiNode();
+	pcArm->mName.Set("arm");
+	pcArm->mParent = pcScene->mRootNode;
+	pcScene->mRootNode->mNumChildren = 1;
+	pcScene->mRootNode->mChildren = new aiNode*[1];
+	pcScene->mRootNode->mChildren[0] = pcArm;
+
+	aiNode* pcHand = new aiNode();
+	pcHand->mName.Set("hand");
+	pcHand->mParent = pcArm;
+	aiMatrix4x4::Translation(aiVector3D(10.f,0.f,0.f),pcHand->mTransformation);
+	pcArm->mNumChildren = 1;
+	pcArm->mChildren = new aiNode*[1];
+	pcArm->mChildren[0] = pcHand;
+
+	// the arm moves along a curve and rotates about z, one key per tick
+	pcChannel = new aiNodeAnim();
+	pcChannel->mNodeName.Set("arm");
+	pcChannel->mNumPositionKeys = pcChannel->mNumRotationKeys = NUM_KEYS;
+	pcChannel->mPositionKeys = new aiVectorKey[NUM_KEYS];
+	pcChannel->mRotationKeys = new aiQuatKey[NUM_KEYS];
+	for (unsigned int i = 0; i < NUM_KEYS;++i)
+	{
+		pcChannel->mPositionKeys[i].mTime = pcChannel->mRotationKeys[i].mTime = (double)i;
+		pcChannel->mPositionKeys[i].mValue = aiVector3D((float)i,sin(i*0.5f),0.f);
+		pcChannel->mRotationKeys[i].mValue = aiQuaternion(aiVector3D(0.f,0.f,1.f),AI_DEG_TO_RAD((float)i));
+	}
+	pcChannel->mNumScalingKeys = 2;
+	pcChannel->mScalingKeys = new aiVectorKey[2];
+	pcChannel->mScalingKeys[0].mValue = pcChannel->mScalingKeys[1].mValue = aiVector3D(2.f,2.f,2.f);
+	pcChannel->mScalingKeys[0].mTime = 0.0;
+	pcChannel->mScalingKeys[1].mTime = NUM_KEYS-1;
+
+	pcScene->mNumAnimations = 1;
+	pcScene->mAnimations = new aiAnimation*[1];
+	pcScene->mAnimations[0] = new aiAnimation();
+	pcScene->mAnimations[0]->mTicksPerSecond = 10.0;
+	pcScene->mAnimations[0]->mDuration = NUM_KEYS-1;
+	pcScene->mAnimations[0]->mNumChannels = 1;
+	pcScene->mAnimations[0]->mChannels = new aiNodeAnim*[1];
+	pcScene->mAnimations[0]->mChannels[0] = pcChannel;
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnimationSamplerTest::TearDown()
+{
+	delete pcScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(AnimationSamplerTest, testHierarchy)
+{
+	AnimationSampler sampler(pcScene);
+
+	ASSERT_EQ(3U, sampler.GetNumNodes());
+	EXPECT_EQ(0U, sampler.FindNodeIndex("root"));
+	EXPECT_EQ(1U, sampler.FindNodeIndex("arm"));
+	EXPECT_EQ(2U, sampler.FindNodeIndex("hand"));
+	EXPECT_EQ(UINT_MAX, sampler.FindNodeIndex("foot"));
+	EXPECT_EQ(UINT_MAX, sampler.GetParentIndex(0));
+	EXPECT_EQ(0U, sampler.GetParentIndex(1));
+	EXPECT_EQ(1U, sampler.GetParentIndex(2));
+	EXPECT_EQ(pcScene->mRootNode->mChildren[0], sampler.GetNode(1));
+
+	// before the first evaluation, the bind pose is returned
+	const aiMatrix4x4 hand = pcScene->mRootNode->mTransformation *
+		pcScene->mRootNode->mChildren[0]->mChildren[0]->mTransformation;
+	EXPECT_TRUE(CompareMatrices(hand, sampler.GetGlobalTransforms()[2]));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(AnimationSamplerTest, testInterpolation)
+{
+	AnimationSampler sampler(pcScene);
+
+	// 1.25 seconds are 12.5 ticks, halfway between two keys
+	sampler.Evaluate(1.25);
+
+	const aiVector3D position = (pcChannel->mPositionKeys[12].mValue + pcChannel->mPositionKeys[13].mValue) * 0.5f;
+	aiMatrix4x4 rotation, scaling, translation;
+	aiMatrix4x4::RotationZ(AI_DEG_TO_RAD(12.5f),rotation);
+	aiMatrix4x4::Scaling(aiVector3D(2.f,2.f,2.f),scaling);
+	aiMatrix4x4::Translation(position,translation);
+
+	const aiMatrix4x4 arm = translation * rotation * scaling;
+	EXPECT_TRUE(CompareMatrices(arm, sampler.GetLocalTransforms()[1]));
+
+	const aiMatrix4x4 hand = pcScene->mRootNode->mTransformation * arm *
+		pcScene->mRootNode->mChildren[0]->mChildren[0]->mTransformation;
+	EXPECT_TRUE(CompareMatrices(hand, sampler.GetGlobalTransforms()[2]));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(AnimationSamplerTest, testSequentialAndRandomAccess)
+{
+	AnimationSampler sequential(pcScene), random(pcScene);
+
+	// play forwards in small steps and jump around with the second sampler
+	for (unsigned int i = 0; i < 500; ++i)
+	{
+		const double time = i * 0.01;
+		sequential.Evaluate(time);
+		random.Evaluate(((i * 7919) % 500) * 0.01);
+		random.Evaluate(time);
+
+		for (unsigned int n = 0; n < 3; ++n) {
+			EXPECT_TRUE(CompareMatrices(sequential.GetGlobalTransforms()[n], random.GetGlobalTransforms()[n]));
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(AnimationSamplerTest, testPrePostStates)
+{
+	AnimationSampler sampler(pcScene);
+	const aiMatrix4x4* local = sampler.GetLocalTransforms();
+
+	// the default behaviour takes the transformation of the node
+	sampler.Evaluate(-1.0);
+	EXPECT_TRUE(CompareMatrices(aiMatrix4x4(),local[1]));
+
+	pcChannel->mPreState = aiAnimBehaviour_CONSTANT;
+	pcChannel->mPostState = aiAnimBehaviour_LINEAR;
+	sampler.Evaluate(-1.0);
+	EXPECT_FLOAT_EQ(0.f, local[1].a4);
+	EXPECT_FLOAT_EQ(0.f, local[1].b4);
+
+	// extrapolated from the last two keys
+	sampler.Evaluate(5.9);
+	EXPECT_NEAR(59.f, local[1].a4, 1e-3f);
+
+	// repeating takes the time modulo the key range
+	pcChannel->mPostState = aiAnimBehaviour_REPEAT;
+	sampler.Evaluate(4.9 + 0.25);
+	EXPECT_NEAR(pcChannel->mPositionKeys[2].mValue.x + 0.5f, local[1].a4, 1e-3f);
+	EXPECT_NEAR((pcChannel->mPositionKeys[2].mValue.y + pcChannel->mPositionKeys[3].mValue.y) * 0.5f, local[1].b4, 1e-3f);
+}
@@ -0,0 +1,222 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/Exporter.hpp>
+#include <assbin_chunks.h>
+
+#include <algorithm>
+
+#if !defined(ASSIMP_BUILD_NO_EXPORT) && !defined(ASSIMP_BUILD_NO_ASSBIN_EXPORTER) && !defined(ASSIMP_BUILD_NO_ASSBIN_IMPORTER)
+
+using namespace Assimp;
+
+static const char* const SourceFile = "../../test/models/X/Testwuson.X";
+static const char* const StoredFile = "assbin_test_stored.assbin";
+static const char* const PackedFile = "assbin_test_packed.assbin";
+static const char* const DamagedFile = "assbin_test_damaged.assbin";
+
+class AssbinTest : public ::testing::Test
+{
+public:
+
+	virtual void SetUp() {
+		source = importer.ReadFile(SourceFile,aiProcess_Triangulate);
+		ASSERT_TRUE(NULL != source);
+
+		Exporter exporter;
+		ASSERT_EQ(AI_SUCCESS, exporter.Export(source,"assbin",StoredFile));
+
+		ExportProperties props;
+		props.SetPropertyBool(AI_CONFIG_EXPORT_ASSBIN_COMPRESS,true);
+		ASSERT_EQ(AI_SUCCESS, exporter.Export(source,"assbin",PackedFile,0,&props));
+	}
+
+	virtual void TearDown() {
+		remove(StoredFile);
+		remove(PackedFile);
+		remove(DamagedFile);
+	}
+
+protected:
+
+	void CompareMeshes(const aiScene* scene) {
+		ASSERT_EQ(source->mNumMeshes, scene->mNumMeshes);
+		for (unsigned int i = 0; i < source->mNumMeshes; ++i) {
+			const aiMesh* a = source->mMeshes[i], *b = scene->mMeshes[i];
+			ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+			ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+			EXPECT_EQ(a->mNumBones, b->mNumBones);
+
+			EXPECT_EQ(0, memcmp(a->mVertices, b->mVertices, a->mNumVertices*sizeof(aiVector3D)));
+			ASSERT_EQ(a->HasNormals(), b->HasNormals());
+			if (a->HasNormals()) {
+				EXPECT_EQ(0, memcmp(a->mNormals, b->mNormals, a->mNumVertices*sizeof(aiVector3D)));
+			}
+			ASSERT_EQ(a->HasTextureCoords(0), b->HasTextureCoords(0));
+			if (a->HasTextureCoords(0)) {
+				EXPECT_EQ(0, memcmp(a->mTextureCoords[0], b->mTextureCoords[0], a->mNumVertices*sizeof(aiVector3D)));
+			}
+
+			for (unsigned int f = 0; f < a->mNumFaces; ++f) {
+				ASSERT_EQ(a->mFaces[f].mNumIndices, b->mFaces[f].mNumIndices);
+				EXPECT_EQ(0, memcmp(a->mFaces[f].mIndices, b->mFaces[f].mIndices, a->mFaces[f].mNumIndices*sizeof(unsigned int)));
+			}
+		}
+	}
+
+	void CompareNodes(const aiNode* a, const aiNode* b) {
+		EXPECT_STREQ(a->mName.data, b->mName.data);
+		EXPECT_TRUE(a->mTransformation == b->mTransformation);
+		ASSERT_EQ(a->mNumMeshes, b->mNumMeshes);
+		EXPECT_EQ(0, memcmp(a->mMeshes, b->mMeshes, a->mNumMeshes*sizeof(unsigned int)));
+		ASSERT_EQ(a->mNumChildren, b->mNumChildren);
+		for (unsigned int i = 0; i < a->mNumChildren; ++i) {
+			EXPECT_EQ(b, b->mChildren[i]->mParent);
+			CompareNodes(a->mChildren[i], b->mChildren[i]);
+		}
+	}
+
+	Importer importer;
+	const aiScene* source;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Chunk headers must be read in release builds as well
+TEST_F(AssbinTest, testRoundTrip)
+{
+	Importer imp;
+	const aiScene* scene = imp.ReadFile(StoredFile,aiProcess_ValidateDataStructure);
+	ASSERT_TRUE(NULL != scene);
+	CompareMeshes(scene);
+	CompareNodes(source->mRootNode, scene->mRootNode);
+
+	ASSERT_EQ(source->mNumMaterials, scene->mNumMaterials);
+	for (unsigned int i = 0; i < source->mNumMaterials; ++i) {
+		EXPECT_EQ(source->mMaterials[i]->mNumProperties, scene->mMaterials[i]->mNumProperties);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(AssbinTest, testDamagedFile)
+{
+	FILE* in = fopen(StoredFile,"rb");
+	ASSERT_TRUE(NULL != in);
+	fseek(in,0,SEEK_END);
+	std::vector<char> data(ftell(in));
+	fseek(in,0,SEEK_SET);
+	ASSERT_EQ(1U, fread(&data[0],data.size(),1,in));
+	fclose(in);
+
+	// the structure of the scene follows the header and the sizes of the blob table
+	uint32_t chunk;
+	memcpy(&chunk,&data[ASSBIN_HEADER_LENGTH + 16],4);
+	ASSERT_EQ(static_cast<uint32_t>(ASSBIN_CHUNK_AISCENE), chunk);
+	chunk = ASSBIN_CHUNK_AIMESH;
+	memcpy(&data[ASSBIN_HEADER_LENGTH + 16],&chunk,4);
+
+	FILE* out = fopen(DamagedFile,"wb");
+	ASSERT_TRUE(NULL != out);
+	fwrite(&data[0],data.size(),1,out);
+	fclose(out);
+
+	Importer imp;
+	EXPECT_TRUE(NULL == imp.ReadFile(DamagedFile,0));
+	EXPECT_TRUE(NULL != strstr(imp.GetErrorString(),"damaged"));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Stored string lengths of MAXLEN or more would overflow aiString::data
+TEST_F(AssbinTest, testStringTooLong)
+{
+	FILE* in = fopen(StoredFile,"rb");
+	ASSERT_TRUE(NULL != in);
+	fseek(in,0,SEEK_END);
+	std::vector<char> data(ftell(in));
+	fseek(in,0,SEEK_SET);
+	ASSERT_EQ(1U, fread(&data[0],data.size(),1,in));
+	fclose(in);
+
+	// strings are stored as their length followed by the characters, find the root node name
+	const aiString& name = source->mRootNode->mName;
+	ASSERT_LT(0U, name.length);
+	const uint32_t length = static_cast<uint32_t>(name.length);
+
+	std::vector<char> pattern(4 + name.length);
+	memcpy(&pattern[0],&length,4);
+	memcpy(&pattern[4],name.data,name.length);
+
+	std::vector<char>::iterator it = std::search(data.begin(),data.end(),pattern.begin(),pattern.end());
+	ASSERT_TRUE(it != data.end());
+
+	const uint32_t damaged = static_cast<uint32_t>(MAXLEN);
+	memcpy(&*it,&damaged,4);
+
+	FILE* out = fopen(DamagedFile,"wb");
+	ASSERT_TRUE(NULL != out);
+	fwrite(&data[0],data.size(),1,out);
+	fclose(out);
+
+	Importer imp;
+	EXPECT_TRUE(NULL == imp.ReadFile(DamagedFile,0));
+	EXPECT_TRUE(NULL != strstr(imp.GetErrorString(),"string too long"));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(AssbinTest, testZeroCopy)
+{
+	Importer imp;
+	const aiScene* scene = imp.ReadFile(StoredFile,0);
+	ASSERT_TRUE(NULL != scene);
+	CompareMeshes(scene);
+
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		EXPECT_NE(0U, scene->mMeshes[i]->mExternalData);
+	}
+
+	// copies own their data
+	aiScene* copy = NULL;
+	aiCopyScene(scene,&copy);
+	ASSERT_TRUE(NULL != copy);
+	EXPECT_EQ(0U, copy->mMeshes[0]->mExternalData);
+	aiFreeScene(copy);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(AssbinTest, testCompressed)
+{
+	FILE* stored = fopen(StoredFile,"rb"), *packed = fopen(PackedFile,"rb");
+	ASSERT_TRUE(NULL != stored && NULL != packed);
+	fseek(stored,0,SEEK_END);
+	fseek(packed,0,SEEK_END);
+	EXPECT_LT(ftell(packed), ftell(stored));
+	fclose(stored);
+	fclose(packed);
+
+	Importer imp;
+	const aiScene* scene = imp.ReadFile(PackedFile,0);
+	ASSERT_TRUE(NULL != scene);
+	CompareMeshes(scene);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(AssbinTest, testCopiedData)
+{
+	Importer imp;
+	imp.SetPropertyBool(AI_CONFIG_IMPORT_ASSBIN_ZERO_COPY,false);
+	const aiScene* scene = imp.ReadFile(StoredFile,0);
+	ASSERT_TRUE(NULL != scene);
+	CompareMeshes(scene);
+	EXPECT_EQ(0U, scene->mMeshes[0]->mExternalData);
+
+	// post-processing works on a private copy of the data
+	Importer pp;
+	scene = pp.ReadFile(StoredFile,aiProcess_JoinIdenticalVertices | aiProcess_GenSmoothNormals);
+	ASSERT_TRUE(NULL != scene);
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		EXPECT_EQ(0U, scene->mMeshes[i]->mExternalData);
+	}
+}
+
+#endif
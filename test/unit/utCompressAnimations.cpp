@@ -0,0 +1,158 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <CompressAnimationsProcess.h>
+
+using namespace std;
+using namespace Assimp;
+
+class CompressAnimationsTest : public ::testing::Test
+{
+public:
+
+	virtual void SetUp();
+	virtual void TearDown();
+
+protected:
+
+	CompressAnimationsProcess* piProcess;
+	aiScene* pcScene;
+	aiNodeAnim* pcChannel;
+};
+
+#define NUM_KEYS 181
+
+// ------------------------------------------------------------------------------------------------
+void CompressAnimationsTest::SetUp()
+{
+	piProcess = new CompressAnimationsProcess();
+	piProcess->SetErrorLimits(0.01f,0.1f,0.01f,false);
+
+	// root -> arm -> hand, the hand is 100 units away from the arm
+	pcScene = new aiScene();
+	pcScene->mRootNode = new aiNode();
+	pcScene->mRootNode->mName.Set("root");
+
+	aiNode* pcArm = new aiNode();
+	pcArm->mName.Set("arm");
+	pcArm->mParent = pcScene->mRootNode;
+	pcScene->mRootNode->mNumChildren = 1;
+	pcScene->mRootNode->mChildren = new aiNode*[1];
+	pcScene->mRootNode->mChildren[0] = pcArm;
+
+	aiNode* pcHand = new aiNode();
+	pcHand->mName.Set("hand");
+	pcHand->mParent = pcArm;
+	aiMatrix4x4::Translation(aiVector3D(100.f,0.f,0.f),pcHand->mTransformation);
+	pcArm->mNumChildren = 1;
+	pcArm->mChildren = new aiNode*[1];
+	pcArm->mChildren[0] = pcHand;
+
+	// the arm moves on a straight line, rotates about z with constant
+	// speed and keeps its scaling.
+	pcChannel = new aiNodeAnim();
+	pcChannel->mNodeName.Set("arm");
+	pcChannel->mNumPositionKeys = pcChannel->mNumRotationKeys = pcChannel->mNumScalingKeys = NUM_KEYS;
+	pcChannel->mPositionKeys = new aiVectorKey[NUM_KEYS];
+	pcChannel->mRotationKeys = new aiQuatKey[NUM_KEYS];
+	pcChannel->mScalingKeys = new aiVectorKey[NUM_KEYS];
+	for (unsigned int i = 0; i < NUM_KEYS;++i)
+	{
+		pcChannel->mPositionKeys[i].mTime = pcChannel->mRotationKeys[i].mTime = pcChannel->mScalingKeys[i].mTime = i;
+		pcChannel->mPositionKeys[i].mValue = aiVector3D(i * 0.5f,i * -0.25f,1.f);
+		pcChannel->mRotationKeys[i].mValue = aiQuaternion(aiVector3D(0.f,0.f,1.f),AI_DEG_TO_RAD(i * 0.5f));
+		pcChannel->mScalingKeys[i].mValue = aiVector3D(1.f,1.f,1.f);
+	}
+
+	pcScene->mNumAnimations = 1;
+	pcScene->mAnimations = new aiAnimation*[1];
+	pcScene->mAnimations[0] = new aiAnimation();
+	pcScene->mAnimations[0]->mNumChannels = 1;
+	pcScene->mAnimations[0]->mChannels = new aiNodeAnim*[1];
+	pcScene->mAnimations[0]->mChannels[0] = pcChannel;
+	pcScene->mAnimations[0]->mDuration = NUM_KEYS - 1;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CompressAnimationsTest::TearDown()
+{
+	delete piProcess;
+	delete pcScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CompressAnimationsTest, testLinearTracks)
+{
+	piProcess->Execute(pcScene);
+
+	ASSERT_EQ(2U, pcChannel->mNumPositionKeys);
+	EXPECT_EQ(0., pcChannel->mPositionKeys[0].mTime);
+	EXPECT_EQ(NUM_KEYS - 1., pcChannel->mPositionKeys[1].mTime);
+
+	// 90 degrees, can be restored by slerp from the first and the last key
+	EXPECT_EQ(2U, pcChannel->mNumRotationKeys);
+
+	// a constant track is collapsed to a single key
+	ASSERT_EQ(1U, pcChannel->mNumScalingKeys);
+	EXPECT_EQ(aiVector3D(1.f,1.f,1.f), pcChannel->mScalingKeys[0].mValue);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CompressAnimationsTest, testErrorBound)
+{
+	aiVector3D pvOld[NUM_KEYS];
+	for (unsigned int i = 0; i < NUM_KEYS;++i)
+	{
+		pvOld[i] = pcChannel->mPositionKeys[i].mValue = aiVector3D(std::sin(i * 0.05f),0.f,0.f);
+	}
+
+	piProcess->Execute(pcScene);
+	EXPECT_LT(pcChannel->mNumPositionKeys, NUM_KEYS / 4U);
+
+	// all original keys must be restorable from the remaining ones
+	unsigned int n = 0;
+	for (unsigned int i = 0; i < NUM_KEYS;++i)
+	{
+		while (pcChannel->mPositionKeys[n+1].mTime < i) {
+			++n;
+		}
+		const aiVectorKey& a = pcChannel->mPositionKeys[n];
+		const aiVectorKey& b = pcChannel->mPositionKeys[n+1];
+		const float f = (float)((i - a.mTime) / (b.mTime - a.mTime));
+		const aiVector3D v = a.mValue + (b.mValue - a.mValue) * f;
+		EXPECT_LE((v - pvOld[i]).Length(), 0.01f);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CompressAnimationsTest, testPropagatedError)
+{
+	// add some jitter well below the rotation error, which still moves
+	// the hand by far more than the position error.
+	for (unsigned int i = 0; i < NUM_KEYS;++i)
+	{
+		pcChannel->mRotationKeys[i].mValue = aiQuaternion(aiVector3D(0.f,0.f,1.f),
+			AI_DEG_TO_RAD((i * 0.5f + (i % 2 ? 0.02f : -0.02f))));
+	}
+
+	aiScene* pcCopy = new aiScene();
+	pcCopy->mNumAnimations = 1;
+	pcCopy->mAnimations = new aiAnimation*[1];
+	pcCopy->mAnimations[0] = new aiAnimation();
+	pcCopy->mAnimations[0]->mNumChannels = 1;
+	pcCopy->mAnimations[0]->mChannels = new aiNodeAnim*[1];
+	aiNodeAnim* pcCopyChannel = pcCopy->mAnimations[0]->mChannels[0] = new aiNodeAnim();
+	pcCopyChannel->mNodeName = pcChannel->mNodeName;
+	pcCopyChannel->mNumRotationKeys = NUM_KEYS;
+	pcCopyChannel->mRotationKeys = new aiQuatKey[NUM_KEYS];
+	std::copy(pcChannel->mRotationKeys,pcChannel->mRotationKeys + NUM_KEYS,pcCopyChannel->mRotationKeys);
+
+	// without a node hierarchy, only the rotation error counts
+	piProcess->SetErrorLimits(0.01f,0.1f,0.01f,true);
+	piProcess->Execute(pcCopy);
+	EXPECT_EQ(2U, pcCopyChannel->mNumRotationKeys);
+	delete pcCopy;
+
+	piProcess->Execute(pcScene);
+	EXPECT_EQ(NUM_KEYS, pcChannel->mNumRotationKeys);
+}
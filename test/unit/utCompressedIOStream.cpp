@@ -0,0 +1,198 @@
+#include "UnitTestPCH.h"
+
+#include <CompressedIOStream.h>
+#include <MemoryIOWrapper.h>
+#include "../../include/assimp/Importer.hpp"
+#include "../../include/assimp/scene.h"
+
+
+using namespace std;
+using namespace Assimp;
+
+class CompressedIOStreamTest : public ::testing::Test
+{
+public:
+
+	virtual void SetUp()
+	{
+		pImp = new Importer();
+		pIO = pImp->GetIOHandler();
+	}
+
+	virtual void TearDown()
+	{
+		delete pImp;
+	}
+
+	// read a whole stream in one go
+	void readAll(IOStream* stream, std::vector<char>& out)
+	{
+		out.resize(stream->FileSize());
+		EXPECT_EQ(1U, stream->Read(&out[0], out.size(), 1));
+	}
+
+protected:
+
+	Importer* pImp;
+	IOSystem* pIO;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CompressedIOStreamTest, testReadAndSeek)
+{
+	std::vector<char> raw, inflated;
+
+	IOStream* rawStream = pIO->Open("../../test/models/PLY/Wuson.ply");
+	ASSERT_TRUE(NULL != rawStream);
+	readAll(rawStream, raw);
+	pIO->Close(rawStream);
+
+	IOStream* gz = pIO->Open("../../test/models/PLY/Wuson.ply.gz");
+	ASSERT_TRUE(NULL != gz);
+	ASSERT_TRUE(CompressedIOStream::IsCompressed(gz));
+
+	// the uncompressed size is determined on demand
+	CompressedIOStream stream(gz, pIO);
+	EXPECT_EQ(CompressedIOStream::UnknownSize, stream.GetKnownSize());
+	ASSERT_EQ(raw.size(), stream.FileSize());
+	ASSERT_GT(stream.FileSize(), CompressedIOStream::BlockSize);
+
+	readAll(&stream, inflated);
+	EXPECT_TRUE(raw == inflated);
+	EXPECT_EQ(0U, stream.Read(&inflated[0], 1, 1));
+
+	// backward seek across block boundaries restarts decompression
+	char buffer[1000];
+	const size_t ofs = CompressedIOStream::BlockSize - 500;
+	EXPECT_EQ(aiReturn_SUCCESS, stream.Seek(ofs, aiOrigin_SET));
+	EXPECT_EQ(1000U, stream.Read(buffer, 1, 1000));
+	EXPECT_EQ(0, memcmp(buffer, &raw[ofs], 1000));
+	EXPECT_EQ(ofs + 1000, stream.Tell());
+
+	EXPECT_EQ(aiReturn_SUCCESS, stream.Seek(100, aiOrigin_SET));
+	EXPECT_EQ(1000U, stream.Read(buffer, 1, 1000));
+	EXPECT_EQ(0, memcmp(buffer, &raw[100], 1000));
+
+	EXPECT_EQ(aiReturn_FAILURE, stream.Seek(raw.size() + 1, aiOrigin_SET));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CompressedIOStreamTest, testMultipleMembers)
+{
+	std::vector<char> raw, gz, inflated;
+
+	IOStream* rawStream = pIO->Open("../../test/models/PLY/Wuson.ply");
+	ASSERT_TRUE(NULL != rawStream);
+	readAll(rawStream, raw);
+	pIO->Close(rawStream);
+
+	IOStream* gzStream = pIO->Open("../../test/models/PLY/Wuson.ply.gz");
+	ASSERT_TRUE(NULL != gzStream);
+	readAll(gzStream, gz);
+	pIO->Close(gzStream);
+
+	// concatenated gzip files are valid, their trailers only hold the size of the last member
+	const size_t half = gz.size();
+	gz.resize(half * 2);
+	std::copy(gz.begin(), gz.begin() + half, gz.begin() + half);
+
+	CompressedIOStream stream(new MemoryIOStream(reinterpret_cast<const uint8_t*>(&gz[0]), gz.size()));
+	ASSERT_EQ(raw.size() * 2, stream.FileSize());
+
+	readAll(&stream, inflated);
+	EXPECT_TRUE(std::equal(raw.begin(), raw.end(), inflated.begin()));
+	EXPECT_TRUE(std::equal(raw.begin(), raw.end(), inflated.begin() + raw.size()));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CompressedIOStreamTest, testSizeFromTrailer)
+{
+	std::vector<char> gz;
+
+	IOStream* gzStream = pIO->Open("../../test/models/PLY/Wuson.ply.gz");
+	ASSERT_TRUE(NULL != gzStream);
+	readAll(gzStream, gz);
+	pIO->Close(gzStream);
+
+	// a single member file takes the size from its trailer without inflating,
+	// a trailer which doesn't match the data shows it is used as is
+	ASSERT_GT(gz.size(), 4U);
+	gz[gz.size() - 4] = 0x2a;
+	gz[gz.size() - 3] = gz[gz.size() - 2] = gz[gz.size() - 1] = 0;
+
+	CompressedIOStream stream(new MemoryIOStream(reinterpret_cast<const uint8_t*>(&gz[0]), gz.size()));
+	EXPECT_EQ(42U, stream.FileSize());
+	EXPECT_EQ(0U, stream.Tell());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CompressedIOStreamTest, testIOSystem)
+{
+	CompressedIOSystem io(pIO);
+
+	// the compressed file is found in place of the missing uncompressed one
+	EXPECT_TRUE(io.Exists("../../test/models/PLY/cube.ply"));
+	EXPECT_TRUE(io.Exists("../../test/models/PLY/Wuson.ply"));
+	EXPECT_FALSE(io.Exists("../../test/models/PLY/missing.ply"));
+
+	std::string stripped;
+	EXPECT_TRUE(CompressedIOSystem::HasCompressedSuffix("a/b.ply.GZ", &stripped));
+	EXPECT_EQ("a/b.ply", stripped);
+	EXPECT_FALSE(CompressedIOSystem::HasCompressedSuffix("a/b.tgz"));
+	EXPECT_FALSE(CompressedIOSystem::HasCompressedSuffix(".gz"));
+
+	// uncompressed files are passed through
+	IOStream* stream = io.Open("../../test/models/PLY/cube.ply");
+	ASSERT_TRUE(NULL != stream);
+	EXPECT_EQ(352U, stream->FileSize());
+	io.Close(stream);
+
+	stream = io.Open("../../test/models/PLY/Wuson.ply.gz");
+	ASSERT_TRUE(NULL != stream);
+	EXPECT_EQ(CompressedIOStream::UnknownSize, static_cast<CompressedIOStream*>(stream)->GetKnownSize());
+	EXPECT_EQ(915754U, stream->FileSize());
+	io.Close(stream);
+
+	// the size is remembered, the file isn't inflated again to count it
+	stream = io.Open("../../test/models/PLY/Wuson.ply.gz");
+	ASSERT_TRUE(NULL != stream);
+	EXPECT_EQ(915754U, static_cast<CompressedIOStream*>(stream)->GetKnownSize());
+	io.Close(stream);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CompressedIOStreamTest, testSizeWhileReading)
+{
+	std::vector<char> raw, inflated;
+
+	IOStream* rawStream = pIO->Open("../../test/models/PLY/Wuson.ply");
+	ASSERT_TRUE(NULL != rawStream);
+	readAll(rawStream, raw);
+	pIO->Close(rawStream);
+
+	IOStream* gz = pIO->Open("../../test/models/PLY/Wuson.ply.gz");
+	ASSERT_TRUE(NULL != gz);
+	CompressedIOStream stream(gz, pIO);
+
+	// read across some blocks before asking for the size, reading continues where it was
+	const size_t first = CompressedIOStream::BlockSize * 2 + 100;
+	inflated.resize(raw.size());
+	ASSERT_EQ(first, stream.Read(&inflated[0], 1, first));
+	EXPECT_EQ(raw.size(), stream.FileSize());
+	EXPECT_EQ(first, stream.Tell());
+	ASSERT_EQ(raw.size() - first, stream.Read(&inflated[first], 1, raw.size() - first));
+	EXPECT_TRUE(raw == inflated);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CompressedIOStreamTest, testImportCompressed)
+{
+	const aiScene* scene = pImp->ReadFile("../../test/models/PLY/Wuson.ply", 0);
+	ASSERT_TRUE(NULL != scene);
+	const unsigned int numVertices = scene->mMeshes[0]->mNumVertices;
+
+	scene = pImp->ReadFile("../../test/models/PLY/Wuson.ply.gz", 0);
+	ASSERT_TRUE(NULL != scene);
+	ASSERT_EQ(1U, scene->mNumMeshes);
+	EXPECT_EQ(numVertices, scene->mMeshes[0]->mNumVertices);
+}
@@ -2,6 +2,8 @@
 
 #include <assimp/cexport.h>
 #include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
 
 
 #ifndef ASSIMP_BUILD_NO_EXPORT
@@ -81,4 +83,32 @@ TEST_F(ExporterTest, testCExportInterface)
 	}
 }
 
+// ------------------------------------------------------------------------------------------------
+TEST_F(ExporterTest, testExportMany)
+{
+	Assimp::Exporter::ExportRequest requests[] = {
+		Assimp::Exporter::ExportRequest("obj", "unittest_many.obj"),
+		Assimp::Exporter::ExportRequest("stl", "unittest_many.stl"),
+		Assimp::Exporter::ExportRequest("ply", "unittest_many.ply"),
+		Assimp::Exporter::ExportRequest("collada", "unittest_many.dae"),
+		Assimp::Exporter::ExportRequest("assbin", "unittest_many.assbin"),
+		Assimp::Exporter::ExportRequest("no_such_format", "unittest_many.bad")
+	};
+	const size_t count = sizeof(requests) / sizeof(requests[0]);
+
+	EXPECT_EQ(AI_FAILURE, ex->ExportMany(pTest, requests, count));
+	EXPECT_STREQ(requests[count-1].mError.c_str(), ex->GetErrorString());
+	EXPECT_EQ(AI_FAILURE, requests[count-1].mResult);
+
+	for (size_t i = 0; i < count - 1; ++i) {
+		EXPECT_EQ(AI_SUCCESS, requests[i].mResult) << requests[i].mError;
+
+		// check if we can read it again
+		Assimp::Importer importer;
+		const aiScene* const scene = importer.ReadFile(requests[i].mPath, 0);
+		ASSERT_TRUE(scene) << requests[i].mPath;
+		EXPECT_EQ(pTest->mMeshes[0]->mNumFaces, scene->mMeshes[0]->mNumFaces);
+	}
+}
+
 #endif
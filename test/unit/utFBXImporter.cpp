@@ -0,0 +1,295 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/config.h>
+#include <ParallelFor.h>
+
+
+using namespace std;
+using namespace Assimp;
+
+#define FBX_BINARY_DIR "../../test/models-nonbsd/FBX/2013_BINARY/"
+
+// Two nodes, one of them with a rotation pivot, both translated by the same
+// two curves. X has keys at 0s and 2s, Y has an extra key at 1s, so the
+// converter has to interpolate X at 1s.
+static const char* const AnimatedPivotsFBX =
+	"; FBX 7.3.0 project file\n"
+	"FBXHeaderExtension:  {\n"
+	"	FBXHeaderVersion: 1003\n"
+	"	FBXVersion: 7300\n"
+	"}\n"
+	"Objects:  {\n"
+	"	Model: 100, \"Model::Plain\", \"Null\" {\n"
+	"		Version: 232\n"
+	"	}\n"
+	"	Model: 101, \"Model::Pivot\", \"Null\" {\n"
+	"		Version: 232\n"
+	"		Properties70:  {\n"
+	"			P: \"RotationPivot\", \"Vector3D\", \"Vector\", \"\",1,0,0\n"
+	"		}\n"
+	"	}\n"
+	"	AnimationStack: 200, \"AnimStack::Take 001\", \"\" {\n"
+	"		Properties70:  {\n"
+	"			P: \"LocalStop\", \"KTime\", \"Time\", \"\",92372316000\n"
+	"		}\n"
+	"	}\n"
+	"	AnimationLayer: 300, \"AnimLayer::Base Layer\", \"\" {\n"
+	"	}\n"
+	"	AnimationCurveNode: 400, \"AnimCurveNode::T\", \"\" {\n"
+	"		Properties70:  {\n"
+	"			P: \"d|X\", \"Number\", \"\", \"A\",0\n"
+	"			P: \"d|Y\", \"Number\", \"\", \"A\",0\n"
+	"			P: \"d|Z\", \"Number\", \"\", \"A\",0\n"
+	"		}\n"
+	"	}\n"
+	"	AnimationCurveNode: 401, \"AnimCurveNode::T\", \"\" {\n"
+	"		Properties70:  {\n"
+	"			P: \"d|X\", \"Number\", \"\", \"A\",0\n"
+	"			P: \"d|Y\", \"Number\", \"\", \"A\",0\n"
+	"			P: \"d|Z\", \"Number\", \"\", \"A\",0\n"
+	"		}\n"
+	"	}\n"
+	"	AnimationCurve: 500, \"AnimCurve::\", \"\" {\n"
+	"		KeyTime: *2 {\n"
+	"			a: 0,92372316000\n"
+	"		}\n"
+	"		KeyValueFloat: *2 {\n"
+	"			a: 0,10\n"
+	"		}\n"
+	"	}\n"
+	"	AnimationCurve: 501, \"AnimCurve::\", \"\" {\n"
+	"		KeyTime: *3 {\n"
+	"			a: 0,46186158000,92372316000\n"
+	"		}\n"
+	"		KeyValueFloat: *3 {\n"
+	"			a: 0,1,2\n"
+	"		}\n"
+	"	}\n"
+	"	AnimationCurve: 502, \"AnimCurve::\", \"\" {\n"
+	"		KeyTime: *2 {\n"
+	"			a: 0,92372316000\n"
+	"		}\n"
+	"		KeyValueFloat: *2 {\n"
+	"			a: 0,10\n"
+	"		}\n"
+	"	}\n"
+	"	AnimationCurve: 503, \"AnimCurve::\", \"\" {\n"
+	"		KeyTime: *3 {\n"
+	"			a: 0,46186158000,92372316000\n"
+	"		}\n"
+	"		KeyValueFloat: *3 {\n"
+	"			a: 0,1,2\n"
+	"		}\n"
+	"	}\n"
+	"}\n"
+	"Connections:  {\n"
+	"	C: \"OO\",100,0\n"
+	"	C: \"OO\",101,0\n"
+	"	C: \"OO\",300,200\n"
+	"	C: \"OO\",400,300\n"
+	"	C: \"OO\",401,300\n"
+	"	C: \"OP\",400,100, \"Lcl Translation\"\n"
+	"	C: \"OP\",401,101, \"Lcl Translation\"\n"
+	"	C: \"OP\",500,400, \"d|X\"\n"
+	"	C: \"OP\",501,400, \"d|Y\"\n"
+	"	C: \"OP\",502,401, \"d|X\"\n"
+	"	C: \"OP\",503,401, \"d|Y\"\n"
+	"}\n";
+
+class FBXImporterTest : public ::testing::Test
+{
+public:
+
+	virtual void TearDown() { SetParallelForThreads(0); }
+
+protected:
+
+	void CompareMeshes(const aiScene* a, const aiScene* b);
+	void CompareAnimations(const aiScene* a, const aiScene* b);
+	const aiNodeAnim* FindChannel(const aiScene* scene, const char* name);
+	void CheckInterpolatedKey(const aiNodeAnim* channel);
+};
+
+// ------------------------------------------------------------------------------------------------
+void FBXImporterTest::CompareMeshes(const aiScene* a, const aiScene* b)
+{
+	ASSERT_EQ(a->mNumMeshes, b->mNumMeshes);
+	for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+		const aiMesh* ma = a->mMeshes[i];
+		const aiMesh* mb = b->mMeshes[i];
+		EXPECT_STREQ(ma->mName.C_Str(), mb->mName.C_Str());
+		EXPECT_EQ(ma->mMaterialIndex, mb->mMaterialIndex);
+
+		ASSERT_EQ(ma->mNumVertices, mb->mNumVertices);
+		for (unsigned int v = 0; v < ma->mNumVertices; ++v) {
+			EXPECT_EQ(ma->mVertices[v], mb->mVertices[v]);
+		}
+		ASSERT_EQ(ma->HasNormals(), mb->HasNormals());
+		for (unsigned int v = 0; ma->HasNormals() && v < ma->mNumVertices; ++v) {
+			EXPECT_EQ(ma->mNormals[v], mb->mNormals[v]);
+		}
+
+		ASSERT_EQ(ma->mNumFaces, mb->mNumFaces);
+		for (unsigned int f = 0; f < ma->mNumFaces; ++f) {
+			ASSERT_EQ(ma->mFaces[f].mNumIndices, mb->mFaces[f].mNumIndices);
+			for (unsigned int n = 0; n < ma->mFaces[f].mNumIndices; ++n) {
+				EXPECT_EQ(ma->mFaces[f].mIndices[n], mb->mFaces[f].mIndices[n]);
+			}
+		}
+
+		ASSERT_EQ(ma->mNumBones, mb->mNumBones);
+		for (unsigned int n = 0; n < ma->mNumBones; ++n) {
+			const aiBone* ba = ma->mBones[n];
+			const aiBone* bb = mb->mBones[n];
+			EXPECT_STREQ(ba->mName.C_Str(), bb->mName.C_Str());
+			EXPECT_TRUE(ba->mOffsetMatrix == bb->mOffsetMatrix);
+
+			ASSERT_EQ(ba->mNumWeights, bb->mNumWeights);
+			for (unsigned int w = 0; w < ba->mNumWeights; ++w) {
+				EXPECT_EQ(ba->mWeights[w].mVertexId, bb->mWeights[w].mVertexId);
+				EXPECT_EQ(ba->mWeights[w].mWeight, bb->mWeights[w].mWeight);
+			}
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void FBXImporterTest::CompareAnimations(const aiScene* a, const aiScene* b)
+{
+	ASSERT_EQ(a->mNumAnimations, b->mNumAnimations);
+	for (unsigned int i = 0; i < a->mNumAnimations; ++i) {
+		const aiAnimation* aa = a->mAnimations[i];
+		const aiAnimation* ab = b->mAnimations[i];
+		EXPECT_STREQ(aa->mName.C_Str(), ab->mName.C_Str());
+		EXPECT_EQ(aa->mDuration, ab->mDuration);
+
+		ASSERT_EQ(aa->mNumChannels, ab->mNumChannels);
+		for (unsigned int c = 0; c < aa->mNumChannels; ++c) {
+			const aiNodeAnim* ca = aa->mChannels[c];
+			const aiNodeAnim* cb = ab->mChannels[c];
+			EXPECT_STREQ(ca->mNodeName.C_Str(), cb->mNodeName.C_Str());
+
+			ASSERT_EQ(ca->mNumPositionKeys, cb->mNumPositionKeys);
+			for (unsigned int k = 0; k < ca->mNumPositionKeys; ++k) {
+				EXPECT_EQ(ca->mPositionKeys[k].mTime, cb->mPositionKeys[k].mTime);
+				EXPECT_EQ(ca->mPositionKeys[k].mValue, cb->mPositionKeys[k].mValue);
+			}
+			ASSERT_EQ(ca->mNumRotationKeys, cb->mNumRotationKeys);
+			for (unsigned int k = 0; k < ca->mNumRotationKeys; ++k) {
+				EXPECT_EQ(ca->mRotationKeys[k].mTime, cb->mRotationKeys[k].mTime);
+				EXPECT_EQ(ca->mRotationKeys[k].mValue, cb->mRotationKeys[k].mValue);
+			}
+			ASSERT_EQ(ca->mNumScalingKeys, cb->mNumScalingKeys);
+			for (unsigned int k = 0; k < ca->mNumScalingKeys; ++k) {
+				EXPECT_EQ(ca->mScalingKeys[k].mTime, cb->mScalingKeys[k].mTime);
+				EXPECT_EQ(ca->mScalingKeys[k].mValue, cb->mScalingKeys[k].mValue);
+			}
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiNodeAnim* FBXImporterTest::FindChannel(const aiScene* scene, const char* name)
+{
+	for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+		const aiAnimation* anim = scene->mAnimations[i];
+		for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+			if (!strcmp(anim->mChannels[c]->mNodeName.C_Str(),name)) {
+				return anim->mChannels[c];
+			}
+		}
+	}
+	return NULL;
+}
+
+// ------------------------------------------------------------------------------------------------
+void FBXImporterTest::CheckInterpolatedKey(const aiNodeAnim* channel)
+{
+	ASSERT_EQ(3U, channel->mNumPositionKeys);
+
+	const aiVectorKey& first = channel->mPositionKeys[0];
+	const aiVectorKey& mid = channel->mPositionKeys[1];
+	const aiVectorKey& last = channel->mPositionKeys[2];
+	EXPECT_LT(first.mTime, mid.mTime);
+	EXPECT_LT(mid.mTime, last.mTime);
+
+	// X has no key of its own at 1s, it must be halfway between 0 and 10
+	EXPECT_FLOAT_EQ(5.f, mid.mValue.x);
+	EXPECT_FLOAT_EQ(1.f, mid.mValue.y);
+	EXPECT_FLOAT_EQ(0.f, mid.mValue.z);
+	EXPECT_FLOAT_EQ(10.f, last.mValue.x);
+	EXPECT_FLOAT_EQ(2.f, last.mValue.y);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Curves with different key times are merged, missing values are interpolated
+TEST_F(FBXImporterTest, testInterpolatedKeys)
+{
+	Importer imp;
+	const aiScene* scene = imp.ReadFileFromMemory(AnimatedPivotsFBX,strlen(AnimatedPivotsFBX),0,"fbx");
+	ASSERT_TRUE(NULL != scene);
+	ASSERT_EQ(1U, scene->mNumAnimations);
+
+	const aiNodeAnim* channel = FindChannel(scene,"Plain");
+	ASSERT_TRUE(NULL != channel);
+	CheckInterpolatedKey(channel);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Without pivot nodes, the whole transformation chain is baked into one channel per node
+TEST_F(FBXImporterTest, testBakedChannelsWithoutPivots)
+{
+	Importer imp;
+	imp.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS,false);
+	const aiScene* scene = imp.ReadFileFromMemory(AnimatedPivotsFBX,strlen(AnimatedPivotsFBX),0,"fbx");
+	ASSERT_TRUE(NULL != scene);
+	ASSERT_EQ(1U, scene->mNumAnimations);
+	EXPECT_EQ(2U, scene->mAnimations[0]->mNumChannels);
+
+	const aiNodeAnim* channel = FindChannel(scene,"Pivot");
+	ASSERT_TRUE(NULL != channel);
+	// the pivot is undone around the (identity) rotation, so the keys stay the same
+	CheckInterpolatedKey(channel);
+
+	channel = FindChannel(scene,"Plain");
+	ASSERT_TRUE(NULL != channel);
+	CheckInterpolatedKey(channel);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Meshes and animations are converted by several workers, the result must not depend on their number
+TEST_F(FBXImporterTest, testSameResultWithAnyNumberOfWorkers)
+{
+	static const char* const files[] = {
+		FBX_BINARY_DIR "multiple_animations_test.fbx",
+		FBX_BINARY_DIR "anims_with_full_rotations_between_keys.fbx",
+		FBX_BINARY_DIR "jeep1.fbx",
+		FBX_BINARY_DIR "cube_with_2UVs.fbx"
+	};
+
+	for (unsigned int i = 0; i < sizeof(files) / sizeof(files[0]); ++i) {
+		SCOPED_TRACE(files[i]);
+
+		SetParallelForThreads(1);
+		Importer serial;
+		const aiScene* a = serial.ReadFile(files[i],0);
+		ASSERT_TRUE(NULL != a);
+
+		SetParallelForThreads(4);
+		Importer parallel;
+		const aiScene* b = parallel.ReadFile(files[i],0);
+		ASSERT_TRUE(NULL != b);
+
+		CompareMeshes(a,b);
+		CompareAnimations(a,b);
+	}
+
+	// make sure the animation code paths are actually covered
+	Importer imp;
+	const aiScene* scene = imp.ReadFile(FBX_BINARY_DIR "multiple_animations_test.fbx",0);
+	ASSERT_TRUE(NULL != scene);
+	EXPECT_LT(1U, scene->mNumAnimations);
+}
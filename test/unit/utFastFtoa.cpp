@@ -0,0 +1,90 @@
+#include "UnitTestPCH.h"
+
+#include <fast_ftoa.h>
+#include <fast_atof.h>
+#include <TextWriter.h>
+
+#include <cstdlib>
+
+using namespace Assimp;
+
+class FastFtoaTest : public ::testing::Test
+{
+protected:
+	static std::string Format(float f)
+	{
+		char buff[AI_FAST_FTOA_BUFFER_SIZE];
+		const unsigned int len = fast_ftoa(buff,f);
+		EXPECT_EQ(strlen(buff), len);
+		return buff;
+	}
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FastFtoaTest, testShortest)
+{
+	EXPECT_EQ("0", Format(0.f));
+	EXPECT_EQ("-0", Format(-0.f));
+	EXPECT_EQ("1", Format(1.f));
+	EXPECT_EQ("-2.5", Format(-2.5f));
+	EXPECT_EQ("0.1", Format(0.1f));
+	EXPECT_EQ("100", Format(100.f));
+	EXPECT_EQ("3.1415927", Format(3.14159265f));
+	EXPECT_EQ("0.00001", Format(1e-5f));
+	EXPECT_EQ("1.5e-06", Format(1.5e-6f));
+	EXPECT_EQ("1e+09", Format(1e9f));
+	EXPECT_EQ("3.4028235e+38", Format(3.4028235e38f));
+	EXPECT_EQ("inf", Format(std::numeric_limits<float>::infinity()));
+	EXPECT_EQ("nan", Format(std::numeric_limits<float>::quiet_NaN()));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FastFtoaTest, testRoundTrip)
+{
+	srand(42);
+	for (unsigned int i = 0; i < 100000; ++i) {
+		uint32_t bits = static_cast<uint32_t>(rand()) * 2654435761u ^ static_cast<uint32_t>(rand());
+		float f;
+		memcpy(&f,&bits,4);
+		if (f != f || std::abs(f) == std::numeric_limits<float>::infinity()) {
+			continue;
+		}
+		EXPECT_EQ(f, static_cast<float>(strtod(Format(f).c_str(),NULL)));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FastFtoaTest, testDouble)
+{
+	char buff[AI_FAST_FTOA_BUFFER_SIZE];
+	fast_dtoa(buff,0.5);
+	EXPECT_STREQ("0.5", buff);
+
+	const double d = 0.1;
+	fast_dtoa(buff,d);
+	EXPECT_EQ(d, fast_atod(buff));
+}
+
+// ------------------------------------------------------------------------------------------------
+struct IndexFormatter
+{
+	void operator() (TextWriter& out, size_t i) const {
+		out << static_cast<unsigned int>(i) << '\n';
+	}
+};
+
+TEST_F(FastFtoaTest, testWriteParallel)
+{
+	// enough items for several batches of chunks, the output must still be in order
+	const size_t count = 70 * AI_TEXTWRITER_PARALLEL_CHUNK + 5;
+
+	TextWriter parallel, serial;
+	IndexFormatter fmt;
+	WriteParallel(parallel,count,fmt);
+	for (size_t i = 0; i < count; ++i) {
+		fmt(serial,i);
+	}
+
+	ASSERT_EQ(serial.GetSize(), parallel.GetSize());
+	EXPECT_EQ(0, memcmp(serial.GetData(),parallel.GetData(),serial.GetSize()));
+}
@@ -0,0 +1,119 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <FindInstancesProcess.h>
+
+
+using namespace std;
+using namespace Assimp;
+
+class FindInstancesProcessTest : public ::testing::Test
+{
+public:
+
+	virtual void SetUp();
+	virtual void TearDown();
+
+protected:
+
+	FindInstancesProcess* piProcess;
+	aiScene* pcScene;
+	aiMatrix4x4 mTransform;
+};
+
+// ------------------------------------------------------------------------------------------------
+void FindInstancesProcessTest::SetUp()
+{
+	piProcess = new FindInstancesProcess();
+
+	// a rotation around z plus a translation
+	aiMatrix4x4 rot, trans;
+	aiMatrix4x4::RotationZ(0.7f,rot);
+	aiMatrix4x4::Translation(aiVector3D(5.f,-2.f,1.f),trans);
+	mTransform = trans * rot;
+
+	// three tetrahedrons: the original, an exact copy and a transformed copy
+	static const aiVector3D positions[4] = {
+		aiVector3D(0.f,0.f,0.f), aiVector3D(1.f,0.f,0.f),
+		aiVector3D(0.f,2.f,0.f), aiVector3D(0.f,0.f,3.f)
+	};
+	static const unsigned int indices[4][3] = {
+		{0,2,1}, {0,1,3}, {0,3,2}, {1,2,3}
+	};
+
+	pcScene = new aiScene();
+	pcScene->mMeshes = new aiMesh*[pcScene->mNumMeshes = 3];
+	pcScene->mRootNode = new aiNode();
+	pcScene->mRootNode->mChildren = new aiNode*[pcScene->mRootNode->mNumChildren = 3];
+
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		aiMesh* mesh = pcScene->mMeshes[i] = new aiMesh();
+		mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+		mesh->mVertices = new aiVector3D[mesh->mNumVertices = 4];
+		mesh->mNormals = new aiVector3D[4];
+		for (unsigned int a = 0; a < 4; ++a)
+		{
+			mesh->mVertices[a] = positions[a];
+			mesh->mNormals[a] = (positions[a] - aiVector3D(0.25f,0.5f,0.75f)).Normalize();
+			if (i == 2)
+			{
+				mesh->mVertices[a] = mTransform * mesh->mVertices[a];
+				mesh->mNormals[a] = aiMatrix3x3(mTransform) * mesh->mNormals[a];
+			}
+		}
+		mesh->mFaces = new aiFace[mesh->mNumFaces = 4];
+		for (unsigned int a = 0; a < 4; ++a)
+		{
+			aiFace& face = mesh->mFaces[a];
+			face.mIndices = new unsigned int[face.mNumIndices = 3];
+			for (unsigned int n = 0; n < 3; ++n)
+				face.mIndices[n] = indices[a][n];
+		}
+
+		aiNode* nd = pcScene->mRootNode->mChildren[i] = new aiNode();
+		nd->mParent = pcScene->mRootNode;
+		nd->mName.length = ::sprintf(nd->mName.data,"node%u",i);
+		nd->mMeshes = new unsigned int[nd->mNumMeshes = 1];
+		nd->mMeshes[0] = i;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void FindInstancesProcessTest::TearDown()
+{
+	delete piProcess;
+	delete pcScene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FindInstancesProcessTest, testExactInstances)
+{
+	piProcess->Execute(pcScene);
+
+	EXPECT_EQ(2U, pcScene->mNumMeshes);
+	EXPECT_EQ(0U, pcScene->mRootNode->mChildren[0]->mMeshes[0]);
+	EXPECT_EQ(0U, pcScene->mRootNode->mChildren[1]->mMeshes[0]);
+	EXPECT_EQ(1U, pcScene->mRootNode->mChildren[2]->mMeshes[0]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(FindInstancesProcessTest, testTransformedInstances)
+{
+	piProcess->SetTransformInvariant(true);
+	piProcess->Execute(pcScene);
+
+	EXPECT_EQ(1U, pcScene->mNumMeshes);
+
+	// the reference moved to a child node carrying the transformation
+	const aiNode* nd = pcScene->mRootNode->mChildren[2];
+	EXPECT_EQ(0U, nd->mNumMeshes);
+	ASSERT_EQ(1U, nd->mNumChildren);
+
+	const aiNode* child = nd->mChildren[0];
+	ASSERT_EQ(1U, child->mNumMeshes);
+	EXPECT_EQ(0U, child->mMeshes[0]);
+
+	const aiVector3D p = child->mTransformation * aiVector3D(0.f,2.f,0.f);
+	EXPECT_LT((p - mTransform * aiVector3D(0.f,2.f,0.f)).Length(), 1e-4f);
+}
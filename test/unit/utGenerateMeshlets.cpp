@@ -0,0 +1,168 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <GenerateMeshletsProcess.h>
+
+#include <set>
+
+using namespace std;
+using namespace Assimp;
+
+class GenerateMeshletsTest : public ::testing::Test
+{
+public:
+
+	virtual void SetUp();
+	virtual void TearDown();
+
+protected:
+
+	GenerateMeshletsProcess* piProcess;
+	aiMesh* pcMesh;
+};
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsTest::SetUp()
+{
+	piProcess = new GenerateMeshletsProcess();
+	piProcess->SetLimits(64,126);
+
+	// a flat grid of 40x40 quads in the xy plane, two triangles each
+	const unsigned int iSize = 40;
+	pcMesh = new aiMesh();
+	pcMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+	pcMesh->mNumVertices = (iSize+1)*(iSize+1);
+	pcMesh->mVertices = new aiVector3D[pcMesh->mNumVertices];
+	for (unsigned int y = 0; y <= iSize;++y)
+	{
+		for (unsigned int x = 0; x <= iSize;++x)
+			pcMesh->mVertices[y*(iSize+1)+x] = aiVector3D((float)x,(float)y,0.f);
+	}
+
+	pcMesh->mNumFaces = iSize*iSize*2;
+	pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+	unsigned int iFace = 0;
+	for (unsigned int y = 0; y < iSize;++y)
+	{
+		for (unsigned int x = 0; x < iSize;++x)
+		{
+			const unsigned int i = y*(iSize+1)+x;
+			const unsigned int quad[2][3] = {{i,i+1,i+iSize+2},{i,i+iSize+2,i+iSize+1}};
+			for (unsigned int t = 0; t < 2;++t)
+			{
+				aiFace& face = pcMesh->mFaces[iFace++];
+				face.mNumIndices = 3;
+				face.mIndices = new unsigned int[3];
+				face.mIndices[0] = quad[t][0];
+				face.mIndices[1] = quad[t][1];
+				face.mIndices[2] = quad[t][2];
+			}
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenerateMeshletsTest::TearDown()
+{
+	delete piProcess;
+	delete pcMesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateMeshletsTest, testMeshletLimits)
+{
+	ASSERT_TRUE(piProcess->ProcessMesh(pcMesh));
+	ASSERT_TRUE(pcMesh->HasMeshlets());
+
+	// 3200 triangles, at most 126 per meshlet
+	EXPECT_GE(pcMesh->mNumMeshlets, 26U);
+
+	unsigned int iOffset = 0;
+	for (unsigned int i = 0; i < pcMesh->mNumMeshlets;++i)
+	{
+		const aiMeshlet& m = pcMesh->mMeshlets[i];
+		EXPECT_EQ(iOffset, m.mFaceOffset);
+		EXPECT_LE(m.mNumFaces, 126U);
+		EXPECT_LE(m.mNumVertices, 64U);
+		iOffset += m.mNumFaces;
+
+		// the vertex list must contain all vertices of the meshlet's faces
+		const std::set<unsigned int> verts(m.mVertices, m.mVertices + m.mNumVertices);
+		EXPECT_EQ(m.mNumVertices, verts.size());
+		for (unsigned int f = m.mFaceOffset; f < m.mFaceOffset + m.mNumFaces;++f)
+		{
+			const aiFace& face = pcMesh->mFaces[f];
+			for (unsigned int n = 0; n < face.mNumIndices;++n)
+			{
+				EXPECT_TRUE(verts.count(face.mIndices[n]) != 0);
+			}
+		}
+	}
+	EXPECT_EQ(pcMesh->mNumFaces, iOffset);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateMeshletsTest, testMeshletBounds)
+{
+	ASSERT_TRUE(piProcess->ProcessMesh(pcMesh));
+
+	for (unsigned int i = 0; i < pcMesh->mNumMeshlets;++i)
+	{
+		const aiMeshlet& m = pcMesh->mMeshlets[i];
+
+		// meshlets should be compact, the grid itself has a radius of ~28
+		EXPECT_LT(m.mRadius, 10.f);
+		for (unsigned int v = 0; v < m.mNumVertices;++v)
+		{
+			EXPECT_LE((pcMesh->mVertices[m.mVertices[v]] - m.mCenter).Length(), m.mRadius * 1.001f);
+		}
+
+		// the grid is flat and faces +z
+		EXPECT_NEAR(1.f, m.mConeAxis.z, 1e-4f);
+		EXPECT_NEAR(1.f, m.mConeCutoff, 1e-4f);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateMeshletsTest, testNonIndexedMesh)
+{
+	// give every face its own vertices, so no two faces are adjacent
+	aiVector3D* pcVertices = new aiVector3D[pcMesh->mNumFaces*3];
+	for (unsigned int i = 0; i < pcMesh->mNumFaces;++i)
+	{
+		aiFace& face = pcMesh->mFaces[i];
+		for (unsigned int n = 0; n < 3;++n)
+		{
+			pcVertices[i*3+n] = pcMesh->mVertices[face.mIndices[n]];
+			face.mIndices[n] = i*3+n;
+		}
+	}
+	delete[] pcMesh->mVertices;
+	pcMesh->mVertices = pcVertices;
+	pcMesh->mNumVertices = pcMesh->mNumFaces*3;
+
+	ASSERT_TRUE(piProcess->ProcessMesh(pcMesh));
+
+	// nearby faces are added although they aren't adjacent, so most meshlets
+	// are filled up to the vertex limit of 21 triangles
+	EXPECT_LE(pcMesh->mNumMeshlets, pcMesh->mNumFaces / 21 * 3 / 2);
+	unsigned int iOffset = 0;
+	for (unsigned int i = 0; i < pcMesh->mNumMeshlets;++i)
+	{
+		const aiMeshlet& m = pcMesh->mMeshlets[i];
+		EXPECT_EQ(iOffset, m.mFaceOffset);
+		EXPECT_EQ(m.mNumFaces * 3, m.mNumVertices);
+		EXPECT_LE(m.mNumVertices, 64U);
+		EXPECT_LT(m.mRadius, 10.f);
+		iOffset += m.mNumFaces;
+	}
+	EXPECT_EQ(pcMesh->mNumFaces, iOffset);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenerateMeshletsTest, testNonTriangleMesh)
+{
+	pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
+	EXPECT_FALSE(piProcess->ProcessMesh(pcMesh));
+	EXPECT_FALSE(pcMesh->HasMeshlets());
+}
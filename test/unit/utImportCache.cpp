@@ -0,0 +1,431 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/IOStream.hpp>
+#include <ImportCache.h>
+#include <TriangulateProcess.h>
+
+#include <cstdio>
+
+#ifndef ASSIMP_BUILD_NO_IMPORT_CACHE
+
+using namespace Assimp;
+
+static const char* const CacheFile = "../../test/models/X/test.x";
+
+class ImportCacheTest : public ::testing::Test
+{
+public:
+
+	// start and finish with an empty cache
+	virtual void SetUp() { ImportCache(".",0); }
+	virtual void TearDown() { ImportCache(".",0); }
+
+protected:
+
+	static size_t CountEntries() {
+		return ImportCache(".",~static_cast<uint64_t>(0)).GetEntryCount();
+	}
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImportCacheTest, testReadFileFromCache)
+{
+	const unsigned int flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices;
+
+	Importer first;
+	first.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY,".");
+	const aiScene* imported = first.ReadFile(CacheFile,flags);
+	ASSERT_TRUE(NULL != imported);
+	EXPECT_EQ(1U, CountEntries());
+
+	Importer second;
+	second.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY,".");
+	const aiScene* cached = second.ReadFile(CacheFile,flags);
+	ASSERT_TRUE(NULL != cached);
+	EXPECT_EQ(1U, CountEntries());
+
+	ASSERT_EQ(imported->mNumMeshes, cached->mNumMeshes);
+	EXPECT_EQ(imported->mNumMaterials, cached->mNumMaterials);
+	for (unsigned int i = 0; i < imported->mNumMeshes; ++i) {
+		ASSERT_EQ(imported->mMeshes[i]->mNumVertices, cached->mMeshes[i]->mNumVertices);
+		ASSERT_EQ(imported->mMeshes[i]->mNumFaces, cached->mMeshes[i]->mNumFaces);
+		EXPECT_EQ(imported->mMeshes[i]->mVertices[0], cached->mMeshes[i]->mVertices[0]);
+	}
+
+	// other flags or properties are cached separately
+	second.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS,aiComponent_NORMALS);
+	EXPECT_TRUE(NULL != second.ReadFile(CacheFile,flags));
+	EXPECT_EQ(2U, CountEntries());
+}
+
+// ------------------------------------------------------------------------------------------------
+static void WriteTextFile(const char* name, const char* text)
+{
+	FILE* f = ::fopen(name,"wb");
+	ASSERT_TRUE(NULL != f);
+	::fputs(text,f);
+	::fclose(f);
+}
+
+// ------------------------------------------------------------------------------------------------
+static aiColor3D GetDiffuse(const aiScene* scene)
+{
+	aiColor3D color;
+	for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+		aiString name;
+		scene->mMaterials[i]->Get(AI_MATKEY_NAME,name);
+		if (!::strcmp(name.C_Str(),"m")) {
+			scene->mMaterials[i]->Get(AI_MATKEY_COLOR_DIFFUSE,color);
+		}
+	}
+	return color;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImportCacheTest, testDependencyChanged)
+{
+	WriteTextFile("cache_dep.obj","mtllib cache_dep.mtl\nv 0 0 0\nv 1 0 0\nv 0 1 0\nusemtl m\nf 1 2 3\n");
+	WriteTextFile("cache_dep.mtl","newmtl m\nKd 1 0 0\n");
+
+	Importer imp;
+	imp.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY,".");
+	const aiScene* scene = imp.ReadFile("cache_dep.obj",0);
+	ASSERT_TRUE(NULL != scene);
+	EXPECT_EQ(aiColor3D(1.f,0.f,0.f), GetDiffuse(scene));
+	EXPECT_EQ(1U, CountEntries());
+
+	// unchanged, served from the cache
+	scene = imp.ReadFile("cache_dep.obj",0);
+	ASSERT_TRUE(NULL != scene);
+	EXPECT_EQ(aiColor3D(1.f,0.f,0.f), GetDiffuse(scene));
+
+	// only the material library changes, the outdated entry is replaced
+	WriteTextFile("cache_dep.mtl","newmtl m\nKd 0 0 1\n");
+	scene = imp.ReadFile("cache_dep.obj",0);
+	ASSERT_TRUE(NULL != scene);
+	EXPECT_EQ(aiColor3D(0.f,0.f,1.f), GetDiffuse(scene));
+	EXPECT_EQ(1U, CountEntries());
+
+	// a file the loader looked for in vain appears
+	::remove("cache_dep.mtl");
+	scene = imp.ReadFile("cache_dep.obj",0);
+	ASSERT_TRUE(NULL != scene);
+	EXPECT_NE(aiColor3D(0.f,0.f,1.f), GetDiffuse(scene));
+
+	WriteTextFile("cache_dep.mtl","newmtl m\nKd 0 1 0\n");
+	scene = imp.ReadFile("cache_dep.obj",0);
+	ASSERT_TRUE(NULL != scene);
+	EXPECT_EQ(aiColor3D(0.f,1.f,0.f), GetDiffuse(scene));
+
+	::remove("cache_dep.obj");
+	::remove("cache_dep.mtl");
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImportCacheTest, testInputChanged)
+{
+	WriteTextFile("cache_input.obj","v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+
+	Importer imp;
+	imp.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY,".");
+	const aiScene* scene = imp.ReadFile("cache_input.obj",0);
+	ASSERT_TRUE(NULL != scene);
+	ASSERT_EQ(1U, scene->mNumMeshes);
+	EXPECT_EQ(aiVector3D(1.f,0.f,0.f), scene->mMeshes[0]->mVertices[1]);
+
+	// same name and size, likely within the resolution of the modification time
+	WriteTextFile("cache_input.obj","v 0 0 0\nv 2 0 0\nv 0 1 0\nf 1 2 3\n");
+	scene = imp.ReadFile("cache_input.obj",0);
+	ASSERT_TRUE(NULL != scene);
+	ASSERT_EQ(1U, scene->mNumMeshes);
+	EXPECT_EQ(aiVector3D(2.f,0.f,0.f), scene->mMeshes[0]->mVertices[1]);
+
+	::remove("cache_input.obj");
+}
+
+// ------------------------------------------------------------------------------------------------
+// Counts the bytes read from all files
+class ReadCountingIOSystem : public IOSystem
+{
+public:
+
+	class Stream : public IOStream
+	{
+	public:
+
+		Stream(IOSystem* io, IOStream* source, size_t& counter)
+			: io(io)
+			, source(source)
+			, counter(counter)
+		{}
+
+		~Stream() { io->Close(source); }
+
+		size_t Read(void* pvBuffer, size_t pSize, size_t pCount) {
+			const size_t cnt = source->Read(pvBuffer,pSize,pCount);
+			counter += cnt * pSize;
+			return cnt;
+		}
+		size_t Write(const void* pvBuffer, size_t pSize, size_t pCount) { return source->Write(pvBuffer,pSize,pCount); }
+		aiReturn Seek(size_t pOffset, aiOrigin pOrigin) { return source->Seek(pOffset,pOrigin); }
+		size_t Tell() const { return source->Tell(); }
+		size_t FileSize() const { return source->FileSize(); }
+		void Flush() { source->Flush(); }
+
+	private:
+
+		IOSystem* io;
+		IOStream* source;
+		size_t& counter;
+	};
+
+	ReadCountingIOSystem(IOSystem* wrapped, size_t& counter)
+		: wrapped(wrapped)
+		, counter(counter)
+	{}
+
+	bool Exists( const char* pFile) const {
+		return wrapped->Exists(pFile);
+	}
+
+	char getOsSeparator() const {
+		return wrapped->getOsSeparator();
+	}
+
+	IOStream* Open(const char* pFile, const char* pMode = "rb") {
+		IOStream* stream = wrapped->Open(pFile,pMode);
+		return stream ? new Stream(wrapped,stream,counter) : NULL;
+	}
+
+	void Close( IOStream* pFile) {
+		delete pFile;
+	}
+
+private:
+
+	IOSystem* wrapped;
+	size_t& counter;
+};
+
+// ------------------------------------------------------------------------------------------------
+// The key doesn't read the input, its digest is taken while the loader reads it
+TEST_F(ImportCacheTest, testInputReadOnceOnMiss)
+{
+	FILE* f = ::fopen(CacheFile,"rb");
+	ASSERT_TRUE(NULL != f);
+	::fseek(f,0,SEEK_END);
+	const size_t fileSize = ::ftell(f);
+	::fclose(f);
+
+	// borrow the default IOSystem of another Importer
+	Importer files;
+	size_t uncachedRead = 0, cachedRead = 0;
+	{
+		Importer imp;
+		imp.SetIOHandler(new ReadCountingIOSystem(files.GetIOHandler(),uncachedRead));
+		ASSERT_TRUE(NULL != imp.ReadFile(CacheFile,0));
+	}
+	{
+		Importer imp;
+		imp.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY,".");
+		imp.SetIOHandler(new ReadCountingIOSystem(files.GetIOHandler(),cachedRead));
+		ASSERT_TRUE(NULL != imp.ReadFile(CacheFile,0));
+	}
+	EXPECT_EQ(1U, CountEntries());
+	EXPECT_LT(cachedRead, uncachedRead + fileSize);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Renames the root node, so it can be told whether the step has run. BaseProcess
+// isn't exported from the library everywhere, so an exported step is derived from.
+class RenameRootStep : public TriangulateProcess
+{
+public:
+
+	RenameRootStep(const char* name, const char* root)
+		: name(name)
+		, root(root)
+	{}
+
+	bool IsActive( unsigned int /*pFlags*/) const {
+		return true;
+	}
+
+	bool IsPerMesh() const {
+		return false;
+	}
+
+	bool RequireVerboseFormat() const {
+		return false;
+	}
+
+	void SetupProperties(const Importer* /*pImp*/) {
+	}
+
+	const char* GetName() const {
+		return name;
+	}
+
+	void Execute( aiScene* pScene) {
+		pScene->mRootNode->mName.Set(root);
+	}
+
+private:
+
+	const char* name;
+	const char* root;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImportCacheTest, testKey)
+{
+	Importer imp;
+	const ImporterPimpl* pimpl = imp.Pimpl();
+	IOSystem* io = imp.GetIOHandler();
+
+	const std::string key = ImportCache::ComputeKey(io,CacheFile,0,pimpl);
+	EXPECT_EQ(32U, key.length());
+	EXPECT_EQ(key, ImportCache::ComputeKey(io,CacheFile,0,pimpl));
+	EXPECT_NE(key, ImportCache::ComputeKey(io,CacheFile,aiProcess_Triangulate,pimpl));
+	EXPECT_NE(key, ImportCache::ComputeKey(io,"../../test/models/X/anim_test.x",0,pimpl));
+	EXPECT_TRUE(ImportCache::ComputeKey(io,"../../test/models/X/not_there.x",0,pimpl).empty());
+
+	// the cache settings don't matter, other properties do
+	imp.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY,".");
+	imp.SetPropertyInteger(AI_CONFIG_IMPORT_CACHE_MAX_SIZE,1);
+	EXPECT_EQ(key, ImportCache::ComputeKey(io,CacheFile,0,pimpl));
+
+	imp.SetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE,30.f);
+	const std::string withProperty = ImportCache::ComputeKey(io,CacheFile,0,pimpl);
+	EXPECT_NE(key, withProperty);
+
+	// so do custom steps
+	RenameRootStep step("RenameRootStep","renamed");
+	imp.RegisterPPStep(&step);
+	EXPECT_NE(withProperty, ImportCache::ComputeKey(io,CacheFile,0,pimpl));
+	imp.UnregisterPPStep(&step);
+	EXPECT_EQ(withProperty, ImportCache::ComputeKey(io,CacheFile,0,pimpl));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Scenes imported with custom steps are cached separately
+TEST_F(ImportCacheTest, testCustomStep)
+{
+	// custom steps only run if any post-processing is requested
+	const unsigned int flags = aiProcess_Triangulate;
+
+	Importer plain;
+	plain.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY,".");
+	ASSERT_TRUE(NULL != plain.ReadFile(CacheFile,flags));
+	EXPECT_EQ(1U, CountEntries());
+
+	RenameRootStep* step = new RenameRootStep("RenameRootStep","renamed");
+	Importer custom;
+	custom.SetPropertyString(AI_CONFIG_IMPORT_CACHE_DIRECTORY,".");
+	custom.RegisterPPStep(step);
+	const aiScene* scene = custom.ReadFile(CacheFile,flags);
+	ASSERT_TRUE(NULL != scene);
+	EXPECT_STREQ("renamed", scene->mRootNode->mName.C_Str());
+	EXPECT_EQ(2U, CountEntries());
+
+	// steps without a name can't be told apart, the cache is not used at all
+	RenameRootStep* unnamed = new RenameRootStep(NULL,"unnamed");
+	custom.UnregisterPPStep(step);
+	delete step;
+	custom.RegisterPPStep(unnamed);
+	scene = custom.ReadFile(CacheFile,flags);
+	ASSERT_TRUE(NULL != scene);
+	EXPECT_STREQ("unnamed", scene->mRootNode->mName.C_Str());
+	EXPECT_EQ(2U, CountEntries());
+
+	custom.UnregisterPPStep(unnamed);
+	delete unnamed;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImportCacheTest, testEviction)
+{
+	Importer imp;
+	const aiScene* scene = imp.ReadFile(CacheFile,0);
+	ASSERT_TRUE(NULL != scene);
+
+	uint64_t entrySize;
+	{
+		ImportCache cache(".",~static_cast<uint64_t>(0));
+		ASSERT_TRUE(cache.Store("a",scene));
+		entrySize = cache.GetSize();
+		ASSERT_GT(entrySize, 0U);
+	}
+
+	// room for two entries, 'a' is used after 'b' was stored, so 'b' is evicted for 'c'
+	ImportCache cache(".",entrySize * 2 + entrySize / 2);
+	EXPECT_TRUE(cache.Store("b",scene));
+
+	aiScene* sc = cache.Lookup(&imp,imp.GetIOHandler(),"a");
+	ASSERT_TRUE(NULL != sc);
+	EXPECT_EQ(scene->mNumMeshes, sc->mNumMeshes);
+	delete sc;
+
+	EXPECT_TRUE(cache.Store("c",scene));
+	EXPECT_EQ(2U, cache.GetEntryCount());
+	EXPECT_TRUE(NULL == cache.Lookup(&imp,imp.GetIOHandler(),"b"));
+
+	sc = cache.Lookup(&imp,imp.GetIOHandler(),"a");
+	EXPECT_TRUE(NULL != sc);
+	delete sc;
+
+	// entries larger than the cache aren't kept
+	ImportCache tiny(".",entrySize / 2);
+	EXPECT_FALSE(tiny.Store("d",scene));
+	EXPECT_EQ(0U, tiny.GetEntryCount());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImportCacheTest, testSharedDirectory)
+{
+	Importer imp;
+	const aiScene* scene = imp.ReadFile(CacheFile,0);
+	ASSERT_TRUE(NULL != scene);
+
+	// two caches on the same directory, as if used by two processes
+	ImportCache first(".",~static_cast<uint64_t>(0));
+	ImportCache second(".",~static_cast<uint64_t>(0));
+
+	ASSERT_TRUE(first.Store("a",scene));
+	ASSERT_TRUE(second.Store("b",scene));
+	EXPECT_EQ(2U, second.GetEntryCount());
+
+	aiScene* sc = second.Lookup(&imp,imp.GetIOHandler(),"a");
+	EXPECT_TRUE(NULL != sc);
+	delete sc;
+
+	sc = first.Lookup(&imp,imp.GetIOHandler(),"b");
+	EXPECT_TRUE(NULL != sc);
+	delete sc;
+	EXPECT_EQ(2U, CountEntries());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImportCacheTest, testMetaDataNotStored)
+{
+	Importer imp;
+	ASSERT_TRUE(NULL != imp.ReadFile(CacheFile,0));
+	aiScene* scene = imp.GetOrphanedScene();
+
+	aiNode* node = scene->mRootNode;
+	while (node->mNumChildren) {
+		node = node->mChildren[0];
+	}
+	node->mMetaData = new aiMetadata();
+
+	ImportCache cache(".",~static_cast<uint64_t>(0));
+	EXPECT_FALSE(cache.Store("a",scene));
+	EXPECT_EQ(0U, cache.GetEntryCount());
+	delete scene;
+}
+
+#endif // ASSIMP_BUILD_NO_IMPORT_CACHE
@@ -4,6 +4,7 @@
 #include "../../include/assimp/scene.h"
 #include <assimp/Importer.hpp>
 #include <BaseImporter.h>
+#include <MemoryIOWrapper.h>
 
 
 using namespace std;
@@ -232,3 +233,144 @@ TEST_F(ImporterTest, testMultipleReads)
 	EXPECT_TRUE(pImp->ReadFile("../../test/models/X/BCN_Epileptic.X",flags));
 	//EXPECT_TRUE(pImp->ReadFile("../../test/models/X/dwarf.x",flags)); # is in nonbsd
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, testCompressedX)
+{
+	// the compressed files span many MSZIP blocks, which are inflated while parsing
+	static const char* files[][2] = {
+		{"../../test/models/X/anim_test.x", "../../test/models/X/anim_test_compressed.x"},
+		{"../../test/models/X/fromtruespace_bin32.x", "../../test/models/X/fromtruespace_bin32_compressed.x"}
+	};
+
+	for (unsigned int i = 0; i < 2; ++i) {
+		const aiScene* sc = pImp->ReadFile(files[i][0],0);
+		ASSERT_TRUE(NULL != sc);
+		ASSERT_EQ(1U, sc->mNumMeshes);
+		const std::vector<aiVector3D> verts(sc->mMeshes[0]->mVertices,
+			sc->mMeshes[0]->mVertices + sc->mMeshes[0]->mNumVertices);
+		const unsigned int numAnims = sc->mNumAnimations;
+
+		sc = pImp->ReadFile(files[i][1],0);
+		ASSERT_TRUE(NULL != sc);
+		ASSERT_EQ(1U, sc->mNumMeshes);
+		ASSERT_EQ(verts.size(), sc->mMeshes[0]->mNumVertices);
+		EXPECT_TRUE(std::equal(verts.begin(), verts.end(), sc->mMeshes[0]->mVertices));
+		EXPECT_EQ(numAnims, sc->mNumAnimations);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, testDXFBlockInstances)
+{
+	// two INSERTs of a block that in turn inserts another block twice, plus an unresolved
+	// and a cyclic reference. Every block should be converted to meshes only once.
+	const aiScene* sc = pImp->ReadFile("../../test/models/DXF/block_instances.dxf",aiProcess_ValidateDataStructure);
+	ASSERT_TRUE(NULL != sc);
+	EXPECT_EQ(3U, sc->mNumMeshes);
+
+	const aiNode* const root = sc->mRootNode;
+	ASSERT_EQ(2U, root->mNumChildren);
+	for (unsigned int i = 0; i < 2; ++i) {
+		const aiNode* const branch = root->mChildren[i];
+		ASSERT_EQ(2U, branch->mNumChildren);
+		ASSERT_EQ(1U, branch->mNumMeshes);
+		EXPECT_EQ(root->mChildren[0]->mMeshes[0], branch->mMeshes[0]);
+		EXPECT_EQ(branch->mChildren[0]->mMeshes[0], branch->mChildren[1]->mMeshes[0]);
+	}
+
+	// baking the instances multiplies the geometry
+	sc = pImp->ReadFile("../../test/models/DXF/block_instances.dxf",aiProcess_PreTransformVertices);
+	ASSERT_TRUE(NULL != sc);
+	unsigned int verts = 0;
+	for (unsigned int i = 0; i < sc->mNumMeshes; ++i) {
+		verts += sc->mMeshes[i]->mNumVertices;
+	}
+	EXPECT_EQ(21U, verts);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Serves a single file from memory under two names and counts how often it is opened
+class CountingIOSystem : public IOSystem
+{
+public:
+	CountingIOSystem(const char* file) : opened() {
+		FILE* f = ::fopen(file,"rb");
+		if (f) {
+			char buffer[4096];
+			size_t read;
+			while ((read = ::fread(buffer,1,sizeof(buffer),f)) > 0) {
+				data.insert(data.end(),buffer,buffer+read);
+			}
+			::fclose(f);
+		}
+	}
+
+	bool Exists( const char* pFile) const {
+		return !::strcmp(pFile,"model.md2") || !::strcmp(pFile,"model.bin");
+	}
+
+	char getOsSeparator() const {
+		return '/';
+	}
+
+	IOStream* Open( const char* pFile, const char* /*pMode*/ = "rb") {
+		if (!Exists(pFile) || data.empty()) {
+			return NULL;
+		}
+		++opened;
+		return new MemoryIOStream(&data[0],data.size());
+	}
+
+	void Close( IOStream* pFile) {
+		delete pFile;
+	}
+
+	std::vector<uint8_t> data;
+	unsigned int opened;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, testSingleHeaderProbe)
+{
+	CountingIOSystem* io = new CountingIOSystem("../../test/models/MD2/sydney.md2");
+	ASSERT_FALSE(io->data.empty());
+	pImp->SetIOHandler(io);
+
+	// the file is opened once to read its header for format detection and
+	// once more by the importer, both for known and unknown extensions
+	ASSERT_TRUE(NULL != pImp->ReadFile("model.md2",0));
+	EXPECT_EQ(2U, io->opened);
+
+	io->opened = 0;
+	ASSERT_TRUE(NULL != pImp->ReadFile("model.bin",0));
+	EXPECT_EQ(2U, io->opened);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, testSharedRegistry)
+{
+	Importer other;
+	ASSERT_EQ(other.GetImporterCount(), pImp->GetImporterCount());
+
+	// importer descriptions come from the shared registry and match the instances
+	for (size_t i = 0; i < pImp->GetImporterCount(); ++i) {
+		EXPECT_EQ(other.GetImporterInfo(i), pImp->GetImporterInfo(i));
+		ASSERT_TRUE(NULL != pImp->GetImporter(i));
+		EXPECT_EQ(pImp->GetImporterInfo(i), pImp->GetImporter(i)->GetInfo());
+	}
+
+	// removing a built-in importer doesn't affect other Importer instances
+	BaseImporter* md2 = pImp->GetImporter("md2");
+	ASSERT_TRUE(NULL != md2);
+	EXPECT_EQ(AI_SUCCESS, pImp->UnregisterLoader(md2));
+	delete md2;
+
+	EXPECT_FALSE(pImp->IsExtensionSupported("md2"));
+	EXPECT_TRUE(pImp->IsExtensionSupported("md3"));
+	EXPECT_TRUE(other.IsExtensionSupported("md2"));
+	EXPECT_EQ(other.GetImporterCount()-1, pImp->GetImporterCount());
+
+	EXPECT_TRUE(NULL == pImp->ReadFile("../../test/models/MD2/sydney.md2",0));
+	EXPECT_TRUE(NULL != other.ReadFile("../../test/models/MD2/sydney.md2",aiProcess_Triangulate));
+}
@@ -99,3 +99,79 @@ TEST_F(LimitBoneWeightsTest, testProcess)
 
 	// everything seems to be OK
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(LimitBoneWeightsTest, testSkinStream)
+{
+	piProcess->mSkinStreamInfluences = 8;
+	piProcess->ProcessMesh(pcMesh);
+
+	ASSERT_TRUE(pcMesh->HasSkinStream());
+	const aiSkinStream* stream = pcMesh->mSkinStream;
+	EXPECT_EQ(pcMesh->mNumVertices, stream->mNumVertices);
+	EXPECT_EQ(8U, stream->mNumInfluences);
+	ASSERT_EQ(32U, stream->mWeightBits);
+
+	// the stream holds the same 4 weights per vertex as the bones
+	const float* weights = reinterpret_cast<const float*>(stream->mWeights);
+	for (unsigned int i = 0; i < pcMesh->mNumVertices;++i)
+	{
+		float fSum = 0.0f;
+		for (unsigned int a = 0; a < 8;++a)
+		{
+			const float w = weights[i*8+a];
+			if (a >= 4) {
+				EXPECT_EQ(0.0f, w);
+				continue;
+			}
+			fSum += w;
+
+			const unsigned int bone = stream->mBoneIndices[i*8+a];
+			ASSERT_LT(bone, pcMesh->mNumBones);
+			bool bFound = false;
+			for (unsigned int q = 0; q < pcMesh->mBones[bone]->mNumWeights;++q)
+			{
+				const aiVertexWeight& v = pcMesh->mBones[bone]->mWeights[q];
+				if (v.mVertexId == i) {
+					EXPECT_FLOAT_EQ(v.mWeight, w);
+					bFound = true;
+				}
+			}
+			EXPECT_TRUE(bFound);
+		}
+		EXPECT_NEAR(1.0f, fSum, 1e-5f);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(LimitBoneWeightsTest, testQuantizedSkinStream)
+{
+	// let the stream keep less weights than the bones. Bones with a higher index
+	// have a larger weight.
+	piProcess->mMaxWeights = 8;
+	piProcess->mSkinStreamInfluences = 4;
+	piProcess->mSkinStreamBits = 8;
+	for (unsigned int i = 0; i < pcMesh->mNumBones;++i)
+	{
+		for (unsigned int q = 0; q < pcMesh->mBones[i]->mNumWeights;++q)
+			pcMesh->mBones[i]->mWeights[q].mWeight = (i+1) / 465.0f;
+	}
+	piProcess->ProcessMesh(pcMesh);
+
+	ASSERT_TRUE(pcMesh->HasSkinStream());
+	const aiSkinStream* stream = pcMesh->mSkinStream;
+	for (unsigned int i = 0; i < pcMesh->mNumVertices;++i)
+	{
+		// weights are sorted by descending weight and sum up to the maximum
+		unsigned int iSum = 0;
+		for (unsigned int a = 0; a < 4;++a)
+		{
+			iSum += stream->mWeights[i*4+a];
+			if (a) {
+				EXPECT_LE(stream->mWeights[i*4+a], stream->mWeights[i*4+a-1]);
+				EXPECT_LT(stream->mBoneIndices[i*4+a], stream->mBoneIndices[i*4+a-1]);
+			}
+		}
+		EXPECT_EQ(0xffU, iSum);
+	}
+}
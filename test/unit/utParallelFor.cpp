@@ -0,0 +1,106 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <ParallelFor.h>
+
+#include <vector>
+
+
+using namespace std;
+using namespace Assimp;
+
+class ParallelForTest : public ::testing::Test
+{
+public:
+
+	// several workers even on a single core machine
+	virtual void SetUp() { SetParallelForThreads(4); }
+	virtual void TearDown() { SetParallelForThreads(0); }
+};
+
+namespace {
+
+// counts how often each item has been processed
+struct CountItems
+{
+	CountItems(unsigned int count) : counts(count,0) {}
+	void operator() (unsigned int i) { ++counts[i]; }
+
+	std::vector<unsigned int> counts;
+};
+
+struct ThrowAt
+{
+	ThrowAt(unsigned int at) : at(at) {}
+	void operator() (unsigned int i) {
+		if (i == at) {
+			throw DeadlyImportError("item failed");
+		}
+	}
+
+	unsigned int at;
+};
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ParallelForTest, testAllItems)
+{
+	EXPECT_EQ(4U, GetParallelForThreads());
+
+	CountItems fn(1000);
+	ParallelFor(1000,fn);
+	for (unsigned int i = 0; i < 1000; ++i) {
+		EXPECT_EQ(1U, fn.counts[i]);
+	}
+
+	// fewer items than workers, and a limit
+	CountItems few(2);
+	ParallelFor(2,few);
+	ParallelFor(2,few,1);
+	EXPECT_EQ(2U, few.counts[0]);
+	EXPECT_EQ(2U, few.counts[1]);
+
+	CountItems none(0);
+	ParallelFor(0,none);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ParallelForTest, testException)
+{
+	ThrowAt fn(500);
+	EXPECT_THROW(ParallelFor(1000,fn), DeadlyImportError);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ParallelForTest, testSameResult)
+{
+	const unsigned int flags = aiProcessPreset_TargetRealtime_MaxQuality |
+		aiProcess_GenerateMeshlets | aiProcess_ValidateDataStructure;
+
+	Importer parallel;
+	const aiScene* a = parallel.ReadFile("../../test/models/OBJ/spider.obj",flags);
+	ASSERT_TRUE(NULL != a);
+
+	SetParallelForThreads(1);
+	Importer serial;
+	const aiScene* b = serial.ReadFile("../../test/models/OBJ/spider.obj",flags);
+	ASSERT_TRUE(NULL != b);
+
+	ASSERT_EQ(a->mNumMeshes, b->mNumMeshes);
+	for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+		const aiMesh* ma = a->mMeshes[i], *mb = b->mMeshes[i];
+		ASSERT_EQ(ma->mNumVertices, mb->mNumVertices);
+		ASSERT_EQ(ma->mNumFaces, mb->mNumFaces);
+		EXPECT_EQ(0, memcmp(ma->mVertices, mb->mVertices, sizeof(aiVector3D)*ma->mNumVertices));
+		EXPECT_EQ(0, memcmp(ma->mNormals, mb->mNormals, sizeof(aiVector3D)*ma->mNumVertices));
+		EXPECT_EQ(ma->mNumMeshlets, mb->mNumMeshlets);
+		for (unsigned int f = 0; f < ma->mNumFaces; ++f) {
+			ASSERT_EQ(ma->mFaces[f].mNumIndices, mb->mFaces[f].mNumIndices);
+			EXPECT_EQ(0, memcmp(ma->mFaces[f].mIndices, mb->mFaces[f].mIndices,
+				sizeof(unsigned int)*ma->mFaces[f].mNumIndices));
+		}
+	}
+}
@@ -0,0 +1,175 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <PostProcessScheduler.h>
+#include <TriangulateProcess.h>
+#include <GenVertexNormalsProcess.h>
+#include <JoinVerticesProcess.h>
+#include <SortByPTypeProcess.h>
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/LogStream.hpp>
+
+#include <set>
+
+
+using namespace std;
+using namespace Assimp;
+
+// Collects the names of the profiler regions started
+class RegionLogStream : public LogStream
+{
+public:
+
+	void write(const char* message)
+	{
+		const char* name = strstr(message,"START `");
+		if (name) {
+			name += 7;
+			const char* end = strchr(name,'`');
+			regions.push_back(end ? std::string(name,end) : std::string(name));
+		}
+	}
+
+	std::vector<std::string> regions;
+};
+
+class PostProcessSchedulerTest : public ::testing::Test
+{
+public:
+
+	virtual void SetUp()
+	{
+		pipelined = new Importer();
+		serial = new Importer();
+		serial->SetPropertyBool(AI_CONFIG_PP_PIPELINE_MESHES,false);
+	}
+
+	virtual void TearDown()
+	{
+		delete pipelined;
+		delete serial;
+	}
+
+protected:
+
+	void CompareMeshes(const aiMesh* a, const aiMesh* b);
+
+	Importer* pipelined;
+	Importer* serial;
+};
+
+// ------------------------------------------------------------------------------------------------
+void PostProcessSchedulerTest::CompareMeshes(const aiMesh* a, const aiMesh* b)
+{
+	ASSERT_EQ(a->mNumVertices,b->mNumVertices);
+	ASSERT_EQ(a->mNumFaces,b->mNumFaces);
+	EXPECT_EQ(a->mPrimitiveTypes,b->mPrimitiveTypes);
+
+	EXPECT_EQ(0,memcmp(a->mVertices,b->mVertices,sizeof(aiVector3D)*a->mNumVertices));
+	ASSERT_EQ(a->HasNormals(),b->HasNormals());
+	if (a->HasNormals()) {
+		EXPECT_EQ(0,memcmp(a->mNormals,b->mNormals,sizeof(aiVector3D)*a->mNumVertices));
+	}
+	ASSERT_EQ(a->HasTangentsAndBitangents(),b->HasTangentsAndBitangents());
+	if (a->HasTangentsAndBitangents()) {
+		EXPECT_EQ(0,memcmp(a->mTangents,b->mTangents,sizeof(aiVector3D)*a->mNumVertices));
+		EXPECT_EQ(0,memcmp(a->mBitangents,b->mBitangents,sizeof(aiVector3D)*a->mNumVertices));
+	}
+	for (unsigned int i = 0; i < a->mNumFaces; ++i) {
+		ASSERT_EQ(a->mFaces[i].mNumIndices,b->mFaces[i].mNumIndices);
+		EXPECT_EQ(0,memcmp(a->mFaces[i].mIndices,b->mFaces[i].mIndices,
+			sizeof(unsigned int)*a->mFaces[i].mNumIndices));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(PostProcessSchedulerTest, testBuildStages)
+{
+	TriangulateProcess tri, tri2;
+	GenVertexNormalsProcess gen, gen2;
+	JoinVerticesProcess join;
+	SortByPTypeProcess sort;
+
+	std::vector<BaseProcess*> steps;
+	steps.push_back(&tri);
+	steps.push_back(&gen);
+	steps.push_back(&join);
+	// reads the scene flags written by JoinVertices
+	steps.push_back(&gen2);
+	// not a per-mesh step
+	steps.push_back(&sort);
+	steps.push_back(&tri2);
+
+	std::vector<PostProcessScheduler::Stage> stages;
+	PostProcessScheduler::BuildStages(steps,stages);
+
+	ASSERT_EQ(4U,stages.size());
+	EXPECT_EQ(0U,stages[0].first);
+	EXPECT_EQ(3U,stages[0].count);
+	EXPECT_TRUE(stages[0].pipelined);
+
+	EXPECT_EQ(3U,stages[1].first);
+	EXPECT_EQ(1U,stages[1].count);
+	EXPECT_TRUE(stages[1].pipelined);
+
+	EXPECT_EQ(4U,stages[2].first);
+	EXPECT_EQ(1U,stages[2].count);
+	EXPECT_FALSE(stages[2].pipelined);
+
+	EXPECT_EQ(5U,stages[3].first);
+	EXPECT_EQ(1U,stages[3].count);
+	EXPECT_TRUE(stages[3].pipelined);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(PostProcessSchedulerTest, testSameResults)
+{
+	const unsigned int flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | 
+		aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices | 
+		aiProcess_ImproveCacheLocality | aiProcess_FixInfacingNormals;
+
+	const aiScene* a = pipelined->ReadFile("../../test/models/OBJ/spider.obj",flags);
+	const aiScene* b = serial->ReadFile("../../test/models/OBJ/spider.obj",flags);
+	ASSERT_TRUE(a);
+	ASSERT_TRUE(b);
+
+	EXPECT_TRUE(a->mFlags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT);
+	EXPECT_EQ(a->mFlags,b->mFlags);
+	ASSERT_EQ(a->mNumMeshes,b->mNumMeshes);
+	ASSERT_GT(a->mNumMeshes,1U);
+	for (unsigned int i = 0; i < a->mNumMeshes; ++i) {
+		CompareMeshes(a->mMeshes[i],b->mMeshes[i]);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+// Profiler regions are named after the step classes, the spatial sort helpers used by several
+// steps must not be reported under the flags of the steps they serve
+TEST_F(PostProcessSchedulerTest, testRegionNames)
+{
+	const unsigned int flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | 
+		aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices;
+
+	RegionLogStream stream;
+	DefaultLogger::get()->attachStream(&stream,Logger::Debugging);
+	serial->SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME,true);
+	const aiScene* scene = serial->ReadFile("../../test/models/OBJ/spider.obj",flags);
+	DefaultLogger::get()->detatchStream(&stream,Logger::Debugging);
+	ASSERT_TRUE(scene);
+
+	std::set<std::string> names;
+	for (std::vector<std::string>::const_iterator it = stream.regions.begin(); it != stream.regions.end(); ++it) {
+		if (!(*it).compare(0,12,"postprocess ")) {
+			EXPECT_TRUE(names.insert(*it).second) << *it;
+		}
+	}
+
+	EXPECT_EQ(1U, names.count("postprocess ComputeSpatialSortProcess"));
+	EXPECT_EQ(1U, names.count("postprocess DestroySpatialSortProcess"));
+	EXPECT_EQ(1U, names.count("postprocess CalcTangentsProcess"));
+	EXPECT_EQ(1U, names.count("postprocess JoinVerticesProcess"));
+	EXPECT_EQ(1U, names.count("postprocess GenVertexNormalsProcess"));
+	EXPECT_EQ(1U, names.count("postprocess TriangulateProcess"));
+}
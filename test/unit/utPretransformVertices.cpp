@@ -2,6 +2,7 @@
 
 #include <assimp/scene.h>
 #include <PretransformVertices.h>
+#include <Exceptional.h>
 
 
 using namespace std;
@@ -109,3 +110,48 @@ TEST_F(PretransformVerticesTest, testProcessKeepHierarchy)
 	EXPECT_EQ(5U, scene->mNumMaterials);
 	EXPECT_EQ(49U, scene->mNumMeshes); // see note on mesh 12 above
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(PretransformVerticesTest, testProcessInstances)
+{
+	process->KeepHierarchy(false);
+	process->SetInstancing(true);
+	process->Execute(scene);
+
+	// every mesh is referenced at least twice, so nothing is joined or copied
+	EXPECT_EQ(25U, scene->mNumMeshes);
+	EXPECT_EQ(60U, scene->mRootNode->mNumChildren);
+	for (unsigned int i = 0; i < scene->mRootNode->mNumChildren; ++i) {
+		EXPECT_EQ(1U, scene->mRootNode->mChildren[i]->mNumMeshes);
+	}
+
+	// shared meshes stay in local space
+	EXPECT_EQ(aiVector3D(3.f,1.f,0.f), scene->mMeshes[3]->mVertices[1]);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(PretransformVerticesTest, testProcessInstancesKeepHierarchy)
+{
+	process->KeepHierarchy(true);
+	process->SetInstancing(true);
+	process->Execute(scene);
+
+	EXPECT_EQ(25U, scene->mNumMeshes);
+	EXPECT_EQ(aiVector3D(3.f,1.f,0.f), scene->mMeshes[3]->mVertices[1]);
+
+	// the references moved to nodes carrying the absolute transformation
+	const aiNode* nd = scene->mRootNode->FindNode("11_instance");
+	ASSERT_TRUE(NULL != nd);
+	EXPECT_EQ(2U, nd->mNumMeshes);
+	EXPECT_EQ(0U, nd->mParent->mNumMeshes);
+	EXPECT_TRUE(nd->mParent->mTransformation.IsIdentity());
+	EXPECT_FALSE(nd->mTransformation.IsIdentity());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(PretransformVerticesTest, testOutputBudget)
+{
+	process->KeepHierarchy(false);
+	process->SetOutputBudget(1024);
+	EXPECT_THROW(process->Execute(scene), DeadlyImportError);
+}
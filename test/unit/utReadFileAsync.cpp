@@ -0,0 +1,226 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/ProgressHandler.hpp>
+#include <Importer.h>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/thread/mutex.hpp>
+#	include <boost/thread/condition_variable.hpp>
+#	include <boost/thread/thread.hpp>
+#endif
+
+using namespace std;
+using namespace Assimp;
+
+static const char* const ObjFile = "../../test/models/OBJ/spider.obj";
+static const char* const StlFile = "../../test/models/STL/Spider_ascii.stl";
+static const char* const FbxFile = "../../test/models-nonbsd/FBX/2013_BINARY/anims_with_full_rotations_between_keys.fbx";
+static const char* const PlyFile = "../../test/models/PLY/Wuson.ply";
+static const char* const DaeFile = "../../test/models/Collada/COLLADA.dae";
+
+// ------------------------------------------------------------------------------------------------
+// Progress handler which counts its calls and aborts after a given number of them
+class CountingProgressHandler : public ProgressHandler
+{
+public:
+
+	CountingProgressHandler(unsigned int abortAfter = ~0u)
+		: calls()
+		, abortAfter(abortAfter)
+	{}
+
+	bool Update(float percentage)
+	{
+		EXPECT_LE(percentage,1.f);
+		return ++calls < abortAfter;
+	}
+
+	unsigned int calls;
+	unsigned int abortAfter;
+};
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+// ------------------------------------------------------------------------------------------------
+// Progress handler which blocks the import at its first call until it is released
+class BlockingProgressHandler : public ProgressHandler
+{
+public:
+
+	BlockingProgressHandler()
+		: started()
+		, released()
+	{}
+
+	bool Update(float /*percentage*/)
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		started = true;
+		changed.notify_all();
+		while (!released) {
+			changed.wait(lock);
+		}
+		return true;
+	}
+
+	void WaitForStart()
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		while (!started) {
+			changed.wait(lock);
+		}
+	}
+
+	void Release()
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		released = true;
+		changed.notify_all();
+	}
+
+private:
+
+	boost::mutex mutex;
+	boost::condition_variable changed;
+	bool started, released;
+};
+#endif
+
+class ReadFileAsyncTest : public ::testing::Test
+{
+public:
+
+	virtual void SetUp()
+	{
+		imp = new Importer();
+	}
+
+	virtual void TearDown()
+	{
+		delete imp;
+	}
+
+protected:
+
+	Importer* imp;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ReadFileAsyncTest, testAsyncImport)
+{
+	ImportFuture future = imp->ReadFileAsync(ObjFile,aiProcess_Triangulate | aiProcess_GenNormals);
+	ASSERT_TRUE(future.IsValid());
+
+	const aiScene* scene = future.Get();
+	ASSERT_TRUE(NULL != scene);
+	EXPECT_TRUE(future.IsReady());
+	EXPECT_EQ(imp->GetScene(),scene);
+	EXPECT_LT(0u,scene->mNumMeshes);
+
+	// a late cancel request must not affect the next import
+	future.Cancel();
+	future = imp->ReadFileAsync(StlFile,0);
+	EXPECT_TRUE(NULL != future.Get());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ReadFileAsyncTest, testProgressIsBounded)
+{
+	CountingProgressHandler* handler = new CountingProgressHandler();
+	imp->SetProgressHandler(handler);
+
+	ASSERT_TRUE(NULL != imp->ReadFile(ObjFile,aiProcess_Triangulate | aiProcess_JoinIdenticalVertices));
+	EXPECT_LT(10u,handler->calls);
+	EXPECT_GE(250u,handler->calls);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ReadFileAsyncTest, testCancelFromHandler)
+{
+	imp->SetProgressHandler(new CountingProgressHandler(5));
+	EXPECT_TRUE(NULL == imp->ReadFile(ObjFile,0));
+	EXPECT_STREQ("Import cancelled",imp->GetErrorString());
+
+	imp->SetProgressHandler(new CountingProgressHandler(5));
+	EXPECT_TRUE(NULL == imp->ReadFile(StlFile,0));
+	EXPECT_STREQ("Import cancelled",imp->GetErrorString());
+
+	imp->SetProgressHandler(new CountingProgressHandler(5));
+	EXPECT_TRUE(NULL == imp->ReadFile(FbxFile,0));
+	EXPECT_STREQ("Import cancelled",imp->GetErrorString());
+
+	imp->SetProgressHandler(new CountingProgressHandler(5));
+	EXPECT_TRUE(NULL == imp->ReadFile(PlyFile,0));
+	EXPECT_STREQ("Import cancelled",imp->GetErrorString());
+
+	imp->SetProgressHandler(new CountingProgressHandler(5));
+	EXPECT_TRUE(NULL == imp->ReadFile(DaeFile,0));
+	EXPECT_STREQ("Import cancelled",imp->GetErrorString());
+
+	// the importer remains usable afterwards
+	imp->SetProgressHandler(NULL);
+	EXPECT_TRUE(NULL != imp->ReadFile(ObjFile,0));
+}
+
+// ------------------------------------------------------------------------------------------------
+// The scene-wide steps report progress while they run and can be cancelled halfway
+TEST_F(ReadFileAsyncTest, testCancelInPostProcessing)
+{
+	const unsigned int steps[] = {aiProcess_PreTransformVertices, aiProcess_OptimizeMeshes};
+	for (unsigned int i = 0; i < sizeof(steps) / sizeof(steps[0]); ++i) {
+		CountingProgressHandler* handler = new CountingProgressHandler();
+		imp->SetProgressHandler(handler);
+		ASSERT_TRUE(NULL != imp->ReadFile(ObjFile,0));
+		const unsigned int loaderCalls = handler->calls;
+
+		handler = new CountingProgressHandler();
+		imp->SetProgressHandler(handler);
+		ASSERT_TRUE(NULL != imp->ReadFile(ObjFile,steps[i]));
+		const unsigned int calls = handler->calls;
+
+		// the step reports more often than the scheduler does around it
+		EXPECT_LT(loaderCalls + 3,calls);
+
+		imp->SetProgressHandler(new CountingProgressHandler(calls - 2));
+		EXPECT_TRUE(NULL == imp->ReadFile(ObjFile,steps[i]));
+		EXPECT_STREQ("Import cancelled",imp->GetErrorString());
+	}
+}
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+// ------------------------------------------------------------------------------------------------
+TEST_F(ReadFileAsyncTest, testCancelRunningImport)
+{
+	BlockingProgressHandler* handler = new BlockingProgressHandler();
+	imp->SetProgressHandler(handler);
+
+	ImportFuture future = imp->ReadFileAsync(ObjFile,0);
+	handler->WaitForStart();
+	EXPECT_FALSE(future.IsReady());
+
+	future.Cancel();
+	handler->Release();
+	EXPECT_TRUE(NULL == future.Get());
+	EXPECT_STREQ("Import cancelled",imp->GetErrorString());
+
+	// the cancel request must not leak into the next import
+	future = imp->ReadFileAsync(ObjFile,0);
+	EXPECT_TRUE(NULL != future.Get());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ReadFileAsyncTest, testLateCancelBeforeReadFile)
+{
+	ImportFuture future = imp->ReadFileAsync(ObjFile,0);
+	while (!future.IsReady()) {
+		boost::this_thread::yield();
+	}
+
+	// a cancel request which arrived while the import was finishing, the
+	// caller doesn't wait for the result but starts the next import
+	imp->Pimpl()->mCancelRequested.Set();
+	EXPECT_TRUE(NULL != imp->ReadFile(StlFile,0));
+}
+#endif
@@ -125,3 +125,89 @@ TEST_F(SplitLargeMeshesTest, testTriangleSplit)
 	}
 	EXPECT_EQ(0, iOldFaceNum);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testSpatialSplit)
+{
+	// a long strip of triangles along the x axis, with the faces shuffled
+	// so consecutive face ranges span the whole strip
+	aiMesh* pcMesh = new aiMesh();
+	pcMesh->mNumFaces = 4000;
+	pcMesh->mNumVertices = pcMesh->mNumFaces * 3;
+	pcMesh->mVertices = new aiVector3D[pcMesh->mNumVertices];
+	pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+
+	for (unsigned int i = 0; i < pcMesh->mNumFaces;++i)
+	{
+		const float x = (float)((i * 7919) % pcMesh->mNumFaces);
+		pcMesh->mVertices[i*3]   = aiVector3D(x,0.f,0.f);
+		pcMesh->mVertices[i*3+1] = aiVector3D(x+1.f,0.f,0.f);
+		pcMesh->mVertices[i*3+2] = aiVector3D(x,1.f,0.f);
+
+		aiFace& face = pcMesh->mFaces[i];
+		face.mNumIndices = 3;
+		face.mIndices = new unsigned int[3];
+		face.mIndices[0] = i*3;
+		face.mIndices[1] = i*3+1;
+		face.mIndices[2] = i*3+2;
+	}
+
+	std::vector< std::pair<aiMesh*, unsigned int> > avOut;
+	piProcessTriangle->SetSpatialSplit(true);
+	piProcessTriangle->SplitMesh(0,pcMesh,avOut);
+
+	int iOldFaceNum = 4000;
+	EXPECT_EQ(4U, avOut.size());
+	for (std::vector< std::pair<aiMesh*, unsigned int> >::const_iterator
+		iter =  avOut.begin(), end = avOut.end();
+		iter != end; ++iter)
+	{
+		aiMesh* mesh = (*iter).first;
+		EXPECT_LE(mesh->mNumFaces, 1000U);
+		EXPECT_EQ(mesh->mNumFaces * 3, mesh->mNumVertices);
+
+		// each chunk must cover roughly a quarter of the strip
+		float fMin = 1e10f, fMax = -1e10f;
+		for (unsigned int i = 0; i < mesh->mNumVertices;++i)
+		{
+			fMin = std::min(fMin,mesh->mVertices[i].x);
+			fMax = std::max(fMax,mesh->mVertices[i].x);
+		}
+		EXPECT_LT(fMax - fMin, 1100.f);
+
+		iOldFaceNum -= mesh->mNumFaces;
+		delete mesh;
+	}
+	EXPECT_EQ(0, iOldFaceNum);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testSpatialVertexSplit)
+{
+	std::vector< std::pair<aiMesh*, unsigned int> > avOut;
+
+	int iOldFaceNum = (int)pcMesh2->mNumFaces;
+	piProcessVertex->SetLimit(500);
+	piProcessVertex->SetSpatialSplit(true);
+	piProcessVertex->SplitMesh(0,pcMesh2,avOut);
+
+	for (std::vector< std::pair<aiMesh*, unsigned int> >::const_iterator
+		iter =  avOut.begin(), end = avOut.end();
+		iter != end; ++iter)
+	{
+		aiMesh* mesh = (*iter).first;
+		EXPECT_LE(mesh->mNumVertices, 500U);
+		EXPECT_TRUE(NULL != mesh->mNormals);
+		EXPECT_TRUE(NULL != mesh->mVertices);
+
+		for (unsigned int i = 0; i < mesh->mNumFaces;++i)
+		{
+			for (unsigned int n = 0; n < mesh->mFaces[i].mNumIndices;++n)
+				EXPECT_LT(mesh->mFaces[i].mIndices[n], mesh->mNumVertices);
+		}
+
+		iOldFaceNum -= mesh->mNumFaces;
+		delete mesh;
+	}
+	EXPECT_EQ(0, iOldFaceNum);
+}
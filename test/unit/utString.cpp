@@ -0,0 +1,131 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/types.h>
+
+#include <string>
+
+class StringTest : public ::testing::Test
+{
+protected:
+
+	// an aiString followed by a guard area, writes past the end of the
+	// buffer show up as modified guard bytes.
+	struct GuardedString
+	{
+		GuardedString() {
+			memset(guard,0x5a,sizeof(guard));
+		}
+
+		bool GuardIntact() const {
+			for (unsigned int i = 0; i < sizeof(guard); ++i) {
+				if (guard[i] != 0x5a) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		aiString str;
+		char guard[64];
+	};
+
+	static void CheckCropped(const aiString& s, char c) {
+		ASSERT_EQ(MAXLEN-1, s.length);
+		EXPECT_EQ('\0', s.data[MAXLEN-1]);
+		EXPECT_EQ(std::string(MAXLEN-1,c), std::string(s.data));
+	}
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(StringTest, testSetLongestFittingString)
+{
+	const std::string in(MAXLEN-1,'a');
+
+	GuardedString g;
+	g.str.Set(in);
+	EXPECT_EQ(in.length(), g.str.length);
+	EXPECT_EQ(in, std::string(g.str.C_Str()));
+	EXPECT_TRUE(g.GuardIntact());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Strings of MAXLEN or more characters are cropped to MAXLEN-1, all ways to set them must agree
+TEST_F(StringTest, testSetCropsLongStrings)
+{
+	const size_t lengths[] = {MAXLEN, MAXLEN+1, 4*MAXLEN};
+	for (unsigned int i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+		const std::string in(lengths[i],'b');
+
+		GuardedString fromStd;
+		fromStd.str.Set(in);
+		CheckCropped(fromStd.str,'b');
+		EXPECT_TRUE(fromStd.GuardIntact());
+
+		GuardedString fromChar;
+		fromChar.str.Set(in.c_str());
+		CheckCropped(fromChar.str,'b');
+		EXPECT_TRUE(fromChar.GuardIntact());
+
+		GuardedString assigned;
+		assigned.str = in;
+		CheckCropped(assigned.str,'b');
+		EXPECT_TRUE(assigned.GuardIntact());
+
+		CheckCropped(aiString(in),'b');
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(StringTest, testSelfAssignment)
+{
+	aiString s;
+	s.Set("self assignment");
+
+	const aiString& ref = s;
+	s = ref;
+	EXPECT_EQ(15U, s.length);
+	EXPECT_STREQ("self assignment", s.C_Str());
+
+	s.Set(std::string(MAXLEN+1,'c'));
+	s = ref;
+	CheckCropped(s,'c');
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(StringTest, testAssignCroppedString)
+{
+	aiString cropped;
+	cropped.Set(std::string(MAXLEN+1,'d'));
+
+	GuardedString g;
+	g.str.Set("short");
+	g.str = cropped;
+	CheckCropped(g.str,'d');
+	EXPECT_TRUE(g.str == cropped);
+	EXPECT_TRUE(g.GuardIntact());
+
+	const aiString copy(cropped);
+	CheckCropped(copy,'d');
+
+	// a damaged length must not make the copy read or write past the buffer
+	cropped.length = MAXLEN+100;
+	GuardedString damaged;
+	damaged.str = cropped;
+	CheckCropped(damaged.str,'d');
+	EXPECT_TRUE(damaged.GuardIntact());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(StringTest, testAppendPastMaxlen)
+{
+	aiString s;
+	s.Set(std::string(MAXLEN-2,'e'));
+	s.Append("f");
+	EXPECT_EQ(MAXLEN-1, s.length);
+
+	// no room left, the string stays as it is
+	s.Append("g");
+	EXPECT_EQ(MAXLEN-1, s.length);
+	EXPECT_EQ('f', s.data[MAXLEN-2]);
+	EXPECT_EQ('\0', s.data[MAXLEN-1]);
+}
@@ -0,0 +1,120 @@
+#include "UnitTestPCH.h"
+
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <ValidateDataStructure.h>
+#include <Exceptional.h>
+
+
+using namespace std;
+using namespace Assimp;
+
+class ValidateDSTest : public ::testing::Test
+{
+public:
+
+	virtual void SetUp();
+	virtual void TearDown();
+
+protected:
+
+	aiScene* scene;
+	ValidateDSProcess* process;
+};
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSTest::SetUp()
+{
+	scene = new aiScene();
+	scene->mRootNode = new aiNode();
+	scene->mRootNode->mName.Set("root");
+
+	scene->mMaterials = new aiMaterial*[scene->mNumMaterials = 1];
+	scene->mMaterials[0] = new aiMaterial();
+
+	// 8 meshes, each a quad made of two triangles, pseudo-indexed
+	scene->mMeshes = new aiMesh*[scene->mNumMeshes = 8];
+	for (unsigned int i = 0; i < 8; ++i) {
+		aiMesh* mesh = scene->mMeshes[i] = new aiMesh();
+		mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+		mesh->mVertices = new aiVector3D[mesh->mNumVertices = 6];
+		mesh->mFaces = new aiFace[mesh->mNumFaces = 2];
+		for (unsigned int f = 0; f < 2; ++f) {
+			aiFace& face = mesh->mFaces[f];
+			face.mIndices = new unsigned int[face.mNumIndices = 3];
+			for (unsigned int a = 0; a < 3; ++a) {
+				face.mIndices[a] = f*3+a;
+				mesh->mVertices[f*3+a] = aiVector3D((float)i,(float)f,(float)a);
+			}
+		}
+	}
+
+	// an animation with a key exceeding the duration
+	scene->mAnimations = new aiAnimation*[scene->mNumAnimations = 1];
+	aiAnimation* anim = scene->mAnimations[0] = new aiAnimation();
+	anim->mDuration = 1.;
+	anim->mChannels = new aiNodeAnim*[anim->mNumChannels = 4];
+	for (unsigned int i = 0; i < 4; ++i) {
+		aiNodeAnim* channel = anim->mChannels[i] = new aiNodeAnim();
+		channel->mNodeName.Set("root");
+		channel->mPositionKeys = new aiVectorKey[channel->mNumPositionKeys = 2];
+		channel->mPositionKeys[0].mTime = 0.;
+		channel->mPositionKeys[1].mTime = i == 3 ? 2. : 1.;
+	}
+
+	process = new ValidateDSProcess();
+}
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSTest::TearDown()
+{
+	delete process;
+	delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDSTest, testStructureLevel)
+{
+	Importer imp;
+	imp.SetPropertyInteger(AI_CONFIG_PP_VDS_LEVEL,AI_VDS_LEVEL_STRUCTURE);
+	process->SetupProperties(&imp);
+
+	// the key time is a plausibility check only
+	EXPECT_NO_THROW(process->Execute(scene));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDSTest, testNonVerboseFormat)
+{
+	// vertices referenced twice are fine once JoinVertices has run
+	scene->mFlags |= AI_SCENE_FLAGS_NON_VERBOSE_FORMAT;
+	scene->mMeshes[5]->mFaces[1].mIndices[0] = 0;
+	scene->mAnimations[0]->mChannels[3]->mPositionKeys[1].mTime = 1.;
+
+	process->SetLevel(AI_VDS_LEVEL_FULL);
+	EXPECT_NO_THROW(process->Execute(scene));
+
+	process->SetLevel(AI_VDS_LEVEL_STRUCTURE);
+	EXPECT_NO_THROW(process->Execute(scene));
+}
+
+// ReportError() asserts in debug builds
+#ifndef ASSIMP_BUILD_DEBUG
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDSTest, testKeyTimes)
+{
+	process->SetLevel(AI_VDS_LEVEL_FULL);
+	EXPECT_THROW(process->Execute(scene), DeadlyImportError);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDSTest, testIndexOutOfRange)
+{
+	scene->mMeshes[6]->mFaces[1].mIndices[2] = 6;
+
+	process->SetLevel(AI_VDS_LEVEL_STRUCTURE);
+	EXPECT_THROW(process->Execute(scene), DeadlyImportError);
+}
+
+#endif // !! ASSIMP_BUILD_DEBUG
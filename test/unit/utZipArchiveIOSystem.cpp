@@ -0,0 +1,149 @@
+#include "UnitTestPCH.h"
+
+#include <ZipArchiveIOSystem.h>
+#include "../../include/assimp/Importer.hpp"
+#include "../../include/assimp/scene.h"
+
+
+using namespace std;
+using namespace Assimp;
+
+class ZipArchiveIOSystemTest : public ::testing::Test
+{
+public:
+
+	virtual void SetUp()
+	{
+		// the importer only provides the default IOSystem to read the archive through
+		pImp = new Importer();
+		pArchive = new ZipArchiveIOSystem(pImp->GetIOHandler(), "../../test/models-nonbsd/PK3/SGDTT3.pk3");
+	}
+
+	virtual void TearDown()
+	{
+		delete pArchive;
+		delete pImp;
+	}
+
+	// read a whole entry in one go
+	void readEntry(const char* name, std::vector<char>& out)
+	{
+		IOStream* stream = pArchive->Open(name);
+		ASSERT_TRUE(NULL != stream);
+		out.resize(stream->FileSize());
+		EXPECT_EQ(out.size(), stream->Read(&out[0], 1, out.size()));
+		pArchive->Close(stream);
+	}
+
+protected:
+
+	Importer* pImp;
+	ZipArchiveIOSystem* pArchive;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ZipArchiveIOSystemTest, testIndex)
+{
+	ASSERT_TRUE(pArchive->isOpen());
+
+	// directory entries are not listed
+	std::vector<std::string> fileList;
+	pArchive->getFileList(fileList);
+	EXPECT_EQ(4U, fileList.size());
+
+	EXPECT_TRUE(pArchive->Exists("maps/SGDTT3.bsp"));
+	EXPECT_TRUE(pArchive->Exists("./maps/SGDTT3.bsp"));
+	EXPECT_TRUE(pArchive->Exists("maps\\SGDTT3.bsp"));
+	EXPECT_FALSE(pArchive->Exists("maps/"));
+	EXPECT_FALSE(pArchive->Exists("maps/missing.bsp"));
+
+	EXPECT_EQ(852016U, pArchive->getFileSize("maps/SGDTT3.bsp"));
+	EXPECT_TRUE(NULL == pArchive->Open("maps/missing.bsp"));
+	EXPECT_TRUE(NULL == pArchive->Open("maps/SGDTT3.bsp", "wb"));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ZipArchiveIOSystemTest, testSeekAndRead)
+{
+	std::vector<char> full;
+	readEntry("maps/SGDTT3.bsp", full);
+	ASSERT_EQ(852016U, full.size());
+
+	IOStream* stream = pArchive->Open("maps/SGDTT3.bsp");
+	ASSERT_TRUE(NULL != stream);
+
+	char buffer[1000];
+
+	// forward seek
+	EXPECT_EQ(aiReturn_SUCCESS, stream->Seek(500000, aiOrigin_SET));
+	EXPECT_EQ(1000U, stream->Read(buffer, 1, 1000));
+	EXPECT_EQ(0, memcmp(buffer, &full[500000], 1000));
+	EXPECT_EQ(501000U, stream->Tell());
+
+	// backward seek restarts the entry
+	EXPECT_EQ(aiReturn_SUCCESS, stream->Seek(1000, aiOrigin_SET));
+	EXPECT_EQ(250U, stream->Read(buffer, 4, 250));
+	EXPECT_EQ(0, memcmp(buffer, &full[1000], 1000));
+
+	// reads are clamped to whole elements at the end of the entry
+	EXPECT_EQ(aiReturn_SUCCESS, stream->Seek(10, aiOrigin_END));
+	EXPECT_EQ(2U, stream->Read(buffer, 4, 250));
+	EXPECT_EQ(0, memcmp(buffer, &full[full.size() - 10], 8));
+	EXPECT_EQ(aiReturn_FAILURE, stream->Seek(full.size() + 1, aiOrigin_SET));
+
+	pArchive->Close(stream);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ZipArchiveIOSystemTest, testInterleavedStreams)
+{
+	std::vector<char> bsp, arena;
+	readEntry("maps/SGDTT3.bsp", bsp);
+	readEntry("scripts/SGDTT3.arena", arena);
+
+	IOStream* a = pArchive->Open("maps/SGDTT3.bsp");
+	IOStream* b = pArchive->Open("scripts/SGDTT3.arena");
+	ASSERT_TRUE(NULL != a && NULL != b);
+
+	// both streams share one unzip handle and must not disturb each other
+	char bufA[64], bufB[64];
+	for (unsigned int i = 0; i < 2; ++i) {
+		EXPECT_EQ(64U, a->Read(bufA, 1, 64));
+		EXPECT_EQ(0, memcmp(bufA, &bsp[i * 64], 64));
+
+		EXPECT_EQ(32U, b->Read(bufB, 1, 32));
+		EXPECT_EQ(0, memcmp(bufB, &arena[i * 32], 32));
+	}
+
+	pArchive->Close(a);
+	pArchive->Close(b);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ZipArchiveIOSystemTest, testImportBundle)
+{
+	const aiScene* scene = pImp->ReadFile("../../test/models/OBJ/spider.obj", 0);
+	ASSERT_TRUE(NULL != scene);
+	const unsigned int numMeshes = scene->mNumMeshes;
+	std::vector<std::string> materials;
+	for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+		aiString name;
+		scene->mMaterials[i]->Get(AI_MATKEY_NAME, name);
+		materials.push_back(name.C_Str());
+	}
+
+	// the entry of an archive is given after the archive's path, the material
+	// library next to it is read from the archive as well
+	scene = pImp->ReadFile("../../test/models/OBJ/spider.zip/spider/spider.obj", 0);
+	ASSERT_TRUE(NULL != scene);
+	EXPECT_EQ(numMeshes, scene->mNumMeshes);
+	ASSERT_EQ(materials.size(), scene->mNumMaterials);
+	for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+		aiString name;
+		scene->mMaterials[i]->Get(AI_MATKEY_NAME, name);
+		EXPECT_EQ(materials[i], name.C_Str());
+	}
+
+	EXPECT_TRUE(NULL == pImp->ReadFile("../../test/models/OBJ/spider.zip/spider/missing.obj", 0));
+	EXPECT_TRUE(NULL == pImp->ReadFile("../../test/models/OBJ/missing.zip/spider/spider.obj", 0));
+}
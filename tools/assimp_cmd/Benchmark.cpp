@@ -0,0 +1,771 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2012, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms, 
+with or without modification, are permitted provided that the following 
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS 
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT 
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT 
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT 
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY 
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT 
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file  Benchmark.cpp
+ *  @brief Implementation of the 'assimp bench' utility
+ */
+
+#include "Main.h"
+
+#include <assimp/config.h>
+#include <assimp/LogStream.hpp>
+#include "../../code/StandardShapes.h"
+#include "../../code/Subdivision.h"
+
+#include <new>
+#include <map>
+#include <vector>
+#include <stdlib.h>
+#include <ctype.h>
+
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+#	include <boost/atomic.hpp>
+#endif
+
+#ifdef _WIN32
+#	include <windows.h>
+#	include <psapi.h>
+#else
+#	include <sys/time.h>
+#	include <sys/resource.h>
+#	ifdef __APPLE__
+#		include <mach/mach.h>
+#	endif
+#	ifdef __GLIBC__
+#		include <malloc.h>
+#	endif
+#endif
+
+const char* AICMD_MSG_BENCH_HELP_E = 
+"assimp bench <model> [<model> ...] [-n<count>] [--json=<file>] [common parameters]\n"
+"\tImport each model repeatedly and report the time spent in each phase of the\n"
+"\timport, the number of memory allocations, the peak RSS and the throughput.\n"
+"\tPhase times are taken in separate runs with the profiler enabled. The peak\n"
+"\tRSS is reported as the increase over the RSS before the model was imported.\n"
+"\tOnly Linux can reset the peak between models, elsewhere a smaller peak is\n"
+"\thidden by a larger one of an earlier model: bench one model per run there.\n"
+"\t -n<count>, --iterations=<count>: Timed imports per model, defaults to 5\n"
+"\t --synthetic: Also import generated models, no model files are needed\n"
+"\t --json=<file>: Write the results to a JSON file as well\n"
+"\t --no-pipeline: Run post-processing steps one at a time, so that each of\n"
+"\t\tthem is timed separately\n"
+"\t[See the assimp_cmd docs for a full list of all common parameters]  \n"
+;
+
+// ------------------------------------------------------------------------------
+// Allocation counters, operator new is replaced for the whole tool. Allocations
+// inside the assimp library are only seen where the platform resolves them to
+// this replacement (i.e. not for a Windows DLL). The counters are atomic if
+// the library can allocate from several threads at once.
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+static boost::atomic<uint64_t> allocCount(0);
+static boost::atomic<uint64_t> allocBytes(0);
+#else
+static uint64_t allocCount = 0;
+static uint64_t allocBytes = 0;
+#endif
+
+#if (defined _MSC_VER) || __cplusplus >= 201103L
+#	define AICMD_THROW_BAD_ALLOC
+#else
+#	define AICMD_THROW_BAD_ALLOC throw(std::bad_alloc)
+#endif
+
+void* operator new (size_t size) AICMD_THROW_BAD_ALLOC
+{
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+	allocCount.fetch_add(1,boost::memory_order_relaxed);
+	allocBytes.fetch_add(size,boost::memory_order_relaxed);
+#else
+	++allocCount;
+	allocBytes += size;
+#endif
+
+	void* p = malloc(size ? size : 1);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[] (size_t size) AICMD_THROW_BAD_ALLOC
+{
+	return operator new (size);
+}
+
+void operator delete (void* p) throw()
+{
+	free(p);
+}
+
+void operator delete[] (void* p) throw()
+{
+	free(p);
+}
+
+namespace {
+
+// ------------------------------------------------------------------------------
+/** Get the wall clock time in seconds */
+double GetWallTime()
+{
+#ifdef _WIN32
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return static_cast<double>(count.QuadPart) / freq.QuadPart;
+#else
+	timeval tv;
+	gettimeofday(&tv,NULL);
+	return tv.tv_sec + tv.tv_usec * 1e-6;
+#endif
+}
+
+#ifdef __linux__
+// ------------------------------------------------------------------------------
+/** Read a value in KB from /proc/self/status, i.e. VmRSS or VmHWM */
+size_t ReadProcStatus(const char* key)
+{
+	FILE* file = fopen("/proc/self/status","r");
+	if (!file) {
+		return 0;
+	}
+	const size_t len = strlen(key);
+	char line[256];
+	unsigned long kb = 0;
+	while (fgets(line,sizeof(line),file)) {
+		if (!strncmp(line,key,len) && line[len] == ':') {
+			kb = strtoul(line + len + 1,NULL,10);
+			break;
+		}
+	}
+	fclose(file);
+	return kb;
+}
+#endif
+
+// ------------------------------------------------------------------------------
+/** Get the peak resident set size of the process so far, in KB */
+size_t GetPeakRSS()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(),&pmc,sizeof(pmc))) {
+		return 0;
+	}
+	return pmc.PeakWorkingSetSize / 1024;
+#elif defined __linux__
+	// unlike getrusage(), this one is affected by ResetPeakRSS()
+	return ReadProcStatus("VmHWM");
+#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF,&usage)) {
+		return 0;
+	}
+#	ifdef __APPLE__
+	return usage.ru_maxrss / 1024;
+#	else
+	return usage.ru_maxrss;
+#	endif
+#endif
+}
+
+// ------------------------------------------------------------------------------
+/** Get the current resident set size of the process, in KB. 0 if unknown. */
+size_t GetCurrentRSS()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(),&pmc,sizeof(pmc))) {
+		return 0;
+	}
+	return pmc.WorkingSetSize / 1024;
+#elif defined __linux__
+	return ReadProcStatus("VmRSS");
+#elif defined __APPLE__
+	mach_task_basic_info info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (KERN_SUCCESS != task_info(mach_task_self(),MACH_TASK_BASIC_INFO,
+		reinterpret_cast<task_info_t>(&info),&count)) {
+		return 0;
+	}
+	return info.resident_size / 1024;
+#else
+	return 0;
+#endif
+}
+
+// ------------------------------------------------------------------------------
+/** Reset the peak resident set size to the current one. Only Linux 4.0 and
+ *  later can do this, elsewhere the peak stays the process-wide maximum. */
+void ResetPeakRSS()
+{
+#ifdef __GLIBC__
+	// hand memory freed by earlier models back, else it's reused without showing up in the RSS
+	malloc_trim(0);
+#endif
+#ifdef __linux__
+	FILE* file = fopen("/proc/self/clear_refs","w");
+	if (file) {
+		fputs("5",file);
+		fclose(file);
+	}
+#endif
+}
+
+typedef std::vector< std::pair<std::string,double> > PhaseTimes;
+
+// ------------------------------------------------------------------------------
+/** Log stream which turns the regions written by the importer's profiler
+ *  (AI_CONFIG_GLOB_MEASURE_TIME) into wall clock times. The profiler itself
+ *  measures processor time. */
+class BenchLogStream : public LogStream
+{
+public:
+
+	BenchLogStream()
+		: times()
+	{}
+
+	void write(const char* message)
+	{
+		if (!times) {
+			return;
+		}
+
+		const double now = GetWallTime();
+		const char* name;
+		if ((name = strstr(message,"START `"))) {
+			const std::string region = GetRegion(name+7);
+			starts[region] = now;
+		}
+		else if ((name = strstr(message,"END   `"))) {
+			const std::string region = GetRegion(name+7);
+			std::map<std::string,double>::const_iterator it = starts.find(region);
+
+			// the total is measured by the caller
+			if (it != starts.end() && region != "total") {
+				times->push_back(PhaseTimes::value_type(region,(now - (*it).second) * 1000.));
+			}
+		}
+	}
+
+	/** Receives the times of all regions ended, in ms. NULL to stop recording */
+	PhaseTimes* times;
+
+private:
+
+	static std::string GetRegion(const char* s)
+	{
+		const char* const end = strchr(s,'`');
+		return end ? std::string(s,end) : std::string(s);
+	}
+
+	std::map<std::string,double> starts;
+};
+
+// ------------------------------------------------------------------------------
+/** Enables the importer's profiler and a verbose logger for as long as it
+ *  exists. Verbose logging takes time and allocates, so only the phase times
+ *  are taken while it is active. */
+class PhaseRecorder
+{
+public:
+
+	PhaseRecorder()
+		: stream(new BenchLogStream())
+	{
+		// the profiler reports through the logger, and only in verbose mode
+		DefaultLogger::create("",Logger::VERBOSE,0);
+		DefaultLogger::get()->attachStream(stream,Logger::Debugging);
+		globalImporter->SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME,true);
+	}
+
+	~PhaseRecorder()
+	{
+		globalImporter->SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME,false);
+
+		// also deletes the stream
+		DefaultLogger::kill();
+	}
+
+	BenchLogStream* const stream;
+};
+
+// ------------------------------------------------------------------------------
+/** A model to be imported, either from a file or from memory */
+struct BenchInput
+{
+	BenchInput()
+		: bytes()
+	{}
+
+	std::string name;
+
+	// file contents and format hint for models generated in memory
+	std::vector<char> buffer;
+	std::string hint;
+
+	size_t bytes;
+};
+
+// ------------------------------------------------------------------------------
+/** Accumulated time of a single phase */
+struct BenchPhase
+{
+	BenchPhase(const std::string& name)
+		: name(name)
+		, sum()
+		, min(std::numeric_limits<double>::max())
+	{}
+
+	std::string name;
+	double sum, min;
+};
+
+// ------------------------------------------------------------------------------
+/** Results for a single model */
+struct BenchResult
+{
+	BenchResult()
+		: bytes(), triangles(), iterations(), allocations(), allocatedBytes(), peakRSSIncrease()
+		, total("total")
+	{}
+
+	std::string name;
+	size_t bytes;
+	size_t triangles;
+	unsigned int iterations;
+
+	// per import
+	uint64_t allocations;
+	uint64_t allocatedBytes;
+
+	// peak RSS over the RSS before the first import of the model, in KB
+	size_t peakRSSIncrease;
+
+	std::vector<BenchPhase> phases;
+	BenchPhase total;
+};
+
+// ------------------------------------------------------------------------------
+/** Parse a decimal number, fails if s contains anything else */
+bool ParseCount(const char* s, unsigned int& out)
+{
+	if (!isdigit(static_cast<unsigned char>(*s))) {
+		return false;
+	}
+	char* end;
+	out = strtoul(s,&end,10);
+	return !*end;
+}
+
+// ------------------------------------------------------------------------------
+size_t CountTriangles(const aiScene* scene)
+{
+	size_t cnt = 0;
+	for(unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		const aiMesh* mesh = scene->mMeshes[i];
+		for(unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+			if (mesh->mFaces[f].mNumIndices > 2) {
+				cnt += mesh->mFaces[f].mNumIndices - 2;
+			}
+		}
+	}
+	return cnt;
+}
+
+// ------------------------------------------------------------------------------
+/** Import a model once, return the times of all phases or false on failure.
+ *  stream is NULL if phase times are not recorded. */
+bool RunImport(const BenchInput& in, const ImportData& imp, BenchLogStream* stream, 
+	PhaseTimes& times, double& total)
+{
+	globalImporter->FreeScene();
+	times.clear();
+
+	if (stream) {
+		stream->times = &times;
+	}
+	const double start = GetWallTime();
+	const aiScene* scene = in.buffer.empty() 
+		? globalImporter->ReadFile(in.name,imp.ppFlags) 
+		: globalImporter->ReadFileFromMemory(&in.buffer[0],in.buffer.size(),imp.ppFlags,in.hint.c_str());
+
+	total = (GetWallTime() - start) * 1000.;
+	if (stream) {
+		stream->times = NULL;
+	}
+	return NULL != scene;
+}
+
+// ------------------------------------------------------------------------------
+/** Benchmark a single model */
+bool Benchmark(const BenchInput& in, const ImportData& imp, unsigned int iterations,
+	BenchResult& out)
+{
+	PhaseTimes times;
+	double total;
+
+	// drop the scene of the previous model, the peak RSS is taken relative to what's left
+	globalImporter->FreeScene();
+	ResetPeakRSS();
+	const size_t rssStart = GetCurrentRSS();
+
+	// untimed run to warm up caches
+	if (!RunImport(in,imp,NULL,times,total)) {
+		printf("assimp bench: failed to import %s: %s\n",in.name.c_str(),globalImporter->GetErrorString());
+		return false;
+	}
+
+	out.name = in.name;
+	out.bytes = in.bytes;
+	out.iterations = iterations;
+
+	// total times and allocations are taken with logging and profiling off
+	const uint64_t allocCountStart = allocCount, allocBytesStart = allocBytes;
+	for (unsigned int i = 0; i < iterations; ++i) {
+		if (!RunImport(in,imp,NULL,times,total)) {
+			return false;
+		}
+		out.total.sum += total;
+		out.total.min = std::min(out.total.min,total);
+	}
+	out.allocations = (allocCount - allocCountStart) / iterations;
+	out.allocatedBytes = (allocBytes - allocBytesStart) / iterations;
+
+	// separate runs for the times of the single phases
+	PhaseRecorder recorder;
+	for (unsigned int i = 0; i < iterations; ++i) {
+		if (!RunImport(in,imp,recorder.stream,times,total)) {
+			return false;
+		}
+
+		// merge regions of the same name within an import, keep the order of first occurrence
+		std::map<std::string,double> merged;
+		for (PhaseTimes::const_iterator it = times.begin(); it != times.end(); ++it) {
+			if (merged.find((*it).first) == merged.end() && !i) {
+				out.phases.push_back(BenchPhase((*it).first));
+			}
+			merged[(*it).first] += (*it).second;
+		}
+		for (std::vector<BenchPhase>::iterator it = out.phases.begin(); it != out.phases.end(); ++it) {
+			const double t = merged[(*it).name];
+			(*it).sum += t;
+			(*it).min = std::min((*it).min,t);
+		}
+	}
+
+	const size_t peak = GetPeakRSS();
+	out.peakRSSIncrease = peak > rssStart ? peak - rssStart : 0;
+	out.triangles = CountTriangles(globalImporter->GetScene());
+	return true;
+}
+
+// ------------------------------------------------------------------------------
+void PrintResult(const BenchResult& res)
+{
+	const double seconds = res.total.sum / res.iterations / 1000.;
+
+	printf("\nassimp bench: %s (%llu bytes, %llu triangles, %u iterations)\n",res.name.c_str(),
+		static_cast<unsigned long long>(res.bytes),static_cast<unsigned long long>(res.triangles),res.iterations);
+	printf("  %-56s %12s %12s\n","phase","mean ms","min ms");
+
+	for (std::vector<BenchPhase>::const_iterator it = res.phases.begin(); it != res.phases.end(); ++it) {
+		// pipelined post-processing stages can have quite long names
+		const char* name = (*it).name.c_str();
+		if ((*it).name.length() > 56) {
+			printf("  %s\n",name);
+			name = "";
+		}
+		printf("  %-56s %12.3f %12.3f\n",name,(*it).sum / res.iterations,(*it).min);
+	}
+	printf("  %-56s %12.3f %12.3f\n","total",res.total.sum / res.iterations,res.total.min);
+
+	printf("  throughput: %.2f MB/s, %.0f triangles/s\n",
+		res.bytes / (1024. * 1024.) / seconds, res.triangles / seconds);
+	printf("  allocations: %llu per import (%.2f MB), peak RSS +%llu KB\n",
+		static_cast<unsigned long long>(res.allocations),res.allocatedBytes / (1024. * 1024.),
+		static_cast<unsigned long long>(res.peakRSSIncrease));
+}
+
+// ------------------------------------------------------------------------------
+std::string JsonString(const std::string& s)
+{
+	std::string out = "\"";
+	for (std::string::const_iterator it = s.begin(); it != s.end(); ++it) {
+		if (*it == '\"' || *it == '\\') {
+			out += '\\';
+		}
+		out += *it;
+	}
+	return out + "\"";
+}
+
+// ------------------------------------------------------------------------------
+bool WriteJson(const std::string& path, const ImportData& imp, const std::vector<BenchResult>& results)
+{
+	FILE* file = fopen(path.c_str(),"wt");
+	if (!file) {
+		return false;
+	}
+
+	fprintf(file,"{\n  \"version\": \"%u.%u.%x\",\n  \"flags\": %u,\n  \"results\": [\n",
+		aiGetVersionMajor(),aiGetVersionMinor(),aiGetVersionRevision(),imp.ppFlags);
+
+	for (std::vector<BenchResult>::const_iterator it = results.begin(); it != results.end(); ++it) {
+		const BenchResult& res = *it;
+		const double seconds = res.total.sum / res.iterations / 1000.;
+
+		fprintf(file,"    {\n      \"name\": %s,\n      \"bytes\": %llu,\n      \"triangles\": %llu,\n"
+			"      \"iterations\": %u,\n      \"phases\": [\n",JsonString(res.name).c_str(),
+			static_cast<unsigned long long>(res.bytes),static_cast<unsigned long long>(res.triangles),res.iterations);
+
+		for (std::vector<BenchPhase>::const_iterator p = res.phases.begin(); p != res.phases.end(); ++p) {
+			fprintf(file,"        { \"name\": %s, \"mean_ms\": %.4f, \"min_ms\": %.4f }%s\n",
+				JsonString((*p).name).c_str(),(*p).sum / res.iterations,(*p).min,
+				p + 1 != res.phases.end() ? "," : "");
+		}
+
+		fprintf(file,"      ],\n      \"total_mean_ms\": %.4f,\n      \"total_min_ms\": %.4f,\n"
+			"      \"mb_per_s\": %.4f,\n      \"triangles_per_s\": %.1f,\n"
+			"      \"allocations\": %llu,\n      \"allocated_bytes\": %llu,\n      \"peak_rss_increase_kb\": %llu\n    }%s\n",
+			res.total.sum / res.iterations,res.total.min,
+			res.bytes / (1024. * 1024.) / seconds,res.triangles / seconds,
+			static_cast<unsigned long long>(res.allocations),static_cast<unsigned long long>(res.allocatedBytes),
+			static_cast<unsigned long long>(res.peakRSSIncrease),it + 1 != results.end() ? "," : "");
+	}
+
+	fprintf(file,"  ]\n}\n");
+	fclose(file);
+	return true;
+}
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+// ------------------------------------------------------------------------------
+/** Generate a scene of tessellated spheres (triangles) and subdivided cubes
+ *  (quads), so that the benchmark needs no model files */
+aiScene* MakeSyntheticScene()
+{
+	std::vector<aiMesh*> meshes;
+	std::vector<aiVector3D> positions;
+
+	for (unsigned int i = 0; i < 4; ++i) {
+		positions.clear();
+		StandardShapes::MakeSphere(5,positions);
+		meshes.push_back(StandardShapes::MakeMesh(positions,3));
+	}
+
+	Subdivider* subdiv = Subdivider::Create(Subdivider::CATMULL_CLARKE);
+	for (unsigned int i = 0; i < 4; ++i) {
+		positions.clear();
+		const unsigned int numIndices = StandardShapes::MakeHexahedron(positions,true);
+
+		aiMesh* mesh;
+		subdiv->Subdivide(StandardShapes::MakeMesh(positions,numIndices),mesh,5,true);
+		meshes.push_back(mesh);
+	}
+	delete subdiv;
+
+	aiScene* scene = new aiScene();
+	scene->mNumMeshes = static_cast<unsigned int>(meshes.size());
+	scene->mMeshes = new aiMesh*[scene->mNumMeshes];
+	std::copy(meshes.begin(),meshes.end(),scene->mMeshes);
+
+	scene->mRootNode = new aiNode();
+	scene->mRootNode->mName.Set("synthetic");
+	scene->mRootNode->mNumMeshes = scene->mNumMeshes;
+	scene->mRootNode->mMeshes = new unsigned int[scene->mNumMeshes];
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		scene->mRootNode->mMeshes[i] = i;
+	}
+
+	aiMaterial* mat = new aiMaterial();
+	const aiString name("DefaultMaterial");
+	mat->AddProperty(&name,AI_MATKEY_NAME);
+
+	scene->mNumMaterials = 1;
+	scene->mMaterials = new aiMaterial*[1];
+	scene->mMaterials[0] = mat;
+	return scene;
+}
+
+// ------------------------------------------------------------------------------
+/** Write the synthetic scene to memory in a couple of formats */
+void AddSyntheticInputs(std::vector<BenchInput>& inputs)
+{
+	// text and binary formats, the hint is the extension of the format
+	static const char* const formats[][2] = {
+		{"obj","obj"}, {"stl","stl"}, {"stlb","stl"}, {"plyb","ply"}, {"assbin","assbin"}
+	};
+
+	aiScene* scene = MakeSyntheticScene();
+	for (unsigned int i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+		const aiExportDataBlob* blob = globalExporter->ExportToBlob(scene,formats[i][0]);
+		if (!blob) {
+			printf("assimp bench: failed to generate synthetic %s model: %s\n",formats[i][0],
+				globalExporter->GetErrorString());
+			continue;
+		}
+
+		BenchInput in;
+		in.name = std::string("synthetic.") + formats[i][0];
+		in.hint = formats[i][1];
+		in.buffer.assign(static_cast<const char*>(blob->data),static_cast<const char*>(blob->data) + blob->size);
+		in.bytes = blob->size;
+		inputs.push_back(in);
+	}
+	globalExporter->FreeBlob();
+	delete scene;
+}
+#endif
+
+} // ! anon namespace
+
+// ------------------------------------------------------------------------------
+int Assimp_Benchmark(const char* const* params, unsigned int num)
+{
+	if (num < 1) {
+		printf("assimp bench: Invalid number of arguments. See \'assimp bench --help\'\n");
+		return 1;
+	}
+
+	// --help
+	if (!strcmp( params[0], "-h") || !strcmp( params[0], "--help") || !strcmp( params[0], "-?") ) {
+		printf("%s",AICMD_MSG_BENCH_HELP_E);
+		return 0;
+	}
+
+	// get import flags
+	ImportData import;
+	ProcessStandardArguments(import,params,num);
+
+	std::vector<BenchInput> inputs;
+	unsigned int iterations = 5;
+	std::string json;
+	bool synthetic = false;
+
+	for (unsigned int i = 0; i < num; ++i) {
+		if (!strncmp( params[i], "-n",2) && isdigit(static_cast<unsigned char>(params[i][2]))) {
+			if (!ParseCount(params[i]+2,iterations)) {
+				printf("assimp bench: invalid number of iterations: %s\n",params[i]);
+				return 1;
+			}
+		}
+		else if (!strncmp( params[i], "--iterations=",13)) {
+			if (!ParseCount(params[i]+13,iterations)) {
+				printf("assimp bench: invalid number of iterations: %s\n",params[i]);
+				return 1;
+			}
+		}
+		else if (!strncmp( params[i], "--json=",7)) {
+			json = std::string(params[i]+7);
+		}
+		else if (!strcmp( params[i], "--synthetic")) {
+			synthetic = true;
+		}
+		else if (!strcmp( params[i], "--no-pipeline")) {
+			globalImporter->SetPropertyBool(AI_CONFIG_PP_PIPELINE_MESHES,false);
+		}
+		else if (params[i][0] != '-') {
+			BenchInput in;
+			in.name = params[i];
+
+			FILE* file = fopen(params[i],"rb");
+			if (file) {
+				fseek(file,0,SEEK_END);
+				in.bytes = ftell(file);
+				fclose(file);
+			}
+			inputs.push_back(in);
+		}
+	}
+
+	if (!iterations) {
+		printf("assimp bench: the number of iterations must not be zero\n");
+		return 1;
+	}
+
+	if (synthetic) {
+#ifndef ASSIMP_BUILD_NO_EXPORT
+		AddSyntheticInputs(inputs);
+#else
+		printf("assimp bench: synthetic models are not available due to build settings\n");
+#endif
+	}
+
+	if (inputs.empty()) {
+		printf("assimp bench: no models given\n");
+		return 1;
+	}
+
+	if(!globalImporter->ValidateFlags(import.ppFlags)) {
+		printf("assimp bench: unsupported post-processing flags\n");
+		return 1;
+	}
+
+	// the profiler is only enabled while phase times are recorded
+	globalImporter->SetPropertyBool(AI_CONFIG_GLOB_MEASURE_TIME,false);
+
+	std::vector<BenchResult> results;
+	int ret = 0;
+	for (std::vector<BenchInput>::const_iterator it = inputs.begin(); it != inputs.end(); ++it) {
+		results.push_back(BenchResult());
+		if (!Benchmark(*it,import,iterations,results.back())) {
+			results.pop_back();
+			ret = -40;
+			continue;
+		}
+		PrintResult(results.back());
+	}
+
+	globalImporter->FreeScene();
+
+	if (json.length()) {
+		if (!WriteJson(json,import,results)) {
+			printf("assimp bench: failed to write %s\n",json.c_str());
+			return -41;
+		}
+		printf("\nassimp bench: wrote results to %s\n",json.c_str());
+	}
+	return ret;
+}
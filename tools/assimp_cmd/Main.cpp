@@ -67,6 +67,7 @@ const char* AICMD_MSG_HELP =
 " \textract    - Extract embedded texture images\n"
 " \tdump       - Convert models to a binary or textual dump (ASSBIN/ASSXML)\n"
 " \tcmpdump    - Compare dumps created using \'assimp dump <file> -s ...\'\n"
+" \tbench      - Measure the import performance for a set of models\n"
 " \tversion    - Display Assimp version\n"
 "\n Use \'assimp <verb> --help\' for detailed help on a command.\n"
 ;
@@ -217,6 +218,12 @@ int main (int argc, char* argv[])
 		return Assimp_Extract (&argv[2],argc-2);
 	}
 
+	// assimp bench
+	// Measure the import performance for a set of models
+	if (! strcmp(argv[1], "bench")) {
+		return Assimp_Benchmark (&argv[2],argc-2);
+	}
+
 	// assimp testbatchload
 	// Used by /test/other/streamload.py to load a list of files
 	// using the same importer instance to check for incompatible
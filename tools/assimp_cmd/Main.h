@@ -193,6 +193,15 @@ int Assimp_Info (
 	const char* const* params, 
 	unsigned int num);
 
+// ------------------------------------------------------------------------------
+/** @brief assimp bench utility
+ *  @param params Command line parameters to 'assimp bench'
+ *  @param Number of params
+ *  @return 0 for success */
+int Assimp_Benchmark (
+	const char* const* params, 
+	unsigned int num);
+
 // ------------------------------------------------------------------------------
 /** @brief assimp testbatchload utility
  *  @param params Command line parameters to 'assimp testbatchload'
@@ -203,4 +212,4 @@ int Assimp_TestBatchLoad (
 	unsigned int num);
 
 
-#endif // !! AICMD_MAIN_INCLUDED
\ No newline at end of file
+#endif // !! AICMD_MAIN_INCLUDED
\ No newline at end of file